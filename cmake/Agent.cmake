@@ -96,6 +96,7 @@ add_library(core
   fboss/agent/RestartTimeTracker.cpp
   fboss/agent/RouteUpdateLogger.cpp
   fboss/agent/RouteUpdateLoggingPrefixTracker.cpp
+  fboss/agent/RxPacketDispatcher.cpp
   fboss/agent/StandaloneRibConversions.cpp
   fboss/agent/StaticL2ForNeighborObserver.cpp
   fboss/agent/SwSwitch.cpp
@@ -92,6 +92,7 @@ add_library(bcm
 target_link_libraries(bcm
   config
   sflow_cpp2
+  sflow_structs
   hw_switch_warmboot_helper
   hw_switch_stats
   bcm_types
@@ -21,6 +21,7 @@ add_library(hw_warm_boot_exit_speed
 target_link_libraries(hw_warm_boot_exit_speed
   config_factory
   hw_switch_ensemble
+  hw_switch_warmboot_helper
   route_scale_gen
   Folly::folly
 )
@@ -31,6 +32,7 @@ add_library(hw_stats_collection_speed
 
 target_link_libraries(hw_stats_collection_speed
   config_factory
+  hw_port_fb303_stats
   hw_packet_utils
   ecmp_helper
   hw_benchmark_main
@@ -38,6 +40,18 @@ target_link_libraries(hw_stats_collection_speed
   Folly::follybenchmark
 )
 
+add_library(hw_acl_config_push_speed
+  fboss/agent/hw/benchmarks/HwAclConfigPushBenchmark.cpp
+)
+
+target_link_libraries(hw_acl_config_push_speed
+  config_factory
+  hw_switch_ensemble
+  Folly::folly
+  hw_benchmark_main
+  Folly::follybenchmark
+)
+
 add_library(hw_fsw_scale_route_add_speed
   fboss/agent/hw/benchmarks/HwFswScaleRouteAddBenchmark.cpp
 )
@@ -171,6 +171,23 @@ function(BUILD_SAI_BENCHMARKS SAI_IMPL_NAME SAI_IMPL_ARG)
     -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
   )
 
+  add_executable(sai_acl_config_push_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
+
+  target_link_libraries(sai_acl_config_push_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    -Wl,--whole-archive
+    sai_switch_ensemble
+    hw_acl_config_push_speed
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_acl_config_push_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
   add_executable(sai_tx_slow_path_rate-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
 
   target_link_libraries(sai_tx_slow_path_rate-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
@@ -288,6 +305,9 @@ if(SAI_IMPL)
   install(
     TARGETS
     sai_stats_collection_speed-sai_impl-${SAI_VER_SUFFIX})
+  install(
+    TARGETS
+    sai_acl_config_push_speed-sai_impl-${SAI_VER_SUFFIX})
   install(
     TARGETS
     sai_warm_boot_exit_speed-sai_impl-${SAI_VER_SUFFIX})
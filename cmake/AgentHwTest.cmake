@@ -151,3 +151,16 @@ target_link_libraries(hw_switch_test
   trunk_utils
   Folly::folly
 )
+
+add_executable(hw_switch_warmboot_helper_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/agent/hw/test/HwSwitchWarmBootHelperTests.cpp
+)
+
+target_link_libraries(hw_switch_warmboot_helper_test
+  hw_switch_warmboot_helper
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(hw_switch_warmboot_helper_test)
@@ -28,6 +28,7 @@ target_link_libraries(packet
 )
 
 add_library(sflow_structs
+  fboss/agent/packet/SflowDatagramBatch.cpp
   fboss/agent/packet/SflowStructs
 )
 
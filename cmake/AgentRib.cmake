@@ -5,7 +5,9 @@
 
 add_library(standalone_rib
   fboss/agent/rib/ConfigApplier.cpp
+  fboss/agent/rib/NextHopDependencyIndex.cpp
   fboss/agent/rib/Route.cpp
+  fboss/agent/rib/RouteBatch.cpp
   fboss/agent/rib/RouteNextHop.cpp
   fboss/agent/rib/RouteNextHopEntry.cpp
   fboss/agent/rib/RouteNextHopsMulti.cpp
@@ -23,6 +25,7 @@ target_link_libraries(standalone_rib
   ctrl_cpp2
   label_forwarding_action
   state_utils
+  interned
   Folly::folly
 )
 
@@ -22,6 +22,7 @@ add_library(state
   fboss/agent/state/LabelForwardingInformationBase.cpp
   fboss/agent/state/LoadBalancer.cpp
   fboss/agent/state/LoadBalancerMap.cpp
+  fboss/agent/state/LpmIndex.cpp
   fboss/agent/state/MacEntry.cpp
   fboss/agent/state/MacTable.cpp
   fboss/agent/state/MatchAction.cpp
@@ -68,6 +69,8 @@ target_link_libraries(state
   label_forwarding_action
   state_utils
   radix_tree
+  persistent_map
+  interned
   phy_cpp2
   Folly::folly
 )
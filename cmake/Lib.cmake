@@ -27,6 +27,18 @@ add_library(ref_map
 
 set_target_properties(ref_map PROPERTIES LINKER_LANGUAGE CXX)
 
+add_library(persistent_map
+  fboss/lib/PersistentMap.h
+)
+
+set_target_properties(persistent_map PROPERTIES LINKER_LANGUAGE CXX)
+
+add_library(interned
+  fboss/lib/Interned.h
+)
+
+set_target_properties(interned PROPERTIES LINKER_LANGUAGE CXX)
+
 add_library(tuple_utils
   fboss/lib/TupleUtils.h
 )
@@ -80,9 +80,10 @@ void updateFibFromConfig(
     facebook::fboss::RouterID vrf,
     const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const facebook::fboss::rib::UpdatedPrefixes* updatedPrefixes,
     void* cookie) {
   facebook::fboss::rib::ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, updatedPrefixes);
 
   auto nextStatePtr =
       static_cast<std::shared_ptr<facebook::fboss::SwitchState>*>(cookie);
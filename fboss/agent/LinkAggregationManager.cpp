@@ -328,7 +328,9 @@ void LinkAggregationManager::enableForwarding(
       portID, aggPortID, AggregatePort::Forwarding::ENABLED);
 
   sw_->updateStateNoCoalescing(
-      "AggregatePort ForwardingState", std::move(enableFwdStateFn));
+      "AggregatePort ForwardingState",
+      std::move(enableFwdStateFn),
+      StateUpdate::Priority::HIGH);
 }
 
 void LinkAggregationManager::disableForwarding(
@@ -340,7 +342,9 @@ void LinkAggregationManager::disableForwarding(
       portID, aggPortID, AggregatePort::Forwarding::DISABLED);
 
   sw_->updateStateNoCoalescing(
-      "AggregatePort ForwardingState", std::move(disableFwdStateFn));
+      "AggregatePort ForwardingState",
+      std::move(disableFwdStateFn),
+      StateUpdate::Priority::HIGH);
 }
 
 std::vector<std::shared_ptr<LacpController>>
@@ -39,6 +39,7 @@ namespace facebook::fboss {
 template <typename NTable>
 class NeighborCache {
   friend class NeighborCacheEntry<NTable>;
+  friend class NeighborCacheImpl<NTable>;
 
  public:
   typedef typename NTable::Entry::AddressType AddressType;
@@ -210,6 +211,16 @@ class NeighborCache {
     return impl_->processEntry(ip);
   }
 
+  // Called by a NeighborCacheEntry, which already holds the cache lock
+  void queueProbe(AddressType ip) {
+    impl_->queueProbe(ip);
+  }
+
+  void sendQueuedProbes() {
+    std::lock_guard<std::mutex> g(cacheLock_);
+    impl_->sendQueuedProbes();
+  }
+
   // Has the entry corresponding to ip has been hit in hw
   bool isHit(AddressType ip) {
     return sw_->getAndClearNeighborHit(RouterID(0), ip);
@@ -19,6 +19,8 @@
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 #include <folly/Random.h>
+#include <folly/io/async/EventBase.h>
+#include <folly/io/async/HHWheelTimer.h>
 #include <chrono>
 
 /**
@@ -56,6 +58,11 @@
  * next update is scheduled. If the entry ever transitions to the EXPIRED state,
  * we do not schedule another update and the cache will flush the entry.
  *
+ * Timeouts are scheduled on the timer wheel of the neighbor cache EventBase,
+ * so all entries share a single event loop timer however many there are.
+ * Probes are not sent by the entry directly but queued on the cache, which
+ * sends them in rate limited batches (see NeighborCacheImpl::queueProbe()).
+ *
  * There is no locking in this class. Instead, the class relies on the
  * synchronization provided by NeighborCache, which should lock around all calls
  * into the cache with a single cache level lock. This class should take care
@@ -78,7 +85,7 @@ template <typename NTable>
 class NeighborCache;
 
 template <typename NTable>
-class NeighborCacheEntry : private folly::AsyncTimeout {
+class NeighborCacheEntry : private folly::HHWheelTimer::Callback {
  public:
   typedef typename NTable::Entry::AddressType AddressType;
   typedef NeighborCache<NTable> Cache;
@@ -89,8 +96,7 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
       folly::EventBase* evb,
       Cache* cache,
       NeighborEntryState state)
-      : AsyncTimeout(evb),
-        fields_(fields),
+      : fields_(fields),
         cache_(cache),
         evb_(evb),
         probesLeft_(cache_->getMaxNeighborProbes()) {
@@ -210,6 +216,20 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
         state_ == NeighborEntryState::INCOMPLETE;
   }
 
+  /*
+   * Send the probe queued by this entry, unless the entry stopped probing
+   * since. Called by the cache when the probe's batch goes out.
+   */
+  void sendQueuedProbe() {
+    if (!probeQueued_) {
+      return;
+    }
+    probeQueued_ = false;
+    if (isProbing()) {
+      sendProbe();
+    }
+  }
+
   template <typename NeighborEntryThrift>
   void populateThriftEntry(NeighborEntryThrift& entry) const {
     *entry.ip_ref() = facebook::network::toBinaryAddress(getIP());
@@ -233,6 +253,10 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
     cache_->processEntry(getIP());
   }
 
+  void scheduleTimeout(std::chrono::milliseconds timeout) {
+    evb_->timer().scheduleTimeout(this, timeout);
+  }
+
   /*
    * Schedules an update on the evb_. This is done synchronously so that we
    * can have a destructor guard around both running the state machine and
@@ -249,7 +273,7 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
         scheduleTimeout(lifetime);
         break;
       case NeighborEntryState::STALE:
-        scheduleTimeout(std::chrono::seconds(cache_->getStaleEntryInterval()));
+        scheduleTimeout(calculateStaleInterval());
         break;
       case NeighborEntryState::PROBE:
       case NeighborEntryState::INCOMPLETE:
@@ -281,6 +305,19 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
     return std::chrono::milliseconds(lifetime);
   }
 
+  /*
+   * STALE entries are checked at most every stale entry interval. Each
+   * interval is shortened by up to 10% at random, so that entries which went
+   * stale together (e.g. after a warm boot) don't stay in lockstep.
+   */
+  std::chrono::milliseconds calculateStaleInterval() const {
+    int64_t interval = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           cache_->getStaleEntryInterval())
+                           .count();
+    auto jitter = folly::Random::rand32(interval / 10 + 1);
+    return std::chrono::milliseconds(interval - jitter);
+  }
+
   bool hasProbesLeft() const {
     return probesLeft_ > 0;
   }
@@ -319,19 +356,32 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
   void probeIfProbesLeft() {
     DCHECK(isProbing());
     if (hasProbesLeft()) {
-      if (state_ == NeighborEntryState::INCOMPLETE) {
-        /* entry is INCOMPLETE, issue multicast probe */
-        cache_->probeFor(getIP());
-      } else {
-        /* entry is PROBE, issue unicast probe */
-        cache_->checkReachability(getIP(), getMac(), getPort());
+      // A probe still queued from an earlier round is not sent twice, and
+      // does not count again
+      if (!evb_->isInEventBaseThread()) {
+        // Only the neighbor cache thread sends batches
+        sendProbe();
+        --probesLeft_;
+      } else if (!probeQueued_) {
+        probeQueued_ = true;
+        cache_->queueProbe(getIP());
+        --probesLeft_;
       }
-      --probesLeft_;
     } else {
       state_ = NeighborEntryState::EXPIRED;
     }
   }
 
+  void sendProbe() {
+    if (state_ == NeighborEntryState::INCOMPLETE) {
+      /* entry is INCOMPLETE, issue multicast probe */
+      cache_->probeFor(getIP());
+    } else {
+      /* entry is PROBE, issue unicast probe */
+      cache_->checkReachability(getIP(), getMac(), getPort());
+    }
+  }
+
   void probeStaleEntryIfHit() {
     DCHECK(state_ == NeighborEntryState::STALE);
     if (cache_->isHit(getIP())) {
@@ -409,6 +459,7 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
   folly::EventBase* evb_;
   NeighborEntryState state_{NeighborEntryState::UNINITIALIZED};
   uint8_t probesLeft_{0};
+  bool probeQueued_{false};
   std::chrono::time_point<std::chrono::steady_clock> expireTime_;
 };
 
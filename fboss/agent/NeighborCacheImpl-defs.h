@@ -14,6 +14,7 @@
 #include <folly/futures/Future.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/logging/xlog.h>
+#include <algorithm>
 #include <list>
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/IPv6Handler.h"
@@ -21,6 +22,7 @@
 #include "fboss/agent/state/ArpTable.h"
 #include "fboss/agent/state/NdpTable.h"
 #include "fboss/agent/state/NeighborEntry.h"
+#include "fboss/agent/state/StateUpdate.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/Vlan.h"
 #include "fboss/agent/types.h"
@@ -101,7 +103,9 @@ void NeighborCacheImpl<NTable>::programEntry(Entry* entry) {
   };
 
   sw_->updateState(
-      folly::to<std::string>("add neighbor ", fields.ip), std::move(updateFn));
+      folly::to<std::string>("add neighbor ", fields.ip),
+      std::move(updateFn),
+      StateUpdate::Priority::HIGH);
 }
 
 template <typename NTable>
@@ -141,7 +145,8 @@ void NeighborCacheImpl<NTable>::programPendingEntry(Entry* entry, bool force) {
 
   sw_->updateStateNoCoalescing(
       folly::to<std::string>("add pending entry ", fields.ip),
-      std::move(updateFn));
+      std::move(updateFn),
+      StateUpdate::Priority::HIGH);
 }
 
 template <typename NTable>
@@ -283,6 +288,33 @@ void NeighborCacheImpl<NTable>::processEntry(AddressType ip) {
   }
 }
 
+template <typename NTable>
+void NeighborCacheImpl<NTable>::queueProbe(AddressType ip) {
+  CHECK(evb_->isInEventBaseThread());
+  queuedProbes_.push_back(ip);
+  if (!isLoopCallbackScheduled() && !isScheduled()) {
+    evb_->runInLoop(this);
+  }
+}
+
+template <typename NTable>
+void NeighborCacheImpl<NTable>::sendQueuedProbes() {
+  auto numProbes = std::min(queuedProbes_.size(), kMaxProbesPerBatch);
+  for (size_t i = 0; i < numProbes; ++i) {
+    auto entry = getCacheEntry(queuedProbes_.front());
+    queuedProbes_.pop_front();
+    if (entry) {
+      entry->sendQueuedProbe();
+    }
+  }
+  if (!queuedProbes_.empty()) {
+    XLOG(DBG4) << queuedProbes_.size() << " neighbor probes left for vlan "
+               << vlanID_ << ", sending the rest in "
+               << kProbeBatchInterval.count() << "ms";
+    evb_->timer().scheduleTimeout(this, kProbeBatchInterval);
+  }
+}
+
 template <typename NTable>
 NeighborCacheEntry<NTable>* NeighborCacheImpl<NTable>::getCacheEntry(
     AddressType ip) const {
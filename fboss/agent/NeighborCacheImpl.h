@@ -18,6 +18,10 @@
 
 #include <folly/IPAddress.h>
 #include <folly/Random.h>
+#include <folly/io/async/EventBase.h>
+#include <folly/io/async/HHWheelTimer.h>
+#include <chrono>
+#include <deque>
 #include <list>
 #include <optional>
 #include <string>
@@ -38,9 +42,15 @@ class NeighborCache;
  * All calls into this should have acquired a cache level lock through
  * NeighborCache so only one thread should ever be operating on the
  * cache at a given time.
+ *
+ * Probes queued by entries are sent at the end of the event loop iteration,
+ * so that the probes of entries whose timeouts fired together go out in one
+ * batch. At most kMaxProbesPerBatch probes are sent per batch, and
+ * kProbeBatchInterval apart, so that mass expiry doesn't cause a probe storm.
  */
 template <typename NTable>
-class NeighborCacheImpl {
+class NeighborCacheImpl : private folly::EventBase::LoopCallback,
+                          private folly::HHWheelTimer::Callback {
   friend class NeighborCache<NTable>;
 
  public:
@@ -48,7 +58,7 @@ class NeighborCacheImpl {
   typedef NeighborCacheEntry<NTable> Entry;
   typedef typename Entry::EntryFields EntryFields;
 
-  ~NeighborCacheImpl();
+  ~NeighborCacheImpl() override;
 
   bool flushEntryBlocking(AddressType ip);
   void repopulate(std::shared_ptr<NTable> table);
@@ -125,12 +135,26 @@ class NeighborCacheImpl {
   std::optional<NeighborEntryThrift> getCacheData(AddressType ip) const;
 
  private:
+  static constexpr size_t kMaxProbesPerBatch = 100;
+  static constexpr std::chrono::milliseconds kProbeBatchInterval{10};
+
   // These are used to program entries into the SwitchState
   void programEntry(Entry* entry);
   void programPendingEntry(Entry* entry, bool force = false);
 
   void processEntry(AddressType ip);
 
+  void queueProbe(AddressType ip);
+  void sendQueuedProbes();
+
+  // Send the next batch of queued probes
+  void runLoopCallback() noexcept override {
+    cache_->sendQueuedProbes();
+  }
+  void timeoutExpired() noexcept override {
+    cache_->sendQueuedProbes();
+  }
+
   // Pass in a non-null flushed if you care whether an entry
   // was actually flushed from the switch state
   void flushEntry(AddressType ip, bool* flushed = nullptr);
@@ -161,6 +185,9 @@ class NeighborCacheImpl {
 
   // Map of all entries
   std::unordered_map<AddressType, std::shared_ptr<Entry>> entries_;
+
+  // Entries waiting for their probe to be sent, in the order they asked
+  std::deque<AddressType> queuedProbes_;
 };
 
 } // namespace facebook::fboss
@@ -0,0 +1,253 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketDispatcher.h"
+
+#include "fboss/agent/DHCPv4Handler.h"
+#include "fboss/agent/Utils.h"
+#include "fboss/agent/packet/DHCPv6Packet.h"
+#include "fboss/agent/packet/Ethertype.h"
+#include "fboss/agent/packet/ICMPHdr.h"
+#include "fboss/agent/packet/IPProto.h"
+
+#include <folly/MacAddress.h>
+#include <folly/io/Cursor.h>
+#include <folly/logging/xlog.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+using facebook::fboss::ICMPv6Type;
+using facebook::fboss::IP_PROTO;
+using Queue = facebook::fboss::RxPacketDispatcher::Queue;
+
+constexpr uint16_t kBgpPort = 179;
+constexpr uint16_t kBfdSingleHopPort = 3784;
+constexpr uint16_t kBfdMultiHopPort = 4784;
+constexpr uint8_t kIPv4MinHeaderLength = 20;
+// Offset of the protocol field in an IPv4 header
+constexpr uint8_t kIPv4ProtocolOffset = 9;
+// Offset of the next header field in an IPv6 header, and the bytes after it
+constexpr uint8_t kIPv6NextHeaderOffset = 6;
+constexpr uint8_t kIPv6AfterNextHeader = 33;
+
+bool isDhcpPort(uint16_t port) {
+  return port == facebook::fboss::DHCPv4Handler::kBootPSPort ||
+      port == facebook::fboss::DHCPv4Handler::kBootPCPort ||
+      port == facebook::fboss::DHCPv6Packet::DHCP6_CLIENT_UDPPORT ||
+      port == facebook::fboss::DHCPv6Packet::DHCP6_SERVERAGENT_UDPPORT;
+}
+
+/*
+ * Classify by the L4 header, which the cursor is at. Only the first
+ * header after the IP header is looked at, so IPv6 packets with extension
+ * headers are DEFAULT.
+ */
+Queue classifyL4(IP_PROTO proto, folly::io::Cursor* c) {
+  switch (proto) {
+    case IP_PROTO::IP_PROTO_TCP: {
+      auto srcPort = c->readBE<uint16_t>();
+      auto dstPort = c->readBE<uint16_t>();
+      if (srcPort == kBgpPort || dstPort == kBgpPort) {
+        return Queue::NETWORK_CONTROL;
+      }
+      break;
+    }
+    case IP_PROTO::IP_PROTO_UDP: {
+      c->skip(sizeof(uint16_t));
+      auto dstPort = c->readBE<uint16_t>();
+      if (dstPort == kBfdSingleHopPort || dstPort == kBfdMultiHopPort) {
+        return Queue::NETWORK_CONTROL;
+      }
+      if (isDhcpPort(dstPort)) {
+        return Queue::DHCP;
+      }
+      break;
+    }
+    case IP_PROTO::IP_PROTO_IPV6_ICMP: {
+      auto type = static_cast<ICMPv6Type>(c->read<uint8_t>());
+      if (type >= ICMPv6Type::ICMPV6_TYPE_NDP_ROUTER_SOLICITATION &&
+          type <= ICMPv6Type::ICMPV6_TYPE_NDP_REDIRECT_MESSAGE) {
+        return Queue::NEIGHBOR;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return Queue::DEFAULT;
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+RxPacketDispatcher::RxPacketDispatcher(
+    PacketHandler handler,
+    DropHandler dropHandler,
+    int numThreads,
+    size_t queueSize,
+    int networkControlCos)
+    : handler_(std::move(handler)),
+      dropHandler_(std::move(dropHandler)),
+      networkControlCos_(networkControlCos) {
+  CHECK_GT(numThreads, 0);
+  CHECK_GT(queueSize, 0);
+  numThreads = std::min(numThreads, kNumQueues);
+  for (int i = 0; i < kNumQueues; ++i) {
+    queues_.push_back(
+        std::make_unique<folly::MPMCQueue<std::unique_ptr<RxPacket>>>(
+            queueSize));
+  }
+  for (int i = 0; i < numThreads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  // Start the workers once workers_ is complete, workerOf() depends on it
+  for (int i = 0; i < numThreads; ++i) {
+    workers_[i]->thread = std::thread([this, i] { workerLoop(i); });
+  }
+  XLOG(DBG2) << "Dispatching trapped packets to " << numThreads
+             << " threads, " << queueSize << " packets per queue";
+}
+
+RxPacketDispatcher::~RxPacketDispatcher() {
+  stop();
+}
+
+void RxPacketDispatcher::stop() {
+  if (stopping_.exchange(true)) {
+    return;
+  }
+  for (auto& worker : workers_) {
+    worker->packetsQueued.post();
+  }
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+bool RxPacketDispatcher::dispatch(std::unique_ptr<RxPacket> pkt) noexcept {
+  auto queue = classify(*pkt);
+  auto index = static_cast<int>(queue);
+  bool queued = false;
+  if (!stopping_.load(std::memory_order_relaxed) &&
+      !queues_[index]->isFull()) {
+    // The packet outlives the buffer it was received in, copy it if needed
+    pkt->buf()->makeManaged();
+    // MPMCQueue::write() leaves pkt alone if the queue is full
+    queued = queues_[index]->write(std::move(pkt));
+  }
+  if (!queued) {
+    drops_[index].fetch_add(1, std::memory_order_relaxed);
+    if (dropHandler_) {
+      dropHandler_(queue, *pkt);
+    }
+    return false;
+  }
+  workers_[workerOf(index)]->packetsQueued.post();
+  return true;
+}
+
+RxPacketDispatcher::Queue RxPacketDispatcher::classify(
+    const RxPacket& pkt) const {
+  // The CoS only decides for packets not recognized by their contents. The
+  // network control CPU queue usually also gets ARP, which has to stay in
+  // order and must not compete with LACP and BGP.
+  auto queue = classifyContents(pkt);
+  if (queue == Queue::DEFAULT && networkControlCos_ >= 0 &&
+      pkt.cosQueue() == networkControlCos_) {
+    return Queue::NETWORK_CONTROL;
+  }
+  return queue;
+}
+
+RxPacketDispatcher::Queue RxPacketDispatcher::classifyContents(
+    const RxPacket& pkt) {
+  try {
+    folly::io::Cursor c(pkt.buf());
+    c.skip(2 * folly::MacAddress::SIZE);
+    auto ethertype = c.readBE<uint16_t>();
+    if (ethertype == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_VLAN)) {
+      c.skip(sizeof(uint16_t));
+      ethertype = c.readBE<uint16_t>();
+    }
+    switch (static_cast<ETHERTYPE>(ethertype)) {
+      case ETHERTYPE::ETHERTYPE_LLDP:
+      case ETHERTYPE::ETHERTYPE_SLOW_PROTOCOLS:
+        return Queue::NETWORK_CONTROL;
+      case ETHERTYPE::ETHERTYPE_ARP:
+        return Queue::NEIGHBOR;
+      case ETHERTYPE::ETHERTYPE_IPV4: {
+        auto headerLength = (c.read<uint8_t>() & 0xf) * 4;
+        if (headerLength < kIPv4MinHeaderLength) {
+          break;
+        }
+        c.skip(kIPv4ProtocolOffset - 1);
+        auto proto = static_cast<IP_PROTO>(c.read<uint8_t>());
+        c.skip(headerLength - kIPv4ProtocolOffset - 1);
+        return classifyL4(proto, &c);
+      }
+      case ETHERTYPE::ETHERTYPE_IPV6: {
+        c.skip(kIPv6NextHeaderOffset);
+        auto proto = static_cast<IP_PROTO>(c.read<uint8_t>());
+        c.skip(kIPv6AfterNextHeader);
+        return classifyL4(proto, &c);
+      }
+      default:
+        break;
+    }
+  } catch (const std::out_of_range&) {
+    // Truncated, the handler will deal with it
+  }
+  return Queue::DEFAULT;
+}
+
+const char* RxPacketDispatcher::getQueueName(Queue queue) {
+  switch (queue) {
+    case Queue::NETWORK_CONTROL:
+      return "network_control";
+    case Queue::NEIGHBOR:
+      return "neighbor";
+    case Queue::DHCP:
+      return "dhcp";
+    case Queue::DEFAULT:
+      return "default";
+  }
+  return "unknown";
+}
+
+void RxPacketDispatcher::workerLoop(int worker) {
+  initThread("fbossRxDispatch");
+  while (true) {
+    workers_[worker]->packetsQueued.wait();
+    if (stopping_.load()) {
+      return;
+    }
+    auto pkt = dequeue(worker);
+    handler_(std::move(pkt));
+  }
+}
+
+std::unique_ptr<RxPacket> RxPacketDispatcher::dequeue(int worker) {
+  // Every post of packetsQueued follows a completed write to one of our
+  // queues, so there is a packet for us, though a write to an earlier slot
+  // of the same queue may still be in progress and briefly hide it.
+  std::unique_ptr<RxPacket> pkt;
+  while (true) {
+    for (int queue = worker; queue < kNumQueues; queue += workers_.size()) {
+      if (queues_[queue]->read(pkt)) {
+        return pkt;
+      }
+    }
+  }
+}
+
+} // namespace facebook::fboss
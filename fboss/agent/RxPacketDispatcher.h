@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/RxPacket.h"
+
+#include <folly/MPMCQueue.h>
+#include <folly/synchronization/LifoSem.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Hands packets trapped to the CPU off from the HwSwitch RX callback thread
+ * to a pool of worker threads, so that a slow handler for one kind of
+ * packet does not hold up the others.
+ *
+ * Packets are classified into queues, each a bounded lock free queue. A
+ * packet that finds its queue full is dropped and counted against the
+ * queue. Each queue is drained by a single worker, so the packets of a queue
+ * are handled one at a time and in the order they arrived, as the ARP, NDP
+ * and LACP handlers expect. With as many workers as queues, network control
+ * traffic (LACP, LLDP, BGP, and anything else the hardware punted on the
+ * network control CPU CoS queue) is never held up by a backlog of ARP/NDP or
+ * DHCP packets. With fewer, a worker takes a packet from the highest priority
+ * non-empty queue it drains.
+ *
+ * Packets whose buffer is not managed by an IOBuf, such as SAI packets
+ * still in the SDK's buffer, are copied when queued, as that buffer is only
+ * valid until the packet is handed over.
+ */
+class RxPacketDispatcher {
+ public:
+  // In strict priority order
+  enum class Queue : int {
+    NETWORK_CONTROL,
+    NEIGHBOR,
+    DHCP,
+    DEFAULT,
+  };
+  static constexpr int kNumQueues = static_cast<int>(Queue::DEFAULT) + 1;
+
+  using PacketHandler = std::function<void(std::unique_ptr<RxPacket>)>;
+  using DropHandler = std::function<void(Queue, const RxPacket&)>;
+
+  /*
+   * handler is called on one of numThreads worker threads for each packet.
+   * There are at most kNumQueues workers, as each queue has just one.
+   * dropHandler is called on the dispatching thread for each packet dropped
+   * because its queue was full. Packets the hardware put on
+   * networkControlCos are network control, unless their contents classify
+   * them otherwise.
+   */
+  RxPacketDispatcher(
+      PacketHandler handler,
+      DropHandler dropHandler,
+      int numThreads,
+      size_t queueSize,
+      int networkControlCos);
+  ~RxPacketDispatcher();
+
+  /*
+   * Queue a packet for the workers. Never blocks; returns false if the
+   * packet was dropped.
+   */
+  bool dispatch(std::unique_ptr<RxPacket> pkt) noexcept;
+
+  /*
+   * Stop and join the workers. Packets still queued are dropped without
+   * being counted. Safe to call more than once.
+   */
+  void stop();
+
+  Queue classify(const RxPacket& pkt) const;
+
+  uint64_t getDrops(Queue queue) const {
+    return drops_[static_cast<int>(queue)].load(std::memory_order_relaxed);
+  }
+
+  static const char* getQueueName(Queue queue);
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  RxPacketDispatcher(RxPacketDispatcher const&) = delete;
+  RxPacketDispatcher& operator=(RxPacketDispatcher const&) = delete;
+
+  struct Worker {
+    // Posted once for every packet queued to one of the worker's queues,
+    // and once on stop
+    folly::LifoSem packetsQueued;
+    std::thread thread;
+  };
+
+  static Queue classifyContents(const RxPacket& pkt);
+  void workerLoop(int worker);
+  std::unique_ptr<RxPacket> dequeue(int worker);
+
+  int workerOf(int queue) const {
+    return queue % workers_.size();
+  }
+
+  PacketHandler handler_;
+  DropHandler dropHandler_;
+  int networkControlCos_;
+  std::vector<std::unique_ptr<folly::MPMCQueue<std::unique_ptr<RxPacket>>>>
+      queues_;
+  std::array<std::atomic<uint64_t>, kNumQueues> drops_{};
+  std::atomic<bool> stopping_{false};
+  // Worker i drains the queues whose index is i modulo the number of workers
+  std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+} // namespace facebook::fboss
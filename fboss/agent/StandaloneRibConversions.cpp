@@ -11,6 +11,7 @@
 #include "fboss/agent/StandaloneRibConversions.h"
 
 #include "fboss/agent/rib/ForwardingInformationBaseUpdater.h"
+#include "fboss/agent/state/StateUpdate.h"
 
 namespace facebook::fboss {
 
@@ -40,12 +41,14 @@ static void dynamicFibUpdate(
     facebook::fboss::RouterID vrf,
     const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const facebook::fboss::rib::UpdatedPrefixes* updatedPrefixes,
     void* cookie) {
   rib::ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, updatedPrefixes);
 
   auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
-  sw->updateStateBlocking("", std::move(fibUpdater));
+  sw->updateStateBlocking(
+      "", std::move(fibUpdater), StateUpdate::Priority::BULK);
 }
 
 void syncFibWithStandaloneRib(
@@ -35,6 +35,7 @@
 #include "fboss/agent/RestartTimeTracker.h"
 #include "fboss/agent/RouteUpdateLogger.h"
 #include "fboss/agent/RxPacket.h"
+#include "fboss/agent/RxPacketDispatcher.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/ThriftHandler.h"
 #include "fboss/agent/TunManager.h"
@@ -69,6 +70,7 @@
 #include <thrift/lib/cpp2/async/RequestChannel.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <exception>
@@ -107,6 +109,37 @@ DEFINE_bool(
     false,
     "Flag to turn on logging of all updates to the FIB");
 
+DEFINE_int32(
+    max_coalesced_state_updates,
+    100,
+    "Maximum number of state updates coalesced into a single update of the "
+    "hardware");
+
+DEFINE_int32(
+    max_coalesced_state_update_ms,
+    500,
+    "Stop coalescing state updates once preparing them has taken this long "
+    "(ms), so that higher priority updates queued meanwhile get a turn");
+
+DEFINE_int32(
+    rx_dispatch_threads,
+    0,
+    "Number of threads handling packets trapped to the CPU, up to one per "
+    "dispatch queue. With 0, packets are handled on the thread the hardware "
+    "delivers them on");
+
+DEFINE_int32(
+    rx_dispatch_queue_size,
+    1024,
+    "Trapped packets queued per traffic class for the RX dispatch threads, "
+    "before dropping");
+
+DEFINE_int32(
+    rx_dispatch_network_control_cos,
+    9,
+    "CPU CoS queue whose packets are dispatched ahead of all others, unless "
+    "recognized as ARP, NDP or DHCP, or -1 for none");
+
 namespace {
 
 /**
@@ -189,6 +222,10 @@ void SwSwitch::stop() {
   // After this we should no longer receive packets or link state changed events
   // while we are destroying ourselves
   hw_->unregisterCallbacks();
+  // Wait for packets already being handled
+  if (rxPacketDispatcher_) {
+    rxPacketDispatcher_->stop();
+  }
 
   // Stop tunMgr so we don't get any packets to process
   // in software that were sent to the switch ip or were
@@ -401,6 +438,18 @@ void SwSwitch::publishTxPacket(TxPacket* pkt, uint16_t ethertype) {
 void SwSwitch::init(std::unique_ptr<TunManager> tunMgr, SwitchFlags flags) {
   auto begin = steady_clock::now();
   flags_ = flags;
+  if (FLAGS_rx_dispatch_threads > 0) {
+    rxPacketDispatcher_ = std::make_unique<RxPacketDispatcher>(
+        [this](std::unique_ptr<RxPacket> pkt) {
+          handlePacketNoThrow(std::move(pkt));
+        },
+        [this](RxPacketDispatcher::Queue queue, const RxPacket& pkt) {
+          rxDispatchDrop(static_cast<int>(queue), pkt);
+        },
+        FLAGS_rx_dispatch_threads,
+        FLAGS_rx_dispatch_queue_size,
+        FLAGS_rx_dispatch_network_control_cos);
+  }
   auto hwInitRet = hw_->init(this);
   auto initialState = hwInitRet.switchState;
   // for now, warmboot is not keeping failed routes, so keep the same state as
@@ -638,9 +687,12 @@ void SwSwitch::notifyStateObservers(const StateDelta& delta) {
 }
 
 void SwSwitch::updateState(unique_ptr<StateUpdate> update) {
+  update->queuedTime_ = std::chrono::steady_clock::now();
+  auto priority = static_cast<size_t>(update->getPriority());
   {
     folly::SpinLockGuard guard(pendingUpdatesLock_);
-    pendingUpdates_.push_back(*update.release());
+    pendingUpdates_[priority].push_back(*update.release());
+    ++numPendingUpdates_[priority];
   }
 
   // Signal the update thread that updates are pending.
@@ -652,14 +704,17 @@ void SwSwitch::updateState(unique_ptr<StateUpdate> update) {
 void SwSwitch::queueStateUpdateForGettingHwInSync(
     StringPiece name,
     StateUpdateFn fn) {
-  auto update = make_unique<FunctionStateUpdate>(name, std::move(fn));
+  auto update = make_unique<FunctionStateUpdate>(
+      name, std::move(fn), true, StateUpdate::Priority::HIGH);
+  update->queuedTime_ = std::chrono::steady_clock::now();
   {
-    // Push the state update in front to preserver ordering.
-    // This is not particularly necessary, since this state
-    // update is freely coalesced with other state updates when
-    // we come to processing pending updates
+    // Push the state update in front of the highest priority queue so that
+    // it's applied first, since it moves the applied state to the desired
+    // state that all other updates start from.
     folly::SpinLockGuard guard(pendingUpdatesLock_);
-    pendingUpdates_.push_front(*update.release());
+    pendingUpdates_[static_cast<size_t>(StateUpdate::Priority::HIGH)]
+        .push_front(*update.release());
+    ++numPendingUpdates_[static_cast<size_t>(StateUpdate::Priority::HIGH)];
   }
   // Don't inform updateEventBase about this update being queued.
   // Rather let this update be processed with the next incoming update.
@@ -674,19 +729,31 @@ void SwSwitch::queueStateUpdateForGettingHwInSync(
   // optimizations).
 }
 
-void SwSwitch::updateState(StringPiece name, StateUpdateFn fn) {
-  auto update = make_unique<FunctionStateUpdate>(name, std::move(fn));
+void SwSwitch::updateState(
+    StringPiece name,
+    StateUpdateFn fn,
+    StateUpdate::Priority priority) {
+  auto update =
+      make_unique<FunctionStateUpdate>(name, std::move(fn), true, priority);
   updateState(std::move(update));
 }
 
-void SwSwitch::updateStateNoCoalescing(StringPiece name, StateUpdateFn fn) {
-  auto update = make_unique<FunctionStateUpdate>(name, std::move(fn), false);
+void SwSwitch::updateStateNoCoalescing(
+    StringPiece name,
+    StateUpdateFn fn,
+    StateUpdate::Priority priority) {
+  auto update =
+      make_unique<FunctionStateUpdate>(name, std::move(fn), false, priority);
   updateState(std::move(update));
 }
 
-void SwSwitch::updateStateBlocking(folly::StringPiece name, StateUpdateFn fn) {
+void SwSwitch::updateStateBlocking(
+    folly::StringPiece name,
+    StateUpdateFn fn,
+    StateUpdate::Priority priority) {
   auto result = std::make_shared<BlockingUpdateResult>();
-  auto update = make_unique<BlockingStateUpdate>(name, std::move(fn), result);
+  auto update = make_unique<BlockingStateUpdate>(
+      name, std::move(fn), result, true, priority);
   updateState(std::move(update));
   result->wait();
 }
@@ -695,35 +762,96 @@ void SwSwitch::handlePendingUpdatesHelper(SwSwitch* sw) {
   sw->handlePendingUpdates();
 }
 
-void SwSwitch::handlePendingUpdates() {
-  // Get the list of updates to run.
-  //
-  // We might pull multiple updates off the list at once if several updates
-  // were scheduled before we had a chance to process them.  In some cases we
-  // might also end up finding 0 updates to process if a previous
-  // handlePendingUpdates() call processed multiple updates.
+SwSwitch::StateUpdateList SwSwitch::getPendingUpdatesBatch() {
   StateUpdateList updates;
+  std::array<size_t, StateUpdate::kNumPriorities> queueDepths;
+  bool morePending = false;
   {
     folly::SpinLockGuard guard(pendingUpdatesLock_);
-    // When deciding how many elements to pull off the pendingUpdates_
-    // list, we pull as many as we can, while making sure we don't
-    // include any updates after an update that does not allow
+    queueDepths = numPendingUpdates_;
+    // Pull updates in priority order, so that all pending updates of a
+    // priority are applied before any update of a lower priority. We pull as
+    // many as we can, up to FLAGS_max_coalesced_state_updates, while making
+    // sure we don't include any updates after an update that does not allow
     // coalescing.
-    auto iter = pendingUpdates_.begin();
-    while (iter != pendingUpdates_.end()) {
-      StateUpdate* update = &(*iter);
-      ++iter;
-      if (!update->allowsCoalescing()) {
-        break;
+    size_t numUpdates = 0;
+    bool stop = false;
+    for (size_t priority = 0; priority < pendingUpdates_.size() && !stop;
+         ++priority) {
+      auto& pending = pendingUpdates_[priority];
+      auto iter = pending.begin();
+      size_t numTaken = 0;
+      while (iter != pending.end()) {
+        if (numUpdates >=
+            static_cast<size_t>(FLAGS_max_coalesced_state_updates)) {
+          stop = true;
+          break;
+        }
+        StateUpdate* update = &(*iter);
+        ++iter;
+        ++numTaken;
+        ++numUpdates;
+        if (!update->allowsCoalescing()) {
+          stop = true;
+          break;
+        }
       }
+      updates.splice(updates.end(), pending, pending.begin(), iter);
+      numPendingUpdates_[priority] -= numTaken;
     }
-    updates.splice(
-        updates.begin(), pendingUpdates_, pendingUpdates_.begin(), iter);
+    morePending = std::any_of(
+        numPendingUpdates_.begin(),
+        numPendingUpdates_.end(),
+        [](size_t numPending) { return numPending > 0; });
+  }
+  // Updates left behind may not have a handlePendingUpdates() call of their
+  // own, e.g. the one queued to get the hardware back in sync, so schedule
+  // another one.
+  if (morePending) {
+    updateEventBase_.runInEventBaseThread(handlePendingUpdatesHelper, this);
   }
 
-  // handlePendingUpdates() is invoked once for each update, but a previous
-  // call might have already processed everything.  If we don't have anything
-  // to do just return early.
+  auto now = std::chrono::steady_clock::now();
+  for (size_t priority = 0; priority < queueDepths.size(); ++priority) {
+    stats()->stateUpdateQueueDepth(
+        static_cast<StateUpdate::Priority>(priority), queueDepths[priority]);
+  }
+  for (const auto& update : updates) {
+    stats()->stateUpdateQueueLatency(
+        update.getPriority(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            now - update.queuedTime_));
+  }
+  return updates;
+}
+
+void SwSwitch::requeuePendingUpdates(StateUpdateList* updates) {
+  {
+    folly::SpinLockGuard guard(pendingUpdatesLock_);
+    // Put the updates back in front of their queues, preserving their order.
+    while (!updates->empty()) {
+      auto& update = updates->back();
+      updates->pop_back();
+      auto priority = static_cast<size_t>(update.getPriority());
+      pendingUpdates_[priority].push_front(update);
+      ++numPendingUpdates_[priority];
+    }
+  }
+  updateEventBase_.runInEventBaseThread(handlePendingUpdatesHelper, this);
+}
+
+void SwSwitch::handlePendingUpdates() {
+  // Get the list of updates to run.
+  //
+  // We might pull multiple updates off the list at once if several updates
+  // were scheduled before we had a chance to process them.  In some cases we
+  // might also end up finding 0 updates to process if a previous
+  // handlePendingUpdates() call processed multiple updates.
+  auto updates = getPendingUpdatesBatch();
+
+  // handlePendingUpdates() is invoked at least once for each update, but a
+  // previous call might have already processed everything.  If we don't have
+  // anything to do just return early.
   if (updates.empty()) {
     return;
   }
@@ -742,8 +870,21 @@ void SwSwitch::handlePendingUpdates() {
   // queue whenever applied and desired states diverge. After that, other
   // supplied state updates are applied (that were spliced above).
   auto newDesiredState = oldAppliedState;
+  auto batchStart = std::chrono::steady_clock::now();
   auto iter = updates.begin();
   while (iter != updates.end()) {
+    if (iter != updates.begin() &&
+        std::chrono::steady_clock::now() - batchStart >
+            std::chrono::milliseconds(FLAGS_max_coalesced_state_update_ms)) {
+      // Stop coalescing and leave the remaining updates for a later batch,
+      // which requeuePendingUpdates() schedules.
+      StateUpdateList deferred;
+      deferred.splice(deferred.begin(), updates, iter, updates.end());
+      XLOG(INFO) << "deferring state updates after preparing for "
+                 << FLAGS_max_coalesced_state_update_ms << "ms";
+      requeuePendingUpdates(&deferred);
+      break;
+    }
     StateUpdate* update = &(*iter);
     ++iter;
 
@@ -961,6 +1102,14 @@ void SwSwitch::setPortStatusCounter(PortID port, bool up) {
 }
 
 void SwSwitch::packetReceived(std::unique_ptr<RxPacket> pkt) noexcept {
+  if (rxPacketDispatcher_) {
+    rxPacketDispatcher_->dispatch(std::move(pkt));
+    return;
+  }
+  handlePacketNoThrow(std::move(pkt));
+}
+
+void SwSwitch::handlePacketNoThrow(std::unique_ptr<RxPacket> pkt) noexcept {
   PortID port = pkt->getSrcPort();
   try {
     handlePacket(std::move(pkt));
@@ -972,6 +1121,24 @@ void SwSwitch::packetReceived(std::unique_ptr<RxPacket> pkt) noexcept {
   }
 }
 
+void SwSwitch::rxDispatchDrop(int queue, const RxPacket& pkt) {
+  portStats(pkt.getSrcPort())->trappedPkt();
+  switch (static_cast<RxPacketDispatcher::Queue>(queue)) {
+    case RxPacketDispatcher::Queue::NETWORK_CONTROL:
+      stats()->rxDispatchNetworkControlDrop();
+      break;
+    case RxPacketDispatcher::Queue::NEIGHBOR:
+      stats()->rxDispatchNeighborDrop();
+      break;
+    case RxPacketDispatcher::Queue::DHCP:
+      stats()->rxDispatchDhcpDrop();
+      break;
+    case RxPacketDispatcher::Queue::DEFAULT:
+      stats()->rxDispatchDefaultDrop();
+      break;
+  }
+}
+
 void SwSwitch::packetReceivedThrowExceptionOnError(
     std::unique_ptr<RxPacket> pkt) {
   handlePacket(std::move(pkt));
@@ -1088,7 +1255,9 @@ void SwSwitch::linkStateChanged(PortID portId, bool up) {
     return newState;
   };
   updateStateNoCoalescing(
-      "Port OperState Update", std::move(updateOperStateFn));
+      "Port OperState Update",
+      std::move(updateOperStateFn),
+      StateUpdate::Priority::HIGH);
 }
 
 void SwSwitch::startThreads() {
@@ -1485,7 +1654,8 @@ void SwSwitch::applyConfig(const std::string& reason, bool reload) {
           return nullptr;
         }
         return newState;
-      });
+      },
+      StateUpdate::Priority::BULK);
 }
 
 bool SwSwitch::isValidStateUpdate(const StateDelta& delta) const {
@@ -25,6 +25,7 @@
 #include <folly/io/async/EventBase.h>
 #include <optional>
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -45,6 +46,7 @@ class PortDescriptor;
 class PortStats;
 class PortUpdateHandler;
 class RxPacket;
+class RxPacketDispatcher;
 class SwitchState;
 class SwitchStats;
 class StateDelta;
@@ -230,8 +232,14 @@ class SwSwitch : public HwSwitch::Callback {
    * send a single update notification to the HwSwitch and other update
    * subscribers.  Therefore the StateUpdateFn may be called with an
    * unpublished SwitchState in some cases.
+   *
+   * Updates with a higher priority are applied before pending updates with a
+   * lower one, see StateUpdate::Priority.
    */
-  void updateState(folly::StringPiece name, StateUpdateFn fn);
+  void updateState(
+      folly::StringPiece name,
+      StateUpdateFn fn,
+      StateUpdate::Priority priority = StateUpdate::Priority::NORMAL);
 
   /**
    * Schedule an update to the switch state.
@@ -245,7 +253,10 @@ class SwSwitch : public HwSwitch::Callback {
    * but can be used when there is an update that MUST be seen by the hw
    * implementation, even if the inverse update is immediately applied.
    */
-  void updateStateNoCoalescing(folly::StringPiece name, StateUpdateFn fn);
+  void updateStateNoCoalescing(
+      folly::StringPiece name,
+      StateUpdateFn fn,
+      StateUpdate::Priority priority = StateUpdate::Priority::NORMAL);
 
   /*
    * A version of updateState() that doesn't return until the update has been
@@ -261,7 +272,10 @@ class SwSwitch : public HwSwitch::Callback {
    * thread, and would simply block the calling thread until the operation
    * completes.
    */
-  void updateStateBlocking(folly::StringPiece name, StateUpdateFn fn);
+  void updateStateBlocking(
+      folly::StringPiece name,
+      StateUpdateFn fn,
+      StateUpdate::Priority priority = StateUpdate::Priority::NORMAL);
 
   /**
    * Apply config from the config file (specified in 'config' flag).
@@ -718,9 +732,13 @@ class SwSwitch : public HwSwitch::Callback {
   void setSwitchRunState(SwitchRunState desiredState);
   SwitchStats* createSwitchStats();
   void handlePacket(std::unique_ptr<RxPacket> pkt);
+  void handlePacketNoThrow(std::unique_ptr<RxPacket> pkt) noexcept;
+  void rxDispatchDrop(int queue, const RxPacket& pkt);
 
   static void handlePendingUpdatesHelper(SwSwitch* sw);
   void handlePendingUpdates();
+  StateUpdateList getPendingUpdatesBatch();
+  void requeuePendingUpdates(StateUpdateList* updates);
   std::shared_ptr<SwitchState> applyUpdate(
       const std::shared_ptr<SwitchState>& oldState,
       const std::shared_ptr<SwitchState>& newState);
@@ -778,10 +796,12 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<TunManager> tunMgr_;
 
   /*
-   * A list of pending state updates to be applied.
+   * Pending state updates to be applied, one list per
+   * StateUpdate::Priority, highest priority first.
    */
   folly::SpinLock pendingUpdatesLock_;
-  StateUpdateList pendingUpdates_;
+  std::array<StateUpdateList, StateUpdate::kNumPriorities> pendingUpdates_;
+  std::array<size_t, StateUpdate::kNumPriorities> numPendingUpdates_{};
 
   /*
    * The current switch state: modelled as two states:
@@ -873,6 +893,8 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<IPv6Handler> ipv6_;
   std::unique_ptr<NeighborUpdater> nUpdater_;
   std::unique_ptr<PktCaptureManager> pcapMgr_;
+  // Hands off trapped packets to worker threads, if enabled
+  std::unique_ptr<RxPacketDispatcher> rxPacketDispatcher_;
   std::unique_ptr<MirrorManager> mirrorManager_;
   std::unique_ptr<RouteUpdateLogger> routeUpdateLogger_;
   std::unique_ptr<LinkAggregationManager> lagManager_;
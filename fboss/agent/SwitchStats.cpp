@@ -30,6 +30,26 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
       trapPktBogus_(map, kCounterPrefix + "trapped.bogus", SUM, RATE),
       trapPktErrors_(map, kCounterPrefix + "trapped.error", SUM, RATE),
       trapPktUnhandled_(map, kCounterPrefix + "trapped.unhandled", SUM, RATE),
+      rxDispatchNetworkControlDrops_(
+          map,
+          kCounterPrefix + "trapped.dispatch_drops.network_control",
+          SUM,
+          RATE),
+      rxDispatchNeighborDrops_(
+          map,
+          kCounterPrefix + "trapped.dispatch_drops.neighbor",
+          SUM,
+          RATE),
+      rxDispatchDhcpDrops_(
+          map,
+          kCounterPrefix + "trapped.dispatch_drops.dhcp",
+          SUM,
+          RATE),
+      rxDispatchDefaultDrops_(
+          map,
+          kCounterPrefix + "trapped.dispatch_drops.default",
+          SUM,
+          RATE),
       trapPktToHost_(map, kCounterPrefix + "host.rx", SUM, RATE),
       trapPktToHostBytes_(map, kCounterPrefix + "host.rx.bytes", SUM, RATE),
       pktFromHost_(map, kCounterPrefix + "host.tx", SUM, RATE),
@@ -79,6 +99,60 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           SUM,
           RATE),
       updateState_(map, kCounterPrefix + "state_update.us", 50000, 0, 1000000),
+      stateUpdateQueueDepthHigh_(
+          map,
+          kCounterPrefix + "state_update.queue_depth.high",
+          10,
+          0,
+          1000,
+          AVG,
+          50,
+          100),
+      stateUpdateQueueDepthNormal_(
+          map,
+          kCounterPrefix + "state_update.queue_depth.normal",
+          10,
+          0,
+          1000,
+          AVG,
+          50,
+          100),
+      stateUpdateQueueDepthBulk_(
+          map,
+          kCounterPrefix + "state_update.queue_depth.bulk",
+          10,
+          0,
+          1000,
+          AVG,
+          50,
+          100),
+      stateUpdateQueueLatencyHigh_(
+          map,
+          kCounterPrefix + "state_update.queue_latency.high.us",
+          50000,
+          0,
+          1000000,
+          AVG,
+          50,
+          100),
+      stateUpdateQueueLatencyNormal_(
+          map,
+          kCounterPrefix + "state_update.queue_latency.normal.us",
+          50000,
+          0,
+          1000000,
+          AVG,
+          50,
+          100),
+      stateUpdateQueueLatencyBulk_(
+          map,
+          kCounterPrefix + "state_update.queue_latency.bulk.us",
+          50000,
+          0,
+          1000000,
+          AVG,
+          50,
+          100),
       routeUpdate_(map, kCounterPrefix + "route_update.us", 50, 0, 500),
       bgHeartbeatDelay_(
           map,
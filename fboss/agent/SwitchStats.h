@@ -15,6 +15,7 @@
 #include <chrono>
 #include "fboss/agent/AggregatePortStats.h"
 #include "fboss/agent/PortStats.h"
+#include "fboss/agent/state/StateUpdate.h"
 #include "fboss/agent/types.h"
 
 namespace facebook::fboss {
@@ -85,6 +86,22 @@ class SwitchStats : public boost::noncopyable {
     trapPktToHost_.addValue(1);
     trapPktToHostBytes_.addValue(bytes);
   }
+  void rxDispatchNetworkControlDrop() {
+    rxDispatchNetworkControlDrops_.addValue(1);
+    trapPktDrops_.addValue(1);
+  }
+  void rxDispatchNeighborDrop() {
+    rxDispatchNeighborDrops_.addValue(1);
+    trapPktDrops_.addValue(1);
+  }
+  void rxDispatchDhcpDrop() {
+    rxDispatchDhcpDrops_.addValue(1);
+    trapPktDrops_.addValue(1);
+  }
+  void rxDispatchDefaultDrop() {
+    rxDispatchDefaultDrops_.addValue(1);
+    trapPktDrops_.addValue(1);
+  }
   void pktFromHost(uint32_t bytes) {
     pktFromHost_.addValue(1);
     pktFromHostBytes_.addValue(bytes);
@@ -226,6 +243,36 @@ class SwitchStats : public boost::noncopyable {
     updateState_.addValue(us.count());
   }
 
+  void stateUpdateQueueDepth(StateUpdate::Priority priority, size_t depth) {
+    switch (priority) {
+      case StateUpdate::Priority::HIGH:
+        stateUpdateQueueDepthHigh_.addValue(depth);
+        break;
+      case StateUpdate::Priority::NORMAL:
+        stateUpdateQueueDepthNormal_.addValue(depth);
+        break;
+      case StateUpdate::Priority::BULK:
+        stateUpdateQueueDepthBulk_.addValue(depth);
+        break;
+    }
+  }
+
+  void stateUpdateQueueLatency(
+      StateUpdate::Priority priority,
+      std::chrono::microseconds us) {
+    switch (priority) {
+      case StateUpdate::Priority::HIGH:
+        stateUpdateQueueLatencyHigh_.addValue(us.count());
+        break;
+      case StateUpdate::Priority::NORMAL:
+        stateUpdateQueueLatencyNormal_.addValue(us.count());
+        break;
+      case StateUpdate::Priority::BULK:
+        stateUpdateQueueLatencyBulk_.addValue(us.count());
+        break;
+    }
+  }
+
   void routeUpdate(std::chrono::microseconds us, uint64_t routes) {
     // As syncFib() could include no routes.
     if (routes == 0) {
@@ -324,6 +371,11 @@ class SwitchStats : public boost::noncopyable {
   TLTimeseries trapPktErrors_;
   // Trapped packets that the controller didn't know how to handle.
   TLTimeseries trapPktUnhandled_;
+  // Trapped packets dropped because their RX dispatch queue was full
+  TLTimeseries rxDispatchNetworkControlDrops_;
+  TLTimeseries rxDispatchNeighborDrops_;
+  TLTimeseries rxDispatchDhcpDrops_;
+  TLTimeseries rxDispatchDefaultDrops_;
   // Trapped packets forwarded to host
   TLTimeseries trapPktToHost_;
   // Trapped packets forwarded to host in bytes
@@ -411,6 +463,22 @@ class SwitchStats : public boost::noncopyable {
    */
   TLHistogram updateState_;
 
+  /**
+   * Number of state updates pending in each priority class, sampled whenever
+   * the update thread pulls a batch of updates
+   */
+  TLHistogram stateUpdateQueueDepthHigh_;
+  TLHistogram stateUpdateQueueDepthNormal_;
+  TLHistogram stateUpdateQueueDepthBulk_;
+
+  /**
+   * Time state updates of each priority class spent queued before being
+   * picked up by the update thread (in microsecond)
+   */
+  TLHistogram stateUpdateQueueLatencyHigh_;
+  TLHistogram stateUpdateQueueLatencyNormal_;
+  TLHistogram stateUpdateQueueLatencyBulk_;
+
   /**
    * Histogram for time used for route update (in microsecond)
    */
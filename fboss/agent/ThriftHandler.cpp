@@ -28,6 +28,7 @@
 #include "fboss/agent/if/gen-cpp2/NeighborListenerClient.h"
 #include "fboss/agent/rib/ForwardingInformationBaseUpdater.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/RouteBatch.h"
 #include "fboss/agent/state/AclMap.h"
 #include "fboss/agent/state/AggregatePort.h"
 #include "fboss/agent/state/AggregatePortMap.h"
@@ -42,6 +43,7 @@
 #include "fboss/agent/state/PortQueue.h"
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/RouteTable.h"
+#include "fboss/agent/state/RouteTableMap.h"
 #include "fboss/agent/state/RouteTableRib.h"
 #include "fboss/agent/state/RouteUpdater.h"
 #include "fboss/agent/state/StateUtils.h"
@@ -64,7 +66,11 @@
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <thrift/lib/cpp2/async/DuplexChannel.h>
 
+#include <algorithm>
 #include <limits>
+#include <optional>
+#include <tuple>
+#include <type_traits>
 
 using apache::thrift::ClientReceiveState;
 using apache::thrift::server::TConnectionContext;
@@ -139,12 +145,14 @@ void dynamicFibUpdate(
     facebook::fboss::RouterID vrf,
     const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const facebook::fboss::rib::UpdatedPrefixes* updatedPrefixes,
     void* cookie) {
   facebook::fboss::rib::ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, updatedPrefixes);
 
   auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
-  sw->updateStateBlocking("", std::move(fibUpdater));
+  sw->updateStateBlocking(
+      "", std::move(fibUpdater), StateUpdate::Priority::BULK);
 }
 
 void fillPortStats(PortInfoThrift& portInfo, int numPortQs) {
@@ -468,6 +476,214 @@ LinkNeighborThrift thriftLinkNeighbor(
   }
   return tn;
 }
+
+template <typename AddrT>
+UnicastRoute forwardUnicastRoute(const Route<AddrT>& route) {
+  UnicastRoute unicastRoute;
+  const auto& fwdInfo = route.getForwardInfo();
+  unicastRoute.dest.ip = toBinaryAddress(route.prefix().network);
+  unicastRoute.dest.prefixLength = route.prefix().mask;
+  *unicastRoute.nextHopAddrs_ref() =
+      util::fromFwdNextHops(fwdInfo.getNextHopSet());
+  *unicastRoute.nextHops_ref() =
+      util::fromRouteNextHopSet(fwdInfo.getNextHopSet());
+  return unicastRoute;
+}
+
+template <typename AddrT>
+UnicastRoute clientUnicastRoute(
+    const Route<AddrT>& route,
+    const RouteNextHopEntry& entry) {
+  UnicastRoute unicastRoute;
+  unicastRoute.dest.ip = toBinaryAddress(route.prefix().network);
+  unicastRoute.dest.prefixLength = route.prefix().mask;
+  *unicastRoute.nextHops_ref() =
+      util::fromRouteNextHopSet(entry.getNextHopSet());
+  for (const auto& nh : *unicastRoute.nextHops_ref()) {
+    unicastRoute.nextHopAddrs_ref()->emplace_back(nh.address);
+  }
+  return unicastRoute;
+}
+
+constexpr int32_t kDefaultRouteTablePageSize = 1000;
+constexpr int32_t kMaxRouteTablePageSize = 10000;
+
+/*
+ * Walks the route tables for one page of a paginated route table request:
+ * routes after the request's cursor are visited in cursor order, until
+ * `maxRoutes` of them have been accepted.
+ *
+ * The prefix in the request's filter is applied here, as it only depends on
+ * the route's prefix. The rest of the filter is left to the callers, which
+ * know which next hops they return.
+ */
+class RouteTablePager {
+ public:
+  explicit RouteTablePager(const RouteTablePageRequest& request)
+      : maxRoutes_(
+            *request.maxRoutes_ref() <= 0
+                ? kDefaultRouteTablePageSize
+                : std::min(*request.maxRoutes_ref(), kMaxRouteTablePageSize)) {
+    if (request.cursor_ref().has_value()) {
+      const auto& cursor = request.cursor_ref().value();
+      cursorRouterId_ = RouterID(*cursor.routerId_ref());
+      cursorPrefix_ = toCidrNetwork(*cursor.lastPrefix_ref());
+    }
+    const auto& filter = *request.filter_ref();
+    if (filter.prefix_ref().has_value()) {
+      filterPrefix_ = toCidrNetwork(filter.prefix_ref().value());
+    }
+  }
+
+  /*
+   * Call `visit` on each route of the page, which returns whether it
+   * accepted the route. Returns the cursor to continue from, or none once all
+   * routes have been visited.
+   */
+  template <typename Visit>
+  std::optional<RouteTableCursor> walk(
+      const RouteTableMap& routeTables,
+      Visit visit) {
+    auto itr = cursorRouterId_ ? routeTables.lowerBound(*cursorRouterId_)
+                               : routeTables.begin();
+    for (; itr != routeTables.end(); ++itr) {
+      const auto& routeTable = *itr;
+      auto resume = cursorRouterId_ == routeTable->getID();
+      if (!(resume && cursorPrefix_->first.isV6()) &&
+          walkRib(
+              routeTable->getID(),
+              *routeTable->getRibV4()->routes(),
+              resume,
+              visit)) {
+        return nextCursor_;
+      }
+      if (walkRib(
+              routeTable->getID(),
+              *routeTable->getRibV6()->routes(),
+              resume && cursorPrefix_->first.isV6(),
+              visit)) {
+        return nextCursor_;
+      }
+    }
+    return std::nullopt;
+  }
+
+ private:
+  static folly::CIDRNetwork toCidrNetwork(const IpPrefix& prefix) {
+    auto ip = toIPAddress(prefix.ip);
+    if (prefix.prefixLength < 0 ||
+        static_cast<size_t>(prefix.prefixLength) > ip.bitCount()) {
+      throw FbossError(
+          "Invalid prefix length: ", ip.str(), "/", prefix.prefixLength);
+    }
+    return std::make_pair(
+        ip.mask(prefix.prefixLength),
+        static_cast<uint8_t>(prefix.prefixLength));
+  }
+
+  template <typename AddrT>
+  static AddrT toAddr(const IPAddress& ip) {
+    if constexpr (std::is_same_v<AddrT, IPAddressV4>) {
+      return ip.asV4();
+    } else {
+      return ip.asV6();
+    }
+  }
+
+  // Returns true once the page is full
+  template <typename AddrT, typename Visit>
+  bool walkRib(
+      RouterID routerId,
+      const RouteTableRibNodeMap<AddrT>& routes,
+      bool resume,
+      Visit& visit) {
+    std::optional<AddrT> filterNetwork;
+    if (filterPrefix_) {
+      if (filterPrefix_->first.bitCount() != AddrT::bitCount()) {
+        return false;
+      }
+      filterNetwork = toAddr<AddrT>(filterPrefix_->first);
+    }
+    auto itr = routes.begin();
+    if (resume) {
+      RoutePrefix<AddrT> after{
+          toAddr<AddrT>(cursorPrefix_->first), cursorPrefix_->second};
+      itr = routes.lowerBound(after);
+      if (itr != routes.end() && (*itr)->prefix() == after) {
+        ++itr;
+      }
+    }
+    for (; itr != routes.end(); ++itr) {
+      const auto& route = *itr;
+      if (filterNetwork &&
+          (route->prefix().mask < filterPrefix_->second ||
+           route->prefix().network.mask(filterPrefix_->second) !=
+               *filterNetwork)) {
+        continue;
+      }
+      if (!visit(*route)) {
+        continue;
+      }
+      if (++numRoutes_ == maxRoutes_) {
+        RouteTableCursor cursor;
+        *cursor.routerId_ref() = static_cast<int32_t>(routerId);
+        cursor.lastPrefix_ref()->ip = toBinaryAddress(route->prefix().network);
+        cursor.lastPrefix_ref()->prefixLength = route->prefix().mask;
+        nextCursor_ = std::move(cursor);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  const int32_t maxRoutes_;
+  std::optional<RouterID> cursorRouterId_;
+  std::optional<folly::CIDRNetwork> cursorPrefix_;
+  std::optional<folly::CIDRNetwork> filterPrefix_;
+  int32_t numRoutes_{0};
+  std::optional<RouteTableCursor> nextCursor_;
+};
+
+bool hasNextHop(
+    const RouteNextHopSet& nextHops,
+    const std::optional<IPAddress>& address) {
+  if (!address) {
+    return true;
+  }
+  return std::any_of(
+      nextHops.begin(), nextHops.end(), [&](const auto& nextHop) {
+        return nextHop.addr() == *address;
+      });
+}
+
+std::optional<ClientID> filterClient(const RouteTablePageRequest& request) {
+  const auto& filter = *request.filter_ref();
+  if (filter.clientId_ref().has_value()) {
+    return ClientID(filter.clientId_ref().value());
+  }
+  return std::nullopt;
+}
+
+std::optional<IPAddress> filterNextHop(const RouteTablePageRequest& request) {
+  const auto& filter = *request.filter_ref();
+  if (filter.nextHop_ref().has_value()) {
+    return toIPAddress(filter.nextHop_ref().value());
+  }
+  return std::nullopt;
+}
+
+void recordRoutesAdded(
+    SwSwitch* sw,
+    const rib::RoutingInformationBase::UpdateStatistics& stats,
+    const std::string& updType) {
+  sw->stats()->addRoutesV4(stats.v4RoutesAdded);
+  sw->stats()->addRoutesV6(stats.v6RoutesAdded);
+
+  auto totalRouteCount = stats.v4RoutesAdded + stats.v6RoutesAdded;
+  sw->stats()->routeUpdate(stats.duration, totalRouteCount);
+  XLOG(DBG0) << updType << " " << totalRouteCount << " routes took "
+             << stats.duration.count() << "us";
+}
 } // namespace
 
 namespace facebook::fboss {
@@ -666,7 +882,8 @@ void ThriftHandler::deleteUnicastRoutesInVrf(
     newState->resetRouteTables(std::move(newRt));
     return newState;
   };
-  sw_->updateStateBlocking("delete unicast route", updateFn);
+  sw_->updateStateBlocking(
+      "delete unicast route", updateFn, StateUpdate::Priority::BULK);
 }
 
 void ThriftHandler::deleteUnicastRoutes(
@@ -698,6 +915,29 @@ void ThriftHandler::syncFib(
   syncFibInVrf(client, std::move(routes), 0);
 }
 
+void ThriftHandler::addUnicastRouteBatchInVrf(
+    int16_t client,
+    std::unique_ptr<UnicastRouteBatch> batch,
+    int32_t vrf) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  ensureFibSynced(__func__);
+  updateUnicastRouteBatchImpl(
+      vrf, client, *batch, "addUnicastRouteBatchInVrf", false);
+}
+
+void ThriftHandler::syncFibBatchInVrf(
+    int16_t client,
+    std::unique_ptr<UnicastRouteBatch> batch,
+    int32_t vrf) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  updateUnicastRouteBatchImpl(vrf, client, *batch, "syncFibBatchInVrf", true);
+  if (!sw_->isFibSynced()) {
+    sw_->fibSynced();
+  }
+}
+
 void ThriftHandler::updateUnicastRoutesImpl(
     int32_t vrf,
     int16_t client,
@@ -719,15 +959,7 @@ void ThriftHandler::updateUnicastRoutesImpl(
         updType,
         &dynamicFibUpdate,
         static_cast<void*>(sw_));
-
-    sw_->stats()->addRoutesV4(stats.v4RoutesAdded);
-    sw_->stats()->addRoutesV6(stats.v6RoutesAdded);
-
-    auto totalRouteCount = stats.v4RoutesAdded + stats.v6RoutesAdded;
-    sw_->stats()->routeUpdate(stats.duration, totalRouteCount);
-    XLOG(DBG0) << updType << " " << totalRouteCount << " routes took "
-               << stats.duration.count() << "us";
-
+    recordRoutesAdded(sw_, stats, updType);
     return;
   }
 
@@ -737,46 +969,46 @@ void ThriftHandler::updateUnicastRoutesImpl(
 
   RouteUpdateStats stats(sw_, updType, routes->size());
 
-  // Note that we capture routes by reference here, since it is a unique_ptr.
-  // This is safe since we use updateStateBlocking(), so routes will still
-  // be valid in our scope when updateFn() is called.
-  // We could use folly::MoveWrapper if we did need to capture routes by value.
+  // Convert the routes up front, so that the update thread, which every
+  // other state update waits on, only has to insert them.
+  auto clientIdToAdmin = sw_->clientIdToAdminDistance(client);
+  std::vector<std::tuple<folly::IPAddress, uint8_t, RouteNextHopEntry>> toAdd;
+  toAdd.reserve(routes->size());
+  for (const auto& route : *routes) {
+    folly::IPAddress network = toIPAddress(route.dest.ip);
+    uint8_t mask = static_cast<uint8_t>(route.dest.prefixLength);
+    auto adminDistance = route.adminDistance_ref().value_or(clientIdToAdmin);
+    RouteNextHopSet nexthops = route.nextHops_ref()->empty()
+        ? util::toRouteNextHopSet(
+              util::thriftNextHopsFromAddresses(*route.nextHopAddrs_ref()))
+        : util::toRouteNextHopSet(*route.nextHops_ref());
+    if (nexthops.size()) {
+      toAdd.emplace_back(
+          network,
+          mask,
+          RouteNextHopEntry(std::move(nexthops), adminDistance));
+    } else {
+      XLOG(DBG3) << "Blackhole route:" << network << "/"
+                 << static_cast<int>(mask);
+      toAdd.emplace_back(
+          network,
+          mask,
+          RouteNextHopEntry(RouteForwardAction::DROP, adminDistance));
+    }
+  }
+
+  // Note that we capture toAdd by reference here. This is safe since we use
+  // updateStateBlocking(), so it will still be valid in our scope when
+  // updateFn() is called.
   auto updateFn = [&](const shared_ptr<SwitchState>& state) {
     // create an update object starting from empty
     RouteUpdater updater(state->getRouteTables());
     RouterID routerId = RouterID(0); // TODO, default vrf for now
-    auto clientIdToAdmin = sw_->clientIdToAdminDistance(client);
     if (sync) {
       updater.removeAllRoutesForClient(routerId, ClientID(client));
     }
-    for (const auto& route : *routes) {
-      folly::IPAddress network = toIPAddress(route.dest.ip);
-      uint8_t mask = static_cast<uint8_t>(route.dest.prefixLength);
-      auto adminDistance = route.adminDistance_ref().value_or(clientIdToAdmin);
-      std::vector<NextHopThrift> nhts;
-      if (route.nextHops_ref()->empty() && !route.nextHopAddrs_ref()->empty()) {
-        nhts = util::thriftNextHopsFromAddresses(*route.nextHopAddrs_ref());
-      } else {
-        nhts = *route.nextHops_ref();
-      }
-      RouteNextHopSet nexthops = util::toRouteNextHopSet(nhts);
-      if (nexthops.size()) {
-        updater.addRoute(
-            routerId,
-            network,
-            mask,
-            ClientID(client),
-            RouteNextHopEntry(std::move(nexthops), adminDistance));
-      } else {
-        XLOG(DBG3) << "Blackhole route:" << network << "/"
-                   << static_cast<int>(mask);
-        updater.addRoute(
-            routerId,
-            network,
-            mask,
-            ClientID(client),
-            RouteNextHopEntry(RouteForwardAction::DROP, adminDistance));
-      }
+    for (const auto& [network, mask, entry] : toAdd) {
+      updater.addRoute(routerId, network, mask, ClientID(client), entry);
       if (network.isV4()) {
         sw_->stats()->addRouteV4();
       } else {
@@ -791,7 +1023,38 @@ void ThriftHandler::updateUnicastRoutesImpl(
     newState->resetRouteTables(std::move(newRt));
     return newState;
   };
-  sw_->updateStateBlocking(updType, updateFn);
+  sw_->updateStateBlocking(updType, updateFn, StateUpdate::Priority::BULK);
+}
+
+void ThriftHandler::updateUnicastRouteBatchImpl(
+    int32_t vrf,
+    int16_t client,
+    const UnicastRouteBatch& batch,
+    const std::string& updType,
+    bool sync) {
+  if (!sw_->isStandaloneRibEnabled()) {
+    throw FbossError(updType, " is only supported with Stand-Alone RIB");
+  }
+
+  auto start = steady_clock::now();
+  auto toAdd = rib::RouteBatch::fromThrift(
+      batch,
+      sw_->clientIdToAdminDistance(client),
+      sw_->getRib()->routeConversionExecutor());
+  auto conversionDuration = duration_cast<std::chrono::microseconds>(
+      steady_clock::now() - start);
+
+  auto stats = sw_->getRib()->update(
+      RouterID(vrf),
+      ClientID(client),
+      toAdd,
+      {} /* prefixes to delete */,
+      sync,
+      updType,
+      &dynamicFibUpdate,
+      static_cast<void*>(sw_));
+  stats.duration += conversionDuration;
+  recordRoutesAdded(sw_, stats, updType);
 }
 
 static void populateInterfaceDetail(
@@ -1168,34 +1431,18 @@ void ThriftHandler::getRouteTable(std::vector<UnicastRoute>& routes) {
   auto appliedState = sw_->getAppliedState();
   for (const auto& routeTable : (*appliedState->getRouteTables())) {
     for (const auto& ipv4 : *(routeTable->getRibV4()->routes())) {
-      UnicastRoute tempRoute;
       if (!ipv4->isResolved()) {
         XLOG(INFO) << "Skipping unresolved route: " << ipv4->toFollyDynamic();
         continue;
       }
-      auto fwdInfo = ipv4->getForwardInfo();
-      tempRoute.dest.ip = toBinaryAddress(ipv4->prefix().network);
-      tempRoute.dest.prefixLength = ipv4->prefix().mask;
-      *tempRoute.nextHopAddrs_ref() =
-          util::fromFwdNextHops(fwdInfo.getNextHopSet());
-      *tempRoute.nextHops_ref() =
-          util::fromRouteNextHopSet(fwdInfo.getNextHopSet());
-      routes.emplace_back(std::move(tempRoute));
+      routes.emplace_back(forwardUnicastRoute(*ipv4));
     }
     for (const auto& ipv6 : *(routeTable->getRibV6()->routes())) {
-      UnicastRoute tempRoute;
       if (!ipv6->isResolved()) {
         XLOG(INFO) << "Skipping unresolved route: " << ipv6->toFollyDynamic();
         continue;
       }
-      auto fwdInfo = ipv6->getForwardInfo();
-      tempRoute.dest.ip = toBinaryAddress(ipv6->prefix().network);
-      tempRoute.dest.prefixLength = ipv6->prefix().mask;
-      *tempRoute.nextHopAddrs_ref() =
-          util::fromFwdNextHops(fwdInfo.getNextHopSet());
-      *tempRoute.nextHops_ref() =
-          util::fromRouteNextHopSet(fwdInfo.getNextHopSet());
-      routes.emplace_back(std::move(tempRoute));
+      routes.emplace_back(forwardUnicastRoute(*ipv6));
     }
   }
 }
@@ -1212,16 +1459,7 @@ void ThriftHandler::getRouteTableByClient(
       if (not entry) {
         continue;
       }
-
-      UnicastRoute tempRoute;
-      tempRoute.dest.ip = toBinaryAddress(ipv4->prefix().network);
-      tempRoute.dest.prefixLength = ipv4->prefix().mask;
-      *tempRoute.nextHops_ref() =
-          util::fromRouteNextHopSet(entry->getNextHopSet());
-      for (const auto& nh : *tempRoute.nextHops_ref()) {
-        tempRoute.nextHopAddrs_ref()->emplace_back(nh.address);
-      }
-      routes.emplace_back(std::move(tempRoute));
+      routes.emplace_back(clientUnicastRoute(*ipv4, *entry));
     }
 
     for (const auto& ipv6 : *(routeTable->getRibV6()->routes())) {
@@ -1229,16 +1467,7 @@ void ThriftHandler::getRouteTableByClient(
       if (not entry) {
         continue;
       }
-
-      UnicastRoute tempRoute;
-      tempRoute.dest.ip = toBinaryAddress(ipv6->prefix().network);
-      tempRoute.dest.prefixLength = ipv6->prefix().mask;
-      *tempRoute.nextHops_ref() =
-          util::fromRouteNextHopSet(entry->getNextHopSet());
-      for (const auto& nh : *tempRoute.nextHops_ref()) {
-        tempRoute.nextHopAddrs_ref()->emplace_back(nh.address);
-      }
-      routes.emplace_back(std::move(tempRoute));
+      routes.emplace_back(clientUnicastRoute(*ipv6, *entry));
     }
   }
 }
@@ -1259,6 +1488,63 @@ void ThriftHandler::getRouteTableDetails(std::vector<RouteDetails>& routes) {
   }
 }
 
+void ThriftHandler::getRouteTablePage(
+    UnicastRoutePage& page,
+    std::unique_ptr<RouteTablePageRequest> request) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  RouteTablePager pager(*request);
+  auto nextHop = filterNextHop(*request);
+  auto client = filterClient(*request);
+  // Same snapshots as getRouteTable and getRouteTableByClient
+  auto state = client ? sw_->getState() : sw_->getAppliedState();
+  auto& routes = *page.routes_ref();
+  auto nextCursor =
+      pager.walk(*state->getRouteTables(), [&](const auto& route) {
+        if (client) {
+          auto entry = route.getEntryForClient(*client);
+          if (!entry || !hasNextHop(entry->getNextHopSet(), nextHop)) {
+            return false;
+          }
+          routes.emplace_back(clientUnicastRoute(route, *entry));
+        } else {
+          if (!route.isResolved() ||
+              !hasNextHop(route.getForwardInfo().getNextHopSet(), nextHop)) {
+            return false;
+          }
+          routes.emplace_back(forwardUnicastRoute(route));
+        }
+        return true;
+      });
+  if (nextCursor) {
+    page.nextCursor_ref() = std::move(*nextCursor);
+  }
+}
+
+void ThriftHandler::getRouteTableDetailsPage(
+    RouteDetailsPage& page,
+    std::unique_ptr<RouteTablePageRequest> request) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  RouteTablePager pager(*request);
+  auto nextHop = filterNextHop(*request);
+  auto client = filterClient(*request);
+  auto state = sw_->getState();
+  auto& routes = *page.routes_ref();
+  auto nextCursor =
+      pager.walk(*state->getRouteTables(), [&](const auto& route) {
+        if ((client && !route.getEntryForClient(*client)) ||
+            !hasNextHop(route.getForwardInfo().getNextHopSet(), nextHop)) {
+          return false;
+        }
+        routes.emplace_back(route.toRouteDetails());
+        return true;
+      });
+  if (nextCursor) {
+    page.nextCursor_ref() = std::move(*nextCursor);
+  }
+}
+
 void ThriftHandler::getIpRoute(
     UnicastRoute& route,
     std::unique_ptr<Address> addr,
@@ -1748,7 +2034,8 @@ void ThriftHandler::addMplsRoutes(
     }
     return newState;
   };
-  sw_->updateStateBlocking("addMplsRoutes", updateFn);
+  sw_->updateStateBlocking(
+      "addMplsRoutes", updateFn, StateUpdate::Priority::BULK);
 }
 
 void ThriftHandler::addMplsRoutesImpl(
@@ -1860,7 +2147,8 @@ void ThriftHandler::deleteMplsRoutes(
     }
     return newState;
   };
-  sw_->updateStateBlocking("deleteMplsRoutes", updateFn);
+  sw_->updateStateBlocking(
+      "deleteMplsRoutes", updateFn, StateUpdate::Priority::BULK);
 }
 
 void ThriftHandler::syncMplsFib(
@@ -1880,7 +2168,8 @@ void ThriftHandler::syncMplsFib(
     }
     return newState;
   };
-  sw_->updateStateBlocking("syncMplsFib", updateFn);
+  sw_->updateStateBlocking(
+      "syncMplsFib", updateFn, StateUpdate::Priority::BULK);
 }
 
 void ThriftHandler::getMplsRouteTableByClient(
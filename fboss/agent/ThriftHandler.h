@@ -96,6 +96,14 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       int16_t client,
       std::unique_ptr<std::vector<UnicastRoute>> routes,
       int32_t vrf) override;
+  void addUnicastRouteBatchInVrf(
+      int16_t client,
+      std::unique_ptr<UnicastRouteBatch> batch,
+      int32_t vrf) override;
+  void syncFibBatchInVrf(
+      int16_t client,
+      std::unique_ptr<UnicastRouteBatch> batch,
+      int32_t vrf) override;
 
   /* MPLS routes */
   void addMplsRoutes(
@@ -165,6 +173,12 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       std::vector<UnicastRoute>& routeTable,
       int16_t clientId) override;
   void getRouteTableDetails(std::vector<RouteDetails>& routeTable) override;
+  void getRouteTablePage(
+      UnicastRoutePage& page,
+      std::unique_ptr<RouteTablePageRequest> request) override;
+  void getRouteTableDetailsPage(
+      RouteDetailsPage& page,
+      std::unique_ptr<RouteTablePageRequest> request) override;
 
   void getPortStatus(
       std::map<int32_t, PortStatus>& status,
@@ -362,6 +376,12 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       const std::unique_ptr<std::vector<UnicastRoute>>& routes,
       const std::string& updType,
       bool sync);
+  void updateUnicastRouteBatchImpl(
+      int32_t vrf,
+      int16_t client,
+      const UnicastRouteBatch& batch,
+      const std::string& updType,
+      bool sync);
 
   void fillPortStats(PortInfoThrift& portInfo, int numPortQs = 0);
 
@@ -20,8 +20,10 @@ extern "C" {
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 }
 
+#include <folly/Likely.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/io/async/EventHandler.h>
 #include <folly/logging/xlog.h>
@@ -41,6 +43,9 @@ const std::string kTunDev = "/dev/net/tun";
 // Max packets to be processed which are received from host
 const int kMaxSentOneTime = 16;
 
+// Max buffers of a packet to host written at once
+const int kMaxIovecs = 16;
+
 // Definition of `iplink_req` as it is not well defined in any header files
 struct iplink_req {
   struct nlmsghdr n;
@@ -251,6 +256,8 @@ void TunIntf::addAddress(const folly::IPAddress& addr, uint8_t mask) {
 
 void TunIntf::setMtu(int mtu) {
   mtu_ = mtu;
+  // Read the next packet into a packet of the new MTU
+  nextPkt_.reset();
   auto sock = socket(PF_INET, SOCK_DGRAM, 0);
   sysCheckError(sock, "Failed to open socket");
   SCOPE_EXIT {
@@ -324,9 +331,10 @@ void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
   bool fdFail = false;
   try {
     while (sent + dropped < kMaxSentOneTime) {
-      std::unique_ptr<TxPacket> pkt;
-      pkt = sw_->allocateL3TxPacket(mtu_);
-      auto buf = pkt->buf();
+      if (!nextPkt_) {
+        nextPkt_ = sw_->allocateL3TxPacket(mtu_);
+      }
+      auto buf = nextPkt_->buf();
       int ret = 0;
       do {
         ret = read(fd_, buf->writableTail(), buf->tailroom());
@@ -353,7 +361,7 @@ void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
       } else {
         bytes += ret;
         buf->append(ret);
-        sw_->sendL3Packet(std::move(pkt), ifID_);
+        sw_->sendL3Packet(std::move(nextPkt_), ifID_);
         ++sent;
       }
     } // while
@@ -384,16 +392,27 @@ bool TunIntf::sendPacketToHost(std::unique_ptr<RxPacket> pkt) {
   // skip L2 header
   buf->trimStart(l2Len);
 
+  // Write chained buffers in one go, tun takes one packet per write
+  iovec vec[kMaxIovecs];
+  auto numIovecs = buf->fillIov(vec, kMaxIovecs).numIovecs;
+  if (UNLIKELY(numIovecs == 0)) {
+    buf->coalesce();
+    vec[0].iov_base = const_cast<uint8_t*>(buf->data());
+    vec[0].iov_len = buf->length();
+    numIovecs = 1;
+  }
+  auto length = buf->computeChainDataLength();
+
   int ret = 0;
   do {
-    ret = write(fd_, buf->data(), buf->length());
+    ret = writev(fd_, vec, numIovecs);
   } while (ret == -1 && errno == EINTR);
   if (ret < 0) {
     sysLogError(ret, "Failed to send packet to host from Interface ", ifID_);
     return false;
-  } else if (ret < buf->length()) {
+  } else if (ret < length) {
     XLOG(ERR) << "Failed to send full packet to host from Interface " << ifID_
-              << ". " << ret << " bytes sent instead of " << buf->length();
+              << ". " << ret << " bytes sent instead of " << length;
     return false;
   }
 
@@ -19,6 +19,7 @@ namespace facebook::fboss {
 
 class SwSwitch;
 class RxPacket;
+class TxPacket;
 
 class TunIntf : private folly::EventHandler {
  public:
@@ -163,6 +164,13 @@ class TunIntf : private folly::EventHandler {
    */
   int fd_{-1};
   int mtu_{-1};
+
+  /**
+   * Packet the next packet from host is read into. It is only replaced once
+   * it is sent, so that reads finding nothing to read, or dropping the packet
+   * read, don't allocate.
+   */
+  std::unique_ptr<TxPacket> nextPkt_;
 };
 
 } // namespace facebook::fboss
@@ -88,9 +88,13 @@ void TunManager::stateUpdated(const StateDelta& delta) {
 bool TunManager::sendPacketToHost(
     InterfaceID dstIfID,
     std::unique_ptr<RxPacket> pkt) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  auto iter = intfs_.find(dstIfID);
-  if (iter == intfs_.end()) {
+  std::shared_ptr<const TunIntfMap> intfs;
+  {
+    folly::SpinLockGuard guard(publishedIntfsLock_);
+    intfs = publishedIntfs_;
+  }
+  auto iter = intfs->find(dstIfID);
+  if (iter == intfs->end()) {
     // the Interface ID has been deleted, make a log, and skip the pkt
     XLOG(DBG4) << "Dropping a packet for unknown interface " << dstIfID;
     return false;
@@ -98,6 +102,13 @@ bool TunManager::sendPacketToHost(
   return iter->second->sendPacketToHost(std::move(pkt));
 }
 
+void TunManager::publishIntfs() {
+  auto intfs = std::make_shared<const TunIntfMap>(intfs_);
+  folly::SpinLockGuard guard(publishedIntfsLock_);
+  // Swap, so that the previous copy is released after the lock
+  publishedIntfs_.swap(intfs);
+}
+
 void TunManager::addExistingIntf(const std::string& ifName, int ifIndex) {
   InterfaceID ifID = util::getIDFromTunIntfName(ifName);
   auto ret = intfs_.emplace(ifID, nullptr);
@@ -164,6 +175,9 @@ void TunManager::removeIntf(InterfaceID ifID) {
   // Remove the route table and associated rule
   removeRouteTable(ifID, intf->getIfIndex());
   intf->setDelete();
+  // Stop reading on this thread, as the interface may be destroyed on a
+  // thread sending to it
+  intf->stop();
   intfs_.erase(iter);
 }
 
@@ -554,6 +568,9 @@ void TunManager::addressProcessor(struct nl_object* obj, void* data) {
 
 void TunManager::probe() {
   std::lock_guard<std::mutex> lock(mutex_);
+  SCOPE_EXIT {
+    publishIntfs();
+  };
   doProbe(lock);
 }
 
@@ -664,6 +681,9 @@ void TunManager::sync(std::shared_ptr<SwitchState> state) {
 
   // Hold mutex while changing interfaces
   std::lock_guard<std::mutex> lock(mutex_);
+  SCOPE_EXIT {
+    publishIntfs();
+  };
   if (!probeDone_) {
     doProbe(lock);
   }
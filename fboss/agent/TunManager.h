@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <folly/SpinLock.h>
 #include <folly/io/async/EventBase.h>
 #include "fboss/agent/StateObserver.h"
 #include "fboss/agent/state/Interface.h"
@@ -195,6 +196,12 @@ class TunManager : public StateObserver {
    */
   int getInterfaceMtu(InterfaceID ifID) const;
 
+  /**
+   * Publish a copy of intfs_ for sendPacketToHost(). Must be called with
+   * mutex_ held, after intfs_ is changed.
+   */
+  void publishIntfs();
+
   /**
    * Get Interface statuses map from a given SwitchState. In switch each
    * Interface/VLAN consists of multiple Ports. We derive state of Interface
@@ -221,14 +228,26 @@ class TunManager : public StateObserver {
   // Netlink socket for managing interface/addresses in Host/Linux
   nl_sock* sock_{nullptr};
 
+  using TunIntfMap =
+      boost::container::flat_map<InterfaceID, std::shared_ptr<TunIntf>>;
+
   /**
    * The mutex used to protect `intfs_` which can be used by
    * sync() could manipulate intfs_. Called on the thread that serves evb_.
-   * sendPacketToHost() uses intfs_, it can be called from any thread.
    */
-  boost::container::flat_map<InterfaceID, std::unique_ptr<TunIntf>> intfs_;
+  TunIntfMap intfs_;
   std::mutex mutex_;
 
+  /**
+   * Copy of intfs_ as of the last change, for sendPacketToHost(), which can
+   * be called from any thread for every packet to the host. Senders only
+   * hold publishedIntfsLock_ to copy the pointer, and keep the interfaces
+   * they send to alive after they are removed from intfs_.
+   */
+  std::shared_ptr<const TunIntfMap> publishedIntfs_{
+      std::make_shared<const TunIntfMap>()};
+  mutable folly::SpinLock publishedIntfsLock_;
+
   // Whether the manager has registered itself to listen for state updates
   // from sw_
   bool observingState_{false};
@@ -15,6 +15,8 @@
 
 #include <folly/logging/xlog.h>
 
+#include <algorithm>
+
 namespace facebook::fboss {
 
 std::array<folly::StringPiece, 2> HwCpuFb303Stats::kQueueStatKeys() {
@@ -44,6 +46,7 @@ void HwCpuFb303Stats::setupStats() {
       queueCounters_.reinitStat(newStatName, std::nullopt);
     }
   }
+  resolveCounters();
 }
 
 void HwCpuFb303Stats::queueChanged(int queueId, const std::string& queueName) {
@@ -59,6 +62,7 @@ void HwCpuFb303Stats::queueChanged(int queueId, const std::string& queueName) {
                            statName(statKey, queueId, *oldQueueName))
                      : std::nullopt);
   }
+  resolveCounters();
 }
 
 void HwCpuFb303Stats::queueRemoved(int queueId) {
@@ -68,35 +72,43 @@ void HwCpuFb303Stats::queueRemoved(int queueId) {
         statName(statKey, queueId, queueId2Name_[queueId]));
   }
   queueId2Name_.erase(queueId);
+  resolveCounters();
+}
+
+void HwCpuFb303Stats::resolveCounters() {
+  queueStatCounters_.clear();
+  for (const auto& queueIdAndName : queueId2Name_) {
+    std::array<stats::MonotonicCounter*, 2> counters;
+    auto queueStatKeys = kQueueStatKeys();
+    for (size_t i = 0; i < queueStatKeys.size(); ++i) {
+      counters[i] = queueCounters_.getCounterIf(statName(
+          queueStatKeys[i], queueIdAndName.first, queueIdAndName.second));
+      CHECK(counters[i]);
+    }
+    queueStatCounters_.emplace_back(queueIdAndName.first, counters);
+  }
+  std::sort(queueStatCounters_.begin(), queueStatCounters_.end());
 }
 
 void HwCpuFb303Stats::updateStats(
     const HwPortStats& curPortStats,
     const std::chrono::seconds& retrievedAt) {
   timeRetrieved_ = retrievedAt;
-  // Update queue stats
-  auto updateQueueStat = [this](
-                             folly::StringPiece statKey,
-                             int queueId,
-                             const std::map<int16_t, int64_t>& queueStats) {
-    auto qitr = queueStats.find(queueId);
-    if (qitr == queueStats.end()) {
-      // may not update stats for every queue but only those that application
-      // cares about.
-      return;
-    }
-    queueCounters_.updateStat(
-        timeRetrieved_,
-        statName(statKey, queueId, queueId2Name_[queueId]),
-        qitr->second);
+  // Update queue stats, in kQueueStatKeys order
+  const std::array<const std::map<int16_t, int64_t>*, 2> queueStats = {
+      &*curPortStats.queueOutPackets__ref(),
+      &*curPortStats.queueOutDiscardPackets__ref(),
   };
-  for (const auto& queueIdAndName : queueId2Name_) {
-    updateQueueStat(
-        kInDroppedPkts(),
-        queueIdAndName.first,
-        *curPortStats.queueOutDiscardPackets__ref());
-    updateQueueStat(
-        kInPkts(), queueIdAndName.first, *curPortStats.queueOutPackets__ref());
+  for (const auto& queueIdAndCounters : queueStatCounters_) {
+    for (size_t i = 0; i < queueStats.size(); ++i) {
+      auto qitr = queueStats[i]->find(queueIdAndCounters.first);
+      if (qitr == queueStats[i]->end()) {
+        // may not update stats for every queue but only those that
+        // application cares about.
+        continue;
+      }
+      queueIdAndCounters.second[i]->updateValue(timeRetrieved_, qitr->second);
+    }
   }
 }
 
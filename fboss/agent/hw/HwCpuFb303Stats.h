@@ -15,8 +15,11 @@
 
 #include "folly/container/F14Map.h"
 
+#include <array>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -27,6 +30,10 @@ class HwCpuFb303Stats {
       : queueId2Name_(queueId2Name) {
     setupStats();
   }
+  // queueStatCounters_ points into queueCounters_, so copies would too
+  HwCpuFb303Stats(HwCpuFb303Stats const&) = delete;
+  HwCpuFb303Stats& operator=(HwCpuFb303Stats const&) = delete;
+
   void updateStats(
       const HwPortStats& latestStats,
       const std::chrono::seconds& retrievedAt);
@@ -47,15 +54,18 @@ class HwCpuFb303Stats {
 
  private:
   void setupStats();
-
-  void updateStat(
-      const std::chrono::seconds& now,
-      const std::string& statName,
-      int64_t val);
+  /*
+   * Look up the counters updateStats updates, after they are created or
+   * renamed
+   */
+  void resolveCounters();
 
   std::chrono::seconds timeRetrieved_{0};
   HwFb303Stats queueCounters_;
   QueueId2Name queueId2Name_;
+  // Counters for kQueueStatKeys, in order, by queue id
+  std::vector<std::pair<int, std::array<stats::MonotonicCounter*, 2>>>
+      queueStatCounters_;
 };
 
 } // namespace facebook::fboss
@@ -36,14 +36,15 @@ class HwFb303Stats {
       int64_t val);
   void removeStat(const std::string& statName);
 
- private:
   /*
-   * Update queue stat
+   * Counters stay at the same address until they are removed or renamed
+   * with reinitStat, so callers updating stats often can look them up once.
    */
   stats::MonotonicCounter* getCounterIf(const std::string& statName);
   const stats::MonotonicCounter* getCounterIf(
       const std::string& statName) const;
 
-  folly::F14FastMap<std::string, stats::MonotonicCounter> counters_;
+ private:
+  folly::F14NodeMap<std::string, stats::MonotonicCounter> counters_;
 };
 } // namespace facebook::fboss
@@ -14,6 +14,8 @@
 
 #include <folly/logging/xlog.h>
 
+#include <algorithm>
+
 namespace facebook::fboss {
 
 std::array<folly::StringPiece, 22> HwPortFb303Stats::kPortStatKeys() {
@@ -87,6 +89,7 @@ void HwPortFb303Stats::reinitStats(std::optional<std::string> oldPortName) {
       portCounters_.reinitStat(newStatName, oldStatName);
     }
   }
+  resolveCounters();
 }
 
 /*
@@ -125,6 +128,7 @@ void HwPortFb303Stats::queueChanged(int queueId, const std::string& queueName) {
   for (auto statKey : kQueueStatKeys()) {
     reinitStat(statKey, queueId, oldQueueName);
   }
+  resolveCounters();
 }
 
 void HwPortFb303Stats::queueRemoved(int queueId) {
@@ -134,100 +138,84 @@ void HwPortFb303Stats::queueRemoved(int queueId) {
         statName(statKey, portName_, queueId, queueId2Name_[queueId]));
   }
   queueId2Name_.erase(queueId);
+  resolveCounters();
+}
+
+void HwPortFb303Stats::resolveCounters() {
+  auto portStatKeys = kPortStatKeys();
+  for (size_t i = 0; i < portStatKeys.size(); ++i) {
+    portStatCounters_[i] =
+        portCounters_.getCounterIf(statName(portStatKeys[i], portName_));
+    CHECK(portStatCounters_[i]);
+  }
+  queueStatCounters_.clear();
+  for (const auto& queueIdAndName : queueId2Name_) {
+    std::array<stats::MonotonicCounter*, 3> counters;
+    auto queueStatKeys = kQueueStatKeys();
+    for (size_t i = 0; i < queueStatKeys.size(); ++i) {
+      counters[i] = portCounters_.getCounterIf(statName(
+          queueStatKeys[i],
+          portName_,
+          queueIdAndName.first,
+          queueIdAndName.second));
+      CHECK(counters[i]);
+    }
+    queueStatCounters_.emplace_back(queueIdAndName.first, counters);
+  }
+  std::sort(queueStatCounters_.begin(), queueStatCounters_.end());
 }
 
 void HwPortFb303Stats::updateStats(
     const HwPortStats& curPortStats,
     const std::chrono::seconds& retrievedAt) {
   timeRetrieved_ = retrievedAt;
-  updateStat(timeRetrieved_, kInBytes(), *curPortStats.inBytes__ref());
-  updateStat(
-      timeRetrieved_, kInUnicastPkts(), *curPortStats.inUnicastPkts__ref());
-  updateStat(
-      timeRetrieved_, kInMulticastPkts(), *curPortStats.inMulticastPkts__ref());
-  updateStat(
-      timeRetrieved_, kInBroadcastPkts(), *curPortStats.inBroadcastPkts__ref());
-  updateStat(
-      timeRetrieved_, kInDiscardsRaw(), *curPortStats.inDiscardsRaw__ref());
-  updateStat(timeRetrieved_, kInDiscards(), *curPortStats.inDiscards__ref());
-  updateStat(timeRetrieved_, kInErrors(), *curPortStats.inErrors__ref());
-  updateStat(timeRetrieved_, kInPause(), *curPortStats.inPause__ref());
-  updateStat(
-      timeRetrieved_, kInIpv4HdrErrors(), *curPortStats.inIpv4HdrErrors__ref());
-  updateStat(
-      timeRetrieved_, kInIpv6HdrErrors(), *curPortStats.inIpv6HdrErrors__ref());
-  updateStat(
-      timeRetrieved_,
-      kInDstNullDiscards(),
-      *curPortStats.inDstNullDiscards__ref());
-  // Egress Stats
-  updateStat(timeRetrieved_, kOutBytes(), *curPortStats.outBytes__ref());
-  updateStat(
-      timeRetrieved_, kOutUnicastPkts(), *curPortStats.outUnicastPkts__ref());
-  updateStat(
-      timeRetrieved_,
-      kOutMulticastPkts(),
-      *curPortStats.outMulticastPkts__ref());
-  updateStat(
-      timeRetrieved_,
-      kOutBroadcastPkts(),
-      *curPortStats.outBroadcastPkts__ref());
-  updateStat(timeRetrieved_, kOutDiscards(), *curPortStats.outDiscards__ref());
-  updateStat(timeRetrieved_, kOutErrors(), *curPortStats.outErrors__ref());
-  updateStat(timeRetrieved_, kOutPause(), *curPortStats.outPause__ref());
-  updateStat(
-      timeRetrieved_,
-      kOutCongestionDiscards(),
-      *curPortStats.outCongestionDiscardPkts__ref());
-  updateStat(
-      timeRetrieved_, kOutEcnCounter(), *curPortStats.outEcnCounter__ref());
-  updateStat(
-      timeRetrieved_,
-      kFecCorrectable(),
-      *curPortStats.fecCorrectableErrors_ref());
-  updateStat(
-      timeRetrieved_,
-      kFecUncorrectable(),
-      *curPortStats.fecUncorrectableErrors_ref());
-
-  // Update queue stats
-  auto updateQueueStat = [this](
-                             folly::StringPiece statKey,
-                             int queueId,
-                             const std::map<int16_t, int64_t>& queueStats) {
-    auto qitr = queueStats.find(queueId);
-    CHECK(qitr != queueStats.end())
-        << "Missing stat: " << statKey
-        << " for queue: :" << queueId2Name_[queueId];
-    updateStat(timeRetrieved_, statKey, queueId, qitr->second);
+  // In kPortStatKeys order
+  const std::array<int64_t, 22> portStatValues = {
+      *curPortStats.inBytes__ref(),
+      *curPortStats.inUnicastPkts__ref(),
+      *curPortStats.inMulticastPkts__ref(),
+      *curPortStats.inBroadcastPkts__ref(),
+      *curPortStats.inDiscards__ref(),
+      *curPortStats.inErrors__ref(),
+      *curPortStats.inPause__ref(),
+      *curPortStats.inIpv4HdrErrors__ref(),
+      *curPortStats.inIpv6HdrErrors__ref(),
+      *curPortStats.inDstNullDiscards__ref(),
+      *curPortStats.inDiscardsRaw__ref(),
+      // Egress Stats
+      *curPortStats.outBytes__ref(),
+      *curPortStats.outUnicastPkts__ref(),
+      *curPortStats.outMulticastPkts__ref(),
+      *curPortStats.outBroadcastPkts__ref(),
+      *curPortStats.outDiscards__ref(),
+      *curPortStats.outErrors__ref(),
+      *curPortStats.outPause__ref(),
+      *curPortStats.outCongestionDiscardPkts__ref(),
+      *curPortStats.outEcnCounter__ref(),
+      *curPortStats.fecCorrectableErrors_ref(),
+      *curPortStats.fecUncorrectableErrors_ref(),
   };
-  for (const auto& queueIdAndName : queueId2Name_) {
-    updateQueueStat(
-        kOutCongestionDiscards(),
-        queueIdAndName.first,
-        *curPortStats.queueOutDiscardBytes__ref());
-    updateQueueStat(
-        kOutBytes(), queueIdAndName.first, *curPortStats.queueOutBytes__ref());
-    updateQueueStat(
-        kOutPkts(), queueIdAndName.first, *curPortStats.queueOutPackets__ref());
+  for (size_t i = 0; i < portStatValues.size(); ++i) {
+    portStatCounters_[i]->updateValue(timeRetrieved_, portStatValues[i]);
+  }
+
+  // Update queue stats, in kQueueStatKeys order
+  const std::array<const std::map<int16_t, int64_t>*, 3> queueStats = {
+      &*curPortStats.queueOutDiscardBytes__ref(),
+      &*curPortStats.queueOutBytes__ref(),
+      &*curPortStats.queueOutPackets__ref(),
+  };
+  for (const auto& queueIdAndCounters : queueStatCounters_) {
+    auto queueId = queueIdAndCounters.first;
+    for (size_t i = 0; i < queueStats.size(); ++i) {
+      auto qitr = queueStats[i]->find(queueId);
+      CHECK(qitr != queueStats[i]->end())
+          << "Missing stat: " << kQueueStatKeys()[i]
+          << " for queue: :" << queueId2Name_[queueId];
+      queueIdAndCounters.second[i]->updateValue(timeRetrieved_, qitr->second);
+    }
   }
   updateQueueWatermarkStats(curPortStats.queueWatermarkBytes_);
   portStats_ = curPortStats;
 }
-
-void HwPortFb303Stats::updateStat(
-    const std::chrono::seconds& now,
-    folly::StringPiece statKey,
-    int queueId,
-    int64_t val) {
-  portCounters_.updateStat(
-      now, statName(statKey, portName_, queueId, queueId2Name_[queueId]), val);
-}
-
-void HwPortFb303Stats::updateStat(
-    const std::chrono::seconds& now,
-    folly::StringPiece statKey,
-    int64_t val) {
-  portCounters_.updateStat(now, statName(statKey, portName_), val);
-}
 } // namespace facebook::fboss
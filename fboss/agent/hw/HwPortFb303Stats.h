@@ -15,8 +15,11 @@
 
 #include "folly/container/F14Map.h"
 
+#include <array>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -29,6 +32,9 @@ class HwPortFb303Stats {
       : portName_(portName), queueId2Name_(queueId2Name) {
     reinitStats(std::nullopt);
   }
+  // Forbidden, the cached counter pointers point into this object
+  HwPortFb303Stats(HwPortFb303Stats const&) = delete;
+  HwPortFb303Stats& operator=(HwPortFb303Stats const&) = delete;
 
   void updateStats(
       const HwPortStats& latestStats,
@@ -90,20 +96,10 @@ class HwPortFb303Stats {
       const std::string& statName,
       std::optional<std::string> oldStatName);
   /*
-   * update port stat
+   * Look up the counters updateStats updates, after they are created or
+   * renamed
    */
-  void updateStat(
-      const std::chrono::seconds& now,
-      folly::StringPiece statKey,
-      int64_t val);
-  /*
-   * update port queue stat
-   */
-  void updateStat(
-      const std::chrono::seconds& now,
-      folly::StringPiece statKey,
-      int queueId,
-      int64_t val);
+  void resolveCounters();
 
   void updateQueueWatermarkStats(
       const std::map<int16_t, int64_t>& queueWatermarkBytes) const;
@@ -112,6 +108,11 @@ class HwPortFb303Stats {
   HwFb303Stats portCounters_;
   QueueId2Name queueId2Name_;
   HwPortStats portStats_;
+  // Counters for kPortStatKeys, in order
+  std::array<stats::MonotonicCounter*, 22> portStatCounters_{};
+  // Counters for kQueueStatKeys, in order, by queue id
+  std::vector<std::pair<int, std::array<stats::MonotonicCounter*, 3>>>
+      queueStatCounters_;
 };
 
 } // namespace facebook::fboss
@@ -10,10 +10,14 @@
 
 #include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
 
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/SysError.h"
 #include "fboss/agent/Utils.h"
 
 #include <folly/FileUtil.h>
+#include <folly/experimental/bser/Bser.h>
+#include <folly/io/Compression.h>
+#include <folly/io/IOBuf.h>
 #include <folly/json.h>
 #include <folly/logging/xlog.h>
 
@@ -21,13 +25,38 @@ DEFINE_bool(can_warm_boot, true, "Enable/disable warm boot functionality");
 DEFINE_string(
     switch_state_file,
     "switch_state",
-    "File for dumping switch state JSON in on exit");
+    "File for dumping switch state in on exit");
+DEFINE_bool(
+    binary_warm_boot_state,
+    false,
+    "Store the warm boot switch state in a compact binary format instead of "
+    "JSON. Only enable once no version that may be rolled back to stores it "
+    "as JSON, since those can not read it");
+DEFINE_bool(
+    compress_warm_boot_state,
+    false,
+    "Compress the binary warm boot switch state file with zstd");
+DEFINE_bool(
+    dump_warm_boot_state_json,
+    false,
+    "Also dump the warm boot switch state as JSON to <switch_state_file>.json "
+    "for debugging");
 
 namespace {
 constexpr auto wbFlagPrefix = "can_warm_boot_";
 constexpr auto forceColdBootPrefix = "cold_boot_once_";
 constexpr auto shutdownDumpPrefix = "sdk_shutdown_dump_";
 constexpr auto startupDumpPrefix = "sdk_startup_dump_";
+constexpr auto jsonDumpSuffix = ".json";
+
+/*
+ * Binary warm boot state header: magic, format version and flags, followed
+ * by the payload. Files without the magic are parsed as JSON.
+ */
+constexpr folly::StringPiece kWarmBootStateMagic{"FBWB"};
+constexpr uint8_t kWarmBootStateVersion = 1;
+constexpr uint8_t kWarmBootStateZstd = 0x1;
+constexpr size_t kWarmBootStateHeaderSize = kWarmBootStateMagic.size() + 2;
 
 /*
  * Remove the given file. Return true if file exists and
@@ -134,17 +163,76 @@ bool HwSwitchWarmBootHelper::checkAndClearWarmBootFlags() {
 
 bool HwSwitchWarmBootHelper::storeWarmBootState(
     const folly::dynamic& switchState) {
-  warmBootStateWritten_ =
-      dumpStateToFile(warmBootSwitchStateFile(), switchState);
+  if (FLAGS_dump_warm_boot_state_json) {
+    auto jsonFile = warmBootSwitchStateFile() + jsonDumpSuffix;
+    if (!dumpStateToFile(jsonFile, switchState)) {
+      XLOG(ERR) << "Unable to dump switch state JSON to " << jsonFile;
+    }
+  }
+  warmBootStateWritten_ = folly::writeFile(
+      serializeWarmBootState(switchState), warmBootSwitchStateFile().c_str());
   return warmBootStateWritten_;
 }
 
 folly::dynamic HwSwitchWarmBootHelper::getWarmBootState() const {
-  std::string warmBootJson;
-  auto ret = folly::readFile(warmBootSwitchStateFile().c_str(), warmBootJson);
-  sysCheckError(
-      ret, "Unable to read switch state from : ", warmBootSwitchStateFile());
-  return folly::parseJson(warmBootJson);
+  return readWarmBootStateFile(warmBootSwitchStateFile());
+}
+
+std::string HwSwitchWarmBootHelper::serializeWarmBootState(
+    const folly::dynamic& switchState) {
+  if (!FLAGS_binary_warm_boot_state) {
+    return folly::toPrettyJson(switchState);
+  }
+  uint8_t flags = 0;
+  auto payload =
+      folly::bser::toBserIOBuf(switchState, folly::bser::serialization_opts());
+  if (FLAGS_compress_warm_boot_state) {
+    auto codec = folly::io::getCodec(folly::io::CodecType::ZSTD);
+    payload = codec->compress(payload.get());
+    flags |= kWarmBootStateZstd;
+  }
+  std::string data;
+  data.reserve(kWarmBootStateHeaderSize + payload->computeChainDataLength());
+  data.append(kWarmBootStateMagic.data(), kWarmBootStateMagic.size());
+  data.push_back(static_cast<char>(kWarmBootStateVersion));
+  data.push_back(static_cast<char>(flags));
+  for (const auto& buf : *payload) {
+    data.append(reinterpret_cast<const char*>(buf.data()), buf.size());
+  }
+  return data;
+}
+
+folly::dynamic HwSwitchWarmBootHelper::deserializeWarmBootState(
+    folly::StringPiece data) {
+  if (!data.startsWith(kWarmBootStateMagic)) {
+    // Written by a version which stored warm boot state as JSON
+    return folly::parseJson(data);
+  }
+  if (data.size() < kWarmBootStateHeaderSize) {
+    throw FbossError("Truncated warm boot state header");
+  }
+  auto version = static_cast<uint8_t>(data[kWarmBootStateMagic.size()]);
+  auto flags = static_cast<uint8_t>(data[kWarmBootStateMagic.size() + 1]);
+  if (version != kWarmBootStateVersion) {
+    throw FbossError(
+        "Unsupported warm boot state version: ", static_cast<int>(version));
+  }
+  data.advance(kWarmBootStateHeaderSize);
+  if (flags & kWarmBootStateZstd) {
+    auto codec = folly::io::getCodec(folly::io::CodecType::ZSTD);
+    auto compressed = folly::IOBuf::wrapBuffer(data.data(), data.size());
+    auto payload = codec->uncompress(compressed.get());
+    return folly::bser::parseBser(payload.get());
+  }
+  return folly::bser::parseBser(folly::ByteRange(data));
+}
+
+folly::dynamic HwSwitchWarmBootHelper::readWarmBootStateFile(
+    const std::string& filename) {
+  std::string data;
+  auto ret = folly::readFile(filename.c_str(), data);
+  sysCheckError(ret, "Unable to read switch state from : ", filename);
+  return deserializeWarmBootState(data);
 }
 
 void HwSwitchWarmBootHelper::setupWarmBootFile() {
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <folly/Range.h>
 #include <folly/dynamic.h>
 
 #include <string>
@@ -43,6 +44,16 @@ class HwSwitchWarmBootHelper {
   bool storeWarmBootState(const folly::dynamic& switchState);
   folly::dynamic getWarmBootState() const;
 
+  /*
+   * Warm boot state is stored as JSON, or with --binary_warm_boot_state in a
+   * compact binary format: a versioned header followed by the BSER encoded
+   * state, optionally zstd compressed. Reading accepts either, and JSON can
+   * still be written for debugging (see --dump_warm_boot_state_json).
+   */
+  static std::string serializeWarmBootState(const folly::dynamic& switchState);
+  static folly::dynamic deserializeWarmBootState(folly::StringPiece data);
+  static folly::dynamic readWarmBootStateFile(const std::string& filename);
+
   std::string startupSdkDumpFile() const;
   std::string shutdownSdkDumpFile() const;
   bool warmBootStateWritten() const {
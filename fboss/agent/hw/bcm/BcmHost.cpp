@@ -49,7 +49,7 @@ namespace facebook::fboss {
 std::ostream& operator<<(
     std::ostream& os,
     const facebook::fboss::BcmMultiPathNextHopKey& key) {
-  return os << "BcmMultiPathNextHop: " << key.second << "@vrf " << key.first;
+  return os << "BcmMultiPathNextHop: " << *key.second << "@vrf " << key.first;
 }
 
 using folly::IPAddress;
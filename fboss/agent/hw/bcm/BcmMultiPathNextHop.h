@@ -25,7 +25,8 @@ namespace facebook::fboss {
  * BcmMultiPathNextHop simply references another egress entry (which maybe
  * either BcmEgress or BcmEcmpEgress).
  */
-using BcmMultiPathNextHopKey = std::pair<bcm_vrf_t, RouteNextHopSet>;
+using BcmMultiPathNextHopKey =
+    std::pair<bcm_vrf_t, RouteNextHopEntry::InternedNextHopSet>;
 
 class BcmNextHop;
 
@@ -47,7 +48,7 @@ class BcmMultiPathNextHop {
 
   const BcmSwitchIf* hw_;
   bcm_vrf_t vrf_;
-  RouteNextHopSet fwd_;
+  RouteNextHopEntry::InternedNextHopSet fwd_;
   std::vector<std::shared_ptr<BcmNextHop>> nexthops_;
   std::unique_ptr<BcmEcmpEgress> ecmpEgress_;
 };
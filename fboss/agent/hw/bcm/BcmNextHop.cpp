@@ -21,7 +21,7 @@ std::string nextHopKeyStr(const KetT& key) {
 
 std::string nextHopKeyStr(const facebook::fboss::BcmMultiPathNextHopKey& key) {
   std::string str = folly::to<std::string>("vrf:", key.first, "->{");
-  for (const auto& nhop : key.second) {
+  for (const auto& nhop : *key.second) {
     str = folly::to<std::string>(nhop.str(), ",");
   }
   str += "}";
@@ -102,7 +102,7 @@ void BcmRoute::program(
     // need to get an entry from the host table for the forward info
     nexthopReference =
         hw_->writableMultiPathNextHopTable()->referenceOrEmplaceNextHop(
-            BcmMultiPathNextHopKey(vrf_, fwd.getNextHopSet()));
+            BcmMultiPathNextHopKey(vrf_, fwd.getInternedNextHopSet()));
     egressId = nexthopReference->getEgressId();
   }
 
@@ -9,6 +9,7 @@
  */
 #include "BcmSflowExporter.h"
 
+#include <array>
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -16,8 +17,10 @@
 #include <fcntl.h>
 #include <ifaddrs.h>
 
+#include <fb303/ServiceData.h>
 #include <folly/Range.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <optional>
 
@@ -25,9 +28,27 @@
 
 #include "fboss/agent/FbossError.h"
 
+DEFINE_bool(
+    sflow_v5_export,
+    false,
+    "Export sFlow samples to collectors as batched sFlow v5 datagrams "
+    "instead of one thrift serialized SflowPacketInfo per datagram");
+DEFINE_int32(
+    sflow_export_max_delay_ms,
+    100,
+    "Longest time an sFlow sample waits for its datagram to fill up before "
+    "being exported, with --sflow_v5_export");
+DEFINE_int32(
+    sflow_datagram_size,
+    1400,
+    "Largest sFlow v5 datagram to send, in bytes, with --sflow_v5_export");
+
 using namespace std;
 
 namespace {
+// Export as soon as this many datagrams are full, instead of waiting for the
+// next flush, to bound the memory used and the length of a sendmmsg batch
+constexpr size_t kMaxPendingDatagrams = 16;
 std::optional<folly::IPAddress> getLocalIPv6FromWhoAmI() {
   const std::string whoAmIFn = "/etc/fbwhoami";
   const std::string key = "DEVICE_PRIMARY_IPV6";
@@ -189,25 +210,97 @@ ssize_t BcmSflowExporter::sendUDPDatagram(iovec* vec, const size_t iovec_len) {
   return ret;
 }
 
+size_t BcmSflowExporter::sendDatagrams(
+    const folly::IPAddress& agentIP,
+    uint32_t uptime,
+    const std::vector<sflow::SampleDatagramBatch::Datagram>& datagrams) {
+  constexpr auto kHeaderSize = sflow::SampleDatagramBatch::kMaxHeaderSize;
+  std::vector<std::array<uint8_t, kHeaderSize>> headers(datagrams.size());
+  std::vector<std::array<iovec, 2>> iovecs(datagrams.size());
+  std::vector<mmsghdr> msgs(datagrams.size());
+
+  sockaddr_storage addrStorage;
+  address_.getAddress(&addrStorage);
+
+  sflow::SampleDatagram header;
+  header.datagramV5.agentAddress = agentIP;
+  header.datagramV5.subAgentID = 0;
+  header.datagramV5.uptime = uptime;
+  header.datagramV5.samples = nullptr;
+  for (auto i = 0; i < datagrams.size(); ++i) {
+    header.datagramV5.sequenceNumber = ++sequenceNumber_;
+    header.datagramV5.samplesCnt = datagrams[i].samplesCnt;
+    auto buf = folly::IOBuf::wrapBuffer(headers[i].data(), kHeaderSize);
+    folly::io::RWPrivateCursor cursor(buf.get());
+    header.serializeHeader(&cursor);
+
+    iovecs[i][0].iov_base = headers[i].data();
+    iovecs[i][0].iov_len = kHeaderSize - cursor.length();
+    iovecs[i][1].iov_base =
+        const_cast<uint8_t*>(datagrams[i].samples->data());
+    iovecs[i][1].iov_len = datagrams[i].samples->length();
+
+    auto& msg = msgs[i].msg_hdr;
+    msg.msg_name = reinterpret_cast<void*>(&addrStorage);
+    msg.msg_namelen = address_.getActualSize();
+    msg.msg_iov = iovecs[i].data();
+    msg.msg_iovlen = iovecs[i].size();
+  }
+
+  size_t sent = 0;
+  while (sent < msgs.size()) {
+    auto ret = ::sendmmsg(socket_, &msgs[sent], msgs.size() - sent, 0);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      XLOG(DBG1) << "Failed sending " << msgs.size() - sent
+                 << " sFlow datagrams to " << address_.describe()
+                 << " reason: " << folly::errnoStr(errno);
+      break;
+    }
+    sent += ret;
+  }
+  XLOG(DBG4) << "Sent " << sent << " sFlow datagrams to "
+             << address_.describe();
+  return sent;
+}
+
 BcmSflowExporter::~BcmSflowExporter() {
   if (socket_ != -1) {
     close(socket_);
   }
 }
 
+BcmSflowExporterTable::BcmSflowExporterTable()
+    : startTime_(std::chrono::steady_clock::now()),
+      batch_(FLAGS_sflow_datagram_size) {
+  if (FLAGS_sflow_v5_export) {
+    flushScheduler_.setThreadName("SflowExport");
+    flushScheduler_.addFunction(
+        [this]() { flush(); },
+        std::chrono::milliseconds(FLAGS_sflow_export_max_delay_ms),
+        "flushSflowDatagrams");
+    flushScheduler_.start();
+  }
+}
+
 bool BcmSflowExporterTable::contains(
     const shared_ptr<SflowCollector>& c) const {
+  std::lock_guard<std::mutex> g(lock_);
   auto iter = map_.find(c->getID());
   return iter != map_.end();
 }
 
 size_t BcmSflowExporterTable::size() const {
+  std::lock_guard<std::mutex> g(lock_);
   return map_.size();
 }
 
 void BcmSflowExporterTable::addExporter(const shared_ptr<SflowCollector>& c) {
   try {
     auto exporter = make_unique<BcmSflowExporter>(c->getAddress());
+    std::lock_guard<std::mutex> g(lock_);
     map_.emplace(c->getID(), move(exporter));
   } catch (const fboss::thrift::FbossBaseError& ex) {
     XLOG(ERR) << "Could not add exporter: "
@@ -222,6 +315,7 @@ void BcmSflowExporterTable::addExporter(const shared_ptr<SflowCollector>& c) {
 
 void BcmSflowExporterTable::removeExporter(const std::string& id) {
   XLOG(INFO) << "Removed sFlow exporter " << id;
+  std::lock_guard<std::mutex> g(lock_);
   map_.erase(id);
 }
 
@@ -229,6 +323,10 @@ void BcmSflowExporterTable::updateSamplingRates(
     PortID id,
     int64_t inRate,
     int64_t outRate) {
+  // We piggyback the update of local IPv6
+  auto localIP = getLocalIPv6();
+
+  std::lock_guard<std::mutex> g(lock_);
   std::pair<int64_t, int64_t> rates(inRate, outRate);
   auto it = port2samplingRates_.find(id);
   if (it != port2samplingRates_.end()) {
@@ -236,17 +334,20 @@ void BcmSflowExporterTable::updateSamplingRates(
   } else {
     port2samplingRates_.insert(std::make_pair(id, rates));
   }
-
-  // We piggyback the update of local IPv6
-  localIP_ = getLocalIPv6();
+  localIP_ = localIP;
 }
 
 void BcmSflowExporterTable::sendToAll(const SflowPacketInfo& info) {
+  std::lock_guard<std::mutex> g(lock_);
   if (map_.empty()) {
     XLOG(DBG1)
         << "zero sFlow collectors with sflow enabled, skipping sample export";
     return;
   }
+  if (FLAGS_sflow_v5_export) {
+    addSampleLocked(info);
+    return;
+  }
   // Serialize info to a string and wrap it in an IOBuf for sending
   string output;
   apache::thrift::BinarySerializer::serialize(info, &output);
@@ -268,4 +369,83 @@ void BcmSflowExporterTable::sendToAll(const SflowPacketInfo& info) {
   }
 }
 
+void BcmSflowExporterTable::addSampleLocked(const SflowPacketInfo& info) {
+  const auto& packetData = info.packetData;
+  sflow::SampledHeader header;
+  header.protocol = sflow::HeaderProtocol::ETHERNET_ISO88023;
+  header.frameLength = std::max<uint32_t>(info.frameLength, packetData.size());
+  header.stripped = 0;
+  header.headerLength = packetData.size();
+  header.header = reinterpret_cast<const sflow::byte*>(packetData.data());
+
+  // Ports are reported by their logical port id, used as ifIndex
+  PortID srcPort(info.srcPort);
+  PortID dstPort(info.dstPort);
+  auto samplingPort = info.ingressSampled ? srcPort : dstPort;
+  int64_t samplingRate = 0;
+  auto it = port2samplingRates_.find(samplingPort);
+  if (it != port2samplingRates_.end()) {
+    samplingRate = info.ingressSampled ? it->second.first : it->second.second;
+  }
+
+  sflow::FlowSample sample;
+  sample.sequenceNumber = ++sampleSequenceNumber_;
+  sample.sourceID = static_cast<uint32_t>(samplingPort);
+  sample.samplingRate = samplingRate;
+  sample.samplePool = 0;
+  sample.drops = 0;
+  sample.input = static_cast<uint32_t>(srcPort);
+  sample.output = static_cast<uint32_t>(dstPort);
+
+  if (!batch_.addSample(sample, header)) {
+    XLOG(DBG2) << "sFlow sample of " << packetData.size()
+               << " bytes does not fit in a datagram, dropping it";
+    fb303::fbData->incrementCounter("sflow.samples_dropped", map_.size());
+    return;
+  }
+  if (batch_.numDatagrams() > kMaxPendingDatagrams) {
+    flushLocked();
+  }
+}
+
+void BcmSflowExporterTable::flush() {
+  std::lock_guard<std::mutex> g(lock_);
+  flushLocked();
+}
+
+void BcmSflowExporterTable::flushLocked() {
+  if (batch_.empty()) {
+    return;
+  }
+  auto datagrams = batch_.take();
+  auto uptime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - startTime_)
+                    .count();
+
+  int64_t datagramsSent = 0;
+  int64_t datagramsDropped = 0;
+  int64_t samplesExported = 0;
+  int64_t samplesDropped = 0;
+  for (const auto& c : map_) {
+    auto sent = c.second->sendDatagrams(localIP_, uptime, datagrams);
+    for (auto i = 0; i < datagrams.size(); ++i) {
+      if (i < sent) {
+        samplesExported += datagrams[i].samplesCnt;
+      } else {
+        samplesDropped += datagrams[i].samplesCnt;
+      }
+    }
+    datagramsSent += sent;
+    datagramsDropped += datagrams.size() - sent;
+  }
+
+  fb303::fbData->incrementCounter("sflow.datagrams_sent", datagramsSent);
+  fb303::fbData->incrementCounter("sflow.samples_exported", samplesExported);
+  if (datagramsDropped) {
+    fb303::fbData->incrementCounter(
+        "sflow.datagrams_dropped", datagramsDropped);
+    fb303::fbData->incrementCounter("sflow.samples_dropped", samplesDropped);
+  }
+}
+
 } // namespace facebook::fboss
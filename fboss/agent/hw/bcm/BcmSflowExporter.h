@@ -9,12 +9,16 @@
  */
 #pragma once
 
+#include <chrono>
+#include <mutex>
 #include <unordered_map>
 
 #include <folly/IPAddress.h>
 #include <folly/SocketAddress.h>
+#include <folly/experimental/FunctionScheduler.h>
 
 #include "fboss/agent/if/gen-cpp2/sflow_types.h"
+#include "fboss/agent/packet/SflowDatagramBatch.h"
 #include "fboss/agent/state/SflowCollector.h"
 #include "fboss/agent/types.h"
 
@@ -35,6 +39,17 @@ class BcmSflowExporter {
    */
   ssize_t sendUDPDatagram(iovec* vec, const size_t iovec_len);
 
+  /*
+   * Send sFlow v5 datagrams made of the given samples, each with a header
+   * carrying this collector's own sequence number, in as few sendmmsg calls
+   * as possible. Returns the number of datagrams sent, which is less than
+   * the number of datagrams if the socket buffer is full.
+   */
+  size_t sendDatagrams(
+      const folly::IPAddress& agentIP,
+      uint32_t uptime,
+      const std::vector<sflow::SampleDatagramBatch::Datagram>& datagrams);
+
  private:
   // no copy or assignment
   BcmSflowExporter(BcmSflowExporter const&) = delete;
@@ -42,11 +57,19 @@ class BcmSflowExporter {
 
   const folly::SocketAddress address_;
   int socket_{-1};
+  uint32_t sequenceNumber_{0};
 };
 
+/*
+ * By default, every sample is sent to every collector in its own datagram,
+ * as a thrift serialized SflowPacketInfo. With --sflow_v5_export, samples
+ * are instead packed into sFlow v5 datagrams of up to --sflow_datagram_size
+ * bytes, sent when enough datagrams are pending or, at the latest,
+ * --sflow_export_max_delay_ms after they were started.
+ */
 class BcmSflowExporterTable {
  public:
-  BcmSflowExporterTable() = default;
+  BcmSflowExporterTable();
   ~BcmSflowExporterTable() = default;
 
   bool contains(const std::shared_ptr<SflowCollector>& collector) const;
@@ -58,17 +81,31 @@ class BcmSflowExporterTable {
 
   void sendToAll(const SflowPacketInfo& info);
 
+  /* Send the pending sFlow v5 datagrams, if any */
+  void flush();
+
  private:
   // no copy or assignment
   BcmSflowExporterTable(BcmSflowExporterTable const&) = delete;
   BcmSflowExporterTable& operator=(BcmSflowExporterTable const&) = delete;
 
+  void addSampleLocked(const SflowPacketInfo& info);
+  void flushLocked();
+
+  // Protects everything below, as samples are exported from the rx thread
+  // and flushed from the flush thread
+  mutable std::mutex lock_;
   std::unordered_map<std::string, std::unique_ptr<BcmSflowExporter>> map_;
   std::unordered_map<
       PortID,
       std::pair<int64_t /* ingress rate */, int64_t /* egress rate */>>
       port2samplingRates_;
-  folly::IPAddress localIP_;
+  folly::IPAddress localIP_{"::"};
+  const std::chrono::steady_clock::time_point startTime_;
+  sflow::SampleDatagramBatch batch_;
+  uint32_t sampleSequenceNumber_{0};
+  // Last, so that it stops before anything it flushes is destroyed
+  folly::FunctionScheduler flushScheduler_;
 };
 
 } // namespace facebook::fboss
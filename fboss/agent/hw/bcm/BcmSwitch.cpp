@@ -2765,6 +2765,7 @@ bool BcmSwitch::handleSflowPacket(bcm_pkt_t* pkt) noexcept {
   info.srcPort = pkt->src_port;
   info.dstPort = pkt->dest_port;
   info.vlan = pkt->vlan;
+  info.frameLength = pkt->pkt_data->len;
 
   auto snapLen = std::min(kMaxSflowSnapLen, (unsigned int)(pkt->pkt_data->len));
 
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "common/init/Init.h"
+#include "fboss/agent/hw/bcm/BcmSflowExporter.h"
+#include "fboss/agent/state/SflowCollector.h"
+
+#include <folly/Benchmark.h>
+#include <folly/SocketAddress.h>
+
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+DECLARE_bool(sflow_v5_export);
+
+using namespace facebook::fboss;
+
+/*
+ * Time to export one sFlow sample of 128 bytes to two collectors on the
+ * loopback interface, sending one thrift serialized SflowPacketInfo per
+ * sample and collector, and batching samples into sFlow v5 datagrams. Samples
+ * are exported from a single thread, the way BcmSwitch does from its rx
+ * thread, so the reciprocal of the time per sample is the samples per second
+ * a single rx thread can export. The CPU time, user and system, the
+ * exporting thread used per sample is printed after each benchmark.
+ * Collectors never read their sockets: the kernel drops what does not fit in
+ * their receive buffer.
+ */
+
+namespace {
+
+constexpr auto kNumCollectors = 2;
+constexpr auto kSnapLen = 128;
+
+class LoopbackCollector {
+ public:
+  LoopbackCollector() {
+    socket_ = ::socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    CHECK_NE(socket_, -1);
+    sockaddr_storage addrStorage;
+    folly::SocketAddress("::1", 0).getAddress(&addrStorage);
+    CHECK_EQ(
+        0,
+        bind(
+            socket_,
+            reinterpret_cast<sockaddr*>(&addrStorage),
+            sizeof(sockaddr_in6)));
+    socklen_t len = sizeof(addrStorage);
+    CHECK_EQ(
+        0,
+        getsockname(
+            socket_, reinterpret_cast<sockaddr*>(&addrStorage), &len));
+    address_.setFromSockaddr(reinterpret_cast<sockaddr*>(&addrStorage), len);
+  }
+  ~LoopbackCollector() {
+    close(socket_);
+  }
+
+  std::shared_ptr<SflowCollector> collector() const {
+    return std::make_shared<SflowCollector>(
+        address_.getAddressStr(), address_.getPort());
+  }
+
+ private:
+  int socket_{-1};
+  folly::SocketAddress address_;
+};
+
+int64_t cpuTimeUsec() {
+  struct rusage usage;
+  getrusage(RUSAGE_THREAD, &usage);
+  auto usec = [](const timeval& tv) {
+    return int64_t(tv.tv_sec) * 1000000 + tv.tv_usec;
+  };
+  return usec(usage.ru_utime) + usec(usage.ru_stime);
+}
+
+void exportSamples(unsigned iters, bool v5Export) {
+  folly::BenchmarkSuspender suspender;
+  FLAGS_sflow_v5_export = v5Export;
+  std::vector<std::unique_ptr<LoopbackCollector>> collectors;
+  auto table = std::make_unique<BcmSflowExporterTable>();
+  for (auto i = 0; i < kNumCollectors; ++i) {
+    collectors.push_back(std::make_unique<LoopbackCollector>());
+    table->addExporter(collectors.back()->collector());
+  }
+  table->updateSamplingRates(PortID(1), 4096, 0);
+
+  SflowPacketInfo info;
+  info.ingressSampled = true;
+  info.egressSampled = false;
+  info.srcPort = 1;
+  info.dstPort = 2;
+  info.vlan = 1;
+  info.packetData = std::string(kSnapLen, 'x');
+  info.frameLength = 1500;
+  auto startCpuTime = cpuTimeUsec();
+  suspender.dismiss();
+
+  for (unsigned n = 0; n < iters; ++n) {
+    table->sendToAll(info);
+  }
+  table->flush();
+
+  suspender.rehire();
+  std::cout << (v5Export ? "v5" : "thrift") << ": "
+            << double(cpuTimeUsec() - startCpuTime) * 1000 / iters
+            << " ns of CPU per sample over " << iters << " samples"
+            << std::endl;
+  table.reset();
+}
+
+} // namespace
+
+BENCHMARK(ThriftPerSampleExport, iters) {
+  exportSamples(iters, false);
+}
+
+BENCHMARK_RELATIVE(SflowV5BatchedExport, iters) {
+  exportSamples(iters, true);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -8,7 +8,7 @@
  *
  */
 
-#include "fboss/agent/SysError.h"
+#include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
 #include "fboss/agent/hw/bcm/tests/BcmTest.h"
 
 #include "fboss/agent/ApplyThriftConfig.h"
@@ -17,13 +17,12 @@
 
 #include "fboss/agent/hw/test/ConfigFactory.h"
 
-#include <folly/FileUtil.h>
 #include <folly/dynamic.h>
 
 DEFINE_string(
     replay_switch_state_file,
     "",
-    "File for dumping switch state JSON in on exit");
+    "Warm boot switch state file (binary or JSON) to replay");
 using std::string;
 
 namespace facebook::fboss {
@@ -31,15 +30,9 @@ namespace facebook::fboss {
 class BcmSwitchStateReplayTest : public BcmTest {
   std::shared_ptr<SwitchState> getWarmBootState() const {
     if (FLAGS_replay_switch_state_file.size()) {
-      std::string warmBootJson;
-      auto ret =
-          folly::readFile(FLAGS_replay_switch_state_file.c_str(), warmBootJson);
-      sysCheckError(
-          ret,
-          "Unable to read switch state from : ",
-          FLAGS_replay_switch_state_file);
       return SwitchState::fromFollyDynamic(
-          folly::parseJson(warmBootJson)["swSwitch"]);
+          HwSwitchWarmBootHelper::readWarmBootStateFile(
+              FLAGS_replay_switch_state_file)["swSwitch"]);
     }
     // No file was given as input. This would happen when this gets
     // invoked as part of bcm_test test suite. In which case, just
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/Platform.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsemble.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+
+#include <string>
+
+namespace facebook::fboss {
+
+namespace {
+
+// As many ACLs as the larger production configs have
+constexpr int kNumAcls = 2000;
+constexpr int kL4DstPortBase = 1024;
+
+cfg::AclEntry makeAcl(int index) {
+  cfg::AclEntry acl;
+  *acl.name_ref() = folly::to<std::string>("acl", index);
+  *acl.actionType_ref() = cfg::AclActionType::DENY;
+  acl.l4DstPort_ref() = kL4DstPortBase + index;
+  return acl;
+}
+
+} // namespace
+
+/*
+ * Push a config that inserts an ACL ahead of kNumAcls existing ones, which
+ * shifts the priority of every existing ACL, and then a config that
+ * removes it again. Only programming the resulting states is timed.
+ */
+BENCHMARK(HwAclConfigPush) {
+  folly::BenchmarkSuspender suspender;
+  auto ensemble = createHwEnsemble({HwSwitchEnsemble::LINKSCAN});
+  auto hwSwitch = ensemble->getHwSwitch();
+  auto config =
+      utility::onePortPerVlanConfig(hwSwitch, ensemble->masterLogicalPortIds());
+  for (int i = 0; i < kNumAcls; ++i) {
+    config.acls_ref()->push_back(makeAcl(i));
+  }
+  ensemble->applyInitialConfig(config);
+
+  auto insertConfig = config;
+  insertConfig.acls_ref()->insert(
+      insertConfig.acls_ref()->begin(), makeAcl(kNumAcls));
+  for (auto i = 0; i < 10; ++i) {
+    auto newState = applyThriftConfig(
+        ensemble->getProgrammedState(),
+        &insertConfig,
+        ensemble->getPlatform());
+    suspender.dismiss();
+    ensemble->applyNewState(newState);
+    suspender.rehire();
+
+    newState = applyThriftConfig(
+        ensemble->getProgrammedState(), &config, ensemble->getPlatform());
+    suspender.dismiss();
+    ensemble->applyNewState(newState);
+    suspender.rehire();
+  }
+}
+
+} // namespace facebook::fboss
@@ -12,9 +12,22 @@
 
 #include "fboss/agent/test/RouteScaleGenerators.h"
 
+#include <gflags/gflags.h>
+
 namespace facebook::fboss {
 
 ROUTE_ADD_BENCHMARK(
     HwFswScaleRouteAddBenchmark,
     utility::FSWRouteScaleGenerator);
+
+/*
+ * Same as above, with routes programmed in chunks through the SAI bulk apis.
+ * The flag is set by name since it only exists for SAI switches; elsewhere
+ * this measures the same thing as HwFswScaleRouteAddBenchmark.
+ */
+BENCHMARK_RELATIVE(HwFswScaleRouteAddBulkBenchmark) {
+  gflags::FlagSaver flagSaver;
+  gflags::SetCommandLineOption("sai_bulk_route_chunk_size", "1024");
+  routeAddDelBenchmarker<utility::FSWRouteScaleGenerator>(true);
+}
 } // namespace facebook::fboss
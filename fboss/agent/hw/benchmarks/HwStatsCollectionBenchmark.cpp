@@ -10,13 +10,19 @@
 
 #include "fboss/agent/Platform.h"
 #include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/hw/HwPortFb303Stats.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/hw/test/HwSwitchEnsemble.h"
 #include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
 
 #include <folly/Benchmark.h>
+#include <folly/Conv.h>
 #include <folly/logging/xlog.h>
 
+#include <chrono>
+#include <memory>
+#include <vector>
+
 namespace facebook::fboss {
 
 /*
@@ -46,4 +52,41 @@ BENCHMARK(HwStatsCollection) {
   suspender.rehire();
 }
 
+/*
+ * Publish stats of 256 ports, with 8 queues each, to fb303 10K times,
+ * without collecting them from the hardware. This isolates the fb303 update
+ * cost from that of the SDK calls.
+ */
+BENCHMARK(HwPortFb303StatsUpdate) {
+  folly::BenchmarkSuspender suspender;
+  constexpr auto kNumPorts = 256;
+  constexpr auto kNumQueues = 8;
+
+  HwPortFb303Stats::QueueId2Name queueId2Name;
+  HwPortStats portStats;
+  for (auto queueId = 0; queueId < kNumQueues; ++queueId) {
+    queueId2Name.emplace(queueId, folly::to<std::string>("queue", queueId));
+    (*portStats.queueOutDiscardBytes__ref())[queueId] = 0;
+    (*portStats.queueOutBytes__ref())[queueId] = 0;
+    (*portStats.queueOutPackets__ref())[queueId] = 0;
+    (*portStats.queueWatermarkBytes__ref())[queueId] = 0;
+  }
+  std::vector<std::unique_ptr<HwPortFb303Stats>> allPortStats;
+  for (auto i = 0; i < kNumPorts; ++i) {
+    allPortStats.push_back(std::make_unique<HwPortFb303Stats>(
+        folly::to<std::string>("eth1/", i + 1, "/1"), queueId2Name));
+  }
+  auto now = std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::system_clock::now().time_since_epoch());
+  suspender.dismiss();
+  for (auto i = 0; i < 10'000; ++i) {
+    *portStats.inBytes__ref() = i;
+    *portStats.outBytes__ref() = i;
+    for (auto& stats : allPortStats) {
+      stats->updateStats(portStats, now);
+    }
+  }
+  suspender.rehire();
+}
+
 } // namespace facebook::fboss
@@ -8,7 +8,11 @@
  *
  */
 
+#include "fboss/agent/Constants.h"
+#include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/Platform.h"
+#include "fboss/agent/SysError.h"
+#include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/hw/test/HwSwitchEnsemble.h"
 #include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
@@ -17,38 +21,101 @@
 #include "fboss/agent/test/EcmpSetupHelper.h"
 #include "fboss/agent/test/RouteScaleGenerators.h"
 
+#include <folly/FileUtil.h>
 #include <folly/IPAddressV6.h>
 #include <folly/dynamic.h>
 #include <folly/init/Init.h>
 #include <folly/json.h>
 
+#include <unistd.h>
 #include <chrono>
 #include <iostream>
 
 DEFINE_bool(json, true, "Output in json form");
 
 namespace {
+/*
+ * Reports the total warm boot exit time, along with the times of the
+ * individual phases of saving and restoring the warm boot state.
+ */
 class StopWatch {
  public:
-  StopWatch() : startTime_(std::chrono::steady_clock::now()) {}
+  explicit StopWatch(folly::dynamic phaseMsecs)
+      : startTime_(std::chrono::steady_clock::now()),
+        phaseMsecs_(std::move(phaseMsecs)) {}
   ~StopWatch() {
     std::chrono::duration<double, std::milli> durationMillseconds =
         std::chrono::steady_clock::now() - startTime_;
     if (FLAGS_json) {
       folly::dynamic warmBootTime = folly::dynamic::object;
       warmBootTime["warm_boot_msecs"] = durationMillseconds.count();
+      warmBootTime.update(phaseMsecs_);
       std::cout << warmBootTime << std::endl;
     } else {
       XLOG(INFO) << " warm boot msecs: " << durationMillseconds.count();
+      for (const auto& phase : phaseMsecs_.items()) {
+        XLOG(INFO) << " " << phase.first.asString() << ": "
+                   << phase.second.asDouble();
+      }
     }
   }
 
  private:
   std::chrono::time_point<std::chrono::steady_clock> startTime_;
+  folly::dynamic phaseMsecs_;
 };
+
+template <typename Fn>
+double timeMsecs(Fn fn) {
+  auto begin = std::chrono::steady_clock::now();
+  fn();
+  std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - begin;
+  return duration.count();
+}
 } // namespace
 namespace facebook::fboss {
 
+/*
+ * Time each phase of a warm boot state round trip separately: building the
+ * state, serializing it, writing and reading the file back, and parsing it.
+ * Uses the format chosen by --binary_warm_boot_state, and a scratch file next
+ * to the real warm boot state file.
+ */
+folly::dynamic measureWarmBootStatePhases(HwSwitchEnsemble* ensemble) {
+  folly::dynamic phaseMsecs = folly::dynamic::object;
+  folly::dynamic switchState = folly::dynamic::object;
+  phaseMsecs["state_to_dynamic_msecs"] = timeMsecs([&] {
+    switchState[kSwSwitch] = ensemble->getProgrammedState()->toFollyDynamic();
+    switchState[kHwSwitch] = ensemble->getHwSwitch()->toFollyDynamic();
+  });
+  std::string serialized;
+  phaseMsecs["serialize_msecs"] = timeMsecs([&] {
+    serialized = HwSwitchWarmBootHelper::serializeWarmBootState(switchState);
+  });
+  phaseMsecs["serialized_bytes"] = serialized.size();
+
+  auto scratchFile =
+      ensemble->getPlatform()->getWarmBootDir() + "/warm_boot_exit_benchmark";
+  phaseMsecs["write_msecs"] = timeMsecs([&] {
+    if (!folly::writeFile(serialized, scratchFile.c_str())) {
+      throw SysError(errno, "Unable to write ", scratchFile);
+    }
+  });
+  std::string readBack;
+  phaseMsecs["read_msecs"] = timeMsecs([&] {
+    auto ret = folly::readFile(scratchFile.c_str(), readBack);
+    sysCheckError(ret, "Unable to read ", scratchFile);
+  });
+  folly::dynamic parsed;
+  phaseMsecs["parse_msecs"] = timeMsecs([&] {
+    parsed = HwSwitchWarmBootHelper::deserializeWarmBootState(readBack);
+  });
+  CHECK(parsed.count(kSwSwitch));
+  unlink(scratchFile.c_str());
+  return phaseMsecs;
+}
+
 void runBenchmark() {
   auto ensemble = createHwEnsemble(HwSwitchEnsemble::getAllFeatures());
   auto hwSwitch = ensemble->getHwSwitch();
@@ -92,11 +159,11 @@ void runBenchmark() {
                   .back();
   }
   ensemble->applyNewState(toApply);
-  // Static such that the object destructor runs as late as possible. In
+  auto phaseMsecs = measureWarmBootStatePhases(ensemble.get());
   // Static such that the object destructor runs as late as possible. In
   // particular in this case, destructor (and thus the duration calculation)
   // will run at the time of program exit when static variable destructors run
-  static StopWatch timer;
+  static StopWatch timer(std::move(phaseMsecs));
   ensemble->gracefulExit();
   // Leak HwSwitchEnsemble for warmboot, so that
   // we don't run destructors and unprogram h/w. We are
@@ -21,6 +21,7 @@
 #include <folly/logging/xlog.h>
 
 #include <iterator>
+#include <vector>
 
 extern "C" {
 #include <sai.h>
@@ -119,6 +120,24 @@ class RouteApi : public SaiApi<RouteApi> {
   sai_status_t _remove(const SaiRouteTraits::RouteEntry& routeEntry) {
     return api_->remove_route_entry(routeEntry.entry());
   }
+  sai_status_t _bulkCreate(
+      const std::vector<SaiRouteTraits::RouteEntry>& routeEntries,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_bulk_op_error_mode_t mode,
+      sai_status_t* statuses) {
+    auto entries = saiRouteEntries(routeEntries);
+    return api_->create_route_entries(
+        entries.size(), entries.data(), attrCounts, attrLists, mode, statuses);
+  }
+  sai_status_t _bulkRemove(
+      const std::vector<SaiRouteTraits::RouteEntry>& routeEntries,
+      sai_bulk_op_error_mode_t mode,
+      sai_status_t* statuses) {
+    auto entries = saiRouteEntries(routeEntries);
+    return api_->remove_route_entries(
+        entries.size(), entries.data(), mode, statuses);
+  }
   sai_status_t _getAttribute(
       const SaiRouteTraits::RouteEntry& routeEntry,
       sai_attribute_t* attr) const {
@@ -130,6 +149,16 @@ class RouteApi : public SaiApi<RouteApi> {
     return api_->set_route_entry_attribute(routeEntry.entry(), attr);
   }
 
+  static std::vector<sai_route_entry_t> saiRouteEntries(
+      const std::vector<SaiRouteTraits::RouteEntry>& routeEntries) {
+    std::vector<sai_route_entry_t> entries;
+    entries.reserve(routeEntries.size());
+    for (const auto& routeEntry : routeEntries) {
+      entries.push_back(*routeEntry.entry());
+    }
+    return entries;
+  }
+
   sai_route_api_t* api_;
   friend class SaiApi<RouteApi>;
 };
@@ -67,7 +67,7 @@ class SaiApi {
         "invalid traits for the api");
     typename SaiObjectTraits::AdapterKey key;
     std::vector<sai_attribute_t> saiAttributeTs = saiAttrs(createAttributes);
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = lockApi();
     sai_status_t status = impl()._create(
         &key, switch_id, saiAttributeTs.size(), saiAttributeTs.data());
     saiApiCheckError(
@@ -89,7 +89,7 @@ class SaiApi {
         std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
         "invalid traits for the api");
     std::vector<sai_attribute_t> saiAttributeTs = saiAttrs(createAttributes);
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = lockApi();
     sai_status_t status =
         impl()._create(entry, saiAttributeTs.size(), saiAttributeTs.data());
     saiApiCheckError(
@@ -102,7 +102,7 @@ class SaiApi {
 
   template <typename AdapterKeyT>
   void remove(const AdapterKeyT& key) {
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = lockApi();
     sai_status_t status = impl()._remove(key);
     saiApiCheckError(
         status,
@@ -111,6 +111,63 @@ class SaiApi {
     XLOGF(DBG5, "removed SAI object: {}", key);
   }
 
+  /*
+   * Bulk create and remove, for objects keyed by an entry struct whose api
+   * implements _bulkCreate/_bulkRemove. The adapter processes every object
+   * even if some fail, and the status of each object is returned rather than
+   * thrown, so that callers can tell which objects were programmed. Errors
+   * of the bulk call as a whole (e.g. bulk not supported) are thrown.
+   */
+  template <typename SaiObjectTraits>
+  std::enable_if_t<
+      AdapterKeyIsEntryStruct<SaiObjectTraits>::value,
+      std::vector<sai_status_t>>
+  bulkCreate(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& entries,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes) {
+    static_assert(
+        std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
+        "invalid traits for the api");
+    CHECK_EQ(entries.size(), createAttributes.size());
+    std::vector<std::vector<sai_attribute_t>> saiAttributeTs;
+    saiAttributeTs.reserve(entries.size());
+    for (const auto& attributes : createAttributes) {
+      saiAttributeTs.push_back(saiAttrs(attributes));
+    }
+    std::vector<uint32_t> attrCounts;
+    std::vector<const sai_attribute_t*> attrLists;
+    attrCounts.reserve(entries.size());
+    attrLists.reserve(entries.size());
+    for (const auto& attrs : saiAttributeTs) {
+      attrCounts.push_back(attrs.size());
+      attrLists.push_back(attrs.data());
+    }
+    std::vector<sai_status_t> statuses(
+        entries.size(), SAI_STATUS_NOT_EXECUTED);
+    auto g = lockApi();
+    sai_status_t status = impl()._bulkCreate(
+        entries,
+        attrCounts.data(),
+        attrLists.data(),
+        SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+        statuses.data());
+    checkBulkError(status, "create");
+    XLOGF(DBG5, "bulk created {} SAI objects", entries.size());
+    return statuses;
+  }
+
+  template <typename AdapterKeyT>
+  std::vector<sai_status_t> bulkRemove(const std::vector<AdapterKeyT>& keys) {
+    std::vector<sai_status_t> statuses(keys.size(), SAI_STATUS_NOT_EXECUTED);
+    auto g = lockApi();
+    sai_status_t status = impl()._bulkRemove(
+        keys, SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+    checkBulkError(status, "remove");
+    XLOGF(DBG5, "bulk removed {} SAI objects", keys.size());
+    return statuses;
+  }
+
   /*
    * We can do getAttribute on top of more complicated types than just
    * attributes. For example, if we overload on tuples and optionals, we
@@ -132,7 +189,7 @@ class SaiApi {
         IsSaiAttribute<typename std::remove_reference<AttrT>::type>::value,
         "getAttribute must be called on a SaiAttribute or supported "
         "collection of SaiAttributes");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = lockApi();
     sai_status_t status;
     status = impl()._getAttribute(key, attr.saiAttr());
     /*
@@ -220,7 +277,7 @@ class SaiApi {
   }
   template <typename AdapterKeyT, typename AttrT>
   void setAttribute(const AdapterKeyT& key, const AttrT& attr) {
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = lockApi();
     setAttributeUnlocked(key, attr);
   }
 
@@ -232,7 +289,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = lockStats();
     return getStatsImpl<SaiObjectTraits>(
         key, counterIds.data(), counterIds.size(), mode);
   }
@@ -243,7 +300,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = lockStats();
     XLOGF(DBG6, "got SAI stats for {}", key);
     return mode == SAI_STATS_MODE_READ
         ? getStatsImpl<SaiObjectTraits>(
@@ -265,7 +322,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = lockApi();
     clearStatsImpl<SaiObjectTraits>(key, counterIds.data(), counterIds.size());
   }
   template <typename SaiObjectTraits>
@@ -273,7 +330,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = lockApi();
     clearStatsImpl<SaiObjectTraits>(
         key,
         SaiObjectTraits::CounterIdsToRead.data(),
@@ -285,6 +342,26 @@ class SaiApi {
   }
 
  private:
+  void checkBulkError(sai_status_t status, folly::StringPiece op) const {
+    // SAI_STATUS_FAILURE only means that some of the objects failed, which
+    // the caller learns from the per object statuses
+    if (status != SAI_STATUS_FAILURE) {
+      saiApiCheckError(
+          status, ApiT::ApiType, fmt::format("Failed to bulk {}", op));
+    }
+  }
+  std::unique_lock<std::mutex> lockApi() const {
+    return std::unique_lock<std::mutex>{
+        SaiApiLock::getInstance()->getLock(ApiT::ApiType)};
+  }
+  std::unique_lock<std::mutex> lockStats() const {
+    auto apiLock = SaiApiLock::getInstance();
+    if (apiLock->isStatsLockFree()) {
+      return std::unique_lock<std::mutex>{};
+    }
+    return std::unique_lock<std::mutex>{apiLock->getLock(ApiT::ApiType)};
+  }
+
   template <typename SaiObjectTraits>
   std::vector<uint64_t> getStatsImpl(
       const typename SaiObjectTraits::AdapterKey& key,
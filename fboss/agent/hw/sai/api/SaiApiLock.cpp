@@ -21,3 +21,31 @@ static folly::Singleton<SaiApiLock, singleton_tag_type> saiApiLockSingleton{};
 std::shared_ptr<SaiApiLock> SaiApiLock::getInstance() {
   return saiApiLockSingleton.try_get();
 }
+
+SaiApiLock::LockDomain SaiApiLock::getLockDomain(sai_api_t api) {
+  switch (api) {
+    case SAI_API_SWITCH:
+    case SAI_API_PORT:
+    case SAI_API_QUEUE:
+    case SAI_API_SCHEDULER:
+    case SAI_API_BUFFER:
+    case SAI_API_QOS_MAP:
+    case SAI_API_HOSTIF:
+      return LockDomain::SWITCH;
+    case SAI_API_ROUTE:
+    case SAI_API_NEXT_HOP:
+    case SAI_API_NEXT_HOP_GROUP:
+    case SAI_API_NEIGHBOR:
+    case SAI_API_FDB:
+    case SAI_API_ROUTER_INTERFACE:
+    case SAI_API_VIRTUAL_ROUTER:
+    case SAI_API_MPLS:
+    case SAI_API_VLAN:
+    case SAI_API_BRIDGE:
+      return LockDomain::FORWARDING;
+    case SAI_API_ACL:
+      return LockDomain::ACL;
+    default:
+      return LockDomain::OTHER;
+  }
+}
@@ -9,11 +9,69 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 
+extern "C" {
+#include <sai.h>
+}
+
+/*
+ * SaiApiLock serializes calls into the SAI adapter.
+ *
+ * Rather than one lock for the whole adapter, SAI apis are grouped into lock
+ * domains, each with its own mutex, so that e.g. stats collection on ports
+ * doesn't block route programming. Apis whose objects reference each other
+ * share a domain: the switch with its ports, queues, buffers and schedulers;
+ * routes with the next hops, next hop groups, neighbors, router interfaces,
+ * virtual routers, VLANs and bridge ports they resolve through.
+ *
+ * A few references still cross domains, e.g. router interfaces and bridge
+ * ports reference ports, and ACL entries reference queues. This requires the
+ * adapter to be thread safe for concurrent calls to apis of different
+ * domains. The agent only references objects which already exist, and
+ * removes them after the objects referencing them, so such calls never race
+ * on the lifetime of an object.
+ *
+ * Lock ordering: every SaiApi call holds exactly one domain lock for its
+ * duration, and never calls another api while holding it. Code that needs
+ * to hold more than one domain lock at once must acquire them in increasing
+ * LockDomain order.
+ */
 class SaiApiLock {
  public:
+  enum class LockDomain : uint8_t {
+    SWITCH,
+    FORWARDING,
+    ACL,
+    OTHER,
+  };
+  static constexpr size_t kNumLockDomains =
+      static_cast<size_t>(LockDomain::OTHER) + 1;
+
   static std::shared_ptr<SaiApiLock> getInstance();
-  std::mutex lock;
+
+  static LockDomain getLockDomain(sai_api_t api);
+
+  std::mutex& getLock(sai_api_t api) {
+    return locks_[static_cast<size_t>(getLockDomain(api))];
+  }
+
+  /*
+   * Some adapters allow reading counters concurrently with any other
+   * operation. When enabled, getStats() calls skip the domain lock.
+   */
+  bool isStatsLockFree() const {
+    return statsLockFree_.load(std::memory_order_relaxed);
+  }
+  void setStatsLockFree(bool lockFree) {
+    statsLockFree_.store(lockFree, std::memory_order_relaxed);
+  }
+
+ private:
+  std::array<std::mutex, kNumLockDomains> locks_;
+  std::atomic<bool> statsLockFree_{false};
 };
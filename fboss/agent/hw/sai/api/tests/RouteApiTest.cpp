@@ -174,6 +174,34 @@ TEST_F(RouteApiTest, routeKeys) {
   EXPECT_EQ(routeKeys[0], r);
 }
 
+TEST_F(RouteApiTest, bulkCreateRemove) {
+  std::vector<SaiRouteTraits::RouteEntry> routes;
+  std::vector<SaiRouteTraits::CreateAttributes> attributes;
+  for (auto mask : {8, 16, 24}) {
+    routes.emplace_back(0, 0, folly::CIDRNetwork(ip4, mask));
+    attributes.push_back(
+        {SAI_PACKET_ACTION_FORWARD,
+         SaiRouteTraits::Attributes::NextHopId(mask),
+         std::nullopt});
+  }
+  auto statuses = routeApi->bulkCreate<SaiRouteTraits>(routes, attributes);
+  EXPECT_EQ(statuses, std::vector<sai_status_t>(3, SAI_STATUS_SUCCESS));
+  for (const auto& r : routes) {
+    EXPECT_EQ(
+        routeApi->getAttribute(r, SaiRouteTraits::Attributes::NextHopId()),
+        r.destination().second);
+  }
+  // Removing a route twice fails for that route only
+  std::vector<SaiRouteTraits::RouteEntry> toRemove{routes[0], routes[0]};
+  statuses = routeApi->bulkRemove(toRemove);
+  EXPECT_EQ(statuses[0], SAI_STATUS_SUCCESS);
+  EXPECT_NE(statuses[1], SAI_STATUS_SUCCESS);
+  statuses = routeApi->bulkRemove(
+      std::vector<SaiRouteTraits::RouteEntry>{routes[1], routes[2]});
+  EXPECT_EQ(statuses, std::vector<sai_status_t>(2, SAI_STATUS_SUCCESS));
+  EXPECT_TRUE(getObjectKeys<SaiRouteTraits>(0).empty());
+}
+
 TEST_F(RouteApiTest, formatRouteNextHopId) {
   SaiRouteTraits::Attributes::NextHopId nhid{42};
   std::string expected("NextHopId: 42");
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "common/init/Init.h"
+#include "fboss/agent/hw/sai/api/PortApi.h"
+#include "fboss/agent/hw/sai/api/RouteApi.h"
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddress.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr auto kNumPollers = 2;
+const PortSaiId kPortId{42};
+
+SaiRouteTraits::RouteEntry routeEntry(uint32_t i) {
+  folly::CIDRNetwork prefix(
+      folly::IPAddressV4::fromLongHBO(0x0a000000 + (i << 8)), 24);
+  return SaiRouteTraits::RouteEntry(0, 0, prefix);
+}
+
+/*
+ * Add and then remove `iters` routes, while optionally polling port stats
+ * from other threads the way stats collection does. Route programming and
+ * port stats are in different SAI lock domains, so polling should only cost
+ * route programming the contention on the adapter itself.
+ */
+void runRouteChurn(unsigned iters, bool pollStats, bool lockFreeStats) {
+  folly::BenchmarkSuspender suspender;
+  auto fs = FakeSai::getInstance();
+  sai_api_initialize(0, nullptr);
+  RouteApi routeApi;
+  PortApi portApi;
+  SaiApiLock::getInstance()->setStatsLockFree(lockFreeStats);
+
+  std::atomic<bool> done{false};
+  std::vector<std::thread> pollers;
+  if (pollStats) {
+    for (auto i = 0; i < kNumPollers; ++i) {
+      pollers.emplace_back([&portApi, &done] {
+        while (!done.load(std::memory_order_relaxed)) {
+          folly::doNotOptimizeAway(
+              portApi.getStats<SaiPortTraits>(kPortId, SAI_STATS_MODE_READ));
+        }
+      });
+    }
+  }
+  suspender.dismiss();
+
+  SaiRouteTraits::Attributes::PacketAction packetAction{
+      SAI_PACKET_ACTION_FORWARD};
+  SaiRouteTraits::Attributes::NextHopId nextHopId(5);
+  for (uint32_t i = 0; i < iters; ++i) {
+    routeApi.create<SaiRouteTraits>(
+        routeEntry(i), {packetAction, nextHopId, std::nullopt});
+  }
+  for (uint32_t i = 0; i < iters; ++i) {
+    routeApi.remove(routeEntry(i));
+  }
+
+  suspender.rehire();
+  done = true;
+  for (auto& poller : pollers) {
+    poller.join();
+  }
+  SaiApiLock::getInstance()->setStatsLockFree(false);
+  FakeSai::clear();
+}
+
+} // namespace
+
+BENCHMARK(SaiRouteChurn, iters) {
+  runRouteChurn(iters, false, false);
+}
+
+BENCHMARK_RELATIVE(SaiRouteChurnWithStatsPolling, iters) {
+  runRouteChurn(iters, true, false);
+}
+
+BENCHMARK_RELATIVE(SaiRouteChurnWithLockFreeStatsPolling, iters) {
+  runRouteChurn(iters, true, true);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
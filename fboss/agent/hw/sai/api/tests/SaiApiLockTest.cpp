@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
+#include "fboss/agent/hw/sai/api/RouteApi.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+
+#include <folly/IPAddress.h>
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+
+using namespace facebook::fboss;
+
+TEST(SaiApiLockTest, lockDomains) {
+  auto apiLock = SaiApiLock::getInstance();
+  EXPECT_EQ(
+      apiLock->getLockDomain(SAI_API_PORT),
+      apiLock->getLockDomain(SAI_API_SWITCH));
+  EXPECT_EQ(
+      apiLock->getLockDomain(SAI_API_PORT),
+      apiLock->getLockDomain(SAI_API_QUEUE));
+  // Routes and everything they resolve through
+  for (auto api :
+       {SAI_API_NEXT_HOP,
+        SAI_API_NEXT_HOP_GROUP,
+        SAI_API_NEIGHBOR,
+        SAI_API_FDB,
+        SAI_API_ROUTER_INTERFACE,
+        SAI_API_VIRTUAL_ROUTER}) {
+    EXPECT_EQ(
+        apiLock->getLockDomain(SAI_API_ROUTE), apiLock->getLockDomain(api));
+  }
+  EXPECT_NE(
+      apiLock->getLockDomain(SAI_API_PORT),
+      apiLock->getLockDomain(SAI_API_ROUTE));
+  EXPECT_NE(&apiLock->getLock(SAI_API_PORT), &apiLock->getLock(SAI_API_ROUTE));
+  EXPECT_EQ(&apiLock->getLock(SAI_API_PORT), &apiLock->getLock(SAI_API_QUEUE));
+}
+
+TEST(SaiApiLockTest, routeProgrammingWhilePortsLocked) {
+  auto fs = FakeSai::getInstance();
+  sai_api_initialize(0, nullptr);
+  RouteApi routeApi;
+  // Stats collection holding the port lock must not block route programming
+  std::lock_guard<std::mutex> g{
+      SaiApiLock::getInstance()->getLock(SAI_API_PORT)};
+  folly::CIDRNetwork prefix(folly::IPAddress("42.42.12.0"), 24);
+  SaiRouteTraits::RouteEntry r(0, 0, prefix);
+  SaiRouteTraits::Attributes::PacketAction packetAction{SAI_PACKET_ACTION_DROP};
+  routeApi.create<SaiRouteTraits>(
+      r, {packetAction, std::nullopt, std::nullopt});
+  EXPECT_EQ(
+      routeApi.getAttribute(r, SaiRouteTraits::Attributes::PacketAction()),
+      SAI_PACKET_ACTION_DROP);
+  routeApi.remove(r);
+}
@@ -70,6 +70,54 @@ sai_status_t remove_route_entry_fn(const sai_route_entry_t* route_entry) {
   return SAI_STATUS_SUCCESS;
 }
 
+/*
+ * Bulk apis just program each entry in turn. With
+ * SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, entries after the first failure are
+ * left as SAI_STATUS_NOT_EXECUTED.
+ */
+sai_status_t create_route_entries_fn(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  auto status = SAI_STATUS_SUCCESS;
+  for (auto i = 0; i < object_count; ++i) {
+    if (status != SAI_STATUS_SUCCESS &&
+        mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+      object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+      continue;
+    }
+    object_statuses[i] =
+        create_route_entry_fn(&route_entry[i], attr_count[i], attr_list[i]);
+    if (object_statuses[i] != SAI_STATUS_SUCCESS) {
+      status = SAI_STATUS_FAILURE;
+    }
+  }
+  return status;
+}
+
+sai_status_t remove_route_entries_fn(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  auto status = SAI_STATUS_SUCCESS;
+  for (auto i = 0; i < object_count; ++i) {
+    if (status != SAI_STATUS_SUCCESS &&
+        mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+      object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+      continue;
+    }
+    object_statuses[i] = remove_route_entry_fn(&route_entry[i]);
+    if (object_statuses[i] != SAI_STATUS_SUCCESS) {
+      status = SAI_STATUS_FAILURE;
+    }
+  }
+  return status;
+}
+
 sai_status_t get_route_entry_attribute_fn(
     const sai_route_entry_t* route_entry,
     uint32_t attr_count,
@@ -107,6 +155,8 @@ void populate_route_api(sai_route_api_t** route_api) {
   _route_api.remove_route_entry = &remove_route_entry_fn;
   _route_api.set_route_entry_attribute = &set_route_entry_attribute_fn;
   _route_api.get_route_entry_attribute = &get_route_entry_attribute_fn;
+  _route_api.create_route_entries = &create_route_entries_fn;
+  _route_api.remove_route_entries = &remove_route_entries_fn;
   *route_api = &_route_api;
 }
 
@@ -47,8 +47,8 @@ void checkSwHwAclMatch(
       aclTableManager.getAclEntryHandle(aclTableHandle, swAcl->getPriority());
   auto aclEntryId = aclEntryHandle->aclEntry->adapterKey();
 
-  auto aclFieldPriorityExpected =
-      aclTableManager.swPriorityToSaiPriority(swAcl->getPriority());
+  auto aclFieldPriorityExpected = GET_OPT_ATTR(
+      AclEntry, Priority, aclEntryHandle->aclEntry->attributes());
   auto aclFieldPriorityGot = SaiApiTable::getInstance()->aclApi().getAttribute(
       aclEntryId, SaiAclEntryTraits::Attributes::Priority());
   EXPECT_EQ(aclFieldPriorityGot, aclFieldPriorityExpected);
@@ -116,7 +116,7 @@ std::map<PortID, HwPortStats> SaiSwitchEnsemble::getLatestPortStats(
   SwitchStats dummy{};
   getHwSwitch()->updateStats(&dummy);
   auto allPortStats =
-      getHwSwitch()->managerTable()->portManager().getPortStats();
+      getHwSwitch()->managerTable()->portManager().getPublishedPortStats();
   boost::container::flat_set<PortID> portIds(ports.begin(), ports.end());
   return folly::gen::from(allPortStats) |
       folly::gen::filter([&portIds](const auto& portIdAndStat) {
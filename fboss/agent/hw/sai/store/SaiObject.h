@@ -153,6 +153,9 @@ typename std::
 
 } // namespace detail
 
+// Tag for constructing a SaiObject for an object already in the adapter
+struct AlreadyCreated {};
+
 /*
  * SaiObject is a generic object which manages an object in the SAI adapter.
  *
@@ -226,6 +229,18 @@ class SaiObject {
     live_ = true;
   }
 
+  // Take ownership of an object that was already created in the adapter with
+  // the given attributes, e.g. by a bulk create.
+  SaiObject(
+      const typename SaiObjectTraits::AdapterKey& adapterKey,
+      const typename SaiObjectTraits::AdapterHostKey& adapterHostKey,
+      const typename SaiObjectTraits::CreateAttributes& attributes,
+      AlreadyCreated /*tag*/)
+      : live_(true),
+        adapterKey_(adapterKey),
+        adapterHostKey_(adapterHostKey),
+        attributes_(attributes) {}
+
   // Forbid copy construction and copy assignment
   SaiObject(const SaiObject& other) = delete;
   SaiObject& operator=(const SaiObject& other) = delete;
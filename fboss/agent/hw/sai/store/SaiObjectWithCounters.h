@@ -60,6 +60,18 @@ class SaiObjectWithCounters : public SaiObject<SaiObjectTraits> {
     fillInStats(counterIds.data(), counters);
   }
 
+  /*
+   * Store counters read without going through this object, e.g. by
+   * collectStats. counters are for counterIds, in order.
+   */
+  template <typename T = SaiObjectTraits>
+  void setStats(
+      const sai_stat_id_t* counterIds,
+      const std::vector<uint64_t>& counters) {
+    static_assert(SaiObjectHasStats<T>::value, "invalid traits for the api");
+    fillInStats(counterIds, counters);
+  }
+
   template <typename T = SaiObjectTraits>
   const StatsMap getStats() const {
     static_assert(SaiObjectHasStats<T>::value, "invalid traits for the api");
@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 extern "C" {
 #include <sai.h>
@@ -166,6 +167,66 @@ class SaiObjectStore {
     return object;
   }
 
+  /*
+   * Bulk version of setObject() for objects keyed by an entry struct, such as
+   * routes. Objects not yet in the store are created in the adapter with a
+   * single bulk call, while existing objects have their attributes updated
+   * one at a time. Returns the object for each key, in order, or nullptr for
+   * objects the adapter failed to create.
+   */
+  std::vector<std::shared_ptr<ObjectType>> setObjects(
+      const std::vector<typename SaiObjectTraits::AdapterHostKey>&
+          adapterHostKeys,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          attributes) {
+    static_assert(
+        AdapterKeyIsEntryStruct<SaiObjectTraits>::value &&
+            !SaiObjectHasStats<SaiObjectTraits>::value &&
+            !IsObjectPublisher<SaiObjectTraits>::value,
+        "bulk set only supported for entry objects without stats or "
+        "subscribers");
+    CHECK_EQ(adapterHostKeys.size(), attributes.size());
+    std::vector<std::shared_ptr<ObjectType>> objects(adapterHostKeys.size());
+    std::vector<size_t> created;
+    std::vector<typename SaiObjectTraits::AdapterKey> createKeys;
+    std::vector<typename SaiObjectTraits::CreateAttributes> createAttributes;
+    for (size_t i = 0; i < adapterHostKeys.size(); ++i) {
+      if (objects_.ref(adapterHostKeys[i])) {
+        objects[i] = setObject(adapterHostKeys[i], attributes[i]);
+        continue;
+      }
+      created.push_back(i);
+      createKeys.push_back(adapterHostKeys[i]);
+      createAttributes.push_back(attributes[i]);
+    }
+    if (createKeys.empty()) {
+      return objects;
+    }
+    auto& api =
+        SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
+    auto statuses = api.template bulkCreate<SaiObjectTraits>(
+        createKeys, createAttributes);
+    for (size_t j = 0; j < created.size(); ++j) {
+      if (statuses[j] != SAI_STATUS_SUCCESS) {
+        XLOGF(
+            ERR,
+            "SaiStore failed to bulk create {}: {}",
+            createKeys[j],
+            saiStatusToString(statuses[j]));
+        continue;
+      }
+      auto ins = objects_.refOrEmplace(
+          createKeys[j],
+          createKeys[j],
+          createKeys[j],
+          createAttributes[j],
+          AlreadyCreated{});
+      objects[created[j]] = ins.first;
+    }
+    XLOGF(DBG5, "SaiStore bulk set {} objects", adapterHostKeys.size());
+    return objects;
+  }
+
   std::shared_ptr<ObjectType> get(
       const typename SaiObjectTraits::AdapterHostKey& adapterHostKey) {
     XLOGF(DBG5, "SaiStore get object {}", adapterHostKey);
@@ -21,8 +21,75 @@
 
 #include <folly/MacAddress.h>
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
 namespace facebook::fboss {
 
+namespace {
+
+/*
+ * SAI priorities left between ACL entries by default, so that ACLs inserted
+ * between others later can be placed without moving them.
+ */
+constexpr int64_t kAclEntryPriorityGap = 16;
+
+sai_uint32_t getSaiPriority(const SaiAclEntryHandle& aclEntryHandle) {
+  return GET_OPT_ATTR(
+      AclEntry, Priority, aclEntryHandle.aclEntry->attributes());
+}
+
+template <typename... ActionTs>
+struct AclEntryActions {
+  // Whether any action set in `from` is not set in `to`
+  static bool anyCleared(
+      const SaiAclEntryTraits::CreateAttributes& from,
+      const SaiAclEntryTraits::CreateAttributes& to) {
+    return (
+        (std::get<std::optional<ActionTs>>(from).has_value() &&
+         !std::get<std::optional<ActionTs>>(to).has_value()) ||
+        ...);
+  }
+
+  static void copy(
+      const SaiAclEntryTraits::CreateAttributes& from,
+      SaiAclEntryTraits::CreateAttributes* to) {
+    ((std::get<std::optional<ActionTs>>(*to) =
+          std::get<std::optional<ActionTs>>(from)),
+     ...);
+  }
+};
+
+using AllAclEntryActions = AclEntryActions<
+    SaiAclEntryTraits::Attributes::ActionPacketAction,
+    SaiAclEntryTraits::Attributes::ActionCounter,
+    SaiAclEntryTraits::Attributes::ActionSetTC,
+    SaiAclEntryTraits::Attributes::ActionSetDSCP,
+    SaiAclEntryTraits::Attributes::ActionMirrorIngress,
+    SaiAclEntryTraits::Attributes::ActionMirrorEgress>;
+
+/*
+ * An entry can be changed by setting attributes if it keeps its table,
+ * priority and fields. SaiObject can not unset an attribute, so it must
+ * also keep all of its actions.
+ */
+bool canUpdateAclEntryInPlace(
+    const SaiAclEntryTraits::CreateAttributes& current,
+    const SaiAclEntryTraits::CreateAttributes& desired) {
+  if (AllAclEntryActions::anyCleared(current, desired)) {
+    return false;
+  }
+  auto withCurrentActions = desired;
+  AllAclEntryActions::copy(current, &withCurrentActions);
+  return withCurrentActions == current;
+}
+
+} // namespace
+
 SaiAclTableManager::SaiAclTableManager(
     SaiManagerTable* managerTable,
     const SaiPlatform* platform)
@@ -355,7 +422,9 @@ SaiAclTableHandle* FOLLY_NULLABLE SaiAclTableManager::getAclTableHandleImpl(
   return itr->second.get();
 }
 
-sai_uint32_t SaiAclTableManager::swPriorityToSaiPriority(int priority) const {
+std::pair<int64_t, int64_t> SaiAclTableManager::saiPriorityGap(
+    const SaiAclTableHandle* aclTableHandle,
+    int priority) const {
   /*
    * TODO(skhare)
    * When adding HwAclPriorityTests, add a test to verify that SAI
@@ -367,19 +436,243 @@ sai_uint32_t SaiAclTableManager::swPriorityToSaiPriority(int priority) const {
    * SAI spec: does not define?
    * But larger priority means higher priority is documented here:
    * https://github.com/opencomputeproject/SAI/blob/master/doc/SAI-Proposal-ACL-1.md
+   *
+   * So an entry at the given SW priority must have a SAI priority strictly
+   * between those of the entries right after and right before it. Returns
+   * those exclusive bounds, ignoring any entry at the priority itself.
+   */
+  int64_t low = static_cast<int64_t>(aclEntryMinimumPriority_) - 1;
+  int64_t high = static_cast<int64_t>(aclEntryMaximumPriority_) + 1;
+  const auto& members = aclTableHandle->aclTableMembers;
+  auto next = members.upper_bound(priority);
+  if (next != members.end()) {
+    low = getSaiPriority(*next->second);
+  }
+  auto prev = members.lower_bound(priority);
+  if (prev != members.begin()) {
+    high = getSaiPriority(*std::prev(prev)->second);
+  }
+  return std::make_pair(low, high);
+}
+
+std::vector<std::shared_ptr<SaiAclEntry>>
+SaiAclTableManager::unclaimedAclEntries(
+    const SaiAclTableHandle* aclTableHandle,
+    const std::vector<sai_uint32_t>& inUseSaiPriorities) const {
+  std::vector<std::shared_ptr<SaiAclEntry>> aclEntries;
+  auto& aclEntryStore = SaiStore::getInstance()->get<SaiAclEntryTraits>();
+  size_t numClaimed = inUseSaiPriorities.size();
+  for (const auto& nameAndHandle : handles_) {
+    numClaimed += nameAndHandle.second->aclTableMembers.size() +
+        nameAndHandle.second->displacedAclEntries.size();
+  }
+  // Only entries reloaded at warm boot can be unclaimed
+  if (aclEntryStore.objects().size() <= numClaimed) {
+    return aclEntries;
+  }
+
+  std::unordered_set<sai_uint32_t> claimed(
+      inUseSaiPriorities.begin(), inUseSaiPriorities.end());
+  for (const auto& priorityAndHandle : aclTableHandle->aclTableMembers) {
+    claimed.insert(getSaiPriority(*priorityAndHandle.second));
+  }
+  for (const auto& nameAndHandle : aclTableHandle->displacedAclEntries) {
+    claimed.insert(getSaiPriority(*nameAndHandle.second));
+  }
+  for (const auto& hostKeyAndObject : aclEntryStore) {
+    auto aclEntry = hostKeyAndObject.second.lock();
+    if (!aclEntry ||
+        GET_ATTR(AclEntry, TableId, aclEntry->attributes()) !=
+            aclTableHandle->aclTable->adapterKey()) {
+      continue;
+    }
+    if (claimed.find(GET_OPT_ATTR(
+            AclEntry, Priority, aclEntry->attributes())) == claimed.end()) {
+      aclEntries.push_back(std::move(aclEntry));
+    }
+  }
+  return aclEntries;
+}
+
+std::optional<sai_uint32_t> SaiAclTableManager::allocateSaiPriority(
+    const SaiAclTableHandle* aclTableHandle,
+    int priority,
+    const SaiAclEntryTraits::CreateAttributes& attributes,
+    const std::vector<sai_uint32_t>& inUseSaiPriorities) const {
+  int64_t low, high;
+  std::tie(low, high) = saiPriorityGap(aclTableHandle, priority);
+
+  // Priorities in the gap still held by displaced or replaced entries
+  std::vector<int64_t> taken;
+  for (const auto& nameAndHandle : aclTableHandle->displacedAclEntries) {
+    taken.push_back(getSaiPriority(*nameAndHandle.second));
+  }
+  taken.insert(
+      taken.end(), inUseSaiPriorities.begin(), inUseSaiPriorities.end());
+
+  /*
+   * Keep an entry found at warm boot where it is, if it matches the same
+   * packets as the ACL and is still in order. Other such entries are left
+   * alone rather than rewritten to match different packets, and are removed
+   * once warm boot completes.
+   */
+  for (const auto& aclEntry :
+       unclaimedAclEntries(aclTableHandle, inUseSaiPriorities)) {
+    int64_t saiPriority =
+        GET_OPT_ATTR(AclEntry, Priority, aclEntry->attributes());
+    if (saiPriority <= low || high <= saiPriority) {
+      continue;
+    }
+    auto adoptedAttributes = attributes;
+    std::get<std::optional<SaiAclEntryTraits::Attributes::Priority>>(
+        adoptedAttributes) = SaiAclEntryTraits::Attributes::Priority{
+        static_cast<sai_uint32_t>(saiPriority)};
+    if (canUpdateAclEntryInPlace(aclEntry->attributes(), adoptedAttributes)) {
+      return saiPriority;
+    }
+    taken.push_back(saiPriority);
+  }
+  auto isFree = [&](int64_t saiPriority) {
+    return low < saiPriority && saiPriority < high &&
+        std::find(taken.begin(), taken.end(), saiPriority) == taken.end();
+  };
+
+  // By default entries are kAclEntryPriorityGap apart, leaving room for
+  // ACLs inserted later
+  auto spreadPriority = static_cast<int64_t>(aclEntryMaximumPriority_) -
+      kAclEntryPriorityGap * priority;
+  if (isFree(spreadPriority)) {
+    return spreadPriority;
+  }
+  auto densePriority =
+      static_cast<int64_t>(aclEntryMaximumPriority_) - priority;
+  if (isFree(densePriority)) {
+    return densePriority;
+  }
+
+  /*
+   * Otherwise use the free ranges of the gap, from the top: an ACL inserted
+   * in front of others displaces them, and goes before them.
+   */
+  std::vector<int64_t> bounds{high};
+  for (auto saiPriority : taken) {
+    if (low < saiPriority && saiPriority < high) {
+      bounds.push_back(saiPriority);
+    }
+  }
+  bounds.push_back(low);
+  std::sort(bounds.begin(), bounds.end(), std::greater<int64_t>());
+  for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+    auto width = bounds[i] - bounds[i + 1];
+    if (width > 2 * kAclEntryPriorityGap) {
+      return bounds[i] - kAclEntryPriorityGap;
+    }
+    if (width >= 2) {
+      return bounds[i + 1] + width / 2;
+    }
+  }
+  return std::nullopt;
+}
+
+sai_uint32_t SaiAclTableManager::rebalanceSaiPriorities(
+    SaiAclTableHandle* aclTableHandle,
+    int priority,
+    const std::vector<sai_uint32_t>& inUseSaiPriorities) {
+  // Priorities held by entries outside of aclTableMembers, which stay
+  // programmed until the ACLs they match are programmed again, or until
+  // warm boot completes
+  std::vector<int64_t> taken(
+      inUseSaiPriorities.begin(), inUseSaiPriorities.end());
+  for (const auto& nameAndHandle : aclTableHandle->displacedAclEntries) {
+    taken.push_back(getSaiPriority(*nameAndHandle.second));
+  }
+  for (const auto& aclEntry :
+       unclaimedAclEntries(aclTableHandle, inUseSaiPriorities)) {
+    taken.push_back(GET_OPT_ATTR(AclEntry, Priority, aclEntry->attributes()));
+  }
+  auto numTaken = [&](int64_t low, int64_t high) {
+    return std::count_if(taken.begin(), taken.end(), [&](int64_t saiPriority) {
+      return low < saiPriority && saiPriority < high;
+    });
+  };
+
+  /*
+   * Spread out the entries right after the priority, taking in more of them
+   * until there is room for them and for a new entry at the priority.
    */
-  sai_uint32_t saiPriority = aclEntryMaximumPriority_ - priority;
-  if (saiPriority < aclEntryMinimumPriority_) {
+  int64_t low, high;
+  std::tie(low, high) = saiPriorityGap(aclTableHandle, priority);
+  auto& members = aclTableHandle->aclTableMembers;
+  auto begin = members.upper_bound(priority);
+  auto end = begin;
+  int64_t numEntries = 1;
+  while (end != members.end() &&
+         high - low <
+             (numEntries + numTaken(low, high) + 1) * kAclEntryPriorityGap) {
+    ++end;
+    ++numEntries;
+    low = end == members.end()
+        ? static_cast<int64_t>(aclEntryMinimumPriority_) - 1
+        : getSaiPriority(*end->second);
+  }
+  auto numSlots = numEntries + numTaken(low, high);
+  if (high - low <= numSlots) {
     throw FbossError(
-        "Acl Entry priority out of range. Supported: [",
+        "No Acl Entry priority left for priority: ",
+        priority,
+        ", supported: [",
         aclEntryMinimumPriority_,
         ", ",
         aclEntryMaximumPriority_,
-        "], specified: ",
-        saiPriority);
+        "]");
   }
+  auto step = (high - low) / (numSlots + 1);
+  std::vector<sai_uint32_t> saiPriorities;
+  for (int64_t slot = 1; slot <= numSlots; ++slot) {
+    auto saiPriority = high - step * slot;
+    if (std::find(taken.begin(), taken.end(), saiPriority) == taken.end()) {
+      saiPriorities.push_back(saiPriority);
+    }
+  }
+  CHECK_GE(saiPriorities.size(), static_cast<size_t>(numEntries));
+  XLOG(DBG2) << "Reprogramming " << numEntries - 1
+             << " Acl Entries to make room for priority: " << priority;
 
-  return saiPriority;
+  /*
+   * Make before break: each entry is created at its new priority before its
+   * old one is removed, so its ACL keeps matching. Entries keep their order,
+   * so those moving up are moved from the top, and those moving down from
+   * the bottom, each to a priority no other entry holds any more.
+   */
+  std::vector<std::pair<SaiAclEntryHandle*, sai_uint32_t>> entries;
+  for (auto it = begin; it != end; ++it) {
+    entries.emplace_back(it->second.get(), saiPriorities[entries.size() + 1]);
+  }
+  auto& aclEntryStore = SaiStore::getInstance()->get<SaiAclEntryTraits>();
+  auto moveEntry = [&](SaiAclEntryHandle* aclEntryHandle,
+                       sai_uint32_t newSaiPriority) {
+    SaiAclEntryTraits::Attributes::Priority saiPriority{newSaiPriority};
+    auto attributes = aclEntryHandle->aclEntry->attributes();
+    std::get<std::optional<SaiAclEntryTraits::Attributes::Priority>>(
+        attributes) = saiPriority;
+    aclEntryHandle->aclEntry = aclEntryStore.setObject(
+        SaiAclEntryTraits::AdapterHostKey{
+            SaiAclEntryTraits::Attributes::TableId{
+                aclTableHandle->aclTable->adapterKey()},
+            saiPriority},
+        attributes);
+  };
+  for (auto& [aclEntryHandle, saiPriority] : entries) {
+    if (saiPriority > getSaiPriority(*aclEntryHandle)) {
+      moveEntry(aclEntryHandle, saiPriority);
+    }
+  }
+  for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+    if (it->second < getSaiPriority(*it->first)) {
+      moveEntry(it->first, it->second);
+    }
+  }
+  return saiPriorities[0];
 }
 
 sai_acl_ip_frag_t SaiAclTableManager::cfgIpFragToSaiIpFrag(
@@ -527,55 +820,34 @@ std::shared_ptr<SaiAclCounter> SaiAclTableManager::addAclCounter(
   return saiAclCounter;
 }
 
-AclEntrySaiId SaiAclTableManager::addAclEntry(
-    const std::shared_ptr<AclEntry>& addedAclEntry,
-    const std::string& aclTableName) {
-  CHECK(
-      platform_->getAsic()->isSupported(HwAsic::Feature::ACLv4) ||
-      platform_->getAsic()->isSupported(HwAsic::Feature::ACLv6));
-
-  // If we attempt to add entry to a table that does not exist, fail.
-  auto aclTableHandle = getAclTableHandle(aclTableName);
-  if (!aclTableHandle) {
-    throw FbossError(
-        "attempted to add AclEntry to a AclTable that does not exist: ",
-        aclTableName);
-  }
-
-  // If we already store a handle for this this Acl Entry, fail to add new one.
-  auto aclEntryHandle =
-      getAclEntryHandle(aclTableHandle, addedAclEntry->getPriority());
-  if (aclEntryHandle) {
-    throw FbossError(
-        "attempted to add a duplicate aclEntry: ", addedAclEntry->getID());
-  }
-
-  std::shared_ptr<SaiStore> s = SaiStore::getInstance();
-  auto& aclEntryStore = s->get<SaiAclEntryTraits>();
-
+std::optional<SaiAclEntryTraits::CreateAttributes>
+SaiAclTableManager::aclEntryAttributes(
+    const SaiAclTableHandle* aclTableHandle,
+    const std::shared_ptr<AclEntry>& aclEntry,
+    sai_uint32_t saiPriority,
+    std::shared_ptr<SaiAclCounter>* saiAclCounter) {
   SaiAclEntryTraits::Attributes::TableId aclTableId{
       aclTableHandle->aclTable->adapterKey()};
-  SaiAclEntryTraits::Attributes::Priority priority{
-      swPriorityToSaiPriority(addedAclEntry->getPriority())};
+  SaiAclEntryTraits::Attributes::Priority priority{saiPriority};
 
   // TODO(skhare) Support all other ACL fields
   std::optional<SaiAclEntryTraits::Attributes::FieldSrcIpV6> fieldSrcIpV6{
       std::nullopt};
   std::optional<SaiAclEntryTraits::Attributes::FieldSrcIpV4> fieldSrcIpV4{
       std::nullopt};
-  if (addedAclEntry->getSrcIp().first) {
-    if (addedAclEntry->getSrcIp().first.isV6()) {
+  if (aclEntry->getSrcIp().first) {
+    if (aclEntry->getSrcIp().first.isV6()) {
       auto srcIpV6Mask = folly::IPAddressV6(
-          folly::IPAddressV6::fetchMask(addedAclEntry->getSrcIp().second));
+          folly::IPAddressV6::fetchMask(aclEntry->getSrcIp().second));
       fieldSrcIpV6 = SaiAclEntryTraits::Attributes::FieldSrcIpV6{
           AclEntryFieldIpV6(std::make_pair(
-              addedAclEntry->getSrcIp().first.asV6(), srcIpV6Mask))};
-    } else if (addedAclEntry->getSrcIp().first.isV4()) {
+              aclEntry->getSrcIp().first.asV6(), srcIpV6Mask))};
+    } else if (aclEntry->getSrcIp().first.isV4()) {
       auto srcIpV4Mask = folly::IPAddressV4(
-          folly::IPAddressV4::fetchMask(addedAclEntry->getSrcIp().second));
+          folly::IPAddressV4::fetchMask(aclEntry->getSrcIp().second));
       fieldSrcIpV4 = SaiAclEntryTraits::Attributes::FieldSrcIpV4{
           AclEntryFieldIpV4(std::make_pair(
-              addedAclEntry->getSrcIp().first.asV4(), srcIpV4Mask))};
+              aclEntry->getSrcIp().first.asV4(), srcIpV4Mask))};
     }
   }
 
@@ -583,36 +855,36 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
       std::nullopt};
   std::optional<SaiAclEntryTraits::Attributes::FieldDstIpV4> fieldDstIpV4{
       std::nullopt};
-  if (addedAclEntry->getDstIp().first) {
-    if (addedAclEntry->getDstIp().first.isV6()) {
+  if (aclEntry->getDstIp().first) {
+    if (aclEntry->getDstIp().first.isV6()) {
       auto dstIpV6Mask = folly::IPAddressV6(
-          folly::IPAddressV6::fetchMask(addedAclEntry->getDstIp().second));
+          folly::IPAddressV6::fetchMask(aclEntry->getDstIp().second));
       fieldDstIpV6 = SaiAclEntryTraits::Attributes::FieldDstIpV6{
           AclEntryFieldIpV6(std::make_pair(
-              addedAclEntry->getDstIp().first.asV6(), dstIpV6Mask))};
-    } else if (addedAclEntry->getDstIp().first.isV4()) {
+              aclEntry->getDstIp().first.asV6(), dstIpV6Mask))};
+    } else if (aclEntry->getDstIp().first.isV4()) {
       auto dstIpV4Mask = folly::IPAddressV4(
-          folly::IPAddressV4::fetchMask(addedAclEntry->getDstIp().second));
+          folly::IPAddressV4::fetchMask(aclEntry->getDstIp().second));
       fieldDstIpV4 = SaiAclEntryTraits::Attributes::FieldDstIpV4{
           AclEntryFieldIpV4(std::make_pair(
-              addedAclEntry->getDstIp().first.asV4(), dstIpV4Mask))};
+              aclEntry->getDstIp().first.asV4(), dstIpV4Mask))};
     }
   }
 
   std::optional<SaiAclEntryTraits::Attributes::FieldSrcPort> fieldSrcPort{
       std::nullopt};
   // TODO(skhare) support cpu source port (SaiCpuPortHandle)
-  if (addedAclEntry->getSrcPort() &&
-      addedAclEntry->getSrcPort().value() !=
+  if (aclEntry->getSrcPort() &&
+      aclEntry->getSrcPort().value() !=
           cfg::switch_config_constants::CPU_PORT_LOGICALID()) {
     auto portHandle = managerTable_->portManager().getPortHandle(
-        PortID(addedAclEntry->getSrcPort().value()));
+        PortID(aclEntry->getSrcPort().value()));
     if (!portHandle) {
       throw FbossError(
           "attempted to configure srcPort: ",
-          addedAclEntry->getSrcPort().value(),
+          aclEntry->getSrcPort().value(),
           " ACL:",
-          addedAclEntry->getID());
+          aclEntry->getID());
     }
     fieldSrcPort =
         SaiAclEntryTraits::Attributes::FieldSrcPort{AclEntryFieldSaiObjectIdT(
@@ -621,15 +893,15 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
 
   std::optional<SaiAclEntryTraits::Attributes::FieldOutPort> fieldOutPort{
       std::nullopt};
-  if (addedAclEntry->getDstPort()) {
+  if (aclEntry->getDstPort()) {
     auto portHandle = managerTable_->portManager().getPortHandle(
-        PortID(addedAclEntry->getDstPort().value()));
+        PortID(aclEntry->getDstPort().value()));
     if (!portHandle) {
       throw FbossError(
           "attempted to configure dstPort: ",
-          addedAclEntry->getDstPort().value(),
+          aclEntry->getDstPort().value(),
           " ACL:",
-          addedAclEntry->getID());
+          aclEntry->getID());
     }
     fieldOutPort =
         SaiAclEntryTraits::Attributes::FieldOutPort{AclEntryFieldSaiObjectIdT(
@@ -638,40 +910,40 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
 
   std::optional<SaiAclEntryTraits::Attributes::FieldL4SrcPort> fieldL4SrcPort{
       std::nullopt};
-  if (addedAclEntry->getL4SrcPort()) {
+  if (aclEntry->getL4SrcPort()) {
     fieldL4SrcPort = SaiAclEntryTraits::Attributes::FieldL4SrcPort{
         AclEntryFieldU16(std::make_pair(
-            addedAclEntry->getL4SrcPort().value(), kL4PortMask))};
+            aclEntry->getL4SrcPort().value(), kL4PortMask))};
   }
 
   std::optional<SaiAclEntryTraits::Attributes::FieldL4DstPort> fieldL4DstPort{
       std::nullopt};
-  if (addedAclEntry->getL4DstPort()) {
+  if (aclEntry->getL4DstPort()) {
     fieldL4DstPort = SaiAclEntryTraits::Attributes::FieldL4DstPort{
         AclEntryFieldU16(std::make_pair(
-            addedAclEntry->getL4DstPort().value(), kL4PortMask))};
+            aclEntry->getL4DstPort().value(), kL4PortMask))};
   }
 
   std::optional<SaiAclEntryTraits::Attributes::FieldIpProtocol> fieldIpProtocol{
       std::nullopt};
-  if (addedAclEntry->getProto()) {
+  if (aclEntry->getProto()) {
     fieldIpProtocol = SaiAclEntryTraits::Attributes::FieldIpProtocol{
         AclEntryFieldU8(std::make_pair(
-            addedAclEntry->getProto().value(), kIpProtocolMask))};
+            aclEntry->getProto().value(), kIpProtocolMask))};
   }
 
   std::optional<SaiAclEntryTraits::Attributes::FieldTcpFlags> fieldTcpFlags{
       std::nullopt};
-  if (addedAclEntry->getTcpFlagsBitMap()) {
+  if (aclEntry->getTcpFlagsBitMap()) {
     fieldTcpFlags = SaiAclEntryTraits::Attributes::FieldTcpFlags{
         AclEntryFieldU8(std::make_pair(
-            addedAclEntry->getTcpFlagsBitMap().value(), kTcpFlagsMask))};
+            aclEntry->getTcpFlagsBitMap().value(), kTcpFlagsMask))};
   }
 
   std::optional<SaiAclEntryTraits::Attributes::FieldIpFrag> fieldIpFrag{
       std::nullopt};
-  if (addedAclEntry->getIpFrag()) {
-    auto ipFragData = cfgIpFragToSaiIpFrag(addedAclEntry->getIpFrag().value());
+  if (aclEntry->getIpFrag()) {
+    auto ipFragData = cfgIpFragToSaiIpFrag(aclEntry->getIpFrag().value());
     fieldIpFrag = SaiAclEntryTraits::Attributes::FieldIpFrag{
         AclEntryFieldU32(std::make_pair(ipFragData, kMaskDontCare))};
   }
@@ -684,26 +956,26 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
       std::nullopt};
   std::optional<SaiAclEntryTraits::Attributes::FieldIcmpV6Code> fieldIcmpV6Code{
       std::nullopt};
-  if (addedAclEntry->getIcmpType()) {
-    if (addedAclEntry->getProto()) {
-      if (addedAclEntry->getProto().value() == AclEntryFields::kProtoIcmp) {
+  if (aclEntry->getIcmpType()) {
+    if (aclEntry->getProto()) {
+      if (aclEntry->getProto().value() == AclEntryFields::kProtoIcmp) {
         fieldIcmpV4Type = SaiAclEntryTraits::Attributes::FieldIcmpV4Type{
             AclEntryFieldU8(std::make_pair(
-                addedAclEntry->getIcmpType().value(), kIcmpTypeMask))};
-        if (addedAclEntry->getIcmpCode()) {
+                aclEntry->getIcmpType().value(), kIcmpTypeMask))};
+        if (aclEntry->getIcmpCode()) {
           fieldIcmpV4Code = SaiAclEntryTraits::Attributes::FieldIcmpV4Code{
               AclEntryFieldU8(std::make_pair(
-                  addedAclEntry->getIcmpCode().value(), kIcmpCodeMask))};
+                  aclEntry->getIcmpCode().value(), kIcmpCodeMask))};
         }
       } else if (
-          addedAclEntry->getProto().value() == AclEntryFields::kProtoIcmpv6) {
+          aclEntry->getProto().value() == AclEntryFields::kProtoIcmpv6) {
         fieldIcmpV6Type = SaiAclEntryTraits::Attributes::FieldIcmpV6Type{
             AclEntryFieldU8(std::make_pair(
-                addedAclEntry->getIcmpType().value(), kIcmpTypeMask))};
-        if (addedAclEntry->getIcmpCode()) {
+                aclEntry->getIcmpType().value(), kIcmpTypeMask))};
+        if (aclEntry->getIcmpCode()) {
           fieldIcmpV6Code = SaiAclEntryTraits::Attributes::FieldIcmpV6Code{
               AclEntryFieldU8(std::make_pair(
-                  addedAclEntry->getIcmpCode().value(), kIcmpCodeMask))};
+                  aclEntry->getIcmpCode().value(), kIcmpCodeMask))};
         }
       }
     }
@@ -711,32 +983,32 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
 
   std::optional<SaiAclEntryTraits::Attributes::FieldDscp> fieldDscp{
       std::nullopt};
-  if (addedAclEntry->getDscp()) {
+  if (aclEntry->getDscp()) {
     fieldDscp = SaiAclEntryTraits::Attributes::FieldDscp{AclEntryFieldU8(
-        std::make_pair(addedAclEntry->getDscp().value(), kDscpMask))};
+        std::make_pair(aclEntry->getDscp().value(), kDscpMask))};
   }
 
   std::optional<SaiAclEntryTraits::Attributes::FieldDstMac> fieldDstMac{
       std::nullopt};
-  if (addedAclEntry->getDstMac()) {
+  if (aclEntry->getDstMac()) {
     fieldDstMac = SaiAclEntryTraits::Attributes::FieldDstMac{AclEntryFieldMac(
-        std::make_pair(addedAclEntry->getDstMac().value(), kMacMask()))};
+        std::make_pair(aclEntry->getDstMac().value(), kMacMask()))};
   }
 
   std::optional<SaiAclEntryTraits::Attributes::FieldIpType> fieldIpType{
       std::nullopt};
-  if (addedAclEntry->getIpType()) {
-    auto ipTypeData = cfgIpTypeToSaiIpType(addedAclEntry->getIpType().value());
+  if (aclEntry->getIpType()) {
+    auto ipTypeData = cfgIpTypeToSaiIpType(aclEntry->getIpType().value());
     fieldIpType = SaiAclEntryTraits::Attributes::FieldIpType{
         AclEntryFieldU32(std::make_pair(ipTypeData, kMaskDontCare))};
   }
 
   std::optional<SaiAclEntryTraits::Attributes::FieldTtl> fieldTtl{std::nullopt};
-  if (addedAclEntry->getTtl()) {
+  if (aclEntry->getTtl()) {
     fieldTtl =
         SaiAclEntryTraits::Attributes::FieldTtl{AclEntryFieldU8(std::make_pair(
-            addedAclEntry->getTtl().value().getValue(),
-            addedAclEntry->getTtl().value().getMask()))};
+            aclEntry->getTtl().value().getValue(),
+            aclEntry->getTtl().value().getMask()))};
   }
 
   std::optional<SaiAclEntryTraits::Attributes::FieldRouteDstUserMeta>
@@ -744,35 +1016,34 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
   std::optional<SaiAclEntryTraits::Attributes::FieldNeighborDstUserMeta>
       fieldNeighborDstUserMeta{std::nullopt};
 
-  if (addedAclEntry->getLookupClass()) {
+  if (aclEntry->getLookupClass()) {
     fieldRouteDstUserMeta =
         SaiAclEntryTraits::Attributes::FieldRouteDstUserMeta{
             AclEntryFieldU32(cfgLookupClassToSaiRouteMetaDataAndMask(
-                addedAclEntry->getLookupClass().value()))};
+                aclEntry->getLookupClass().value()))};
     fieldNeighborDstUserMeta =
         SaiAclEntryTraits::Attributes::FieldNeighborDstUserMeta{
             AclEntryFieldU32(cfgLookupClassToSaiNeighborMetaDataAndMask(
-                addedAclEntry->getLookupClass().value()))};
+                aclEntry->getLookupClass().value()))};
   }
 
   std::optional<SaiAclEntryTraits::Attributes::FieldFdbDstUserMeta>
       fieldFdbDstUserMeta{std::nullopt};
-  if (addedAclEntry->getLookupClassL2()) {
+  if (aclEntry->getLookupClassL2()) {
     fieldFdbDstUserMeta = SaiAclEntryTraits::Attributes::FieldFdbDstUserMeta{
         AclEntryFieldU32(cfgLookupClassToSaiFdbMetaDataAndMask(
-            addedAclEntry->getLookupClassL2().value()))};
+            aclEntry->getLookupClassL2().value()))};
   }
 
   // TODO(skhare) Support all other ACL actions
   std::optional<SaiAclEntryTraits::Attributes::ActionPacketAction>
       aclActionPacketAction{std::nullopt};
-  const auto& act = addedAclEntry->getActionType();
+  const auto& act = aclEntry->getActionType();
   if (act == cfg::AclActionType::DENY) {
     aclActionPacketAction = SaiAclEntryTraits::Attributes::ActionPacketAction{
         SAI_PACKET_ACTION_DROP};
   }
 
-  std::shared_ptr<SaiAclCounter> saiAclCounter{nullptr};
   std::optional<SaiAclEntryTraits::Attributes::ActionCounter> aclActionCounter{
       std::nullopt};
 
@@ -782,14 +1053,14 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
   std::optional<SaiAclEntryTraits::Attributes::ActionSetDSCP> aclActionSetDSCP{
       std::nullopt};
 
-  auto action = addedAclEntry->getAclAction();
+  auto action = aclEntry->getAclAction();
   if (action) {
     if (action.value().getTrafficCounter()) {
-      saiAclCounter = addAclCounter(
+      *saiAclCounter = addAclCounter(
           aclTableHandle, action.value().getTrafficCounter().value());
       aclActionCounter = SaiAclEntryTraits::Attributes::ActionCounter{
           AclEntryActionSaiObjectIdT(
-              AclCounterSaiId{saiAclCounter->adapterKey()})};
+              AclCounterSaiId{(*saiAclCounter)->adapterKey()})};
     }
 
     if (action.value().getSendToQueue()) {
@@ -829,14 +1100,12 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
          fieldNeighborDstUserMeta.has_value()) &&
         (aclActionPacketAction.has_value() || aclActionCounter.has_value() ||
          aclActionSetTC.has_value() || aclActionSetDSCP.has_value()))) {
-    XLOG(DBG)
-        << "Unsupported field/action for aclEntry: addedAclEntry->getID())";
-    return AclEntrySaiId{0};
+    XLOG(DBG) << "Unsupported field/action for aclEntry: "
+              << aclEntry->getID();
+    return std::nullopt;
   }
 
-  SaiAclEntryTraits::AdapterHostKey adapterHostKey{aclTableId, priority};
-
-  SaiAclEntryTraits::CreateAttributes attributes{
+  return SaiAclEntryTraits::CreateAttributes{
       aclTableId,
       priority,
       fieldSrcIpV6,
@@ -868,19 +1137,160 @@ AclEntrySaiId SaiAclTableManager::addAclEntry(
       std::nullopt, // mirrorIngress
       std::nullopt, // mirrorEgress
   };
+}
+
+AclEntrySaiId SaiAclTableManager::addAclEntry(
+    const std::shared_ptr<AclEntry>& addedAclEntry,
+    const std::string& aclTableName) {
+  CHECK(
+      platform_->getAsic()->isSupported(HwAsic::Feature::ACLv4) ||
+      platform_->getAsic()->isSupported(HwAsic::Feature::ACLv6));
+
+  // If we attempt to add entry to a table that does not exist, fail.
+  auto aclTableHandle = getAclTableHandle(aclTableName);
+  if (!aclTableHandle) {
+    throw FbossError(
+        "attempted to add AclEntry to a AclTable that does not exist: ",
+        aclTableName);
+  }
+
+  // If we already store a handle for this this Acl Entry, fail to add new one.
+  auto aclEntryHandle =
+      getAclEntryHandle(aclTableHandle, addedAclEntry->getPriority());
+  if (aclEntryHandle) {
+    throw FbossError(
+        "attempted to add a duplicate aclEntry: ", addedAclEntry->getID());
+  }
+
+  return programAclEntry(aclTableHandle, addedAclEntry, nullptr);
+}
+
+AclEntrySaiId SaiAclTableManager::programAclEntry(
+    SaiAclTableHandle* aclTableHandle,
+    const std::shared_ptr<AclEntry>& aclEntry,
+    std::unique_ptr<SaiAclEntryHandle> replacedHandle) {
+  auto priority = aclEntry->getPriority();
+
+  /*
+   * If the ACL moved here from another priority, keep its entry as long as it
+   * is still in order with its new neighbours.
+   */
+  auto movedHandle = detachAclEntryByName(aclTableHandle, aclEntry->getID());
+  if (movedHandle) {
+    auto gap = saiPriorityGap(aclTableHandle, priority);
+    auto saiPriority = getSaiPriority(*movedHandle);
+    if (gap.first < saiPriority && saiPriority < gap.second) {
+      std::shared_ptr<SaiAclCounter> saiAclCounter;
+      auto attributes = aclEntryAttributes(
+          aclTableHandle, aclEntry, saiPriority, &saiAclCounter);
+      if (attributes &&
+          updateAclEntry(movedHandle.get(), *attributes, saiAclCounter)) {
+        return insertAclEntryHandle(
+            aclTableHandle, aclEntry, std::move(movedHandle));
+      }
+    }
+  }
+
+  // Entries of this ACL stay programmed until the new one is in place
+  std::vector<sai_uint32_t> inUseSaiPriorities;
+  for (const auto* handle : {replacedHandle.get(), movedHandle.get()}) {
+    if (handle) {
+      inUseSaiPriorities.push_back(getSaiPriority(*handle));
+    }
+  }
+  // The SAI priority is filled in once allocated
+  std::shared_ptr<SaiAclCounter> saiAclCounter;
+  auto attributes = aclEntryAttributes(
+      aclTableHandle, aclEntry, aclEntryMinimumPriority_, &saiAclCounter);
+  if (!attributes) {
+    return AclEntrySaiId{0};
+  }
+  auto saiPriority = allocateSaiPriority(
+      aclTableHandle, priority, *attributes, inUseSaiPriorities);
+  if (!saiPriority) {
+    saiPriority =
+        rebalanceSaiPriorities(aclTableHandle, priority, inUseSaiPriorities);
+  }
+  std::get<std::optional<SaiAclEntryTraits::Attributes::Priority>>(
+      *attributes) = SaiAclEntryTraits::Attributes::Priority{*saiPriority};
 
-  auto saiAclEntry = aclEntryStore.setObject(adapterHostKey, attributes);
+  std::shared_ptr<SaiStore> s = SaiStore::getInstance();
+  auto& aclEntryStore = s->get<SaiAclEntryTraits>();
+  SaiAclEntryTraits::AdapterHostKey adapterHostKey{
+      std::get<SaiAclEntryTraits::Attributes::TableId>(*attributes),
+      std::get<std::optional<SaiAclEntryTraits::Attributes::Priority>>(
+          *attributes)};
   auto entryHandle = std::make_unique<SaiAclEntryHandle>();
-  entryHandle->aclEntry = saiAclEntry;
+  entryHandle->aclEntry = aclEntryStore.setObject(adapterHostKey, *attributes);
   entryHandle->aclCounter = saiAclCounter;
 
+  // Only remove the entries being replaced once the new one is in place, so
+  // that traffic keeps matching the ACL
+  replacedHandle.reset();
+  movedHandle.reset();
+
+  return insertAclEntryHandle(aclTableHandle, aclEntry, std::move(entryHandle));
+}
+
+bool SaiAclTableManager::updateAclEntry(
+    SaiAclEntryHandle* aclEntryHandle,
+    const SaiAclEntryTraits::CreateAttributes& attributes,
+    std::shared_ptr<SaiAclCounter> saiAclCounter) {
+  if (!canUpdateAclEntryInPlace(
+          aclEntryHandle->aclEntry->attributes(), attributes)) {
+    return false;
+  }
+  // Only sets the attributes that changed
+  aclEntryHandle->aclEntry->setAttributes(attributes);
+  // If the counter changed, the old one is no longer used by the entry and
+  // can be removed
+  aclEntryHandle->aclCounter = std::move(saiAclCounter);
+  return true;
+}
+
+AclEntrySaiId SaiAclTableManager::insertAclEntryHandle(
+    SaiAclTableHandle* aclTableHandle,
+    const std::shared_ptr<AclEntry>& aclEntry,
+    std::unique_ptr<SaiAclEntryHandle> aclEntryHandle) {
+  aclEntryHandle->aclName = aclEntry->getID();
   auto [it, inserted] = aclTableHandle->aclTableMembers.emplace(
-      addedAclEntry->getPriority(), std::move(entryHandle));
+      aclEntry->getPriority(), std::move(aclEntryHandle));
   CHECK(inserted);
+  aclTableHandle->aclNameToPriority.insert_or_assign(
+      aclEntry->getID(), aclEntry->getPriority());
 
   return it->second->aclEntry->adapterKey();
 }
 
+std::unique_ptr<SaiAclEntryHandle> SaiAclTableManager::detachAclEntry(
+    SaiAclTableHandle* aclTableHandle,
+    int priority) {
+  auto itr = aclTableHandle->aclTableMembers.find(priority);
+  if (itr == aclTableHandle->aclTableMembers.end()) {
+    return nullptr;
+  }
+  auto aclEntryHandle = std::move(itr->second);
+  aclTableHandle->aclTableMembers.erase(itr);
+  aclTableHandle->aclNameToPriority.erase(aclEntryHandle->aclName);
+  return aclEntryHandle;
+}
+
+std::unique_ptr<SaiAclEntryHandle> SaiAclTableManager::detachAclEntryByName(
+    SaiAclTableHandle* aclTableHandle,
+    const std::string& aclName) {
+  auto displacedItr = aclTableHandle->displacedAclEntries.find(aclName);
+  if (displacedItr != aclTableHandle->displacedAclEntries.end()) {
+    auto aclEntryHandle = std::move(displacedItr->second);
+    aclTableHandle->displacedAclEntries.erase(displacedItr);
+    return aclEntryHandle;
+  }
+  auto priorityItr = aclTableHandle->aclNameToPriority.find(aclName);
+  if (priorityItr != aclTableHandle->aclNameToPriority.end()) {
+    return detachAclEntry(aclTableHandle, priorityItr->second);
+  }
+  return nullptr;
+}
+
 void SaiAclTableManager::removeAclEntry(
     const std::shared_ptr<AclEntry>& removedAclEntry,
     const std::string& aclTableName) {
@@ -896,16 +1306,15 @@ void SaiAclTableManager::removeAclEntry(
         aclTableName);
   }
 
-  // If we attempt to remove entry that does not exist, fail.
-  auto itr =
-      aclTableHandle->aclTableMembers.find(removedAclEntry->getPriority());
-  if (itr == aclTableHandle->aclTableMembers.end()) {
+  // If we attempt to remove entry that does not exist, fail. Unless its ACL
+  // already moved to another priority in this delta.
+  if (!detachAclEntry(aclTableHandle, removedAclEntry->getPriority()) &&
+      aclTableHandle->aclNameToPriority.find(removedAclEntry->getID()) ==
+          aclTableHandle->aclNameToPriority.end()) {
     throw FbossError(
         "attempted to remove aclEntry which does not exist: ",
         removedAclEntry->getID());
   }
-
-  aclTableHandle->aclTableMembers.erase(itr);
 }
 
 void SaiAclTableManager::changedAclEntry(
@@ -916,12 +1325,67 @@ void SaiAclTableManager::changedAclEntry(
       platform_->getAsic()->isSupported(HwAsic::Feature::ACLv4) ||
       platform_->getAsic()->isSupported(HwAsic::Feature::ACLv6));
 
+  auto aclTableHandle = getAclTableHandle(aclTableName);
+  if (!aclTableHandle) {
+    throw FbossError(
+        "attempted to change AclEntry in a AclTable that does not exist: ",
+        aclTableName);
+  }
+
+  auto priority = newAclEntry->getPriority();
+  if (oldAclEntry->getPriority() != priority) {
+    removeAclEntry(oldAclEntry, aclTableName);
+    addAclEntry(newAclEntry, aclTableName);
+    return;
+  }
+
   /*
-   * ASIC/SAI implementation typically does not allow modifying an ACL entry.
-   * Thus, remove and re-add.
+   * ACL deltas are by priority, so inserting or removing an ACL shows up as
+   * every ACL after it changing to its neighbour. Entries are matched up with
+   * their ACL by name, so that they are reused at the ACL's new priority.
    */
-  removeAclEntry(oldAclEntry, aclTableName);
-  addAclEntry(newAclEntry, aclTableName);
+  auto aclEntryHandle = detachAclEntry(aclTableHandle, priority);
+  if (!aclEntryHandle || aclEntryHandle->aclName != newAclEntry->getID()) {
+    if (aclEntryHandle) {
+      auto aclName = aclEntryHandle->aclName;
+      aclTableHandle->displacedAclEntries.insert_or_assign(
+          aclName, std::move(aclEntryHandle));
+    }
+    programAclEntry(aclTableHandle, newAclEntry, nullptr);
+    return;
+  }
+
+  /*
+   * ASIC/SAI implementations may not allow modifying the fields an ACL entry
+   * matches on. So change the actions of the same ACL in place, and replace
+   * the entry if anything else changed.
+   */
+  std::shared_ptr<SaiAclCounter> saiAclCounter;
+  auto attributes = aclEntryAttributes(
+      aclTableHandle,
+      newAclEntry,
+      getSaiPriority(*aclEntryHandle),
+      &saiAclCounter);
+  if (!attributes) {
+    return;
+  }
+  if (updateAclEntry(aclEntryHandle.get(), *attributes, saiAclCounter)) {
+    insertAclEntryHandle(
+        aclTableHandle, newAclEntry, std::move(aclEntryHandle));
+    return;
+  }
+  programAclEntry(aclTableHandle, newAclEntry, std::move(aclEntryHandle));
+}
+
+void SaiAclTableManager::removeDisplacedAclEntries(
+    const std::string& aclTableName) {
+  auto aclTableHandle = getAclTableHandle(aclTableName);
+  if (!aclTableHandle) {
+    throw FbossError(
+        "attempted to remove AclEntries of a AclTable that does not exist: ",
+        aclTableName);
+  }
+  aclTableHandle->displacedAclEntries.clear();
 }
 
 const SaiAclEntryHandle* FOLLY_NULLABLE SaiAclTableManager::getAclEntryHandle(
@@ -18,7 +18,11 @@
 
 #include <folly/MacAddress.h>
 
+#include <map>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
 
 namespace facebook::fboss {
 
@@ -42,12 +46,22 @@ struct SaiAclEntryHandle {
    */
   std::shared_ptr<SaiAclCounter> aclCounter;
   std::shared_ptr<SaiAclEntry> aclEntry;
+  std::string aclName;
 };
 
 struct SaiAclTableHandle {
   std::shared_ptr<SaiAclTable> aclTable;
-  // SAI ACL priority to corresponding handle
-  folly::F14FastMap<int, std::unique_ptr<SaiAclEntryHandle>> aclTableMembers;
+  // SW ACL priority to corresponding handle, in priority order
+  std::map<int, std::unique_ptr<SaiAclEntryHandle>> aclTableMembers;
+  // ACL name to its SW ACL priority in aclTableMembers
+  folly::F14FastMap<std::string, int> aclNameToPriority;
+  /*
+   * Entries whose SW ACL priority was taken over by another ACL in the state
+   * delta being processed, by ACL name. They stay programmed so that they can
+   * be reused once their ACL shows up at its new priority.
+   */
+  folly::F14FastMap<std::string, std::unique_ptr<SaiAclEntryHandle>>
+      displacedAclEntries;
 };
 
 class SaiAclTableManager {
@@ -108,6 +122,13 @@ class SaiAclTableManager {
       const std::shared_ptr<AclEntry>& newAclEntry,
       const std::string& aclTableName);
 
+  /*
+   * Remove the entries displaced by ACLs that moved to another priority,
+   * whose ACL was not placed again. Called once the whole ACL delta has
+   * been processed.
+   */
+  void removeDisplacedAclEntries(const std::string& aclTableName);
+
   const SaiAclEntryHandle* FOLLY_NULLABLE getAclEntryHandle(
       const SaiAclTableHandle* aclTableHandle,
       int priority) const;
@@ -116,8 +137,6 @@ class SaiAclTableManager {
       const SaiAclTableHandle* aclTableHandle,
       const cfg::TrafficCounter& trafficCount);
 
-  sai_uint32_t swPriorityToSaiPriority(int priority) const;
-
   sai_acl_ip_frag_t cfgIpFragToSaiIpFrag(cfg::IpFragMatch cfgType) const;
   sai_acl_ip_type_t cfgIpTypeToSaiIpType(cfg::IpType cfgIpType) const;
 
@@ -133,6 +152,52 @@ class SaiAclTableManager {
   SaiAclTableHandle* FOLLY_NULLABLE
   getAclTableHandleImpl(const std::string& aclTableName) const;
 
+  std::optional<SaiAclEntryTraits::CreateAttributes> aclEntryAttributes(
+      const SaiAclTableHandle* aclTableHandle,
+      const std::shared_ptr<AclEntry>& aclEntry,
+      sai_uint32_t saiPriority,
+      std::shared_ptr<SaiAclCounter>* saiAclCounter);
+
+  AclEntrySaiId programAclEntry(
+      SaiAclTableHandle* aclTableHandle,
+      const std::shared_ptr<AclEntry>& aclEntry,
+      std::unique_ptr<SaiAclEntryHandle> replacedHandle);
+  bool updateAclEntry(
+      SaiAclEntryHandle* aclEntryHandle,
+      const SaiAclEntryTraits::CreateAttributes& attributes,
+      std::shared_ptr<SaiAclCounter> saiAclCounter);
+
+  AclEntrySaiId insertAclEntryHandle(
+      SaiAclTableHandle* aclTableHandle,
+      const std::shared_ptr<AclEntry>& aclEntry,
+      std::unique_ptr<SaiAclEntryHandle> aclEntryHandle);
+  std::unique_ptr<SaiAclEntryHandle> detachAclEntry(
+      SaiAclTableHandle* aclTableHandle,
+      int priority);
+  std::unique_ptr<SaiAclEntryHandle> detachAclEntryByName(
+      SaiAclTableHandle* aclTableHandle,
+      const std::string& aclName);
+
+  std::pair<int64_t, int64_t> saiPriorityGap(
+      const SaiAclTableHandle* aclTableHandle,
+      int priority) const;
+  /*
+   * Entries of the table that no ACL holds, i.e. ones reloaded at warm boot
+   * that were not programmed again yet.
+   */
+  std::vector<std::shared_ptr<SaiAclEntry>> unclaimedAclEntries(
+      const SaiAclTableHandle* aclTableHandle,
+      const std::vector<sai_uint32_t>& inUseSaiPriorities) const;
+  std::optional<sai_uint32_t> allocateSaiPriority(
+      const SaiAclTableHandle* aclTableHandle,
+      int priority,
+      const SaiAclEntryTraits::CreateAttributes& attributes,
+      const std::vector<sai_uint32_t>& inUseSaiPriorities) const;
+  sai_uint32_t rebalanceSaiPriorities(
+      SaiAclTableHandle* aclTableHandle,
+      int priority,
+      const std::vector<sai_uint32_t>& inUseSaiPriorities);
+
   std::pair<
       SaiAclTableTraits::AdapterHostKey,
       SaiAclTableTraits::CreateAttributes>
@@ -357,10 +357,22 @@ SaiHostifManager::SaiHostifManager(
 }
 
 void SaiHostifManager::updateStats() {
+  auto requests = getStatsRequests();
+  collectStats(requests);
+  publishStats(requests);
+}
+
+std::vector<SaiQueueStatsRequest> SaiHostifManager::getStatsRequests() const {
+  return managerTable_->queueManager().getStatsRequests(
+      cpuPortHandle_->configuredQueues);
+}
+
+void SaiHostifManager::publishStats(
+    const std::vector<SaiQueueStatsRequest>& requests) {
   auto now = duration_cast<seconds>(system_clock::now().time_since_epoch());
   HwPortStats cpuQueueStats;
-  managerTable_->queueManager().updateStats(
-      cpuPortHandle_->configuredQueues, cpuQueueStats);
+  managerTable_->queueManager().publishStats(
+      cpuPortHandle_->configuredQueues, requests, cpuQueueStats);
   cpuStats_.updateStats(cpuQueueStats, now);
 }
 
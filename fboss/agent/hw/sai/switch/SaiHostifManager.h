@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -71,6 +72,9 @@ class SaiHostifManager {
   const SaiQueueHandle* getQueueHandle(
       const SaiQueueConfig& saiQueueConfig) const;
   void updateStats();
+  // updateStats in steps, see SaiStatsCollector.h
+  std::vector<SaiQueueStatsRequest> getStatsRequests() const;
+  void publishStats(const std::vector<SaiQueueStatsRequest>& requests);
   HwPortStats getCpuPortStats() const;
   QueueConfig getQueueSettings() const;
   const HwCpuFb303Stats& getCpuFb303Stats() const {
@@ -25,7 +25,8 @@ std::shared_ptr<SaiNextHopGroupHandle> getNextHopGroupHandle(
   }
 
   auto nextHopGroupHandle =
-      managerTable->nextHopGroupManager().incRefOrAddNextHopGroup(nexthops);
+      managerTable->nextHopGroupManager().incRefOrAddNextHopGroup(
+          swLabelFibEntry->getLabelNextHop().getInternedNextHopSet());
   return nextHopGroupHandle;
 }
 } // namespace
@@ -31,7 +31,7 @@ SaiNextHopGroupManager::SaiNextHopGroupManager(
 
 std::shared_ptr<SaiNextHopGroupHandle>
 SaiNextHopGroupManager::incRefOrAddNextHopGroup(
-    const RouteNextHopEntry::NextHopSet& swNextHops) {
+    const RouteNextHopEntry::InternedNextHopSet& swNextHops) {
   auto ins = handles_.refOrEmplace(swNextHops);
   std::shared_ptr<SaiNextHopGroupHandle> nextHopGroupHandle = ins.first;
   if (!ins.second) {
@@ -44,7 +44,7 @@ SaiNextHopGroupManager::incRefOrAddNextHopGroup(
   // already existing, so we cannot create them inline in the loop (since
   // creating the next hop group requires going through all the next hops
   // to figure out the AdapterHostKey)
-  for (const auto& swNextHop : swNextHops) {
+  for (const auto& swNextHop : *swNextHops) {
     // Compute the sai id of the next hop's router interface
     InterfaceID interfaceId = swNextHop.intf();
     auto routerInterfaceHandle =
@@ -67,7 +67,7 @@ SaiNextHopGroupManager::incRefOrAddNextHopGroup(
   NextHopGroupSaiId nextHopGroupId =
       nextHopGroupHandle->nextHopGroup->adapterKey();
 
-  for (const auto& swNextHop : swNextHops) {
+  for (const auto& swNextHop : *swNextHops) {
     auto resolvedNextHop = folly::poly_cast<ResolvedNextHop>(swNextHop);
     auto key = std::make_pair(nextHopGroupId, resolvedNextHop);
     auto result = managedNextHopGroupMembers_.refOrEmplace(
@@ -133,7 +133,7 @@ class SaiNextHopGroupManager {
       const SaiPlatform* platform);
 
   std::shared_ptr<SaiNextHopGroupHandle> incRefOrAddNextHopGroup(
-      const RouteNextHopEntry::NextHopSet& swNextHops);
+      const RouteNextHopEntry::InternedNextHopSet& swNextHops);
 
  private:
   SaiManagerTable* managerTable_;
@@ -141,7 +141,9 @@ class SaiNextHopGroupManager {
   // TODO(borisb): improve SaiObject/SaiStore to the point where they
   // support the next hop group use case correctly, rather than this
   // abomination of multiple levels of RefMaps :(
-  FlatRefMap<RouteNextHopEntry::NextHopSet, SaiNextHopGroupHandle> handles_;
+  // Keyed by interned next hop sets, so that lookups compare pointers
+  FlatRefMap<RouteNextHopEntry::InternedNextHopSet, SaiNextHopGroupHandle>
+      handles_;
   FlatRefMap<
       std::pair<typename SaiNextHopGroupTraits::AdapterKey, ResolvedNextHop>,
       ManagedNextHopGroupMember>
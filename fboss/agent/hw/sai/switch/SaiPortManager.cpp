@@ -218,6 +218,8 @@ void SaiPortManager::removePort(const std::shared_ptr<Port>& swPort) {
   concurrentIndices_->vlanIds.erase(itr->second->port->adapterKey());
   handles_.erase(itr);
   portStats_.erase(swId);
+  nextPublishedPortStats_.erase(swId);
+  publishedPortStats_.wlock()->erase(swId);
   // TODO: do FDB entries associated with this port need to be removed
   // now?
   XLOG(INFO) << "removed port " << swPort->getID() << " with vlan "
@@ -317,6 +319,8 @@ void SaiPortManager::changePort(
   } else if (oldPort->isEnabled()) {
     // Port transitioned from enabled to disabled, remove stats
     portStats_.erase(newPort->getID());
+    nextPublishedPortStats_.erase(newPort->getID());
+    publishedPortStats_.wlock()->erase(newPort->getID());
   }
   changeQueue(
       newPort->getID(), oldPort->getPortQueues(), newPort->getPortQueues());
@@ -509,17 +513,62 @@ const std::vector<sai_stat_id_t>& SaiPortManager::supportedStats() const {
 }
 
 void SaiPortManager::updateStats(PortID portId) {
+  auto request = getStatsRequest(portId);
+  if (!request) {
+    return;
+  }
+  collectStats(*request);
+  publishStats(*request);
+  // Only this port was polled, so readers see the rest of the last poll
+  auto itr = nextPublishedPortStats_.find(portId);
+  if (itr != nextPublishedPortStats_.end()) {
+    publishedPortStats_.wlock()->insert_or_assign(
+        portId, std::move(itr->second));
+    nextPublishedPortStats_.erase(itr);
+  }
+}
+
+std::optional<SaiPortStatsRequest> SaiPortManager::getStatsRequest(
+    PortID portId) const {
   auto handlesItr = handles_.find(portId);
   if (handlesItr == handles_.end()) {
+    return std::nullopt;
+  }
+  if (portStats_.find(portId) == portStats_.end()) {
+    // We don't maintain port stats for disabled ports.
+    return std::nullopt;
+  }
+  const auto* handle = handlesItr->second.get();
+  SaiPortStatsRequest request(
+      portId, handle->port->adapterKey(), &supportedStats());
+  request.queues =
+      managerTable_->queueManager().getStatsRequests(handle->configuredQueues);
+  return request;
+}
+
+void SaiPortManager::getStatsRequests(
+    std::vector<SaiPortStatsRequest>& requests) const {
+  requests.reserve(requests.size() + portStats_.size());
+  for (const auto& portIdAndStats : portStats_) {
+    if (auto request = getStatsRequest(portIdAndStats.first)) {
+      requests.push_back(std::move(*request));
+    }
+  }
+}
+
+void SaiPortManager::publishStats(const SaiPortStatsRequest& request) {
+  auto handlesItr = handles_.find(request.portId);
+  auto portStatItr = portStats_.find(request.portId);
+  if (!request.collected || handlesItr == handles_.end() ||
+      portStatItr == portStats_.end()) {
     return;
   }
-  auto now = duration_cast<seconds>(system_clock::now().time_since_epoch());
   auto* handle = handlesItr->second.get();
-  auto portStatItr = portStats_.find(portId);
-  if (portStatItr == portStats_.end()) {
-    // We don't maintain port stats for disabled ports.
+  if (handle->port->adapterKey() != request.saiId) {
+    // Port was recreated since the request was made
     return;
   }
+  auto now = duration_cast<seconds>(system_clock::now().time_since_epoch());
   const auto& prevPortStats = portStatItr->second->portStats();
   HwPortStats curPortStats{prevPortStats};
   // All stats start with a unitialized (-1) value. If there are no in
@@ -529,7 +578,7 @@ void SaiPortManager::updateStats(PortID portId) {
           hardware_stats_constants::STAT_UNINITIALIZED()
       ? 0
       : *curPortStats.inDiscards__ref();
-  handle->port->updateStats(supportedStats(), SAI_STATS_MODE_READ);
+  handle->port->setStats(request.counterIds->data(), request.counters);
   const auto& counters = handle->port->getStats();
   fillHwPortStats(counters, curPortStats);
   std::vector<utility::CounterPrevAndCur> toSubtractFromInDiscardsRaw = {
@@ -539,9 +588,30 @@ void SaiPortManager::updateStats(PortID portId) {
   *curPortStats.inDiscards__ref() += utility::subtractIncrements(
       {*prevPortStats.inDiscardsRaw__ref(), *curPortStats.inDiscardsRaw__ref()},
       toSubtractFromInDiscardsRaw);
-  managerTable_->queueManager().updateStats(
-      handle->configuredQueues, curPortStats);
-  portStats_[portId]->updateStats(curPortStats, now);
+  managerTable_->queueManager().publishStats(
+      handle->configuredQueues, request.queues, curPortStats);
+  portStatItr->second->updateStats(curPortStats, now);
+  nextPublishedPortStats_.insert_or_assign(
+      request.portId, std::move(curPortStats));
+}
+
+std::map<PortID, HwPortStats> SaiPortManager::getPublishedPortStats() const {
+  return *publishedPortStats_.rlock();
+}
+
+void SaiPortManager::swapPublishedPortStats() {
+  {
+    auto publishedPortStats = publishedPortStats_.wlock();
+    // Ports that could not be read this poll keep their last stats
+    for (auto& [portId, hwPortStats] : *publishedPortStats) {
+      if (portStats_.find(portId) != portStats_.end()) {
+        nextPublishedPortStats_.emplace(portId, std::move(hwPortStats));
+      }
+    }
+    publishedPortStats->swap(nextPublishedPortStats_);
+  }
+  // Outside of the lock, readers don't wait for the old stats to be freed
+  nextPublishedPortStats_.clear();
 }
 
 std::map<PortID, HwPortStats> SaiPortManager::getPortStats() const {
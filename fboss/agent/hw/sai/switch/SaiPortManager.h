@@ -16,14 +16,20 @@
 #include "fboss/agent/hw/sai/switch/SaiBridgeManager.h"
 #include "fboss/agent/hw/sai/switch/SaiQosMapManager.h"
 #include "fboss/agent/hw/sai/switch/SaiQueueManager.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/PortQueue.h"
 #include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/types.h"
 
+#include "folly/Synchronized.h"
 #include "folly/container/F14Map.h"
 #include "folly/container/F14Set.h"
 
+#include <map>
+#include <optional>
+#include <vector>
+
 namespace facebook::fboss {
 
 class ConcurrentIndices;
@@ -94,6 +100,22 @@ class SaiPortManager {
       SaiPortTraits::CreateAttributes attributees) const;
 
   void updateStats(PortID portID);
+  /*
+   * updateStats in steps, see SaiStatsCollector.h. getStatsRequests
+   * appends a request for every port we maintain stats for.
+   */
+  std::optional<SaiPortStatsRequest> getStatsRequest(PortID portID) const;
+  void getStatsRequests(std::vector<SaiPortStatsRequest>& requests) const;
+  void publishStats(const SaiPortStatsRequest& request);
+  /*
+   * HwPortStats as of the last poll, for readers that do not hold the
+   * SaiSwitch lock. publishStats fills in a back buffer, which
+   * swapPublishedPortStats makes the one readers see once the whole poll is
+   * published. So readers never see some ports from one poll and some from
+   * the previous one.
+   */
+  std::map<PortID, HwPortStats> getPublishedPortStats() const;
+  void swapPublishedPortStats();
 
   void clearStats(PortID portID);
 
@@ -123,6 +145,8 @@ class SaiPortManager {
   ConcurrentIndices* concurrentIndices_;
   Handles handles_;
   Stats portStats_;
+  std::map<PortID, HwPortStats> nextPublishedPortStats_;
+  folly::Synchronized<std::map<PortID, HwPortStats>> publishedPortStats_;
   std::shared_ptr<SaiQosMap> globalDscpToTcQosMap_;
   std::shared_ptr<SaiQosMap> globalTcToQueueQosMap_;
   std::optional<cfg::L2LearningMode> l2LearningMode_{std::nullopt};
@@ -15,6 +15,8 @@
 #include "fboss/agent/hw/sai/switch/SaiSwitchManager.h"
 #include "fboss/lib/TupleUtils.h"
 
+#include <algorithm>
+
 namespace facebook::fboss {
 
 namespace {
@@ -166,12 +168,46 @@ SaiQueueHandles SaiQueueManager::loadQueues(
 void SaiQueueManager::updateStats(
     const std::vector<SaiQueueHandle*>& queueHandles,
     HwPortStats& hwPortStats) {
+  auto requests = getStatsRequests(queueHandles);
+  collectStats(requests);
+  publishStats(queueHandles, requests, hwPortStats);
+}
+
+std::vector<SaiQueueStatsRequest> SaiQueueManager::getStatsRequests(
+    const std::vector<SaiQueueHandle*>& queueHandles) const {
+  std::vector<SaiQueueStatsRequest> requests;
+  requests.reserve(queueHandles.size());
   for (auto queueHandle : queueHandles) {
-    queueHandle->queue->updateStats();
-    const auto& counters = queueHandle->queue->getStats();
-    auto queueId = SaiApiTable::getInstance()->queueApi().getAttribute(
-        queueHandle->queue->adapterKey(), SaiQueueTraits::Attributes::Index{});
-    fillHwQueueStats(queueId, counters, hwPortStats);
+    // The index is part of the adapter host key, so no need to ask the SDK
+    requests.emplace_back(
+        GET_ATTR(Queue, Index, queueHandle->queue->attributes()),
+        queueHandle->queue->adapterKey());
+  }
+  return requests;
+}
+
+void SaiQueueManager::publishStats(
+    const std::vector<SaiQueueHandle*>& queueHandles,
+    const std::vector<SaiQueueStatsRequest>& requests,
+    HwPortStats& hwPortStats) {
+  for (const auto& request : requests) {
+    if (!request.collected) {
+      continue;
+    }
+    auto queueItr = std::find_if(
+        queueHandles.begin(), queueHandles.end(), [&](auto queueHandle) {
+          return queueHandle->queue->adapterKey() == request.saiId;
+        });
+    if (queueItr == queueHandles.end()) {
+      // Queue no longer configured since the request was made
+      continue;
+    }
+    auto& queue = (*queueItr)->queue;
+    queue->setStats(SaiQueueTraits::CounterIdsToRead.data(), request.counters);
+    queue->setStats(
+        SaiQueueTraits::CounterIdsToReadAndClear.data(),
+        request.countersToReadAndClear);
+    fillHwQueueStats(request.queueId, queue->getStats(), hwPortStats);
   }
 }
 
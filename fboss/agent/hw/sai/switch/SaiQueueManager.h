@@ -15,6 +15,7 @@
 #include "fboss/agent/hw/sai/store/SaiObjectWithCounters.h"
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/SaiSchedulerManager.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
 #include "fboss/agent/state/PortQueue.h"
 #include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/types.h"
@@ -22,6 +23,7 @@
 #include "folly/container/F14Map.h"
 
 #include <memory>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -57,6 +59,16 @@ class SaiQueueManager {
   void updateStats(
       const std::vector<SaiQueueHandle*>& queues,
       HwPortStats& stats);
+  /*
+   * updateStats in steps, see SaiStatsCollector.h. Requests for queues that
+   * are no longer in queues by the time they are published are skipped.
+   */
+  std::vector<SaiQueueStatsRequest> getStatsRequests(
+      const std::vector<SaiQueueHandle*>& queues) const;
+  void publishStats(
+      const std::vector<SaiQueueHandle*>& queues,
+      const std::vector<SaiQueueStatsRequest>& requests,
+      HwPortStats& stats);
   void getStats(SaiQueueHandles& queueHandles, HwPortStats& hwPortStats);
   QueueConfig getQueueSettings(const SaiQueueHandles& queueHandles) const;
 
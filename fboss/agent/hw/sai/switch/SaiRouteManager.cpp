@@ -21,8 +21,16 @@
 
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 
+#include <gflags/gflags.h>
+
 #include <optional>
 
+DEFINE_int32(
+    sai_bulk_route_chunk_size,
+    0,
+    "Program routes with SAI bulk apis, this many routes at a time. "
+    "0 programs routes one at a time");
+
 namespace facebook::fboss {
 
 sai_object_id_t SaiRouteHandle::nextHopAdapterKey() const {
@@ -204,6 +212,7 @@ void SaiRouteManager::addOrUpdateRoute(
       attributes =
           SaiRouteTraits::CreateAttributes{packetAction, cpuPortId, metadata};
 
+      pendingRouteCreates_.erase(entry);
       auto& store = SaiStore::getInstance()->get<SaiRouteTraits>();
       auto route = store.setObject(entry, attributes.value());
       routeHandle->route = route;
@@ -245,6 +254,14 @@ void SaiRouteManager::addOrUpdateRoute(
     attributes =
         SaiRouteTraits::CreateAttributes{packetAction, std::nullopt, metadata};
   }
+  if (!routeHandle->route && FLAGS_sai_bulk_route_chunk_size > 0) {
+    // New route, create it along with other pending routes. A route changed
+    // before it was created replaces its pending create.
+    routeHandle->nexthopHandle_ = nextHopHandle;
+    pendingRouteCreates_.insert_or_assign(entry, attributes.value());
+    return;
+  }
+  pendingRouteCreates_.erase(entry);
   auto& store = SaiStore::getInstance()->get<SaiRouteTraits>();
   auto route = store.setObject(entry, attributes.value());
   routeHandle->route = route;
@@ -288,6 +305,11 @@ void SaiRouteManager::addRoute(
   addOrUpdateRoute(
       routeHandle.get(), routerId, std::shared_ptr<Route<AddrT>>{}, swRoute);
   handles_.emplace(entry, std::move(routeHandle));
+  if (FLAGS_sai_bulk_route_chunk_size > 0 &&
+      pendingRouteCreates_.size() >=
+          static_cast<size_t>(FLAGS_sai_bulk_route_chunk_size)) {
+    flushPendingRouteCreates();
+  }
 }
 
 template <typename AddrT>
@@ -295,11 +317,134 @@ void SaiRouteManager::removeRoute(
     const std::shared_ptr<Route<AddrT>>& swRoute,
     RouterID routerId) {
   SaiRouteTraits::RouteEntry entry = routeEntryFromSwRoute(routerId, swRoute);
-  size_t count = handles_.erase(entry);
-  if (!count) {
+  auto itr = handles_.find(entry);
+  if (itr == handles_.end()) {
     throw FbossError(
         "Failed to remove non-existent route to ", swRoute->prefix().str());
   }
+  if (FLAGS_sai_bulk_route_chunk_size > 0 && itr->second->route) {
+    pendingRouteRemoves_.push_back(std::move(itr->second));
+    handles_.erase(itr);
+    if (pendingRouteRemoves_.size() >=
+        static_cast<size_t>(FLAGS_sai_bulk_route_chunk_size)) {
+      // Keep make before break for deltas larger than a chunk
+      flushPendingRouteCreates();
+      flushPendingRouteRemoves();
+    }
+    return;
+  }
+  // Never created, drop its pending create if any
+  pendingRouteCreates_.erase(entry);
+  handles_.erase(itr);
+}
+
+void SaiRouteManager::flushPendingRoutes() {
+  // Make before break: routes replacing removed ones, e.g. a /16 added in
+  // the same delta as the covering /8 is removed, are programmed first.
+  // Re-adding a route pending removal is also safe, as the store hands out
+  // the same object, which the removal then leaves alone. If creating
+  // fails, removes stay pending until the next flush.
+  flushPendingRouteCreates();
+  flushPendingRouteRemoves();
+}
+
+void SaiRouteManager::flushPendingRouteCreates() {
+  if (pendingRouteCreates_.empty()) {
+    return;
+  }
+  // Take the pending creates, so that none are left behind if creating throws
+  folly::F14FastMap<
+      SaiRouteTraits::RouteEntry,
+      SaiRouteTraits::CreateAttributes>
+      creates;
+  creates.swap(pendingRouteCreates_);
+  std::vector<SaiRouteTraits::RouteEntry> entries;
+  std::vector<SaiRouteTraits::CreateAttributes> attributes;
+  entries.reserve(creates.size());
+  attributes.reserve(creates.size());
+  for (auto& create : creates) {
+    entries.push_back(create.first);
+    attributes.push_back(std::move(create.second));
+  }
+  // Drop the handles of routes which were not created, releasing their next
+  // hops
+  auto dropHandle = [this](const SaiRouteTraits::RouteEntry& entry) {
+    auto itr = handles_.find(entry);
+    if (itr != handles_.end() && !itr->second->route) {
+      handles_.erase(itr);
+    }
+  };
+  auto& store = SaiStore::getInstance()->get<SaiRouteTraits>();
+  std::vector<std::shared_ptr<SaiRoute>> routes;
+  try {
+    routes = store.setObjects(entries, attributes);
+  } catch (const std::exception&) {
+    for (const auto& entry : entries) {
+      dropHandle(entry);
+    }
+    throw;
+  }
+  std::vector<std::string> failed;
+  for (size_t i = 0; i < routes.size(); ++i) {
+    if (!routes[i]) {
+      dropHandle(entries[i]);
+      failed.push_back(entries[i].toString());
+      continue;
+    }
+    handles_.at(entries[i])->route = routes[i];
+  }
+  if (!failed.empty()) {
+    throw FbossError(
+        "Failed to create ",
+        failed.size(),
+        " routes: ",
+        folly::join(", ", failed));
+  }
+}
+
+void SaiRouteManager::flushPendingRouteRemoves() {
+  if (pendingRouteRemoves_.empty()) {
+    return;
+  }
+  std::vector<std::unique_ptr<SaiRouteHandle>> removes;
+  removes.swap(pendingRouteRemoves_);
+  std::vector<size_t> removed;
+  std::vector<SaiRouteTraits::RouteEntry> entries;
+  entries.reserve(removes.size());
+  for (size_t i = 0; i < removes.size(); ++i) {
+    // Routes still referenced elsewhere (e.g. by warm boot handles) are
+    // removed as usual once the last reference goes away
+    if (removes[i]->route.use_count() == 1) {
+      removed.push_back(i);
+      entries.push_back(removes[i]->route->adapterKey());
+    }
+  }
+  if (entries.empty()) {
+    return;
+  }
+  auto statuses = SaiApiTable::getInstance()->routeApi().bulkRemove(entries);
+  std::vector<std::string> failed;
+  for (size_t i = 0; i < statuses.size(); ++i) {
+    auto& handle = removes[removed[i]];
+    if (statuses[i] == SAI_STATUS_SUCCESS) {
+      // Already removed, don't remove again when the handle goes away
+      handle->route->release();
+      continue;
+    }
+    failed.push_back(folly::to<std::string>(
+        entries[i].toString(), ": ", saiStatusToString(statuses[i])));
+    // Keep the handle, and the next hops the route points to, to retry
+    // removing the route on the next flush
+    pendingRouteRemoves_.push_back(std::move(handle));
+  }
+  if (failed.empty()) {
+    return;
+  }
+  throw FbossError(
+      "Failed to remove ",
+      failed.size(),
+      " routes: ",
+      folly::join(", ", failed));
 }
 
 SaiRouteHandle* SaiRouteManager::getRouteHandle(
@@ -325,6 +470,8 @@ SaiRouteHandle* SaiRouteManager::getRouteHandleImpl(
 }
 
 void SaiRouteManager::clear() {
+  pendingRouteCreates_.clear();
+  pendingRouteRemoves_.clear();
   handles_.clear();
 }
 
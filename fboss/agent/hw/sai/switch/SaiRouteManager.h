@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -103,9 +104,21 @@ class SaiRouteManager {
   const SaiRouteHandle* getRouteHandle(
       const SaiRouteTraits::RouteEntry& entry) const;
 
+  /*
+   * When bulk programming is enabled (--sai_bulk_route_chunk_size), routes
+   * added and removed by addRoute()/removeRoute() are queued and programmed
+   * with bulk SAI calls once a chunk's worth is pending. This programs the
+   * remaining queued routes, and must be called once the routes of a state
+   * delta have been processed.
+   */
+  void flushPendingRoutes();
+
   void clear();
 
  private:
+  void flushPendingRouteCreates();
+  void flushPendingRouteRemoves();
+
   SaiRouteHandle* getRouteHandleImpl(
       const SaiRouteTraits::RouteEntry& entry) const;
   template <typename AddrT>
@@ -122,6 +135,15 @@ class SaiRouteManager {
   const SaiPlatform* platform_;
   folly::F14FastMap<SaiRouteTraits::RouteEntry, std::unique_ptr<SaiRouteHandle>>
       handles_;
+  // Routes to create, by entry. Their handles are looked up in handles_
+  // when they are created, as routes may be removed before that.
+  folly::F14FastMap<
+      SaiRouteTraits::RouteEntry,
+      SaiRouteTraits::CreateAttributes>
+      pendingRouteCreates_;
+  // Handles of removed routes, kept until their routes are removed so that
+  // next hops outlive the routes pointing to them
+  std::vector<std::unique_ptr<SaiRouteHandle>> pendingRouteRemoves_;
 };
 
 } // namespace facebook::fboss
@@ -14,17 +14,14 @@
 
 namespace facebook::fboss {
 
-void freeRxPacket(void* /* ptr */, void* /* arg */) {
-  // The packet is on the stack, don't "free" it.
-}
-
 SaiRxPacket::SaiRxPacket(
     size_t buffer_size,
     const void* buffer,
     PortID portId,
     VlanID vlanId) {
-  buf_ = folly::IOBuf::takeOwnership(
-      const_cast<void*>(buffer), buffer_size, freeRxPacket, nullptr);
+  // The buffer belongs to the SDK and is only valid during the RX callback.
+  // Packets handled after the callback returns are copied when dispatched.
+  buf_ = folly::IOBuf::wrapBuffer(buffer, buffer_size);
   len_ = buffer_size;
   srcPort_ = portId;
   srcVlan_ = vlanId;
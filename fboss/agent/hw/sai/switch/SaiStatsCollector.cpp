@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/sai/api/SaiApiTable.h"
+
+#include <folly/logging/xlog.h>
+
+namespace facebook::fboss {
+
+void collectStats(SaiStatsPlan& plan) {
+  for (auto& request : plan.ports) {
+    collectStats(request);
+  }
+  collectStats(plan.cpuQueues);
+}
+
+void collectStats(SaiPortStatsRequest& request) {
+  auto& portApi = SaiApiTable::getInstance()->portApi();
+  try {
+    request.counters = portApi.getStats<SaiPortTraits>(
+        request.saiId, *request.counterIds, SAI_STATS_MODE_READ);
+    request.collected = true;
+  } catch (const FbossError& ex) {
+    XLOG(DBG2) << "Skipping stats of port " << request.portId << ": "
+               << ex.what();
+    return;
+  }
+  collectStats(request.queues);
+}
+
+void collectStats(std::vector<SaiQueueStatsRequest>& requests) {
+  auto& queueApi = SaiApiTable::getInstance()->queueApi();
+  for (auto& request : requests) {
+    try {
+      request.counters = queueApi.getStats<SaiQueueTraits>(
+          request.saiId, SAI_STATS_MODE_READ);
+      request.countersToReadAndClear = queueApi.getStats<SaiQueueTraits>(
+          request.saiId, SAI_STATS_MODE_READ_AND_CLEAR);
+      request.collected = true;
+    } catch (const FbossError& ex) {
+      XLOG(DBG2) << "Skipping stats of queue " << request.saiId << ": "
+                 << ex.what();
+    }
+  }
+}
+
+} // namespace facebook::fboss
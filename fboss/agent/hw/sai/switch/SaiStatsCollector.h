@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include "fboss/agent/hw/sai/api/PortApi.h"
+#include "fboss/agent/hw/sai/api/QueueApi.h"
+#include "fboss/agent/types.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Stats collection is split in three steps, so that the SDK calls, which
+ * take most of the time, are made without holding the SaiSwitch lock:
+ * 1. With the lock held, the managers build a SaiStatsPlan of every object
+ *    to read stats from, identified by its SAI id.
+ * 2. Without the lock, collectStats reads the counters of every object in
+ *    the plan into the plan.
+ * 3. With the lock held again, the managers publish the counters in the
+ *    plan to their SaiObjects, HwPortStats and fb303 counters. HwPortStats
+ *    are double buffered, see SaiPortManager::getPublishedPortStats.
+ * Objects removed or replaced between 1 and 3 fail to be read, or no
+ * longer match the object the plan is published to, and are skipped.
+ */
+
+struct SaiQueueStatsRequest {
+  SaiQueueStatsRequest(uint8_t queueId, QueueSaiId saiId)
+      : queueId(queueId), saiId(saiId) {}
+
+  uint8_t queueId;
+  QueueSaiId saiId;
+  bool collected{false};
+  // For SaiQueueTraits::CounterIdsToRead, in order
+  std::vector<uint64_t> counters;
+  // For SaiQueueTraits::CounterIdsToReadAndClear, in order
+  std::vector<uint64_t> countersToReadAndClear;
+};
+
+struct SaiPortStatsRequest {
+  SaiPortStatsRequest(
+      PortID portId,
+      PortSaiId saiId,
+      const std::vector<sai_stat_id_t>* counterIds)
+      : portId(portId), saiId(saiId), counterIds(counterIds) {}
+
+  PortID portId;
+  PortSaiId saiId;
+  // Owned by SaiPortManager, which outlives any plan
+  const std::vector<sai_stat_id_t>* counterIds;
+  bool collected{false};
+  // For counterIds, in order
+  std::vector<uint64_t> counters;
+  std::vector<SaiQueueStatsRequest> queues;
+};
+
+struct SaiStatsPlan {
+  std::vector<SaiPortStatsRequest> ports;
+  std::vector<SaiQueueStatsRequest> cpuQueues;
+};
+
+/*
+ * Read the counters of every object in the plan. Needs no lock besides the
+ * SaiApiLock taken by SaiApi. Objects that fail to be read are left
+ * uncollected.
+ */
+void collectStats(SaiStatsPlan& plan);
+void collectStats(SaiPortStatsRequest& request);
+void collectStats(std::vector<SaiQueueStatsRequest>& requests);
+
+} // namespace facebook::fboss
@@ -16,6 +16,7 @@
 #include "fboss/agent/hw/sai/api/FdbApi.h"
 #include "fboss/agent/hw/sai/api/HostifApi.h"
 #include "fboss/agent/hw/sai/api/LoggingUtil.h"
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/api/SaiApiTable.h"
 #include "fboss/agent/hw/sai/api/SaiObjectApi.h"
 #include "fboss/agent/hw/sai/api/Types.h"
@@ -33,6 +34,7 @@
 #include "fboss/agent/hw/sai/switch/SaiRouteManager.h"
 #include "fboss/agent/hw/sai/switch/SaiRouterInterfaceManager.h"
 #include "fboss/agent/hw/sai/switch/SaiRxPacket.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
 #include "fboss/agent/hw/sai/switch/SaiSwitchManager.h"
 #include "fboss/agent/hw/sai/switch/SaiTxPacket.h"
 #include "fboss/agent/hw/sai/switch/SaiUnsupportedFeatureManager.h"
@@ -70,6 +72,12 @@ DEFINE_string(
     "CRITICAL",
     "Turn on SAI SDK logging. Options are DEBUG|INFO|NOTICE|WARN|ERROR|CRITICAL");
 
+DEFINE_bool(
+    sai_lock_free_stats,
+    false,
+    "Read SAI counters without taking the SAI api lock. Only enable for SDKs "
+    "that support reading stats concurrently with other SAI calls");
+
 namespace {
 /*
  * For the devices/SDK we use, the only events we should get (and process)
@@ -305,6 +313,10 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChanged(const StateDelta& delta) {
         &SaiRouteManager::removeRoute<folly::IPAddressV6>,
         routerID);
   }
+  {
+    auto lock = std::lock_guard<std::mutex>(saiSwitchMutex_);
+    managerTable_->routeManager().flushPendingRoutes();
+  }
 
   {
     auto controlPlaneDelta = delta.getControlPlaneDelta();
@@ -336,6 +348,8 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChanged(const StateDelta& delta) {
         &SaiAclTableManager::addAclEntry,
         &SaiAclTableManager::removeAclEntry,
         kAclTable1);
+    auto lock = std::lock_guard<std::mutex>(saiSwitchMutex_);
+    managerTable_->aclTableManager().removeDisplacedAclEntries(kAclTable1);
   }
 
   processSwitchSettingsChanged(delta);
@@ -436,17 +450,23 @@ bool SaiSwitch::sendPacketOutOfPortAsync(
 
 void SaiSwitch::updateStats(SwitchStats* switchStats) {
   auto& portManager = managerTable_->portManager();
-  auto iter = concurrentIndices_->portIds.begin();
-  while (iter != concurrentIndices_->portIds.end()) {
-    {
-      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-      portManager.updateStats(iter->second);
-    }
-    ++iter;
+  auto& hostifManager = managerTable_->hostifManager();
+  // Reading the counters from the SDK is most of the work, so only hold the
+  // lock to plan what to read and to publish what was read
+  SaiStatsPlan plan;
+  {
+    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+    portManager.getStatsRequests(plan.ports);
+    plan.cpuQueues = hostifManager.getStatsRequests();
   }
+  collectStats(plan);
 
   std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-  managerTable_->hostifManager().updateStats();
+  for (const auto& request : plan.ports) {
+    portManager.publishStats(request);
+  }
+  portManager.swapPublishedPortStats();
+  hostifManager.publishStats(plan.cpuQueues);
 }
 
 void SaiSwitch::fetchL2Table(std::vector<L2EntryThrift>* l2Table) const {
@@ -661,6 +681,7 @@ HwInitResult SaiSwitch::initLocked(
     }
   }
   SaiApiTable::getInstance()->queryApis();
+  SaiApiLock::getInstance()->setStatsLockFree(FLAGS_sai_lock_free_stats);
   concurrentIndices_ = std::make_unique<ConcurrentIndices>();
   managerTable_ =
       std::make_unique<SaiManagerTable>(platform_, existingSwitchId);
@@ -10,6 +10,7 @@
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/hw/sai/api/SaiApiTable.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/SaiAclTableGroupManager.h"
 #include "fboss/agent/hw/sai/switch/SaiAclTableManager.h"
 #include "fboss/agent/hw/sai/switch/SaiManagerTable.h"
@@ -17,7 +18,11 @@
 #include "fboss/agent/hw/sai/switch/tests/ManagerTestBase.h"
 #include "fboss/agent/types.h"
 
+#include <folly/Conv.h>
+
+#include <optional>
 #include <string>
+#include <vector>
 
 using namespace facebook::fboss;
 
@@ -224,3 +229,280 @@ TEST_F(AclTableManagerTest, checkNonExistentAclEntry) {
       aclTableHandle, kPriority());
   EXPECT_FALSE(aclEntryHandle);
 }
+
+class AclTableManagerUpdateTest : public AclTableManagerTest {
+ public:
+  std::shared_ptr<AclEntry> makeAclEntry(
+      int priority,
+      const std::string& name,
+      uint8_t dscp) {
+    auto aclEntry = std::make_shared<AclEntry>(priority, name);
+    aclEntry->setDscp(dscp);
+    aclEntry->setActionType(kActionType());
+    return aclEntry;
+  }
+
+  const SaiAclEntryHandle* getAclEntryHandle(int priority) {
+    auto& aclTableManager = saiManagerTable->aclTableManager();
+    return aclTableManager.getAclEntryHandle(
+        aclTableManager.getAclTableHandle(SaiSwitch::kAclTable1), priority);
+  }
+
+  AclEntrySaiId getAclEntryId(int priority) {
+    return getAclEntryHandle(priority)->aclEntry->adapterKey();
+  }
+
+  sai_uint32_t getSaiPriority(int priority) {
+    return saiApiTable->aclApi().getAttribute(
+        getAclEntryId(priority), SaiAclEntryTraits::Attributes::Priority());
+  }
+
+  // SAI priorities must decrease as SW priorities increase
+  void checkPriorityOrder() {
+    auto aclTableHandle = saiManagerTable->aclTableManager().getAclTableHandle(
+        SaiSwitch::kAclTable1);
+    std::optional<sai_uint32_t> prevSaiPriority;
+    for (const auto& [priority, aclEntryHandle] :
+         aclTableHandle->aclTableMembers) {
+      auto saiPriority = getSaiPriority(priority);
+      if (prevSaiPriority) {
+        EXPECT_LT(saiPriority, *prevSaiPriority);
+      }
+      prevSaiPriority = saiPriority;
+    }
+  }
+
+  size_t numAclEntries() const {
+    return fs->aclEntryManager.map().size();
+  }
+};
+
+TEST_F(AclTableManagerUpdateTest, changeActionInPlace) {
+  auto& aclTableManager = saiManagerTable->aclTableManager();
+  auto aclEntry = makeAclEntry(kPriority(), "AclEntry1", kDscp());
+  auto aclEntryId =
+      aclTableManager.addAclEntry(aclEntry, SaiSwitch::kAclTable1);
+
+  auto counter = cfg::TrafficCounter();
+  *counter.name_ref() = "stat0.c";
+  *counter.types_ref() = {cfg::CounterType::PACKETS};
+  MatchAction action = MatchAction();
+  action.setTrafficCounter(counter);
+  auto newAclEntry = makeAclEntry(kPriority(), "AclEntry1", kDscp());
+  newAclEntry->setAclAction(action);
+  aclTableManager.changedAclEntry(
+      aclEntry, newAclEntry, SaiSwitch::kAclTable1);
+
+  // Same entry, now with a counter
+  EXPECT_EQ(aclEntryId, getAclEntryId(kPriority()));
+  auto counterId = saiApiTable->aclApi()
+                       .getAttribute(
+                           aclEntryId,
+                           SaiAclEntryTraits::Attributes::ActionCounter())
+                       .getData();
+  EXPECT_EQ(
+      getAclEntryHandle(kPriority())->aclCounter->adapterKey(), counterId);
+
+  // Changing the counter replaces just the counter
+  *counter.types_ref() = {cfg::CounterType::BYTES};
+  action.setTrafficCounter(counter);
+  auto newAclEntry2 = makeAclEntry(kPriority(), "AclEntry1", kDscp());
+  newAclEntry2->setAclAction(action);
+  aclTableManager.changedAclEntry(
+      newAclEntry, newAclEntry2, SaiSwitch::kAclTable1);
+
+  EXPECT_EQ(aclEntryId, getAclEntryId(kPriority()));
+  auto counterId2 = saiApiTable->aclApi()
+                        .getAttribute(
+                            aclEntryId,
+                            SaiAclEntryTraits::Attributes::ActionCounter())
+                        .getData();
+  EXPECT_NE(counterId, counterId2);
+  EXPECT_EQ(1, fs->aclCounterManager.map().size());
+  EXPECT_TRUE(saiApiTable->aclApi().getAttribute(
+      AclCounterSaiId(counterId2),
+      SaiAclCounterTraits::Attributes::EnableByteCount()));
+}
+
+TEST_F(AclTableManagerUpdateTest, changeFieldRecreates) {
+  auto& aclTableManager = saiManagerTable->aclTableManager();
+  auto aclEntry = makeAclEntry(kPriority(), "AclEntry1", kDscp());
+  auto aclEntryId =
+      aclTableManager.addAclEntry(aclEntry, SaiSwitch::kAclTable1);
+  auto numEntries = numAclEntries();
+
+  auto newAclEntry = makeAclEntry(kPriority(), "AclEntry1", kDscp2());
+  aclTableManager.changedAclEntry(
+      aclEntry, newAclEntry, SaiSwitch::kAclTable1);
+
+  auto newAclEntryId = getAclEntryId(kPriority());
+  EXPECT_NE(aclEntryId, newAclEntryId);
+  EXPECT_EQ(numEntries, numAclEntries());
+  auto dscpGot = saiApiTable->aclApi().getAttribute(
+      newAclEntryId, SaiAclEntryTraits::Attributes::FieldDscp());
+  EXPECT_EQ(kDscp2(), dscpGot.getDataAndMask().first);
+}
+
+TEST_F(AclTableManagerUpdateTest, removeActionRecreates) {
+  auto& aclTableManager = saiManagerTable->aclTableManager();
+  auto aclEntry = makeAclEntry(kPriority(), "AclEntry1", kDscp());
+  MatchAction action = MatchAction();
+  cfg::SetDscpMatchAction setDscp;
+  *setDscp.dscpValue_ref() = kDscp2();
+  action.setSetDscp(setDscp);
+  aclEntry->setAclAction(action);
+  auto aclEntryId =
+      aclTableManager.addAclEntry(aclEntry, SaiSwitch::kAclTable1);
+
+  // An action can not be unset in place
+  auto newAclEntry = makeAclEntry(kPriority(), "AclEntry1", kDscp());
+  aclTableManager.changedAclEntry(
+      aclEntry, newAclEntry, SaiSwitch::kAclTable1);
+
+  EXPECT_NE(aclEntryId, getAclEntryId(kPriority()));
+}
+
+TEST_F(AclTableManagerUpdateTest, insertKeepsOtherEntries) {
+  auto& aclTableManager = saiManagerTable->aclTableManager();
+  std::vector<std::shared_ptr<AclEntry>> aclEntries;
+  std::vector<AclEntrySaiId> aclEntryIds;
+  for (int i = 0; i < 3; ++i) {
+    aclEntries.push_back(makeAclEntry(
+        kPriority() + i, folly::to<std::string>("AclEntry", i), kDscp() + i));
+    aclEntryIds.push_back(
+        aclTableManager.addAclEntry(aclEntries.back(), SaiSwitch::kAclTable1));
+  }
+  auto numEntries = numAclEntries();
+
+  // Insert an ACL after the first one, which moves the others down. The ACL
+  // delta is by priority.
+  auto moved = [&](int i) {
+    return makeAclEntry(
+        kPriority() + i + 1,
+        folly::to<std::string>("AclEntry", i),
+        kDscp() + i);
+  };
+  aclTableManager.changedAclEntry(
+      aclEntries[1],
+      makeAclEntry(kPriority() + 1, "Inserted", kDscp2()),
+      SaiSwitch::kAclTable1);
+  aclTableManager.changedAclEntry(
+      aclEntries[2], moved(1), SaiSwitch::kAclTable1);
+  aclTableManager.addAclEntry(moved(2), SaiSwitch::kAclTable1);
+  aclTableManager.removeDisplacedAclEntries(SaiSwitch::kAclTable1);
+
+  EXPECT_EQ(numEntries + 1, numAclEntries());
+  EXPECT_EQ(aclEntryIds[0], getAclEntryId(kPriority()));
+  EXPECT_EQ(aclEntryIds[1], getAclEntryId(kPriority() + 2));
+  EXPECT_EQ(aclEntryIds[2], getAclEntryId(kPriority() + 3));
+  checkPriorityOrder();
+}
+
+TEST_F(AclTableManagerUpdateTest, removeKeepsOtherEntries) {
+  auto& aclTableManager = saiManagerTable->aclTableManager();
+  std::vector<std::shared_ptr<AclEntry>> aclEntries;
+  std::vector<AclEntrySaiId> aclEntryIds;
+  for (int i = 0; i < 3; ++i) {
+    aclEntries.push_back(makeAclEntry(
+        kPriority() + i, folly::to<std::string>("AclEntry", i), kDscp() + i));
+    aclEntryIds.push_back(
+        aclTableManager.addAclEntry(aclEntries.back(), SaiSwitch::kAclTable1));
+  }
+  auto numEntries = numAclEntries();
+
+  // Remove the first ACL, which moves the others up
+  auto moved = [&](int i) {
+    return makeAclEntry(
+        kPriority() + i - 1,
+        folly::to<std::string>("AclEntry", i),
+        kDscp() + i);
+  };
+  aclTableManager.changedAclEntry(
+      aclEntries[0], moved(1), SaiSwitch::kAclTable1);
+  aclTableManager.changedAclEntry(
+      aclEntries[1], moved(2), SaiSwitch::kAclTable1);
+  aclTableManager.removeAclEntry(aclEntries[2], SaiSwitch::kAclTable1);
+  aclTableManager.removeDisplacedAclEntries(SaiSwitch::kAclTable1);
+
+  EXPECT_EQ(numEntries - 1, numAclEntries());
+  EXPECT_EQ(aclEntryIds[1], getAclEntryId(kPriority()));
+  EXPECT_EQ(aclEntryIds[2], getAclEntryId(kPriority() + 1));
+  EXPECT_FALSE(getAclEntryHandle(kPriority() + 2));
+  checkPriorityOrder();
+}
+
+TEST_F(AclTableManagerUpdateTest, repeatedInsertsRebalance) {
+  auto& aclTableManager = saiManagerTable->aclTableManager();
+  // Keep inserting an ACL right after the first one, until the gap after it
+  // is used up and entries have to be spread out again
+  std::vector<std::shared_ptr<AclEntry>> aclEntries{
+      makeAclEntry(kPriority(), "First", kDscp()),
+      makeAclEntry(kPriority() + 1, "Last", kDscp2())};
+  for (const auto& aclEntry : aclEntries) {
+    aclTableManager.addAclEntry(aclEntry, SaiSwitch::kAclTable1);
+  }
+  for (int i = 0; i < 20; ++i) {
+    std::vector<std::shared_ptr<AclEntry>> newAclEntries{aclEntries[0]};
+    newAclEntries.push_back(makeAclEntry(
+        kPriority() + 1, folly::to<std::string>("Inserted", i), kDscp() + 1));
+    for (size_t j = 1; j < aclEntries.size(); ++j) {
+      newAclEntries.push_back(makeAclEntry(
+          kPriority() + j + 1,
+          aclEntries[j]->getID(),
+          *aclEntries[j]->getDscp()));
+    }
+    for (size_t j = 1; j < aclEntries.size(); ++j) {
+      aclTableManager.changedAclEntry(
+          aclEntries[j], newAclEntries[j], SaiSwitch::kAclTable1);
+    }
+    aclTableManager.addAclEntry(newAclEntries.back(), SaiSwitch::kAclTable1);
+    aclTableManager.removeDisplacedAclEntries(SaiSwitch::kAclTable1);
+    aclEntries = std::move(newAclEntries);
+    checkPriorityOrder();
+    // Entries moved to new priorities still match the same traffic
+    for (const auto& aclEntry : aclEntries) {
+      auto dscpGot = saiApiTable->aclApi().getAttribute(
+          getAclEntryId(aclEntry->getPriority()),
+          SaiAclEntryTraits::Attributes::FieldDscp());
+      EXPECT_EQ(*aclEntry->getDscp(), dscpGot.getDataAndMask().first);
+    }
+  }
+  EXPECT_EQ(aclEntries.size(), numAclEntries());
+}
+
+TEST_F(AclTableManagerUpdateTest, warmBootAdoptsMatchingEntriesOnly) {
+  auto& aclTableManager = saiManagerTable->aclTableManager();
+  aclTableManager.addAclEntry(
+      makeAclEntry(kPriority(), "First", kDscp()), SaiSwitch::kAclTable1);
+  auto attributes = getAclEntryHandle(kPriority())->aclEntry->attributes();
+  auto firstSaiPriority = getSaiPriority(kPriority());
+
+  // Entries reloaded at warm boot, which no ACL holds yet. One is where the
+  // next ACL would go by default, but matches different packets.
+  auto& aclEntryStore = SaiStore::getInstance()->get<SaiAclEntryTraits>();
+  auto reloadAclEntry = [&](sai_uint32_t saiPriority, uint8_t dscp) {
+    auto reloaded = attributes;
+    SaiAclEntryTraits::Attributes::Priority priority{saiPriority};
+    std::get<std::optional<SaiAclEntryTraits::Attributes::Priority>>(
+        reloaded) = priority;
+    std::get<std::optional<SaiAclEntryTraits::Attributes::FieldDscp>>(
+        reloaded) = SaiAclEntryTraits::Attributes::FieldDscp{AclEntryFieldU8(
+        std::make_pair(dscp, SaiAclTableManager::kDscpMask))};
+    return aclEntryStore.setObject(
+        SaiAclEntryTraits::AdapterHostKey{
+            std::get<SaiAclEntryTraits::Attributes::TableId>(reloaded),
+            priority},
+        reloaded);
+  };
+  auto otherAclEntry = reloadAclEntry(firstSaiPriority - 16, kDscp() + 1);
+  auto matchingAclEntry = reloadAclEntry(firstSaiPriority - 4, kDscp2());
+
+  aclTableManager.addAclEntry(
+      makeAclEntry(kPriority2(), "Second", kDscp2()), SaiSwitch::kAclTable1);
+
+  EXPECT_EQ(matchingAclEntry->adapterKey(), getAclEntryId(kPriority2()));
+  auto dscpGot = saiApiTable->aclApi().getAttribute(
+      otherAclEntry->adapterKey(), SaiAclEntryTraits::Attributes::FieldDscp());
+  EXPECT_EQ(kDscp() + 1, dscpGot.getDataAndMask().first);
+  checkPriorityOrder();
+}
@@ -15,6 +15,7 @@
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/SaiManagerTable.h"
 #include "fboss/agent/hw/sai/switch/SaiPortManager.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
 #include "fboss/agent/hw/sai/switch/tests/ManagerTestBase.h"
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 #include "fboss/agent/platforms/sai/SaiPlatformPort.h"
@@ -356,6 +357,56 @@ TEST_F(PortManagerTest, collectStatsAfterPortDisable) {
   checkCounterExport(swPort->getName(), ExpectExport::NO_EXPORT);
 }
 
+TEST_F(PortManagerTest, publishStatsAfterPortRemove) {
+  std::shared_ptr<Port> swPort = makePort(p0);
+  auto& portManager = saiManagerTable->portManager();
+  auto saiId = portManager.addPort(swPort);
+  std::vector<SaiPortStatsRequest> requests;
+  portManager.getStatsRequests(requests);
+  ASSERT_EQ(requests.size(), 1);
+  EXPECT_EQ(requests[0].portId, swPort->getID());
+  EXPECT_EQ(requests[0].saiId, saiId);
+  collectStats(requests[0]);
+  EXPECT_TRUE(requests[0].collected);
+  portManager.removePort(swPort);
+  EXPECT_FALSE(portManager.getStatsRequest(swPort->getID()));
+  // Port is gone, so the request is dropped
+  portManager.publishStats(requests[0]);
+  EXPECT_EQ(portManager.getLastPortStat(swPort->getID()), nullptr);
+}
+
+TEST_F(PortManagerTest, publishedStatsSwappedPerPoll) {
+  auto& portManager = saiManagerTable->portManager();
+  std::vector<std::shared_ptr<Port>> swPorts{makePort(p0), makePort(p1)};
+  for (const auto& swPort : swPorts) {
+    portManager.addPort(swPort);
+  }
+  std::vector<SaiPortStatsRequest> requests;
+  portManager.getStatsRequests(requests);
+  ASSERT_EQ(requests.size(), 2);
+  for (auto& request : requests) {
+    collectStats(request);
+    portManager.publishStats(request);
+    // Not visible until the whole poll is published
+    EXPECT_TRUE(portManager.getPublishedPortStats().empty());
+  }
+  portManager.swapPublishedPortStats();
+  EXPECT_EQ(portManager.getPublishedPortStats().size(), 2);
+
+  // A port that could not be read keeps its stats from the last poll
+  requests[1].collected = false;
+  for (const auto& request : requests) {
+    portManager.publishStats(request);
+  }
+  portManager.swapPublishedPortStats();
+  EXPECT_EQ(portManager.getPublishedPortStats().size(), 2);
+
+  portManager.removePort(swPorts[0]);
+  auto publishedPortStats = portManager.getPublishedPortStats();
+  EXPECT_EQ(publishedPortStats.size(), 1);
+  EXPECT_EQ(publishedPortStats.count(swPorts[1]->getID()), 1);
+}
+
 TEST_F(PortManagerTest, subsumedPorts) {
   // Port P0 has a port ID 0 and only be configured with all speeds.
   checkSubsumedPorts(p0, cfg::PortSpeed::XG, {});
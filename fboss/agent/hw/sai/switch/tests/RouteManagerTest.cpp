@@ -18,6 +18,12 @@
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/types.h"
 
+#include <folly/Conv.h>
+#include <folly/ScopeGuard.h>
+#include <gflags/gflags.h>
+
+DECLARE_int32(sai_bulk_route_chunk_size);
+
 using namespace facebook::fboss;
 class RouteManagerTest : public ManagerTestBase {
  public:
@@ -301,6 +307,154 @@ TEST_F(RouteManagerTest, updateCpuRoutetoNextHopRoute) {
   EXPECT_FALSE(saiRouteHandle->nextHopGroupHandle());
 }
 
+TEST_F(RouteManagerTest, bulkReplaceCoveringRoute) {
+  FLAGS_sai_bulk_route_chunk_size = 16;
+  SCOPE_EXIT {
+    FLAGS_sai_bulk_route_chunk_size = 0;
+  };
+  auto& routeManager = saiManagerTable->routeManager();
+  auto r1 = makeRoute(tr1);
+  routeManager.addRoute<folly::IPAddressV4>(r1, RouterID(0));
+  routeManager.flushPendingRoutes();
+  auto fs = FakeSai::getInstance();
+  auto numRoutes = fs->routeManager.map().size();
+
+  // Replace the /24 with a /25 inside it in a single flush
+  tr2.destination = {folly::IPAddress{"42.42.42.0"}, 25};
+  tr2.nextHopInterfaces = tr1.nextHopInterfaces;
+  auto r2 = makeRoute(tr2);
+  routeManager.removeRoute<folly::IPAddressV4>(r1, RouterID(0));
+  routeManager.addRoute<folly::IPAddressV4>(r2, RouterID(0));
+  routeManager.flushPendingRoutes();
+
+  auto e1 = routeManager.routeEntryFromSwRoute(RouterID(0), r1);
+  auto e2 = routeManager.routeEntryFromSwRoute(RouterID(0), r2);
+  EXPECT_EQ(routeManager.getRouteHandle(e1), nullptr);
+  auto handle = routeManager.getRouteHandle(e2);
+  ASSERT_NE(handle, nullptr);
+  ASSERT_TRUE(handle->route);
+  EXPECT_TRUE(GET_OPT_ATTR(Route, NextHopId, handle->route->attributes()));
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes);
+}
+
+TEST_F(RouteManagerTest, bulkRemoveAndReaddRoute) {
+  FLAGS_sai_bulk_route_chunk_size = 16;
+  SCOPE_EXIT {
+    FLAGS_sai_bulk_route_chunk_size = 0;
+  };
+  auto& routeManager = saiManagerTable->routeManager();
+  auto r1 = makeRoute(tr1);
+  routeManager.addRoute<folly::IPAddressV4>(r1, RouterID(0));
+  routeManager.flushPendingRoutes();
+  auto fs = FakeSai::getInstance();
+  auto numRoutes = fs->routeManager.map().size();
+
+  // Creates are flushed before removes: the re-added route shares the
+  // object of the removed one, which must then not be removed
+  auto r2 = makeRoute(tr1);
+  routeManager.removeRoute<folly::IPAddressV4>(r1, RouterID(0));
+  routeManager.addRoute<folly::IPAddressV4>(r2, RouterID(0));
+  routeManager.flushPendingRoutes();
+
+  auto entry = routeManager.routeEntryFromSwRoute(RouterID(0), r2);
+  auto handle = routeManager.getRouteHandle(entry);
+  ASSERT_NE(handle, nullptr);
+  ASSERT_TRUE(handle->route);
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes);
+}
+
+TEST_F(RouteManagerTest, bulkRemoveRouteBeforeCreate) {
+  FLAGS_sai_bulk_route_chunk_size = 16;
+  SCOPE_EXIT {
+    FLAGS_sai_bulk_route_chunk_size = 0;
+  };
+  auto& routeManager = saiManagerTable->routeManager();
+  auto fs = FakeSai::getInstance();
+  auto numRoutes = fs->routeManager.map().size();
+
+  // Removing a route whose create is still pending drops the create
+  auto r1 = makeRoute(tr1);
+  routeManager.addRoute<folly::IPAddressV4>(r1, RouterID(0));
+  routeManager.removeRoute<folly::IPAddressV4>(r1, RouterID(0));
+  routeManager.flushPendingRoutes();
+
+  auto entry = routeManager.routeEntryFromSwRoute(RouterID(0), r1);
+  EXPECT_EQ(routeManager.getRouteHandle(entry), nullptr);
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes);
+}
+
+TEST_F(RouteManagerTest, bulkChangeRouteBeforeCreate) {
+  FLAGS_sai_bulk_route_chunk_size = 16;
+  SCOPE_EXIT {
+    FLAGS_sai_bulk_route_chunk_size = 0;
+  };
+  auto& routeManager = saiManagerTable->routeManager();
+  auto fs = FakeSai::getInstance();
+  auto numRoutes = fs->routeManager.map().size();
+
+  // Changing a route whose create is still pending replaces the create
+  auto r1 = makeRoute(tr1);
+  RouteFields<folly::IPAddressV4>::Prefix destination;
+  destination.network = tr1.destination.first.asV4();
+  destination.mask = tr1.destination.second;
+  auto r2 = std::make_shared<Route<folly::IPAddressV4>>(destination);
+  RouteNextHopEntry drop(RouteForwardAction::DROP, AdminDistance::STATIC_ROUTE);
+  r2->update(ClientID{42}, drop);
+  r2->setResolved(drop);
+  routeManager.addRoute<folly::IPAddressV4>(r1, RouterID(0));
+  routeManager.changeRoute<folly::IPAddressV4>(r1, r2, RouterID(0));
+  routeManager.flushPendingRoutes();
+
+  auto entry = routeManager.routeEntryFromSwRoute(RouterID(0), r2);
+  auto handle = routeManager.getRouteHandle(entry);
+  ASSERT_NE(handle, nullptr);
+  ASSERT_TRUE(handle->route);
+  EXPECT_EQ(
+      GET_ATTR(Route, PacketAction, handle->route->attributes()),
+      SAI_PACKET_ACTION_DROP);
+  EXPECT_FALSE(handle->nextHopGroupHandle());
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 1);
+}
+
+TEST_F(RouteManagerTest, bulkRemovesBeyondChunkSize) {
+  FLAGS_sai_bulk_route_chunk_size = 2;
+  SCOPE_EXIT {
+    FLAGS_sai_bulk_route_chunk_size = 0;
+  };
+  auto& routeManager = saiManagerTable->routeManager();
+  auto fs = FakeSai::getInstance();
+  auto numRoutes = fs->routeManager.map().size();
+  std::vector<std::shared_ptr<Route<folly::IPAddressV4>>> oldRoutes;
+  for (auto i = 0; i < 3; ++i) {
+    TestRoute tr = tr1;
+    tr.destination = {
+        folly::IPAddress{folly::to<std::string>("10.0.", i, ".0")}, 24};
+    oldRoutes.push_back(makeRoute(tr));
+    routeManager.addRoute<folly::IPAddressV4>(oldRoutes.back(), RouterID(0));
+  }
+  routeManager.flushPendingRoutes();
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 3);
+
+  // Replace the routes with a covering route in a delta with more removes
+  // than fit in a chunk. The covering route must be created before the
+  // first chunk of removes is programmed.
+  TestRoute tr = tr1;
+  tr.destination = {folly::IPAddress{"10.0.0.0"}, 16};
+  auto newRoute = makeRoute(tr);
+  routeManager.addRoute<folly::IPAddressV4>(newRoute, RouterID(0));
+  routeManager.removeRoute<folly::IPAddressV4>(oldRoutes[0], RouterID(0));
+  routeManager.removeRoute<folly::IPAddressV4>(oldRoutes[1], RouterID(0));
+  auto entry = routeManager.routeEntryFromSwRoute(RouterID(0), newRoute);
+  auto handle = routeManager.getRouteHandle(entry);
+  ASSERT_NE(handle, nullptr);
+  EXPECT_TRUE(handle->route);
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 2);
+
+  routeManager.removeRoute<folly::IPAddressV4>(oldRoutes[2], RouterID(0));
+  routeManager.flushPendingRoutes();
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 1);
+}
+
 /*
  * Test for ToMe routes doesn't want to do all the setup, because
  * setting up the router interfaces will result in creating ToMeRoutes
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "common/init/Init.h"
+#include "fboss/agent/hw/sai/api/PortApi.h"
+#include "fboss/agent/hw/sai/api/QueueApi.h"
+#include "fboss/agent/hw/sai/api/SaiApiTable.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
+
+#include <folly/Benchmark.h>
+
+#include <vector>
+
+using namespace facebook::fboss;
+
+/*
+ * Time to read the stats of all ports and their queues from FakeSai, as a
+ * function of the number of ports, the way SaiSwitch::updateStats used to
+ * (one port at a time, asking the SDK for the index of every queue), and
+ * with a SaiStatsPlan built ahead of the SDK calls.
+ */
+
+namespace {
+
+const std::vector<sai_stat_id_t> kPortCounterIds(
+    SaiPortTraits::CounterIdsToRead.begin(),
+    SaiPortTraits::CounterIdsToRead.end());
+
+SaiPortTraits::CreateAttributes portAttributes(uint32_t lane) {
+  SaiPortTraits::CreateAttributes attributes{};
+  std::get<SaiPortTraits::Attributes::HwLaneList>(attributes) =
+      std::vector<uint32_t>{lane};
+  std::get<SaiPortTraits::Attributes::Speed>(attributes) = 25000;
+  return attributes;
+}
+
+SaiStatsPlan createPorts(int numPorts) {
+  auto& portApi = SaiApiTable::getInstance()->portApi();
+  auto& queueApi = SaiApiTable::getInstance()->queueApi();
+  SaiStatsPlan plan;
+  for (auto i = 0; i < numPorts; ++i) {
+    auto portSaiId = portApi.create<SaiPortTraits>(portAttributes(i), 0);
+    SaiPortStatsRequest request(PortID(i), portSaiId, &kPortCounterIds);
+    SaiPortTraits::Attributes::QosQueueList queueListAttribute;
+    for (auto queueId : portApi.getAttribute(portSaiId, queueListAttribute)) {
+      auto index = queueApi.getAttribute(
+          QueueSaiId(queueId), SaiQueueTraits::Attributes::Index{});
+      request.queues.emplace_back(index, QueueSaiId(queueId));
+    }
+    plan.ports.push_back(std::move(request));
+  }
+  return plan;
+}
+
+void pollPerPort(unsigned iters, int numPorts) {
+  folly::BenchmarkSuspender suspender;
+  auto fs = FakeSai::getInstance();
+  sai_api_initialize(0, nullptr);
+  SaiApiTable::getInstance()->queryApis();
+  auto plan = createPorts(numPorts);
+  auto& portApi = SaiApiTable::getInstance()->portApi();
+  auto& queueApi = SaiApiTable::getInstance()->queueApi();
+  suspender.dismiss();
+
+  for (unsigned n = 0; n < iters; ++n) {
+    for (const auto& port : plan.ports) {
+      folly::doNotOptimizeAway(portApi.getStats<SaiPortTraits>(
+          port.saiId, kPortCounterIds, SAI_STATS_MODE_READ));
+      for (const auto& queue : port.queues) {
+        folly::doNotOptimizeAway(queueApi.getStats<SaiQueueTraits>(
+            queue.saiId, SAI_STATS_MODE_READ));
+        folly::doNotOptimizeAway(queueApi.getStats<SaiQueueTraits>(
+            queue.saiId, SAI_STATS_MODE_READ_AND_CLEAR));
+        folly::doNotOptimizeAway(queueApi.getAttribute(
+            queue.saiId, SaiQueueTraits::Attributes::Index{}));
+      }
+    }
+  }
+
+  suspender.rehire();
+  FakeSai::clear();
+}
+
+void pollPlanned(unsigned iters, int numPorts) {
+  folly::BenchmarkSuspender suspender;
+  auto fs = FakeSai::getInstance();
+  sai_api_initialize(0, nullptr);
+  SaiApiTable::getInstance()->queryApis();
+  auto plan = createPorts(numPorts);
+  suspender.dismiss();
+
+  for (unsigned n = 0; n < iters; ++n) {
+    collectStats(plan);
+  }
+
+  suspender.rehire();
+  FakeSai::clear();
+}
+
+} // namespace
+
+BENCHMARK_PARAM(pollPerPort, 32)
+BENCHMARK_RELATIVE_PARAM(pollPlanned, 32)
+BENCHMARK_PARAM(pollPerPort, 128)
+BENCHMARK_RELATIVE_PARAM(pollPlanned, 128)
+BENCHMARK_PARAM(pollPerPort, 512)
+BENCHMARK_RELATIVE_PARAM(pollPlanned, 512)
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -272,3 +272,41 @@ TEST(HwPortFb303Stats, queueNameChangeResetsValue) {
     }
   }
 }
+
+TEST(HwPortFb303Stats, updateStatsAfterRename) {
+  constexpr auto kNewPortName = "eth1/2/1";
+  HwPortFb303Stats portStats(kPortName, kQueue2Name);
+  portStats.portNameChanged(kNewPortName);
+  portStats.queueChanged(1, "platinum");
+  portStats.queueChanged(3, "bronze");
+  auto now = duration_cast<seconds>(system_clock::now().time_since_epoch());
+  HwPortStats empty{};
+  *empty.queueOutDiscardBytes__ref() = *empty.queueOutBytes__ref() =
+      *empty.queueOutPackets__ref() = {{1, 0}, {2, 0}, {3, 0}};
+  auto stats = getInitedStats();
+  *stats.queueOutDiscardBytes__ref() = *stats.queueOutBytes__ref() =
+      *stats.queueOutPackets__ref() = {{1, 1}, {2, 2}, {3, 3}};
+  portStats.updateStats(empty, now);
+  portStats.updateStats(stats, now);
+
+  auto curValue{1};
+  for (auto counterName : HwPortFb303Stats::kPortStatKeys()) {
+    EXPECT_EQ(
+        portStats.getCounterLastIncrement(
+            HwPortFb303Stats::statName(counterName, kNewPortName)),
+        curValue++ + 1);
+  }
+  HwPortFb303Stats::QueueId2Name newQueues = {
+      {1, "platinum"}, {2, "silver"}, {3, "bronze"}};
+  for (auto counterName : HwPortFb303Stats::kQueueStatKeys()) {
+    for (const auto& queueIdAndName : newQueues) {
+      EXPECT_EQ(
+          portStats.getCounterLastIncrement(HwPortFb303Stats::statName(
+              counterName,
+              kNewPortName,
+              queueIdAndName.first,
+              queueIdAndName.second)),
+          queueIdAndName.first);
+    }
+  }
+}
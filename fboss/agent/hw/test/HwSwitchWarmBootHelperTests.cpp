@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
+#include "fboss/agent/FbossError.h"
+
+#include <folly/dynamic.h>
+#include <folly/json.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+DECLARE_bool(binary_warm_boot_state);
+DECLARE_bool(compress_warm_boot_state);
+
+using namespace facebook::fboss;
+
+namespace {
+
+folly::dynamic warmBootState() {
+  return folly::dynamic::object(
+      "swSwitch",
+      folly::dynamic::object("ports", folly::dynamic::array(1, 2, 3))(
+          "name", "switch")("enabled", true)("ratio", 0.5))(
+      "hwSwitch", folly::dynamic::object("unit", 0)("table", nullptr));
+}
+
+std::string header(uint8_t version, uint8_t flags) {
+  std::string data{"FBWB"};
+  data.push_back(static_cast<char>(version));
+  data.push_back(static_cast<char>(flags));
+  return data;
+}
+
+} // namespace
+
+TEST(HwSwitchWarmBootHelperTests, RoundTrip) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_binary_warm_boot_state = true;
+  FLAGS_compress_warm_boot_state = false;
+  auto data = HwSwitchWarmBootHelper::serializeWarmBootState(warmBootState());
+
+  EXPECT_EQ(header(1, 0), data.substr(0, 6));
+  EXPECT_EQ(
+      warmBootState(),
+      HwSwitchWarmBootHelper::deserializeWarmBootState(data));
+}
+
+TEST(HwSwitchWarmBootHelperTests, RoundTripZstd) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_binary_warm_boot_state = true;
+  FLAGS_compress_warm_boot_state = true;
+  auto data = HwSwitchWarmBootHelper::serializeWarmBootState(warmBootState());
+
+  EXPECT_EQ(header(1, 1), data.substr(0, 6));
+  EXPECT_EQ(
+      warmBootState(),
+      HwSwitchWarmBootHelper::deserializeWarmBootState(data));
+
+  // Reading does not depend on the flag
+  FLAGS_compress_warm_boot_state = false;
+  EXPECT_EQ(
+      warmBootState(),
+      HwSwitchWarmBootHelper::deserializeWarmBootState(data));
+}
+
+TEST(HwSwitchWarmBootHelperTests, JsonByDefault) {
+  // So that versions which only read JSON can still warm boot from it
+  auto data = HwSwitchWarmBootHelper::serializeWarmBootState(warmBootState());
+
+  EXPECT_EQ(warmBootState(), folly::parseJson(data));
+  EXPECT_EQ(
+      warmBootState(),
+      HwSwitchWarmBootHelper::deserializeWarmBootState(data));
+}
+
+TEST(HwSwitchWarmBootHelperTests, LegacyJson) {
+  // Written by versions which stored warm boot state as JSON
+  EXPECT_EQ(
+      warmBootState(),
+      HwSwitchWarmBootHelper::deserializeWarmBootState(
+          folly::toPrettyJson(warmBootState())));
+}
+
+TEST(HwSwitchWarmBootHelperTests, TruncatedHeader) {
+  EXPECT_THROW(
+      HwSwitchWarmBootHelper::deserializeWarmBootState("FBWB"), FbossError);
+  EXPECT_THROW(
+      HwSwitchWarmBootHelper::deserializeWarmBootState(
+          header(1, 0).substr(0, 5)),
+      FbossError);
+}
+
+TEST(HwSwitchWarmBootHelperTests, UnknownVersion) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_binary_warm_boot_state = true;
+  FLAGS_compress_warm_boot_state = false;
+  auto data = HwSwitchWarmBootHelper::serializeWarmBootState(warmBootState());
+  data[4] = 2;
+
+  EXPECT_THROW(
+      HwSwitchWarmBootHelper::deserializeWarmBootState(data), FbossError);
+}
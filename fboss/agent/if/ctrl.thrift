@@ -83,6 +83,35 @@ struct UnicastRoute {
   4: list<NextHopThrift> nextHops,
 }
 
+/*
+ * Next hops shared by the routes of a UnicastRouteBatch referencing them.
+ * Routes without next hops are dropped.
+ */
+struct UnicastRouteBatchNextHops {
+  1: list<NextHopThrift> nextHops,
+  // Defaults to the admin distance of the client sending the batch
+  2: optional AdminDistance adminDistance,
+}
+
+/*
+ * Unicast routes in columnar form. Each distinct set of next hops is sent,
+ * and converted by the agent, once rather than once per route.
+ *
+ * The i-th v4 route has network v4Networks[4i, 4i + 4) in network byte
+ * order, prefix length v4PrefixLengths[i] and next hops
+ * nextHops[v4NextHopIndices[i]]. v6 routes are laid out likewise, with 16
+ * byte networks.
+ */
+struct UnicastRouteBatch {
+  1: list<UnicastRouteBatchNextHops> nextHops,
+  2: binary v4Networks,
+  3: binary v4PrefixLengths,
+  4: list<i32> v4NextHopIndices,
+  5: binary v6Networks,
+  6: binary v6PrefixLengths,
+  7: list<i32> v6NextHopIndices,
+}
+
 struct MplsRoute {
   1: required mpls.MplsLabel topLabel,
   3: optional AdminDistance adminDistance,
@@ -120,6 +149,49 @@ struct MplsRouteDetails {
   5: list<NextHopThrift> nextHops,
 }
 
+/*
+ * Restricts the routes returned by the paginated route table APIs. Unset
+ * fields match all routes.
+ */
+struct RouteTableFilter {
+  // Only routes within this prefix, i.e. the prefix itself or more specifics
+  1: optional IpPrefix prefix,
+  // Only routes with next hops from this client
+  2: optional i16 clientId,
+  // Only routes with this next hop address
+  3: optional Address.BinaryAddress nextHop,
+}
+
+/*
+ * Position in the route table, i.e. the last route returned by a paginated
+ * route table API. Routes are walked by router ID, v4 before v6, and then by
+ * prefix length and address.
+ */
+struct RouteTableCursor {
+  1: i32 routerId,
+  2: IpPrefix lastPrefix,
+}
+
+struct RouteTablePageRequest {
+  1: RouteTableFilter filter,
+  // Continue after this route, or start from the beginning if unset
+  2: optional RouteTableCursor cursor,
+  // Capped by the agent, a value <= 0 selects the agent's default
+  3: i32 maxRoutes = 0,
+}
+
+struct UnicastRoutePage {
+  1: list<UnicastRoute> routes,
+  // Unset once the whole route table has been returned
+  2: optional RouteTableCursor nextCursor,
+}
+
+struct RouteDetailsPage {
+  1: list<RouteDetails> routes,
+  // Unset once the whole route table has been returned
+  2: optional RouteTableCursor nextCursor,
+}
+
 struct ArpEntryThrift {
   1: string mac,
   2: i32 port,
@@ -565,6 +637,21 @@ service FbossCtrl extends fb303.FacebookService {
   void syncFibInVrf(1: i16 clientId, 2: list<UnicastRoute> routes, 3: i32 vrf)
     throws (1: fboss.FbossBaseError error)
 
+  /*
+   * Same as addUnicastRoutesInVrf and syncFibInVrf, for routes in columnar
+   * form. Only supported with the standalone RIB.
+   */
+  void addUnicastRouteBatchInVrf(
+    1: i16 clientId,
+    2: UnicastRouteBatch batch,
+    3: i32 vrf
+  ) throws (1: fboss.FbossBaseError error)
+  void syncFibBatchInVrf(
+    1: i16 clientId,
+    2: UnicastRouteBatch batch,
+    3: i32 vrf
+  ) throws (1: fboss.FbossBaseError error)
+
   /*
    * Send packets in binary or hex format to controller.
    *
@@ -659,6 +746,21 @@ service FbossCtrl extends fb303.FacebookService {
     throws (1: fboss.FbossBaseError error)
   list<RouteDetails> getRouteTableDetails()
     throws (1: fboss.FbossBaseError error)
+  /*
+   * Paginated forms of the route table APIs above, returning at most
+   * request.maxRoutes routes per call. Without a client in the filter,
+   * getRouteTablePage returns resolved routes and their forwarding next hops
+   * as getRouteTable does. With one, it returns that client's next hops as
+   * getRouteTableByClient does.
+   *
+   * Each page is read from the then current state: routes added or removed
+   * between calls may or may not be returned, but no route is returned
+   * twice.
+   */
+  UnicastRoutePage getRouteTablePage(1: RouteTablePageRequest request)
+    throws (1: fboss.FbossBaseError error)
+  RouteDetailsPage getRouteTableDetailsPage(1: RouteTablePageRequest request)
+    throws (1: fboss.FbossBaseError error)
   InterfaceDetail getInterfaceDetail(1: i32 interfaceId)
     throws (1: fboss.FbossBaseError error)
 
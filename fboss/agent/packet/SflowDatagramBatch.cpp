@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/packet/SflowDatagramBatch.h"
+
+#include <glog/logging.h>
+
+using namespace folly;
+using namespace folly::io;
+
+namespace {
+uint32_t xdrPadded(uint32_t size) {
+  using facebook::fboss::sflow::XDR_BASIC_BLOCK_SIZE;
+  return (size + XDR_BASIC_BLOCK_SIZE - 1) / XDR_BASIC_BLOCK_SIZE *
+      XDR_BASIC_BLOCK_SIZE;
+}
+
+// sample_record types
+constexpr facebook::fboss::sflow::DataFormat kFlowSample = 1;
+// flow_record types
+constexpr facebook::fboss::sflow::DataFormat kSampledHeader = 1;
+} // namespace
+
+namespace facebook::fboss {
+
+namespace sflow {
+
+SampleDatagramBatch::SampleDatagramBatch(uint32_t maxDatagramSize)
+    : maxSamplesSize_(maxDatagramSize - kMaxHeaderSize) {
+  CHECK_GT(maxDatagramSize, kMaxHeaderSize);
+  datagrams_.push_back(newDatagram());
+}
+
+SampleDatagramBatch::Datagram SampleDatagramBatch::newDatagram() const {
+  Datagram datagram;
+  datagram.samples = IOBuf::create(maxSamplesSize_);
+  return datagram;
+}
+
+bool SampleDatagramBatch::addSample(
+    FlowSample sample,
+    const SampledHeader& header) {
+  headerBuf_.resize(xdrPadded(header.size()));
+  auto headerIOBuf = IOBuf::wrapBuffer(headerBuf_.data(), headerBuf_.size());
+  RWPrivateCursor headerCursor(headerIOBuf.get());
+  header.serialize(&headerCursor);
+
+  FlowRecord record;
+  record.flowFormat = kSampledHeader;
+  record.flowDataLen = headerBuf_.size();
+  record.flowData = headerBuf_.data();
+  sample.flowRecordsCnt = 1;
+  sample.flowRecords = &record;
+
+  // Every field of the sample is a multiple of XDR_BASIC_BLOCK_SIZE
+  auto sampleSize = sample.size(record.size());
+  auto recordSize = 4 /* sampleType */ + 4 /* sampleDataLen */ + sampleSize;
+  if (recordSize > maxSamplesSize_) {
+    return false;
+  }
+
+  if (datagrams_.back().samples->length() + recordSize > maxSamplesSize_) {
+    datagrams_.push_back(newDatagram());
+  }
+  auto& datagram = datagrams_.back();
+  auto offset = datagram.samples->length();
+  datagram.samples->append(recordSize);
+  RWPrivateCursor cursor(datagram.samples.get());
+  cursor.skip(offset);
+  serializeDataFormat(&cursor, kFlowSample);
+  cursor.writeBE<uint32_t>(sampleSize);
+  sample.serialize(&cursor);
+  DCHECK(cursor.isAtEnd());
+
+  ++datagram.samplesCnt;
+  ++numSamples_;
+  return true;
+}
+
+size_t SampleDatagramBatch::numDatagrams() const {
+  return datagrams_.back().samplesCnt ? datagrams_.size()
+                                      : datagrams_.size() - 1;
+}
+
+std::vector<SampleDatagramBatch::Datagram> SampleDatagramBatch::take() {
+  if (datagrams_.back().samplesCnt == 0) {
+    datagrams_.pop_back();
+  }
+  std::vector<Datagram> datagrams;
+  datagrams.swap(datagrams_);
+  datagrams_.push_back(newDatagram());
+  numSamples_ = 0;
+  return datagrams;
+}
+
+} // namespace sflow
+
+} // namespace facebook::fboss
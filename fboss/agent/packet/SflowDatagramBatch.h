@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/packet/SflowStructs.h"
+
+#include <folly/io/IOBuf.h>
+
+#include <memory>
+#include <vector>
+
+namespace facebook::fboss {
+
+namespace sflow {
+
+/*
+ * Packs flow samples into sFlow v5 datagrams of at most maxDatagramSize
+ * bytes. Samples are serialized once, as they are added, without the
+ * datagram header: the header carries a per-collector sequence number and
+ * is written by the exporter when sending the same samples to every
+ * collector.
+ */
+class SampleDatagramBatch {
+ public:
+  /* Header of a datagram with an IPv6 agent address */
+  static constexpr uint32_t kMaxHeaderSize = 4 /* version */ +
+      4 /* address type */ + 16 /* agentAddress */ + 4 /* subAgentID */ +
+      4 /* sequenceNumber */ + 4 /* uptime */ + 4 /* samplesCnt */;
+
+  struct Datagram {
+    // Serialized SampleRecords, to follow the datagram header
+    std::unique_ptr<folly::IOBuf> samples;
+    uint32_t samplesCnt{0};
+  };
+
+  explicit SampleDatagramBatch(uint32_t maxDatagramSize);
+
+  /*
+   * Add a flow sample with a single raw packet header flow record. The
+   * flowRecords of sample are ignored. Returns false, and drops the sample,
+   * if it does not fit in a datagram on its own.
+   */
+  bool addSample(FlowSample sample, const SampledHeader& header);
+
+  /* Datagrams with at least one sample, including the one being filled */
+  size_t numDatagrams() const;
+  uint32_t numSamples() const {
+    return numSamples_;
+  }
+  bool empty() const {
+    return numSamples_ == 0;
+  }
+
+  /* Hand out every datagram with at least one sample and start over */
+  std::vector<Datagram> take();
+
+ private:
+  Datagram newDatagram() const;
+
+  const uint32_t maxSamplesSize_;
+  // The last datagram is the one being filled
+  std::vector<Datagram> datagrams_;
+  uint32_t numSamples_{0};
+  std::vector<byte> headerBuf_;
+};
+
+} // namespace sflow
+
+} // namespace facebook::fboss
@@ -13,18 +13,24 @@
 using namespace folly;
 using namespace folly::io;
 
+namespace {
+constexpr facebook::fboss::sflow::byte
+    kXdrFill[facebook::fboss::sflow::XDR_BASIC_BLOCK_SIZE] = {};
+}
+
 namespace facebook::fboss {
 
 namespace sflow {
 
 void serializeIP(RWPrivateCursor* cursor, folly::IPAddress ip) {
   // We first push the address type
-  cursor->writeBE<uint32_t>(static_cast<uint32_t>(AddressType::IP_V6));
+  cursor->writeBE<uint32_t>(static_cast<uint32_t>(
+      ip.isV4() ? AddressType::IP_V4 : AddressType::IP_V6));
   // then push the address in bytes
   cursor->push(ip.bytes(), ip.byteCount());
 }
 
-uint32_t sizeIP(folly::IPAddress const& ip) {
+uint32_t sizeIP(folly::IPAddress ip) {
   return 4 + ip.byteCount();
 }
 
@@ -48,8 +54,7 @@ void FlowRecord::serialize(RWPrivateCursor* cursor) const {
   if (this->flowDataLen % XDR_BASIC_BLOCK_SIZE != 0) {
     int fillCnt =
         XDR_BASIC_BLOCK_SIZE - this->flowDataLen % XDR_BASIC_BLOCK_SIZE;
-    std::vector<byte> crud(XDR_BASIC_BLOCK_SIZE, 0);
-    cursor->push(crud.data(), fillCnt);
+    cursor->push(kXdrFill, fillCnt);
   }
 }
 
@@ -87,8 +92,7 @@ void SampleRecord::serialize(RWPrivateCursor* cursor) const {
   if (this->sampleDataLen % XDR_BASIC_BLOCK_SIZE > 0) {
     int fillCnt =
         XDR_BASIC_BLOCK_SIZE - this->sampleDataLen % XDR_BASIC_BLOCK_SIZE;
-    std::vector<byte> crud(XDR_BASIC_BLOCK_SIZE, 0);
-    cursor->push(crud.data(), fillCnt);
+    cursor->push(kXdrFill, fillCnt);
   }
 }
 
@@ -97,19 +101,23 @@ uint32_t SampleRecord::size() const {
 }
 
 void SampleDatagramV5::serialize(RWPrivateCursor* cursor) const {
+  serializeHeader(cursor);
+  for (int i = 0; i < this->samplesCnt; i++) {
+    this->samples[i].serialize(cursor);
+  }
+}
+
+void SampleDatagramV5::serializeHeader(RWPrivateCursor* cursor) const {
   serializeIP(cursor, this->agentAddress);
 
   cursor->writeBE<uint32_t>(this->subAgentID);
   cursor->writeBE<uint32_t>(this->sequenceNumber);
   cursor->writeBE<uint32_t>(this->uptime);
   cursor->writeBE<uint32_t>(this->samplesCnt);
-  for (int i = 0; i < this->samplesCnt; i++) {
-    this->samples[i].serialize(cursor);
-  }
 }
 
 uint32_t SampleDatagramV5::size(const uint32_t recordsSize) const {
-  return this->agentAddress.byteCount() + 4 /* subAgentID */ +
+  return sizeIP(this->agentAddress) + 4 /* subAgentID */ +
       4 /*sequenceNumber */ + 4 /*uptime*/
       + 4 /*samplesCnt */ + recordsSize;
 }
@@ -119,6 +127,11 @@ void SampleDatagram::serialize(RWPrivateCursor* cursor) const {
   this->datagramV5.serialize(cursor);
 }
 
+void SampleDatagram::serializeHeader(RWPrivateCursor* cursor) const {
+  cursor->writeBE<uint32_t>(SampleDatagram::VERSION5);
+  this->datagramV5.serializeHeader(cursor);
+}
+
 uint32_t SampleDatagram::size(const uint32_t recordsSize) const {
   return 4 + this->datagramV5.size(recordsSize);
 }
@@ -132,8 +145,7 @@ void SampledHeader::serialize(RWPrivateCursor* cursor) const {
   if (this->headerLength % XDR_BASIC_BLOCK_SIZE > 0) {
     int fillCnt =
         XDR_BASIC_BLOCK_SIZE - this->headerLength % XDR_BASIC_BLOCK_SIZE;
-    std::vector<byte> crud(XDR_BASIC_BLOCK_SIZE, 0);
-    cursor->push(crud.data(), fillCnt);
+    cursor->push(kXdrFill, fillCnt);
   }
 }
 
@@ -124,6 +124,8 @@ struct SampleDatagramV5 {
   SampleRecord* samples;
 
   void serialize(folly::io::RWPrivateCursor* cursor) const;
+  // Everything but the samples, for samples serialized separately
+  void serializeHeader(folly::io::RWPrivateCursor* cursor) const;
   uint32_t size(const uint32_t recordsSize) const;
 };
 
@@ -134,6 +136,8 @@ struct SampleDatagram {
   SampleDatagramV5 datagramV5;
 
   void serialize(folly::io::RWPrivateCursor* cursor) const;
+  // Everything but the samples, for samples serialized separately
+  void serializeHeader(folly::io::RWPrivateCursor* cursor) const;
   uint32_t size(const uint32_t recordsSize) const;
 };
 
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/IPAddress.h>
+
+#include "fboss/agent/packet/SflowDatagramBatch.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+sflow::FlowSample makeSample(uint32_t sequenceNumber) {
+  sflow::FlowSample sample{};
+  sample.sequenceNumber = sequenceNumber;
+  sample.samplingRate = 123;
+  sample.input = 56;
+  sample.output = 6;
+  return sample;
+}
+
+sflow::SampledHeader makeHeader(const std::vector<uint8_t>& data) {
+  sflow::SampledHeader header;
+  header.protocol = sflow::HeaderProtocol::ETHERNET_ISO88023;
+  header.frameLength = 0;
+  header.stripped = 0;
+  header.headerLength = data.size();
+  header.header = data.data();
+  return header;
+}
+
+} // namespace
+
+TEST(SflowDatagramBatchTest, MatchesSampleDatagram) {
+  // Same sample as SflowStructsTest.Serialize
+  std::vector<uint8_t> data(11, 15);
+  auto header = makeHeader(data);
+  auto sample = makeSample(0);
+
+  sflow::SampleDatagramBatch batch(1400);
+  EXPECT_TRUE(batch.empty());
+  EXPECT_TRUE(batch.addSample(sample, header));
+  EXPECT_EQ(1, batch.numDatagrams());
+  EXPECT_EQ(1, batch.numSamples());
+
+  auto datagrams = batch.take();
+  ASSERT_EQ(1, datagrams.size());
+  EXPECT_EQ(1, datagrams[0].samplesCnt);
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(0, batch.numDatagrams());
+
+  // Serialize the same sample with SampleDatagram
+  std::vector<uint8_t> hb(28);
+  auto hbuf = folly::IOBuf::wrapBuffer(hb.data(), hb.size());
+  folly::io::RWPrivateCursor hc(hbuf.get());
+  header.serialize(&hc);
+
+  sflow::FlowRecord frecord;
+  frecord.flowFormat = 1;
+  frecord.flowDataLen = hb.size();
+  frecord.flowData = hb.data();
+  sample.flowRecordsCnt = 1;
+  sample.flowRecords = &frecord;
+
+  std::vector<uint8_t> fsb(68);
+  auto fbuf = folly::IOBuf::wrapBuffer(fsb.data(), fsb.size());
+  folly::io::RWPrivateCursor fc(fbuf.get());
+  sample.serialize(&fc);
+
+  sflow::SampleRecord record;
+  record.sampleType = 1;
+  record.sampleDataLen = fsb.size();
+  record.sampleData = fsb.data();
+
+  sflow::SampleDatagram datagram;
+  datagram.datagramV5.agentAddress = folly::IPAddress("2401:db00::1b");
+  datagram.datagramV5.subAgentID = 0;
+  datagram.datagramV5.sequenceNumber = 7;
+  datagram.datagramV5.uptime = 1000;
+  datagram.datagramV5.samplesCnt = 1;
+  datagram.datagramV5.samples = &record;
+
+  auto expectedSize = datagram.size(record.size());
+  EXPECT_EQ(116, expectedSize);
+  EXPECT_EQ(sflow::SampleDatagramBatch::kMaxHeaderSize, datagram.size(0));
+  std::vector<uint8_t> expected(expectedSize);
+  auto ebuf = folly::IOBuf::wrapBuffer(expected.data(), expected.size());
+  folly::io::RWPrivateCursor ec(ebuf.get());
+  datagram.serialize(&ec);
+  EXPECT_TRUE(ec.isAtEnd());
+
+  // Header followed by the batched samples
+  std::vector<uint8_t> actual(datagram.size(0));
+  auto abuf = folly::IOBuf::wrapBuffer(actual.data(), actual.size());
+  folly::io::RWPrivateCursor ac(abuf.get());
+  datagram.serializeHeader(&ac);
+  EXPECT_TRUE(ac.isAtEnd());
+  auto samples = datagrams[0].samples->coalesce();
+  actual.insert(actual.end(), samples.begin(), samples.end());
+
+  EXPECT_EQ(expected, actual);
+}
+
+TEST(SflowDatagramBatchTest, SplitsDatagrams) {
+  std::vector<uint8_t> data(128, 1);
+  auto header = makeHeader(data);
+
+  // 8 + 32 + 8 + 16 + 128 = 192 bytes per sample record
+  sflow::SampleDatagramBatch batch(
+      sflow::SampleDatagramBatch::kMaxHeaderSize + 3 * 192);
+  for (auto i = 0; i < 10; ++i) {
+    EXPECT_TRUE(batch.addSample(makeSample(i), header));
+  }
+  EXPECT_EQ(4, batch.numDatagrams());
+  EXPECT_EQ(10, batch.numSamples());
+
+  auto datagrams = batch.take();
+  ASSERT_EQ(4, datagrams.size());
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_EQ(3, datagrams[i].samplesCnt);
+    EXPECT_EQ(3 * 192, datagrams[i].samples->computeChainDataLength());
+  }
+  EXPECT_EQ(1, datagrams[3].samplesCnt);
+  EXPECT_EQ(192, datagrams[3].samples->computeChainDataLength());
+}
+
+TEST(SflowDatagramBatchTest, DropsOversizedSample) {
+  std::vector<uint8_t> data(128, 1);
+  auto header = makeHeader(data);
+
+  sflow::SampleDatagramBatch batch(
+      sflow::SampleDatagramBatch::kMaxHeaderSize + 191);
+  EXPECT_FALSE(batch.addSample(makeSample(0), header));
+  EXPECT_TRUE(batch.empty());
+  EXPECT_TRUE(batch.take().empty());
+}
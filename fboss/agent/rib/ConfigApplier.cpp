@@ -26,7 +26,8 @@ ConfigApplier::ConfigApplier(
     folly::Range<StaticRouteNoNextHopsIterator> staticDropRouteRange,
     folly::Range<StaticRouteWithNextHopsIterator> staticRouteRange,
     RoutingInformationBase::FibUpdateFunction fibUpdateCallback,
-    void* cookie)
+    void* cookie,
+    NextHopDependencyIndex* nextHopDependencies)
     : vrf_(vrf),
       v4NetworkToRoute_(v4NetworkToRoute),
       v6NetworkToRoute_(v6NetworkToRoute),
@@ -35,13 +36,15 @@ ConfigApplier::ConfigApplier(
       staticDropRouteRange_(staticDropRouteRange),
       staticRouteRange_(staticRouteRange),
       fibUpdateCallback_(fibUpdateCallback),
-      cookie_(cookie) {
+      cookie_(cookie),
+      nextHopDependencies_(nextHopDependencies) {
   CHECK_NOTNULL(v4NetworkToRoute_);
   CHECK_NOTNULL(v6NetworkToRoute_);
 }
 
 void ConfigApplier::updateRibAndFib() {
-  RouteUpdater updater(v4NetworkToRoute_, v6NetworkToRoute_);
+  RouteUpdater updater(
+      v4NetworkToRoute_, v6NetworkToRoute_, nextHopDependencies_);
 
   // Enable ALPM
   updater.addRoute(
@@ -107,7 +110,10 @@ void ConfigApplier::updateRibAndFib() {
   // Trigger recrusive resolution
   updater.updateDone();
 
-  fibUpdateCallback_(vrf_, *v4NetworkToRoute_, *v6NetworkToRoute_, cookie_);
+  // Config changes are rare, so always rebuild the whole FIB rather than
+  // relying on the SwitchState under construction matching the RIB.
+  fibUpdateCallback_(
+      vrf_, *v4NetworkToRoute_, *v6NetworkToRoute_, nullptr, cookie_);
 }
 
 void ConfigApplier::addInterfaceRoutes(
@@ -19,6 +19,7 @@
 
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
 #include "fboss/agent/rib/RoutingInformationBase.h"
 #include "fboss/agent/types.h"
 
@@ -51,7 +52,8 @@ class ConfigApplier {
       folly::Range<StaticRouteNoNextHopsIterator> staticDropRouteRange,
       folly::Range<StaticRouteWithNextHopsIterator> staticRouteRange,
       RoutingInformationBase::FibUpdateFunction fibUpdateCallback,
-      void* cookie);
+      void* cookie,
+      NextHopDependencyIndex* nextHopDependencies = nullptr);
 
   void updateRibAndFib();
 
@@ -70,6 +72,7 @@ class ConfigApplier {
   folly::Range<StaticRouteWithNextHopsIterator> staticRouteRange_;
   RoutingInformationBase::FibUpdateFunction fibUpdateCallback_;
   void* cookie_;
+  NextHopDependencyIndex* nextHopDependencies_;
 };
 
 } // namespace facebook::fboss::rib
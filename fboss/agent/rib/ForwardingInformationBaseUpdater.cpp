@@ -17,16 +17,35 @@
 #include <folly/logging/xlog.h>
 
 #include <algorithm>
+#include <optional>
+#include <type_traits>
+
+namespace {
+template <typename AddressT>
+AddressT toAddressT(const folly::IPAddress& addr);
+
+template <>
+folly::IPAddressV4 toAddressT(const folly::IPAddress& addr) {
+  return addr.asV4();
+}
+
+template <>
+folly::IPAddressV6 toAddressT(const folly::IPAddress& addr) {
+  return addr.asV6();
+}
+} // namespace
 
 namespace facebook::fboss::rib {
 
 ForwardingInformationBaseUpdater::ForwardingInformationBaseUpdater(
     RouterID vrf,
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
-    const IPv6NetworkToRouteMap& v6NetworkToRoute)
+    const IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const UpdatedPrefixes* updatedPrefixes)
     : vrf_(vrf),
       v4NetworkToRoute_(v4NetworkToRoute),
-      v6NetworkToRoute_(v6NetworkToRoute) {}
+      v6NetworkToRoute_(v6NetworkToRoute),
+      updatedPrefixes_(updatedPrefixes) {}
 
 std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
     const std::shared_ptr<SwitchState>& state) {
@@ -45,6 +64,14 @@ std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
 
   auto nextFibContainer = previousFibContainer->modify(&nextState);
 
+  if (updatedPrefixes_) {
+    nextFibContainer->writableFields()->fibV4 =
+        patchFib(v4NetworkToRoute_, previousFibContainer->getFibV4());
+    nextFibContainer->writableFields()->fibV6 =
+        patchFib(v6NetworkToRoute_, previousFibContainer->getFibV6());
+    return nextState;
+  }
+
   nextFibContainer->writableFields()->fibV4 =
       std::shared_ptr<ForwardingInformationBaseV4>(createUpdatedFib(
           v4NetworkToRoute_, previousFibContainer->getFibV4()));
@@ -56,6 +83,61 @@ std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
   return nextState;
 }
 
+template <typename AddressT>
+std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+ForwardingInformationBaseUpdater::patchFib(
+    const facebook::fboss::rib::NetworkToRouteMap<AddressT>& rib,
+    const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
+        fib) {
+  constexpr bool kIsV4 = std::is_same_v<AddressT, folly::IPAddressV4>;
+
+  std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>
+      updatedFib;
+  for (const auto& prefix : *updatedPrefixes_) {
+    if (prefix.first.isV4() != kIsV4) {
+      continue;
+    }
+    facebook::fboss::RoutePrefix<AddressT> fibPrefix{
+        toAddressT<AddressT>(prefix.first), prefix.second};
+
+    auto ribIt = rib.exactMatch(fibPrefix.network, fibPrefix.mask);
+    auto fibRoute = fib->getNodeIf(fibPrefix);
+    bool ribRouteResolved = ribIt != rib.end() && ribIt->value().isResolved();
+    if (!ribRouteResolved && !fibRoute) {
+      continue;
+    }
+    std::optional<facebook::fboss::RouteNextHopEntry> fibNextHop;
+    if (ribRouteResolved) {
+      fibNextHop = toFibNextHopCached(ribIt->value().getForwardInfo());
+      if (fibRoute && *fibNextHop == fibRoute->getForwardInfo()) {
+        // Reuse prior FIB route
+        continue;
+      }
+    }
+
+    // Only copy the FIB once we know it actually changes
+    if (!updatedFib) {
+      updatedFib = fib->clone();
+    }
+    // Go through the NodeMap API so that the FIB delta only needs to visit
+    // the prefixes changed here.
+    if (!ribRouteResolved) {
+      updatedFib->removeNode(fibPrefix);
+    } else if (fibRoute) {
+      updatedFib->updateNode(
+          toFibRoute(ribIt->value(), std::move(*fibNextHop)));
+    } else {
+      updatedFib->addNode(toFibRoute(ribIt->value(), std::move(*fibNextHop)));
+    }
+  }
+
+  if (!updatedFib) {
+    return fib;
+  }
+
+  return updatedFib;
+}
+
 template <typename AddressT>
 std::unique_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
 ForwardingInformationBaseUpdater::createUpdatedFib(
@@ -65,8 +147,9 @@ ForwardingInformationBaseUpdater::createUpdatedFib(
   // TODO(samank): updateFib should have size equal to the number of resovled
   // routes in the rib
 
-  typename facebook::fboss::ForwardingInformationBase<
-      AddressT>::Base::NodeContainer updatedFib;
+  // Start from the existing routes so that every route which is unchanged
+  // stays shared with the current FIB.
+  auto updatedFib = fib->getAllNodes();
 
   for (const auto& entry : rib) {
     const facebook::fboss::rib::Route<AddressT>& ribRoute = entry.value();
@@ -82,29 +165,24 @@ ForwardingInformationBaseUpdater::createUpdatedFib(
                                                      ribRoute.prefix().mask};
     std::shared_ptr<facebook::fboss::Route<AddressT>> fibRoute =
         fib->getNodeIf(fibPrefix);
-    if (fibRoute) {
-      if (toFibNextHop(ribRoute.getForwardInfo()) ==
-          fibRoute->getForwardInfo()) {
-        // Reuse prior FIB route
-      } else {
-        fibRoute = toFibRoute(ribRoute);
-      }
+    auto fibNextHop = toFibNextHopCached(ribRoute.getForwardInfo());
+    if (fibRoute && fibNextHop == fibRoute->getForwardInfo()) {
+      // Reuse prior FIB route
     } else {
-      fibRoute = toFibRoute(ribRoute);
+      fibRoute = toFibRoute(ribRoute, std::move(fibNextHop));
     }
 
-    updatedFib.emplace_hint(updatedFib.cend(), fibPrefix, fibRoute);
+    updatedFib.insert_or_assign(fibPrefix, fibRoute);
   }
 
-  DCHECK_EQ(
-      updatedFib.size(),
-      std::count_if(
-          rib.begin(),
-          rib.end(),
-          [](const typename std::remove_reference_t<decltype(
-                 rib)>::ConstIterator::TreeNode& entry) {
-            return entry.value().isResolved();
-          }));
+  // Remove the routes which are no longer resolved in the RIB
+  for (const auto& prefixAndRoute : fib->getAllNodes()) {
+    const auto& fibPrefix = prefixAndRoute.first;
+    auto ribIt = rib.exactMatch(fibPrefix.network, fibPrefix.mask);
+    if (ribIt == rib.end() || !ribIt->value().isResolved()) {
+      updatedFib.erase(fibPrefix);
+    }
+  }
 
   return std::make_unique<ForwardingInformationBase<AddressT>>(
       std::move(updatedFib));
@@ -138,9 +216,30 @@ ForwardingInformationBaseUpdater::toFibNextHop(
   XLOG(FATAL) << "Unknown RouteNextHopEntry::Action value";
 }
 
+facebook::fboss::RouteNextHopEntry
+ForwardingInformationBaseUpdater::toFibNextHopCached(
+    const RouteNextHopEntry& ribNextHopEntry) {
+  if (ribNextHopEntry.getAction() != RouteNextHopEntry::Action::NEXTHOPS) {
+    return toFibNextHop(ribNextHopEntry);
+  }
+  const auto& ribNextHopSet = ribNextHopEntry.getInternedNextHopSet();
+  auto itr = fibNextHopSets_.find(ribNextHopSet);
+  if (itr == fibNextHopSets_.end()) {
+    itr = fibNextHopSets_
+              .emplace(
+                  ribNextHopSet,
+                  toFibNextHop(ribNextHopEntry).getInternedNextHopSet())
+              .first;
+  }
+  return facebook::fboss::RouteNextHopEntry(
+      itr->second, ribNextHopEntry.getAdminDistance());
+}
+
 template <typename AddrT>
 std::unique_ptr<facebook::fboss::Route<AddrT>>
-ForwardingInformationBaseUpdater::toFibRoute(const Route<AddrT>& ribRoute) {
+ForwardingInformationBaseUpdater::toFibRoute(
+    const Route<AddrT>& ribRoute,
+    facebook::fboss::RouteNextHopEntry fibNextHop) {
   CHECK(ribRoute.isResolved());
 
   facebook::fboss::RoutePrefix<AddrT> fibPrefix;
@@ -149,7 +248,7 @@ ForwardingInformationBaseUpdater::toFibRoute(const Route<AddrT>& ribRoute) {
 
   auto fibRoute = std::make_unique<facebook::fboss::Route<AddrT>>(fibPrefix);
 
-  fibRoute->setResolved(toFibNextHop(ribRoute.getForwardInfo()));
+  fibRoute->setResolved(std::move(fibNextHop));
   if (ribRoute.isConnected()) {
     fibRoute->setConnected();
   }
@@ -159,9 +258,11 @@ ForwardingInformationBaseUpdater::toFibRoute(const Route<AddrT>& ribRoute) {
 
 template std::unique_ptr<facebook::fboss::Route<folly::IPAddressV4>>
 ForwardingInformationBaseUpdater::toFibRoute<folly::IPAddressV4>(
-    const Route<folly::IPAddressV4>&);
+    const Route<folly::IPAddressV4>&,
+    facebook::fboss::RouteNextHopEntry);
 template std::unique_ptr<facebook::fboss::Route<folly::IPAddressV6>>
 ForwardingInformationBaseUpdater::toFibRoute<folly::IPAddressV6>(
-    const Route<folly::IPAddressV6>&);
+    const Route<folly::IPAddressV6>&,
+    facebook::fboss::RouteNextHopEntry);
 
 } // namespace facebook::fboss::rib
@@ -11,12 +11,14 @@
 
 #include "fboss/agent/rib/NetworkToRouteMap.h"
 #include "fboss/agent/rib/Route.h"
+#include "fboss/agent/rib/RouteTypes.h"
 #include "fboss/agent/state/ForwardingInformationBase.h"
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/RouteNextHopEntry.h"
 #include "fboss/agent/types.h"
 
 #include <memory>
+#include <unordered_map>
 
 namespace facebook::fboss {
 
@@ -30,10 +32,16 @@ class RouteNextHopEntry;
 
 class ForwardingInformationBaseUpdater {
  public:
+  /*
+   * If `updatedPrefixes` is provided, only those prefixes are patched into a
+   * clone of the current FIB and every other FIB entry is assumed to already
+   * reflect the RIB. Otherwise the FIB is rebuilt from the whole RIB.
+   */
   ForwardingInformationBaseUpdater(
       RouterID vrf,
       const IPv4NetworkToRouteMap& v4NetworkToRoute,
-      const IPv6NetworkToRouteMap& v6NetworkToRoute);
+      const IPv6NetworkToRouteMap& v6NetworkToRoute,
+      const UpdatedPrefixes* updatedPrefixes = nullptr);
 
   std::shared_ptr<SwitchState> operator()(
       const std::shared_ptr<SwitchState>& state);
@@ -42,9 +50,23 @@ class ForwardingInformationBaseUpdater {
       const RouteNextHopEntry& ribNextHopEntry);
   template <typename AddrT>
   static std::unique_ptr<facebook::fboss::Route<AddrT>> toFibRoute(
-      const Route<AddrT>& ribRoute);
+      const Route<AddrT>& ribRoute) {
+    return toFibRoute(ribRoute, toFibNextHop(ribRoute.getForwardInfo()));
+  }
 
  private:
+  template <typename AddrT>
+  static std::unique_ptr<facebook::fboss::Route<AddrT>> toFibRoute(
+      const Route<AddrT>& ribRoute,
+      facebook::fboss::RouteNextHopEntry fibNextHop);
+
+  /*
+   * Same as toFibNextHop, but converts each distinct RIB next hop set only
+   * once per update, since most routes share a few ECMP groups.
+   */
+  facebook::fboss::RouteNextHopEntry toFibNextHopCached(
+      const RouteNextHopEntry& ribNextHopEntry);
+
   template <typename AddressT>
   std::unique_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
   createUpdatedFib(
@@ -52,9 +74,21 @@ class ForwardingInformationBaseUpdater {
       const std::shared_ptr<
           facebook::fboss::ForwardingInformationBase<AddressT>>& fib);
 
+  template <typename AddressT>
+  std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+  patchFib(
+      const facebook::fboss::rib::NetworkToRouteMap<AddressT>& rib,
+      const std::shared_ptr<
+          facebook::fboss::ForwardingInformationBase<AddressT>>& fib);
+
   RouterID vrf_;
   const IPv4NetworkToRouteMap& v4NetworkToRoute_;
   const IPv6NetworkToRouteMap& v6NetworkToRoute_;
+  const UpdatedPrefixes* updatedPrefixes_;
+  std::unordered_map<
+      RouteNextHopEntry::InternedNextHopSet,
+      facebook::fboss::RouteNextHopEntry::InternedNextHopSet>
+      fibNextHopSets_;
 };
 
 } // namespace facebook::fboss::rib
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
+
+namespace facebook::fboss::rib {
+
+namespace {
+template <typename NextHopToRoutes, typename AddressT, typename Prefix>
+void eraseDependency(
+    NextHopToRoutes& nextHopToRoutes,
+    const AddressT& nexthop,
+    const Prefix& route) {
+  auto it = nextHopToRoutes.find(nexthop);
+  if (it == nextHopToRoutes.end()) {
+    return;
+  }
+  it->second.erase(route);
+  if (it->second.empty()) {
+    nextHopToRoutes.erase(it);
+  }
+}
+} // namespace
+
+void NextHopDependencyIndex::addDependency(
+    const folly::IPAddress& nexthop,
+    const Prefix& route) {
+  if (nexthop.isV4()) {
+    v4NextHopToRoutes_[nexthop.asV4()].insert(route);
+  } else {
+    v6NextHopToRoutes_[nexthop.asV6()].insert(route);
+  }
+}
+
+void NextHopDependencyIndex::delDependency(
+    const folly::IPAddress& nexthop,
+    const Prefix& route) {
+  if (nexthop.isV4()) {
+    eraseDependency(v4NextHopToRoutes_, nexthop.asV4(), route);
+  } else {
+    eraseDependency(v6NextHopToRoutes_, nexthop.asV6(), route);
+  }
+}
+
+void NextHopDependencyIndex::setDependencies(
+    const Prefix& route,
+    const std::vector<folly::IPAddress>& nexthops) {
+  removeRoute(route);
+  if (nexthops.empty()) {
+    return;
+  }
+  for (const auto& nexthop : nexthops) {
+    addDependency(nexthop, route);
+  }
+  routeToNextHops_.emplace(route, nexthops);
+}
+
+void NextHopDependencyIndex::removeRoute(const Prefix& route) {
+  auto it = routeToNextHops_.find(route);
+  if (it == routeToNextHops_.end()) {
+    return;
+  }
+  for (const auto& nexthop : it->second) {
+    delDependency(nexthop, route);
+  }
+  routeToNextHops_.erase(it);
+}
+
+void NextHopDependencyIndex::clear() {
+  v4NextHopToRoutes_.clear();
+  v6NextHopToRoutes_.clear();
+  routeToNextHops_.clear();
+  initialized_ = false;
+}
+
+} // namespace facebook::fboss::rib
@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <boost/container/flat_set.hpp>
+#include <folly/IPAddress.h>
+
+#include <map>
+#include <vector>
+
+namespace facebook::fboss::rib {
+
+/*
+ * NextHopDependencyIndex is a reverse index from an (unresolved) next-hop
+ * address to the set of routes whose best entry contains that next-hop.
+ *
+ * Recursive resolution of a route R only depends on the routes that are the
+ * longest match for each of R's next-hops. When a prefix P is added, removed
+ * or modified, the only routes whose resolution can change are therefore
+ * those having a next-hop inside P, plus, transitively, the routes which
+ * depend on those. RouteUpdater uses this index to compute that closure and
+ * re-resolve only the affected routes instead of the whole table.
+ *
+ * Next-hops of either address family are tracked, since a v4 route may be
+ * resolved through a v6 next-hop and vice versa. The per-family maps are kept
+ * separate so that all next-hops covered by a prefix are contiguous.
+ */
+class NextHopDependencyIndex {
+ public:
+  using Prefix = folly::CIDRNetwork;
+
+  /*
+   * Replace the set of next-hops that `route` depends on.
+   */
+  void setDependencies(
+      const Prefix& route,
+      const std::vector<folly::IPAddress>& nexthops);
+  void removeRoute(const Prefix& route);
+
+  /*
+   * Invoke `fn` with every route having at least one next-hop in `network`.
+   * A route may be visited more than once if several of its next-hops fall
+   * within `network`.
+   */
+  template <typename Fn>
+  void forEachDependentRoute(const Prefix& network, Fn&& fn) const {
+    if (network.first.isV4()) {
+      forEachDependentRouteImpl(
+          v4NextHopToRoutes_, network.first.asV4(), network.second, fn);
+    } else {
+      forEachDependentRouteImpl(
+          v6NextHopToRoutes_, network.first.asV6(), network.second, fn);
+    }
+  }
+
+  /*
+   * The index is only usable once it has been populated from a fully
+   * resolved route table. Until then, RouteUpdater falls back to resolving
+   * every route.
+   */
+  bool isInitialized() const {
+    return initialized_;
+  }
+  void setInitialized() {
+    initialized_ = true;
+  }
+  void clear();
+
+  size_t numRoutes() const {
+    return routeToNextHops_.size();
+  }
+
+ private:
+  using Routes = boost::container::flat_set<Prefix>;
+  template <typename AddressT>
+  using NextHopToRoutes = std::map<AddressT, Routes>;
+
+  template <typename AddressT, typename Fn>
+  static void forEachDependentRouteImpl(
+      const NextHopToRoutes<AddressT>& nextHopToRoutes,
+      const AddressT& network,
+      uint8_t mask,
+      Fn& fn) {
+    // All addresses in network/mask sort contiguously starting at the
+    // masked network address.
+    for (auto it = nextHopToRoutes.lower_bound(network.mask(mask));
+         it != nextHopToRoutes.end() && it->first.inSubnet(network, mask);
+         ++it) {
+      for (const auto& route : it->second) {
+        fn(route);
+      }
+    }
+  }
+
+  void addDependency(const folly::IPAddress& nexthop, const Prefix& route);
+  void delDependency(const folly::IPAddress& nexthop, const Prefix& route);
+
+  NextHopToRoutes<folly::IPAddressV4> v4NextHopToRoutes_;
+  NextHopToRoutes<folly::IPAddressV6> v6NextHopToRoutes_;
+  std::map<Prefix, std::vector<folly::IPAddress>> routeToNextHops_;
+  bool initialized_{false};
+};
+
+} // namespace facebook::fboss::rib
@@ -0,0 +1,217 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/rib/RouteBatch.h"
+
+#include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/FbossError.h"
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+namespace {
+
+using facebook::fboss::rib::RouteBatch;
+
+// Below this many routes per thread, splitting a conversion isn't worth it
+constexpr size_t kMinRoutesPerThread = 10000;
+
+/*
+ * Split [0, size) into consecutive ranges and return convert(begin, end) for
+ * each, in order. If there are enough of them, the ranges after the first
+ * are converted on the executor while the calling thread converts the first.
+ */
+template <typename Convert>
+auto convertInChunks(size_t size, folly::Executor* executor, Convert convert) {
+  using Result = decltype(convert(size_t(0), size_t(0)));
+  size_t numThreads = std::min(
+      {size / kMinRoutesPerThread,
+       RouteBatch::kMaxConversionThreads,
+       static_cast<size_t>(std::thread::hardware_concurrency())});
+  std::vector<Result> results;
+  if (!executor || numThreads <= 1) {
+    results.push_back(convert(0, size));
+    return results;
+  }
+
+  auto chunkSize = (size + numThreads - 1) / numThreads;
+  std::vector<folly::Future<Result>> futures;
+  for (auto begin = chunkSize; begin < size; begin += chunkSize) {
+    auto end = std::min(begin + chunkSize, size);
+    futures.push_back(folly::via(
+        executor, [&convert, begin, end] { return convert(begin, end); }));
+  }
+  // The calling thread converts the first chunk itself. Wait for the other
+  // chunks even if it fails, since they refer to the routes being converted.
+  auto first = folly::makeTryWith([&] { return convert(0, chunkSize); });
+  auto rest = folly::collectAll(std::move(futures)).get();
+  results.push_back(std::move(first).value());
+  for (auto& result : rest) {
+    results.push_back(std::move(result).value());
+  }
+  return results;
+}
+
+template <typename Route>
+void appendRoutes(
+    std::vector<Route>* routes,
+    std::vector<Route>&& toAppend,
+    uint32_t indexOffset) {
+  if (routes->empty() && indexOffset == 0) {
+    *routes = std::move(toAppend);
+    return;
+  }
+  routes->reserve(routes->size() + toAppend.size());
+  for (auto& route : toAppend) {
+    routes->emplace_back(std::move(route.first), route.second + indexOffset);
+  }
+}
+
+/*
+ * Decode the packed routes of one address family of a UnicastRouteBatch.
+ */
+template <typename AddrT>
+std::vector<std::pair<facebook::fboss::rib::RoutePrefix<AddrT>, uint32_t>>
+decodeRoutes(
+    const std::string& networks,
+    const std::string& prefixLengths,
+    const std::vector<int32_t>& nextHopIndices,
+    size_t numNextHopEntries,
+    folly::Executor* executor) {
+  auto numRoutes = nextHopIndices.size();
+  if (networks.size() != numRoutes * AddrT::byteCount() ||
+      prefixLengths.size() != numRoutes) {
+    throw facebook::fboss::FbossError(
+        "Route batch has ",
+        numRoutes,
+        " next hop indices, but ",
+        networks.size(),
+        " network bytes and ",
+        prefixLengths.size(),
+        " prefix lengths for IPv",
+        AddrT::bitCount() == 32 ? 4 : 6);
+  }
+
+  auto convertRange = [&](size_t begin, size_t end) {
+    std::vector<std::pair<facebook::fboss::rib::RoutePrefix<AddrT>, uint32_t>>
+        routes;
+    routes.reserve(end - begin);
+    auto bytes = folly::ByteRange(folly::StringPiece(networks));
+    for (auto i = begin; i < end; ++i) {
+      auto network = AddrT::fromBinary(
+          bytes.subpiece(i * AddrT::byteCount(), AddrT::byteCount()));
+      auto mask = static_cast<uint8_t>(prefixLengths[i]);
+      auto index = nextHopIndices[i];
+      if (mask > AddrT::bitCount() || index < 0 ||
+          static_cast<size_t>(index) >= numNextHopEntries) {
+        throw facebook::fboss::FbossError(
+            "Invalid route in batch: ",
+            network,
+            "/",
+            static_cast<int>(mask),
+            " with next hop index ",
+            index);
+      }
+      routes.emplace_back(
+          facebook::fboss::rib::RoutePrefix<AddrT>{network.mask(mask), mask},
+          index);
+    }
+    return routes;
+  };
+
+  auto chunks = convertInChunks(numRoutes, executor, convertRange);
+  auto routes = std::move(chunks.front());
+  for (size_t i = 1; i < chunks.size(); ++i) {
+    appendRoutes(&routes, std::move(chunks[i]), 0);
+  }
+  return routes;
+}
+
+} // namespace
+
+namespace facebook::fboss::rib {
+
+RouteBatch RouteBatch::fromThrift(
+    const UnicastRouteBatch& batch,
+    AdminDistance defaultAdminDistance,
+    folly::Executor* executor) {
+  RouteBatch converted;
+  converted.nextHopEntries.reserve(batch.nextHops_ref()->size());
+  for (const auto& nextHops : *batch.nextHops_ref()) {
+    converted.nextHopEntries.push_back(RouteNextHopEntry::from(
+        *nextHops.nextHops_ref(),
+        nextHops.adminDistance_ref().value_or(defaultAdminDistance)));
+  }
+
+  converted.v4Routes = decodeRoutes<folly::IPAddressV4>(
+      *batch.v4Networks_ref(),
+      *batch.v4PrefixLengths_ref(),
+      *batch.v4NextHopIndices_ref(),
+      converted.nextHopEntries.size(),
+      executor);
+  converted.v6Routes = decodeRoutes<folly::IPAddressV6>(
+      *batch.v6Networks_ref(),
+      *batch.v6PrefixLengths_ref(),
+      *batch.v6NextHopIndices_ref(),
+      converted.nextHopEntries.size(),
+      executor);
+  return converted;
+}
+
+RouteBatch RouteBatch::fromUnicastRoutes(
+    const std::vector<UnicastRoute>& routes,
+    AdminDistance defaultAdminDistance,
+    folly::Executor* executor) {
+  auto convertRange = [&](size_t begin, size_t end) {
+    RouteBatch batch;
+    batch.nextHopEntries.reserve(end - begin);
+    for (auto i = begin; i < end; ++i) {
+      const auto& route = routes[i];
+      auto network = facebook::network::toIPAddress(route.dest.ip);
+      auto prefixLength = route.dest.prefixLength;
+      if (prefixLength < 0 ||
+          static_cast<size_t>(prefixLength) > network.bitCount()) {
+        throw facebook::fboss::FbossError(
+            "Invalid route: ", network, "/", prefixLength);
+      }
+      auto mask = static_cast<uint8_t>(prefixLength);
+      auto index = static_cast<uint32_t>(batch.nextHopEntries.size());
+      batch.nextHopEntries.push_back(
+          RouteNextHopEntry::from(route, defaultAdminDistance));
+      if (network.isV4()) {
+        batch.v4Routes.emplace_back(
+            PrefixV4{network.asV4().mask(mask), mask}, index);
+      } else {
+        batch.v6Routes.emplace_back(
+            PrefixV6{network.asV6().mask(mask), mask}, index);
+      }
+    }
+    return batch;
+  };
+
+  auto chunks = convertInChunks(routes.size(), executor, convertRange);
+  auto batch = std::move(chunks.front());
+  for (size_t i = 1; i < chunks.size(); ++i) {
+    auto offset = static_cast<uint32_t>(batch.nextHopEntries.size());
+    batch.nextHopEntries.insert(
+        batch.nextHopEntries.end(),
+        std::make_move_iterator(chunks[i].nextHopEntries.begin()),
+        std::make_move_iterator(chunks[i].nextHopEntries.end()));
+    appendRoutes(&batch.v4Routes, std::move(chunks[i].v4Routes), offset);
+    appendRoutes(&batch.v6Routes, std::move(chunks[i].v6Routes), offset);
+  }
+  return batch;
+}
+
+} // namespace facebook::fboss::rib
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+#include "fboss/agent/rib/RouteNextHopEntry.h"
+#include "fboss/agent/rib/RouteTypes.h"
+#include "fboss/agent/types.h"
+
+#include <folly/Executor.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss::rib {
+
+/*
+ * Routes to add to the RIB in one update, already converted from thrift.
+ * Routes refer to their next hop entry by index, so that an entry shared by
+ * many routes is converted once. Prefixes are masked.
+ *
+ * Converting a batch does not touch the RIB, so it is done before taking
+ * the route table lock, and large batches are split across the threads of
+ * the given executor. Without one, batches are converted inline.
+ */
+struct RouteBatch {
+  // Most threads, including the calling one, that convert one batch
+  static constexpr size_t kMaxConversionThreads = 8;
+
+  std::vector<RouteNextHopEntry> nextHopEntries;
+  std::vector<std::pair<PrefixV4, uint32_t>> v4Routes;
+  std::vector<std::pair<PrefixV6, uint32_t>> v6Routes;
+
+  size_t size() const {
+    return v4Routes.size() + v6Routes.size();
+  }
+
+  /*
+   * Convert routes in columnar form. Throws FbossError if the batch is
+   * malformed.
+   */
+  static RouteBatch fromThrift(
+      const UnicastRouteBatch& batch,
+      AdminDistance defaultAdminDistance,
+      folly::Executor* executor = nullptr);
+
+  /*
+   * Convert a list of routes, each with its own next hop entry.
+   */
+  static RouteBatch fromUnicastRoutes(
+      const std::vector<UnicastRoute>& routes,
+      AdminDistance defaultAdminDistance,
+      folly::Executor* executor = nullptr);
+};
+
+} // namespace facebook::fboss::rib
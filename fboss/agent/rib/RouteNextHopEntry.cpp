@@ -14,6 +14,7 @@
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 #include "fboss/agent/state/LabelForwardingAction.h"
 
+#include <folly/hash/Hash.h>
 #include <folly/logging/xlog.h>
 #include <gflags/gflags.h>
 #include <numeric>
@@ -66,7 +67,7 @@ RouteNextHopEntry::RouteNextHopEntry(NextHopSet nhopSet, AdminDistance distance)
     : adminDistance_(distance),
       action_(Action::NEXTHOPS),
       nhopSet_(std::move(nhopSet)) {
-  if (nhopSet_.size() == 0) {
+  if (nhopSet_->size() == 0) {
     throw FbossError("Empty nexthop set is passed to the RouteNextHopEntry");
   }
 }
@@ -99,7 +100,7 @@ std::string RouteNextHopEntry::str() const {
 bool operator==(const RouteNextHopEntry& a, const RouteNextHopEntry& b) {
   return (
       a.getAction() == b.getAction() and
-      a.getNextHopSet() == b.getNextHopSet() and
+      a.getInternedNextHopSet() == b.getInternedNextHopSet() and
       a.getAdminDistance() == b.getAdminDistance());
 }
 
@@ -107,9 +108,25 @@ bool operator<(const RouteNextHopEntry& a, const RouteNextHopEntry& b) {
   if (a.getAdminDistance() != b.getAdminDistance()) {
     return a.getAdminDistance() < b.getAdminDistance();
   }
-  return (
-      (a.getAction() == b.getAction()) ? (a.getNextHopSet() < b.getNextHopSet())
-                                       : a.getAction() < b.getAction());
+  if (a.getAction() != b.getAction()) {
+    return a.getAction() < b.getAction();
+  }
+  return a.getInternedNextHopSet() != b.getInternedNextHopSet() &&
+      a.getNextHopSet() < b.getNextHopSet();
+}
+
+size_t RouteNextHopEntry::NextHopSetHash::operator()(
+    const NextHopSet& nhops) const {
+  // Label forwarding actions are left out, equality checks them anyway
+  size_t hash = nhops.size();
+  for (const auto& nhop : nhops) {
+    hash = folly::hash::hash_combine(
+        hash,
+        nhop.addr().hash(),
+        nhop.isResolved() ? static_cast<uint32_t>(nhop.intf()) : 0,
+        nhop.weight());
+  }
+  return hash;
 }
 
 // Methods for RouteNextHopEntry
@@ -148,7 +165,7 @@ folly::dynamic RouteNextHopEntry::toFollyDynamic() const {
   folly::dynamic entry = folly::dynamic::object;
   entry[kAction] = forwardActionStr(action_);
   folly::dynamic nhops = folly::dynamic::array;
-  for (const auto& nhop : nhopSet_) {
+  for (const auto& nhop : *nhopSet_) {
     nhops.push_back(nhop.toFollyDynamic());
   }
   entry[kNexthops] = std::move(nhops);
@@ -165,25 +182,29 @@ RouteNextHopEntry RouteNextHopEntry::fromFollyDynamic(
       : AdminDistance(entryJson[kAdminDistance].asInt());
   RouteNextHopEntry entry(Action::DROP, adminDistance);
   entry.action_ = action;
+  NextHopSet nhops;
   for (const auto& nhop : entryJson[kNexthops]) {
-    entry.nhopSet_.insert(util::nextHopFromFollyDynamic(nhop));
+    nhops.insert(util::nextHopFromFollyDynamic(nhop));
   }
+  entry.nhopSet_ = InternedNextHopSet(std::move(nhops));
   return entry;
 }
 
 RouteNextHopEntry RouteNextHopEntry::from(
     const facebook::fboss::UnicastRoute& route,
     AdminDistance defaultAdminDistance) {
-  std::vector<NextHopThrift> nhts;
+  auto adminDistance = route.adminDistance_ref().value_or(defaultAdminDistance);
   if (route.nextHops_ref()->empty() && !route.nextHopAddrs_ref()->empty()) {
-    nhts = thriftNextHopsFromAddresses(*route.nextHopAddrs_ref());
-  } else {
-    nhts = *route.nextHops_ref();
+    return from(
+        thriftNextHopsFromAddresses(*route.nextHopAddrs_ref()), adminDistance);
   }
+  return from(*route.nextHops_ref(), adminDistance);
+}
 
-  RouteNextHopSet nexthops = util::toRouteNextHopSet(nhts);
-
-  auto adminDistance = route.adminDistance_ref().value_or(defaultAdminDistance);
+RouteNextHopEntry RouteNextHopEntry::from(
+    const std::vector<NextHopThrift>& nextHops,
+    AdminDistance adminDistance) {
+  RouteNextHopSet nexthops = util::toRouteNextHopSet(nextHops);
 
   return nexthops.size()
       ? RouteNextHopEntry(std::move(nexthops), adminDistance)
@@ -194,7 +215,7 @@ bool RouteNextHopEntry::isValid(bool forMplsRoute) const {
   bool valid = true;
   if (!forMplsRoute) {
     /* for ip2mpls routes, next hop label forwarding action must be push */
-    for (const auto& nexthop : nhopSet_) {
+    for (const auto& nexthop : *nhopSet_) {
       if (action_ != Action::NEXTHOPS) {
         continue;
       }
@@ -15,6 +15,7 @@
 
 #include "fboss/agent/rib/RouteNextHop.h"
 #include "fboss/agent/rib/RouteTypes.h"
+#include "fboss/lib/Interned.h"
 
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 
@@ -34,6 +35,11 @@ class RouteNextHopEntry {
  public:
   using Action = RouteForwardAction;
   using NextHopSet = boost::container::flat_set<NextHop>;
+  struct NextHopSetHash {
+    size_t operator()(const NextHopSet& nhops) const;
+  };
+  // All entries with the same next hops share one copy of them
+  using InternedNextHopSet = Interned<NextHopSet, NextHopSetHash>;
 
   RouteNextHopEntry(Action action, AdminDistance distance)
       : adminDistance_(distance), action_(action) {
@@ -43,9 +49,9 @@ class RouteNextHopEntry {
   RouteNextHopEntry(NextHopSet nhopSet, AdminDistance distance);
 
   RouteNextHopEntry(NextHop nhop, AdminDistance distance)
-      : adminDistance_(distance), action_(Action::NEXTHOPS) {
-    nhopSet_.emplace(std::move(nhop));
-  }
+      : adminDistance_(distance),
+        action_(Action::NEXTHOPS),
+        nhopSet_(NextHopSet{std::move(nhop)}) {}
 
   AdminDistance getAdminDistance() const {
     return adminDistance_;
@@ -56,6 +62,10 @@ class RouteNextHopEntry {
   }
 
   const NextHopSet& getNextHopSet() const {
+    return *nhopSet_;
+  }
+
+  const InternedNextHopSet& getInternedNextHopSet() const {
     return nhopSet_;
   }
 
@@ -87,13 +97,17 @@ class RouteNextHopEntry {
 
   // Reset the NextHopSet
   void reset() {
-    nhopSet_.clear();
+    nhopSet_ = InternedNextHopSet();
     action_ = Action::DROP;
   }
 
   static RouteNextHopEntry from(
       const facebook::fboss::UnicastRoute& route,
       AdminDistance defaultAdminDistance);
+  // A DROP entry if `nextHops` is empty
+  static RouteNextHopEntry from(
+      const std::vector<NextHopThrift>& nextHops,
+      AdminDistance adminDistance);
 
   bool isValid(bool forMplsRoute = false) const;
 
@@ -107,7 +121,7 @@ class RouteNextHopEntry {
  private:
   AdminDistance adminDistance_;
   Action action_{Action::DROP};
-  NextHopSet nhopSet_;
+  InternedNextHopSet nhopSet_;
 };
 
 /**
@@ -13,6 +13,7 @@
 #include <folly/FBString.h>
 #include <folly/IPAddress.h>
 #include <folly/dynamic.h>
+#include <set>
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 #include "fboss/agent/state/RouteTypes.h"
 #include "fboss/agent/types.h"
@@ -77,4 +78,10 @@ using PrefixV6 = RoutePrefix<folly::IPAddressV6>;
 void toAppend(const PrefixV4& prefix, std::string* result);
 void toAppend(const PrefixV6& prefix, std::string* result);
 
+/*
+ * Prefixes of either address family whose route or forwarding info may have
+ * changed as part of a RIB update.
+ */
+using UpdatedPrefixes = std::set<folly::CIDRNetwork>;
+
 } // namespace facebook::fboss::rib
@@ -37,8 +37,16 @@ static const auto kInterfaceRouteClientId = ClientID::INTERFACE_ROUTE;
 
 RouteUpdater::RouteUpdater(
     IPv4NetworkToRouteMap* v4Routes,
-    IPv6NetworkToRouteMap* v6Routes)
-    : v4Routes_(v4Routes), v6Routes_(v6Routes) {}
+    IPv6NetworkToRouteMap* v6Routes,
+    NextHopDependencyIndex* nextHopDependencies)
+    : v4Routes_(v4Routes),
+      v6Routes_(v6Routes),
+      nextHopDependencies_(nextHopDependencies) {}
+
+template <typename AddressT>
+void RouteUpdater::markTouched(const Prefix<AddressT>& prefix) {
+  touchedPrefixes_.emplace(folly::IPAddress(prefix.network), prefix.mask);
+}
 
 template <typename AddressT>
 void RouteUpdater::addRouteImpl(
@@ -55,10 +63,12 @@ void RouteUpdater::addRouteImpl(
     }
 
     route->update(clientID, entry);
+    markTouched(prefix);
     return;
   }
 
   CHECK(it == routes->end());
+  markTouched(prefix);
   routes->insert(
       prefix.network, prefix.mask, Route<AddressT>(prefix, clientID, entry));
 }
@@ -69,16 +79,30 @@ void RouteUpdater::addRoute(
     ClientID clientID,
     RouteNextHopEntry entry) {
   if (network.isV4()) {
-    PrefixV4 prefix{network.asV4().mask(mask), mask};
-    addRouteImpl(prefix, v4Routes_, clientID, std::move(entry));
+    addRoute(
+        PrefixV4{network.asV4().mask(mask), mask}, clientID, std::move(entry));
   } else {
-    PrefixV6 prefix{network.asV6().mask(mask), mask};
-    if (prefix.network.isLinkLocal()) {
-      XLOG(DBG2) << "Ignoring v6 link-local interface route: " << prefix.str();
-      return;
-    }
-    addRouteImpl(prefix, v6Routes_, clientID, std::move(entry));
+    addRoute(
+        PrefixV6{network.asV6().mask(mask), mask}, clientID, std::move(entry));
+  }
+}
+
+void RouteUpdater::addRoute(
+    const PrefixV4& prefix,
+    ClientID clientID,
+    RouteNextHopEntry entry) {
+  addRouteImpl(prefix, v4Routes_, clientID, std::move(entry));
+}
+
+void RouteUpdater::addRoute(
+    const PrefixV6& prefix,
+    ClientID clientID,
+    RouteNextHopEntry entry) {
+  if (prefix.network.isLinkLocal()) {
+    XLOG(DBG2) << "Ignoring v6 link-local interface route: " << prefix.str();
+    return;
   }
+  addRouteImpl(prefix, v6Routes_, clientID, std::move(entry));
 }
 
 void RouteUpdater::addInterfaceRoute(
@@ -121,6 +145,7 @@ void RouteUpdater::delRouteImpl(
 
   Route<AddressT>& route = it->value();
   route.delEntryForClient(clientID);
+  markTouched(prefix);
 
   XLOG(DBG3) << "Deleted next-hops for prefix " << prefix.str()
              << "from client " << folly::to<std::string>(clientID);
@@ -153,7 +178,11 @@ void RouteUpdater::removeAllRoutesFromClientImpl(
 
   for (auto it = routes->begin(); it != routes->end(); ++it) {
     auto& route = it->value();
+    if (!route.getEntryForClient(clientID)) {
+      continue;
+    }
     route.delEntryForClient(clientID);
+    markTouched(route.prefix());
     if (route.hasNoEntry()) {
       // The nexthops we removed was the only one.  Delete the route.
       toDelete.push_back(it);
@@ -535,9 +564,132 @@ void RouteUpdater::updateDoneImpl(NetworkToRouteMap<AddressT>* routes) {
   resolve(routes);
 }
 
+template <typename AddressT>
+Route<AddressT>* RouteUpdater::findRoute(
+    NetworkToRouteMap<AddressT>* routes,
+    const AddressT& network,
+    uint8_t mask) {
+  auto it = routes->exactMatch(network, mask);
+  if (it == routes->end()) {
+    return nullptr;
+  }
+  return &(it->value());
+}
+
+template <typename AddressT>
+void RouteUpdater::updateDependencies(const Route<AddressT>& route) {
+  std::vector<folly::IPAddress> nexthops;
+  const auto bestEntry = route.getBestEntry().second;
+  if (bestEntry->getAction() == RouteForwardAction::NEXTHOPS) {
+    for (const auto& nh : bestEntry->getNextHopSet()) {
+      // Next hops carrying an interface are resolved by construction and
+      // don't depend on any other route (see resolveOne()).
+      if (!nh.intfID().has_value()) {
+        nexthops.push_back(nh.addr());
+      }
+    }
+  }
+  nextHopDependencies_->setDependencies(
+      folly::CIDRNetwork(route.prefix().network, route.prefix().mask),
+      nexthops);
+}
+
+template <typename AddressT>
+void RouteUpdater::rebuildDependencies(NetworkToRouteMap<AddressT>* routes) {
+  for (const auto& entry : *routes) {
+    updateDependencies(entry.value());
+  }
+}
+
+void RouteUpdater::incrementalUpdateDone() {
+  // Refresh the dependencies of the touched routes first. A touched route's
+  // own next-hops may have changed, or the route may be gone altogether.
+  for (const auto& prefix : touchedPrefixes_) {
+    if (prefix.first.isV4()) {
+      if (auto route =
+              findRoute(v4Routes_, prefix.first.asV4(), prefix.second)) {
+        updateDependencies(*route);
+      } else {
+        nextHopDependencies_->removeRoute(prefix);
+      }
+    } else {
+      if (auto route =
+              findRoute(v6Routes_, prefix.first.asV6(), prefix.second)) {
+        updateDependencies(*route);
+      } else {
+        nextHopDependencies_->removeRoute(prefix);
+      }
+    }
+  }
+
+  // Compute the transitive closure of routes whose resolution may change:
+  // any route with a next-hop covered by a dirty prefix may now resolve via a
+  // different longest match, and so may the routes resolved through it.
+  UpdatedPrefixes dirtyPrefixes(touchedPrefixes_);
+  std::vector<folly::CIDRNetwork> toVisit(
+      touchedPrefixes_.begin(), touchedPrefixes_.end());
+  while (!toVisit.empty()) {
+    auto prefix = std::move(toVisit.back());
+    toVisit.pop_back();
+    nextHopDependencies_->forEachDependentRoute(
+        prefix, [&](const folly::CIDRNetwork& dependent) {
+          if (dirtyPrefixes.insert(dependent).second) {
+            toVisit.push_back(dependent);
+          }
+        });
+  }
+
+  XLOG(DBG3) << "Re-resolving " << dirtyPrefixes.size() << " routes for "
+             << touchedPrefixes_.size() << " updated prefixes";
+
+  // Clear forwarding info of all dirty routes before resolving any of them,
+  // so that resolveOne() never consumes stale forwarding info.
+  std::vector<RouteV4*> v4Dirty;
+  std::vector<RouteV6*> v6Dirty;
+  for (const auto& prefix : dirtyPrefixes) {
+    if (prefix.first.isV4()) {
+      if (auto route =
+              findRoute(v4Routes_, prefix.first.asV4(), prefix.second)) {
+        route->clearForward();
+        v4Dirty.push_back(route);
+      }
+    } else {
+      if (auto route =
+              findRoute(v6Routes_, prefix.first.asV6(), prefix.second)) {
+        route->clearForward();
+        v6Dirty.push_back(route);
+      }
+    }
+  }
+  for (auto route : v4Dirty) {
+    if (route->needResolve()) {
+      resolveOne(route);
+    }
+  }
+  for (auto route : v6Dirty) {
+    if (route->needResolve()) {
+      resolveOne(route);
+    }
+  }
+
+  updatedPrefixes_ = std::move(dirtyPrefixes);
+}
+
 void RouteUpdater::updateDone() {
-  updateDoneImpl(v4Routes_);
-  updateDoneImpl(v6Routes_);
+  updatedPrefixes_.reset();
+  if (nextHopDependencies_ && nextHopDependencies_->isInitialized()) {
+    incrementalUpdateDone();
+  } else {
+    updateDoneImpl(v4Routes_);
+    updateDoneImpl(v6Routes_);
+    if (nextHopDependencies_) {
+      nextHopDependencies_->clear();
+      rebuildDependencies(v4Routes_);
+      rebuildDependencies(v6Routes_);
+      nextHopDependencies_->setInitialized();
+    }
+  }
+  touchedPrefixes_.clear();
 }
 
 } // namespace facebook::fboss::rib
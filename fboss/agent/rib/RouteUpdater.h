@@ -13,6 +13,7 @@
 #include "fboss/agent/types.h"
 
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
 #include "fboss/agent/rib/Route.h"
 #include "fboss/agent/rib/RouteNextHopEntry.h"
 #include "fboss/agent/rib/RouteNextHopsMulti.h"
@@ -20,6 +21,8 @@
 
 #include <folly/IPAddress.h>
 
+#include <optional>
+
 namespace facebook::fboss::rib {
 
 /**
@@ -45,18 +48,29 @@ namespace facebook::fboss::rib {
  *    only IP nexthops will be in the final ECMP group.
  * 5. If and only if TO_CPU is the only nexthop (directly or indirectly) of
  *    a route, TO_CPU action will be only path in the resolved ECMP group.
+ *
+ * When a NextHopDependencyIndex is supplied, updateDone() only re-resolves
+ * the prefixes touched by this updater and, transitively, the routes having
+ * a next-hop covered by one of them. Without an index (or before the index
+ * has been populated) every route in the table is re-resolved.
  */
 class RouteUpdater {
  public:
   RouteUpdater(
       IPv4NetworkToRouteMap* v4Routes,
-      IPv6NetworkToRouteMap* v6Routes);
+      IPv6NetworkToRouteMap* v6Routes,
+      NextHopDependencyIndex* nextHopDependencies = nullptr);
 
   void addRoute(
       const folly::IPAddress& network,
       uint8_t mask,
       ClientID clientID,
       RouteNextHopEntry entry);
+  // Same as above, for a prefix whose network is already masked
+  void
+  addRoute(const PrefixV4& prefix, ClientID clientID, RouteNextHopEntry entry);
+  void
+  addRoute(const PrefixV6& prefix, ClientID clientID, RouteNextHopEntry entry);
   void addLinkLocalRoutes();
   void addInterfaceRoute(
       const folly::IPAddress& network,
@@ -72,9 +86,22 @@ class RouteUpdater {
 
   void updateDone();
 
+  /*
+   * Prefixes which were added, deleted or re-resolved by updateDone(). Returns
+   * nullptr if every route in the table was re-resolved.
+   */
+  const UpdatedPrefixes* getUpdatedPrefixes() const {
+    return updatedPrefixes_ ? &(*updatedPrefixes_) : nullptr;
+  }
+
  private:
   IPv4NetworkToRouteMap* v4Routes_{nullptr};
   IPv6NetworkToRouteMap* v6Routes_{nullptr};
+  NextHopDependencyIndex* nextHopDependencies_{nullptr};
+
+  // Prefixes added, deleted or modified since this updater was created
+  UpdatedPrefixes touchedPrefixes_;
+  std::optional<UpdatedPrefixes> updatedPrefixes_;
 
   // TODO(samank): rename in original file
   template <typename AddressT>
@@ -98,6 +125,19 @@ class RouteUpdater {
       ClientID clientID);
   template <typename AddressT>
   void updateDoneImpl(NetworkToRouteMap<AddressT>* routes);
+  void incrementalUpdateDone();
+
+  template <typename AddressT>
+  void markTouched(const Prefix<AddressT>& prefix);
+  template <typename AddressT>
+  static Route<AddressT>* findRoute(
+      NetworkToRouteMap<AddressT>* routes,
+      const AddressT& network,
+      uint8_t mask);
+  template <typename AddressT>
+  void updateDependencies(const Route<AddressT>& route);
+  template <typename AddressT>
+  void rebuildDependencies(NetworkToRouteMap<AddressT>* routes);
 
   template <typename AddressT>
   void resolve(NetworkToRouteMap<AddressT>* routes);
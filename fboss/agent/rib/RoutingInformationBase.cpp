@@ -79,6 +79,7 @@ void RoutingInformationBase::reconfigure(
   for (auto& vrfAndRouteTable : *lockedRouteTables) {
     auto vrf = vrfAndRouteTable.first;
     const auto& interfaceRoutes = configRouterIDToInterfaceRoutes.at(vrf);
+    auto lockedRouteTable = vrfAndRouteTable.second->wlock();
 
     // A ConfigApplier object should be independent of the VRF whose routes it
     // is processing. However, because interface and static routes for _all_
@@ -89,15 +90,16 @@ void RoutingInformationBase::reconfigure(
     // processing by the use of boost::filter_iterator.
     ConfigApplier configApplier(
         vrf,
-        &(vrfAndRouteTable.second.v4NetworkToRoute),
-        &(vrfAndRouteTable.second.v6NetworkToRoute),
+        &(lockedRouteTable->v4NetworkToRoute),
+        &(lockedRouteTable->v6NetworkToRoute),
         folly::range(interfaceRoutes.cbegin(), interfaceRoutes.cend()),
         folly::range(staticRoutesToCpu.cbegin(), staticRoutesToCpu.cend()),
         folly::range(staticRoutesToNull.cbegin(), staticRoutesToNull.cend()),
         folly::range(
             staticRoutesWithNextHops.cbegin(), staticRoutesWithNextHops.cend()),
         updateFibCallback,
-        cookie);
+        cookie,
+        &(lockedRouteTable->nextHopDependencies));
 
     configApplier.updateRibAndFib();
   }
@@ -113,40 +115,69 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
     folly::StringPiece updateType,
     FibUpdateFunction fibUpdateCallback,
     void* cookie) {
+  std::chrono::microseconds conversionDuration;
+  RouteBatch batch;
+  {
+    Timer conversionTimer(&conversionDuration);
+    batch = RouteBatch::fromUnicastRoutes(
+        toAdd, adminDistanceFromClientID, routeConversionExecutor());
+  }
+
+  auto stats = update(
+      routerID,
+      clientID,
+      batch,
+      toDelete,
+      resetClientsRoutes,
+      updateType,
+      std::move(fibUpdateCallback),
+      cookie);
+  stats.duration += conversionDuration;
+  return stats;
+}
+
+RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
+    RouterID routerID,
+    ClientID clientID,
+    const RouteBatch& toAdd,
+    const std::vector<IpPrefix>& toDelete,
+    bool resetClientsRoutes,
+    folly::StringPiece updateType,
+    FibUpdateFunction fibUpdateCallback,
+    void* cookie) {
   UpdateStatistics stats;
 
   Timer updateTimer(&stats.duration);
 
-  auto lockedRouteTables = synchronizedRouteTables_.wlock();
+  // Only VRF addition and removal take the outer lock exclusively, so updates
+  // to other VRFs can proceed concurrently with this one.
+  auto lockedRouteTables = synchronizedRouteTables_.rlock();
 
   auto it = lockedRouteTables->find(routerID);
   if (it == lockedRouteTables->end()) {
     throw FbossError("VRF ", routerID, " not configured");
   }
+  auto lockedRouteTable = it->second->wlock();
 
   RouteUpdater updater(
-      &(it->second.v4NetworkToRoute), &(it->second.v6NetworkToRoute));
+      &(lockedRouteTable->v4NetworkToRoute),
+      &(lockedRouteTable->v6NetworkToRoute),
+      &(lockedRouteTable->nextHopDependencies));
 
   if (resetClientsRoutes) {
     updater.removeAllRoutesForClient(clientID);
   }
 
-  for (const auto& route : toAdd) {
-    auto network = facebook::network::toIPAddress(route.dest.ip);
-    auto mask = static_cast<uint8_t>(route.dest.prefixLength);
-
-    if (network.isV4()) {
-      ++stats.v4RoutesAdded;
-    } else {
-      ++stats.v6RoutesAdded;
-    }
-
-    updater.addRoute(
-        network,
-        mask,
-        clientID,
-        RouteNextHopEntry::from(route, adminDistanceFromClientID));
+  // Routes sharing a next hop entry share its interned next hops, so adding
+  // them only copies a handle.
+  for (const auto& [prefix, index] : toAdd.v4Routes) {
+    updater.addRoute(prefix, clientID, toAdd.nextHopEntries[index]);
+  }
+  for (const auto& [prefix, index] : toAdd.v6Routes) {
+    updater.addRoute(prefix, clientID, toAdd.nextHopEntries[index]);
   }
+  stats.v4RoutesAdded = toAdd.v4Routes.size();
+  stats.v6RoutesAdded = toAdd.v6Routes.size();
 
   for (const auto& prefix : toDelete) {
     auto network = facebook::network::toIPAddress(prefix.ip);
@@ -163,11 +194,20 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
 
   updater.updateDone();
 
-  fibUpdateCallback(
-      routerID,
-      it->second.v4NetworkToRoute,
-      it->second.v6NetworkToRoute,
-      cookie);
+  try {
+    fibUpdateCallback(
+        routerID,
+        lockedRouteTable->v4NetworkToRoute,
+        lockedRouteTable->v6NetworkToRoute,
+        updater.getUpdatedPrefixes(),
+        cookie);
+  } catch (const std::exception&) {
+    // The FIB may now be out of sync with the RIB, so applying only the next
+    // update's changes to it would not be enough. Dropping the dependency
+    // index forces the next update to re-resolve and rebuild everything.
+    lockedRouteTable->nextHopDependencies.clear();
+    throw;
+  }
 
   return stats;
 }
@@ -177,14 +217,15 @@ folly::dynamic RoutingInformationBase::toFollyDynamic() const {
 
   auto lockedRouteTables = synchronizedRouteTables_.rlock();
   for (const auto& routeTable : *lockedRouteTables) {
+    auto lockedRouteTable = routeTable.second->rlock();
     auto routerIdStr =
         folly::to<std::string>(static_cast<uint32_t>(routeTable.first));
     rib[routerIdStr] = folly::dynamic::object;
     rib[routerIdStr][kRouterId] = static_cast<uint32_t>(routeTable.first);
     rib[routerIdStr][kRibV4] =
-        routeTable.second.v4NetworkToRoute.toFollyDynamic();
+        lockedRouteTable->v4NetworkToRoute.toFollyDynamic();
     rib[routerIdStr][kRibV6] =
-        routeTable.second.v6NetworkToRoute.toFollyDynamic();
+        lockedRouteTable->v6NetworkToRoute.toFollyDynamic();
   }
 
   return rib;
@@ -196,12 +237,13 @@ RoutingInformationBase RoutingInformationBase::fromFollyDynamic(
 
   auto lockedRouteTables = rib.synchronizedRouteTables_.wlock();
   for (const auto& routeTable : ribJson.items()) {
-    lockedRouteTables->insert(std::make_pair(
+    lockedRouteTables->emplace(
         RouterID(routeTable.first.asInt()),
-        RouteTable{
+        std::make_unique<SynchronizedRouteTable>(RouteTable{
             IPv4NetworkToRouteMap::fromFollyDynamic(routeTable.second[kRibV4]),
             IPv6NetworkToRouteMap::fromFollyDynamic(routeTable.second[kRibV6]),
-            UpdateStatistics{}}));
+            UpdateStatistics{},
+            NextHopDependencyIndex{}}));
   }
 
   return rib;
@@ -209,7 +251,9 @@ RoutingInformationBase RoutingInformationBase::fromFollyDynamic(
 
 void RoutingInformationBase::createVrf(RouterID rid) {
   auto lockedRouteTables = synchronizedRouteTables_.wlock();
-  lockedRouteTables->insert(std::make_pair(rid, RouteTable()));
+  if (lockedRouteTables->find(rid) == lockedRouteTables->end()) {
+    lockedRouteTables->emplace(rid, std::make_unique<SynchronizedRouteTable>());
+  }
 }
 
 std::vector<RouterID> RoutingInformationBase::getVrfList() const {
@@ -224,19 +268,24 @@ std::vector<RouterID> RoutingInformationBase::getVrfList() const {
 std::vector<RouteDetails> RoutingInformationBase::getRouteTableDetails(
     RouterID rid) const {
   std::vector<RouteDetails> routeDetails;
-  SYNCHRONIZED_CONST(synchronizedRouteTables_) {
-    const auto it = synchronizedRouteTables_.find(rid);
-    if (it != synchronizedRouteTables_.end()) {
-      for (auto rit = it->second.v4NetworkToRoute.begin();
-           rit != it->second.v4NetworkToRoute.end();
-           ++rit) {
-        routeDetails.emplace_back(rit->value().toRouteDetails());
-      }
-      for (auto rit = it->second.v6NetworkToRoute.begin();
-           rit != it->second.v6NetworkToRoute.end();
-           ++rit) {
-        routeDetails.emplace_back(rit->value().toRouteDetails());
-      }
+  // Only the route table of `rid` is locked, and only in shared mode, so this
+  // never blocks updates to other VRFs.
+  auto lockedRouteTables = synchronizedRouteTables_.rlock();
+  const auto it = lockedRouteTables->find(rid);
+  if (it != lockedRouteTables->end()) {
+    auto lockedRouteTable = it->second->rlock();
+    routeDetails.reserve(
+        lockedRouteTable->v4NetworkToRoute.size() +
+        lockedRouteTable->v6NetworkToRoute.size());
+    for (auto rit = lockedRouteTable->v4NetworkToRoute.begin();
+         rit != lockedRouteTable->v4NetworkToRoute.end();
+         ++rit) {
+      routeDetails.emplace_back(rit->value().toRouteDetails());
+    }
+    for (auto rit = lockedRouteTable->v6NetworkToRoute.begin();
+         rit != lockedRouteTable->v6NetworkToRoute.end();
+         ++rit) {
+      routeDetails.emplace_back(rit->value().toRouteDetails());
     }
   }
   return routeDetails;
@@ -255,7 +304,9 @@ RoutingInformationBase::constructRouteTables(
     const RouterID configVrf = routerIDAndInterfaceRoutes.first;
 
     newRouteTablesIter = newRouteTables.emplace_hint(
-        newRouteTables.cend(), configVrf, RouteTable());
+        newRouteTables.cend(),
+        configVrf,
+        std::make_unique<SynchronizedRouteTable>());
 
     auto oldRouteTablesIter = lockedRouteTables->find(configVrf);
     if (oldRouteTablesIter == lockedRouteTables->end()) {
@@ -277,7 +328,18 @@ bool RoutingInformationBase::operator==(
   const auto& routeTables = synchronizedRouteTables_.rlock();
   const auto& otherTables = other.synchronizedRouteTables_.rlock();
 
-  return *routeTables == *otherTables;
+  if (routeTables->size() != otherTables->size()) {
+    return false;
+  }
+  for (auto it = routeTables->begin(), otherIt = otherTables->begin();
+       it != routeTables->end();
+       ++it, ++otherIt) {
+    if (it->first != otherIt->first ||
+        *(it->second->rlock()) != *(otherIt->second->rlock())) {
+      return false;
+    }
+  }
+  return true;
 }
 
 } // namespace facebook::fboss::rib
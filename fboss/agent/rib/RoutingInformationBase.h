@@ -12,9 +12,13 @@
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/if/gen-cpp2/FbossCtrl.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
+#include "fboss/agent/rib/RouteBatch.h"
 #include "fboss/agent/types.h"
 
 #include <folly/Synchronized.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 
 #include <functional>
 #include <memory>
@@ -25,10 +29,15 @@ namespace facebook::fboss::rib {
 
 class RoutingInformationBase {
  public:
+  /*
+   * `updatedPrefixes` holds the prefixes whose FIB entry may have changed. It
+   * is nullptr when the FIB should be rebuilt from the whole RIB.
+   */
   using FibUpdateFunction = std::function<void(
       RouterID vrf,
       const IPv4NetworkToRouteMap& v4NetworkToRoute,
       const IPv6NetworkToRouteMap& v6NetworkToRoute,
+      const UpdatedPrefixes* updatedPrefixes,
       void* cookie)>;
 
   struct UpdateStatistics {
@@ -40,8 +49,8 @@ class RoutingInformationBase {
   };
 
   /*
-   * `update()` first acquires exclusive ownership of the RIB and executes the
-   * following sequence of actions:
+   * `update()` first acquires exclusive ownership of the route table of
+   * `routerID` and executes the following sequence of actions:
    * 1. Injects and removes routes in `toAdd` and `toDelete`, respectively.
    * 2. Triggers recursive (IP) resolution.
    * 3. Updates the FIB synchronously.
@@ -52,6 +61,10 @@ class RoutingInformationBase {
    * this mapping is exposed via SwSwitch, which we can't a dependency on here.
    * The adminDistanceFromClientID allows callsites to propogate admin distances
    * per client.
+   *
+   * Updates to distinct VRFs proceed in parallel: the set of VRFs is only
+   * locked in shared mode, and each VRF's route table has its own lock.
+   * `toAdd` is converted before any lock is taken.
    */
   UpdateStatistics update(
       RouterID routerID,
@@ -64,6 +77,19 @@ class RoutingInformationBase {
       FibUpdateFunction fibUpdateCallback,
       void* cookie);
 
+  /*
+   * Same as above, for routes already converted from thrift.
+   */
+  UpdateStatistics update(
+      RouterID routerID,
+      ClientID clientID,
+      const RouteBatch& toAdd,
+      const std::vector<IpPrefix>& toDelete,
+      bool resetClientsRoutes,
+      folly::StringPiece updateType,
+      FibUpdateFunction fibUpdateCallback,
+      void* cookie);
+
   /*
    * VrfAndNetworkToInterfaceRoute is conceptually a mapping from the pair
    * (RouterID, folly::CIDRNetwork) to the pair (Interface(1),
@@ -100,6 +126,14 @@ class RoutingInformationBase {
     return !(*this == other);
   }
 
+  /*
+   * Converts large route batches, see RouteBatch. Shared by all updates, so
+   * that concurrent updates do not each start threads of their own.
+   */
+  folly::Executor* routeConversionExecutor() const {
+    return routeConversionExecutor_.get();
+  }
+
  private:
   struct RouteTable {
     IPv4NetworkToRouteMap v4NetworkToRoute;
@@ -107,6 +141,10 @@ class RoutingInformationBase {
 
     UpdateStatistics lastUpdateStats_;
 
+    // Lets RouteUpdater re-resolve only routes affected by an update. It is
+    // derived state and thus not serialized nor part of equality.
+    NextHopDependencyIndex nextHopDependencies;
+
     bool operator==(const RouteTable& other) const {
       return v4NetworkToRoute == other.v4NetworkToRoute &&
           v6NetworkToRoute == other.v6NetworkToRoute;
@@ -117,13 +155,16 @@ class RoutingInformationBase {
   };
 
   /*
-   * Currently, route updates to separate VRFs are made to be sequential. In the
-   * event FBOSS has to operate in a routing architecture with numerous VRFs,
-   * we can avoid a slow down by a factor of number of VRFs by parallelizing
-   * route updates across VRFs. This can be accomplished simply by associating
-   * the mutex implicit in folly::Synchronized with an individual RouteTable.
+   * Locking is two-level. The outer lock protects the set of VRFs: it is held
+   * exclusively only when VRFs are added or removed (reconfigure(),
+   * createVrf(), deserialization) and in shared mode otherwise. Each
+   * RouteTable is protected by its own lock, so that route updates and
+   * readers of distinct VRFs never contend. Lock ordering is always outer
+   * lock first, then per-VRF locks in increasing RouterID order.
    */
-  using RouterIDToRouteTable = boost::container::flat_map<RouterID, RouteTable>;
+  using SynchronizedRouteTable = folly::Synchronized<RouteTable>;
+  using RouterIDToRouteTable = boost::container::
+      flat_map<RouterID, std::unique_ptr<SynchronizedRouteTable>>;
   using SynchronizedRouteTables = folly::Synchronized<RouterIDToRouteTable>;
 
   RouterIDToRouteTable constructRouteTables(
@@ -132,6 +173,12 @@ class RoutingInformationBase {
           configRouterIDToInterfaceRoutes) const;
 
   SynchronizedRouteTables synchronizedRouteTables_;
+
+  // The updating thread converts a chunk of its batch too
+  std::unique_ptr<folly::CPUThreadPoolExecutor> routeConversionExecutor_{
+      std::make_unique<folly::CPUThreadPoolExecutor>(
+          RouteBatch::kMaxConversionThreads - 1,
+          std::make_shared<folly::NamedThreadFactory>("RouteConversion"))};
 };
 
 } // namespace facebook::fboss::rib
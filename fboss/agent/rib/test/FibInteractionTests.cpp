@@ -18,6 +18,7 @@
 #include "fboss/agent/rib/RouteNextHop.h"
 #include "fboss/agent/rib/RouteNextHopEntry.h"
 #include "fboss/agent/rib/RouteTypes.h"
+#include "fboss/agent/rib/RouteUpdater.h"
 #include "fboss/agent/state/ForwardingInformationBase.h"
 #include "fboss/agent/state/ForwardingInformationBaseContainer.h"
 #include "fboss/agent/state/ForwardingInformationBaseMap.h"
@@ -46,9 +47,10 @@ void dynamicFibUpdate(
     facebook::fboss::RouterID vrf,
     const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const facebook::fboss::rib::UpdatedPrefixes* updatedPrefixes,
     void* cookie) {
   facebook::fboss::rib::ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, updatedPrefixes);
 
   auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
   sw->updateStateBlocking("", std::move(fibUpdater));
@@ -618,3 +620,195 @@ TEST(ForwardingInformationBaseUpdater, Deduplication) {
   ASSERT_TRUE(route3);
   EXPECT_NE(route, route3);
 }
+
+namespace {
+
+facebook::fboss::rib::RouteNextHopEntry ribNextHops(
+    const std::string& nexthop) {
+  return facebook::fboss::rib::RouteNextHopEntry(
+      facebook::fboss::rib::UnresolvedNextHop(
+          folly::IPAddress(nexthop), facebook::fboss::rib::ECMP_WEIGHT),
+      kDefaultAdminDistance);
+}
+
+template <typename AddressT>
+void EXPECT_SAME_FIB(
+    const facebook::fboss::rib::NetworkToRouteMap<AddressT>& rib,
+    const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
+        patched,
+    const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
+        rebuilt) {
+  std::size_t numResolved = 0;
+  for (const auto& entry : rib) {
+    numResolved += entry.value().isResolved();
+  }
+  EXPECT_EQ(numResolved, rebuilt->size());
+  EXPECT_EQ(rebuilt->size(), patched->size());
+  for (const auto& route : *rebuilt) {
+    auto patchedRoute = patched->getNodeIf(route->prefix());
+    ASSERT_NE(nullptr, patchedRoute) << route->str();
+    EXPECT_EQ(route->getForwardInfo(), patchedRoute->getForwardInfo());
+  }
+}
+
+/*
+ * Update the FIB of `state` by patching in `updatedPrefixes` and check that
+ * the result matches the FIB rebuilt from the whole RIB. Returns the
+ * patched, published state.
+ */
+std::shared_ptr<facebook::fboss::SwitchState> patchAndCompare(
+    const std::shared_ptr<facebook::fboss::SwitchState>& state,
+    facebook::fboss::RouterID vrf,
+    const facebook::fboss::rib::IPv4NetworkToRouteMap& v4Rib,
+    const facebook::fboss::rib::IPv6NetworkToRouteMap& v6Rib,
+    const facebook::fboss::rib::UpdatedPrefixes& updatedPrefixes) {
+  facebook::fboss::rib::ForwardingInformationBaseUpdater patcher(
+      vrf, v4Rib, v6Rib, &updatedPrefixes);
+  auto patched = patcher(state);
+  facebook::fboss::rib::ForwardingInformationBaseUpdater rebuilder(
+      vrf, v4Rib, v6Rib);
+  auto rebuilt = rebuilder(state);
+
+  const auto& patchedFibs = patched->getFibs()->getFibContainer(vrf);
+  const auto& rebuiltFibs = rebuilt->getFibs()->getFibContainer(vrf);
+  EXPECT_SAME_FIB(v4Rib, patchedFibs->getFibV4(), rebuiltFibs->getFibV4());
+  EXPECT_SAME_FIB(v6Rib, patchedFibs->getFibV6(), rebuiltFibs->getFibV6());
+
+  patched->publish();
+  return patched;
+}
+
+} // namespace
+
+TEST(ForwardingInformationBaseUpdater, PatchMatchesRebuild) {
+  using namespace facebook::fboss;
+
+  const RouterID vrfZero{0};
+  auto fibContainer =
+      std::make_shared<ForwardingInformationBaseContainer>(vrfZero);
+  fibContainer->writableFields()->fibV4 =
+      std::make_shared<ForwardingInformationBaseV4>();
+  fibContainer->writableFields()->fibV6 =
+      std::make_shared<ForwardingInformationBaseV6>();
+  auto fibMap = std::make_shared<ForwardingInformationBaseMap>();
+  fibMap->addNode(fibContainer);
+  auto state = std::make_shared<SwitchState>();
+  state->resetForwardingInformationBases(fibMap);
+  state->publish();
+
+  rib::IPv4NetworkToRouteMap v4Rib;
+  rib::IPv6NetworkToRouteMap v6Rib;
+  auto v4Prefix = [](const std::string& network) {
+    return folly::CIDRNetwork(folly::IPAddress(network), 24);
+  };
+  auto v6Prefix = [](const std::string& network) {
+    return folly::CIDRNetwork(folly::IPAddress(network), 64);
+  };
+
+  // Initial routes: connected, resolved, DROP and unresolved
+  {
+    rib::RouteUpdater updater(&v4Rib, &v6Rib);
+    updater.addInterfaceRoute(
+        folly::IPAddress("10.0.0.1"),
+        24,
+        folly::IPAddress("10.0.0.1"),
+        InterfaceID(1));
+    updater.addInterfaceRoute(
+        folly::IPAddress("2401:db00::1"),
+        64,
+        folly::IPAddress("2401:db00::1"),
+        InterfaceID(1));
+    updater.addRoute(
+        folly::IPAddress("11.0.0.0"), 24, ClientID(0), ribNextHops("10.0.0.2"));
+    updater.addRoute(
+        folly::IPAddress("12.0.0.0"),
+        24,
+        ClientID(0),
+        rib::RouteNextHopEntry(
+            rib::RouteNextHopEntry::Action::DROP, kDefaultAdminDistance));
+    updater.addRoute(
+        folly::IPAddress("20.0.0.0"), 24, ClientID(0), ribNextHops("30.0.0.1"));
+    updater.addRoute(
+        folly::IPAddress("2401:db01::"),
+        64,
+        ClientID(0),
+        ribNextHops("2401:db00::2"));
+    updater.updateDone();
+  }
+  state = patchAndCompare(
+      state,
+      vrfZero,
+      v4Rib,
+      v6Rib,
+      {v4Prefix("10.0.0.0"),
+       v4Prefix("11.0.0.0"),
+       v4Prefix("12.0.0.0"),
+       v4Prefix("20.0.0.0"),
+       v6Prefix("2401:db00::"),
+       v6Prefix("2401:db01::")});
+  EXPECT_FIB_SIZE(state, vrfZero, 3, 2);
+  auto v4Route = getRoute(
+      state, vrfZero, folly::IPAddressV4("11.0.0.0"), static_cast<uint8_t>(24));
+  auto v6Route = getRoute(
+      state,
+      vrfZero,
+      folly::IPAddressV6("2401:db01::"),
+      static_cast<uint8_t>(64));
+
+  // Add
+  {
+    rib::RouteUpdater updater(&v4Rib, &v6Rib);
+    updater.addRoute(
+        folly::IPAddress("13.0.0.0"), 24, ClientID(0), ribNextHops("10.0.0.3"));
+    updater.updateDone();
+  }
+  state = patchAndCompare(
+      state, vrfZero, v4Rib, v6Rib, {v4Prefix("13.0.0.0")});
+  EXPECT_FIB_SIZE(state, vrfZero, 4, 2);
+  EXPECT_ROUTE(
+      state, vrfZero, folly::IPAddressV4("13.0.0.0"), static_cast<uint8_t>(24));
+
+  // Next hop change
+  {
+    rib::RouteUpdater updater(&v4Rib, &v6Rib);
+    updater.addRoute(
+        folly::IPAddress("11.0.0.0"), 24, ClientID(0), ribNextHops("10.0.0.4"));
+    updater.updateDone();
+  }
+  state = patchAndCompare(
+      state, vrfZero, v4Rib, v6Rib, {v4Prefix("11.0.0.0")});
+  EXPECT_FIB_SIZE(state, vrfZero, 4, 2);
+  EXPECT_NE(
+      v4Route->getForwardInfo(),
+      getRoute(
+          state,
+          vrfZero,
+          folly::IPAddressV4("11.0.0.0"),
+          static_cast<uint8_t>(24))
+          ->getForwardInfo());
+  // Routes which were not patched are still shared with the prior FIB
+  EXPECT_EQ(
+      v6Route,
+      getRoute(
+          state,
+          vrfZero,
+          folly::IPAddressV6("2401:db01::"),
+          static_cast<uint8_t>(64)));
+
+  // Remove
+  {
+    rib::RouteUpdater updater(&v4Rib, &v6Rib);
+    updater.delRoute(folly::IPAddress("12.0.0.0"), 24, ClientID(0));
+    updater.delRoute(folly::IPAddress("2401:db01::"), 64, ClientID(0));
+    updater.updateDone();
+  }
+  state = patchAndCompare(
+      state,
+      vrfZero,
+      v4Rib,
+      v6Rib,
+      {v4Prefix("12.0.0.0"), v6Prefix("2401:db01::")});
+  EXPECT_FIB_SIZE(state, vrfZero, 3, 1);
+  EXPECT_NO_ROUTE(
+      state, vrfZero, folly::IPAddressV4("12.0.0.0"), static_cast<uint8_t>(24));
+}
@@ -0,0 +1,240 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+#include "fboss/agent/rib/RouteBatch.h"
+#include "fboss/agent/rib/RouteNextHopEntry.h"
+#include "fboss/agent/rib/RouteTypes.h"
+
+#include <folly/Format.h>
+#include <folly/IPAddress.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace facebook::fboss::rib;
+
+using facebook::fboss::AdminDistance;
+using facebook::fboss::FbossError;
+using facebook::fboss::NextHopThrift;
+using facebook::fboss::UnicastRoute;
+using facebook::fboss::UnicastRouteBatch;
+using facebook::fboss::UnicastRouteBatchNextHops;
+
+namespace {
+
+const AdminDistance kDefaultAdminDistance = AdminDistance::EBGP;
+
+UnicastRouteBatchNextHops makeNextHops(
+    const std::vector<folly::IPAddress>& addrs) {
+  UnicastRouteBatchNextHops nextHops;
+  for (const auto& addr : addrs) {
+    NextHopThrift nextHop;
+    *nextHop.address_ref() = facebook::network::toBinaryAddress(addr);
+    *nextHop.weight_ref() = static_cast<int32_t>(ECMP_WEIGHT);
+    nextHops.nextHops_ref()->push_back(std::move(nextHop));
+  }
+  return nextHops;
+}
+
+void addRoute(
+    UnicastRouteBatch* batch,
+    const folly::IPAddress& network,
+    uint8_t mask,
+    int32_t nextHopIndex) {
+  auto bytes = std::string(
+      reinterpret_cast<const char*>(network.bytes()), network.byteCount());
+  if (network.isV4()) {
+    batch->v4Networks_ref()->append(bytes);
+    batch->v4PrefixLengths_ref()->push_back(static_cast<char>(mask));
+    batch->v4NextHopIndices_ref()->push_back(nextHopIndex);
+  } else {
+    batch->v6Networks_ref()->append(bytes);
+    batch->v6PrefixLengths_ref()->push_back(static_cast<char>(mask));
+    batch->v6NextHopIndices_ref()->push_back(nextHopIndex);
+  }
+}
+
+UnicastRouteBatch makeBatch() {
+  UnicastRouteBatch batch;
+  batch.nextHops_ref()->push_back(makeNextHops(
+      {folly::IPAddress("10.0.0.1"), folly::IPAddress("10.0.0.2")}));
+  auto v6NextHops = makeNextHops({folly::IPAddress("2401:db00::1")});
+  v6NextHops.adminDistance_ref() = AdminDistance::STATIC_ROUTE;
+  batch.nextHops_ref()->push_back(std::move(v6NextHops));
+  // No next hops, so dropped
+  batch.nextHops_ref()->push_back(UnicastRouteBatchNextHops());
+
+  addRoute(&batch, folly::IPAddress("11.0.0.0"), 24, 0);
+  // Host bits are masked off
+  addRoute(&batch, folly::IPAddress("11.0.1.255"), 24, 0);
+  addRoute(&batch, folly::IPAddress("12.0.0.0"), 8, 2);
+  addRoute(&batch, folly::IPAddress("2401:db00:1::"), 64, 1);
+  addRoute(&batch, folly::IPAddress("2401:db00:2::"), 64, 0);
+  return batch;
+}
+
+} // namespace
+
+TEST(RouteBatch, FromThrift) {
+  auto batch = RouteBatch::fromThrift(makeBatch(), kDefaultAdminDistance);
+
+  ASSERT_EQ(3, batch.nextHopEntries.size());
+  EXPECT_EQ(
+      RouteNextHopEntry::Action::NEXTHOPS,
+      batch.nextHopEntries[0].getAction());
+  EXPECT_EQ(2, batch.nextHopEntries[0].getNextHopSet().size());
+  EXPECT_EQ(kDefaultAdminDistance, batch.nextHopEntries[0].getAdminDistance());
+  EXPECT_EQ(
+      AdminDistance::STATIC_ROUTE, batch.nextHopEntries[1].getAdminDistance());
+  EXPECT_EQ(
+      RouteNextHopEntry::Action::DROP, batch.nextHopEntries[2].getAction());
+
+  ASSERT_EQ(3, batch.v4Routes.size());
+  EXPECT_EQ(
+      (PrefixV4{folly::IPAddressV4("11.0.0.0"), 24}), batch.v4Routes[0].first);
+  EXPECT_EQ(0, batch.v4Routes[0].second);
+  EXPECT_EQ(
+      (PrefixV4{folly::IPAddressV4("11.0.1.0"), 24}), batch.v4Routes[1].first);
+  EXPECT_EQ(0, batch.v4Routes[1].second);
+  EXPECT_EQ(
+      (PrefixV4{folly::IPAddressV4("12.0.0.0"), 8}), batch.v4Routes[2].first);
+  EXPECT_EQ(2, batch.v4Routes[2].second);
+
+  ASSERT_EQ(2, batch.v6Routes.size());
+  EXPECT_EQ(
+      (PrefixV6{folly::IPAddressV6("2401:db00:1::"), 64}),
+      batch.v6Routes[0].first);
+  EXPECT_EQ(1, batch.v6Routes[0].second);
+  EXPECT_EQ(0, batch.v6Routes[1].second);
+  EXPECT_EQ(5, batch.size());
+}
+
+TEST(RouteBatch, FromThriftMalformed) {
+  {
+    // Next hop index out of range
+    auto batch = makeBatch();
+    (*batch.v4NextHopIndices_ref())[0] = 3;
+    EXPECT_THROW(
+        RouteBatch::fromThrift(batch, kDefaultAdminDistance), FbossError);
+  }
+  {
+    auto batch = makeBatch();
+    (*batch.v6NextHopIndices_ref())[0] = -1;
+    EXPECT_THROW(
+        RouteBatch::fromThrift(batch, kDefaultAdminDistance), FbossError);
+  }
+  {
+    // Prefix length too long
+    auto batch = makeBatch();
+    (*batch.v4PrefixLengths_ref())[0] = 33;
+    EXPECT_THROW(
+        RouteBatch::fromThrift(batch, kDefaultAdminDistance), FbossError);
+  }
+  {
+    // Truncated networks
+    auto batch = makeBatch();
+    batch.v6Networks_ref()->pop_back();
+    EXPECT_THROW(
+        RouteBatch::fromThrift(batch, kDefaultAdminDistance), FbossError);
+  }
+  {
+    // More routes than prefix lengths
+    auto batch = makeBatch();
+    batch.v4NextHopIndices_ref()->push_back(0);
+    batch.v4Networks_ref()->append(4, '\0');
+    EXPECT_THROW(
+        RouteBatch::fromThrift(batch, kDefaultAdminDistance), FbossError);
+  }
+}
+
+namespace {
+
+std::vector<UnicastRoute> makeUnicastRoutes(uint32_t numRoutes) {
+  std::vector<UnicastRoute> routes;
+  for (uint32_t i = 0; i < numRoutes; ++i) {
+    UnicastRoute route;
+    auto network = i % 2
+        ? folly::IPAddress::fromLongHBO((11u << 24) + (i << 8))
+        : folly::IPAddress(folly::IPAddressV6(folly::sformat(
+              "2401:db00:{:x}:{:x}::", i >> 16, i & 0xffff)));
+    route.dest.ip = facebook::network::toBinaryAddress(network);
+    route.dest.prefixLength = network.isV4() ? 24 : 64;
+    route.nextHopAddrs_ref()->push_back(facebook::network::toBinaryAddress(
+        folly::IPAddress::fromLongHBO((10u << 24) + i % 8)));
+    routes.push_back(std::move(route));
+  }
+  return routes;
+}
+
+} // namespace
+
+// Large enough to be converted by several threads
+TEST(RouteBatch, FromUnicastRoutes) {
+  constexpr uint32_t kNumRoutes = 50000;
+  auto routes = makeUnicastRoutes(kNumRoutes);
+  folly::CPUThreadPoolExecutor executor(RouteBatch::kMaxConversionThreads);
+
+  auto batch =
+      RouteBatch::fromUnicastRoutes(routes, kDefaultAdminDistance, &executor);
+
+  ASSERT_EQ(kNumRoutes, batch.nextHopEntries.size());
+  ASSERT_EQ(kNumRoutes / 2, batch.v4Routes.size());
+  ASSERT_EQ(kNumRoutes / 2, batch.v6Routes.size());
+  // Routes keep their order and refer to their own next hop entry
+  for (uint32_t i = 0; i < kNumRoutes; ++i) {
+    auto index = i % 2 ? batch.v4Routes[i / 2].second
+                       : batch.v6Routes[i / 2].second;
+    EXPECT_EQ(i, index);
+    EXPECT_EQ(
+        RouteNextHopEntry::from(routes[i], kDefaultAdminDistance),
+        batch.nextHopEntries[index]);
+  }
+  EXPECT_EQ(
+      (PrefixV4{folly::IPAddressV4("11.0.1.0"), 24}), batch.v4Routes[0].first);
+  EXPECT_EQ(
+      (PrefixV6{folly::IPAddressV6("2401:db00:0:2::"), 64}),
+      batch.v6Routes[1].first);
+}
+
+TEST(RouteBatch, FromUnicastRoutesMalformed) {
+  auto makeRoute = [](const std::string& ip, int16_t prefixLength) {
+    UnicastRoute route;
+    route.dest.ip = facebook::network::toBinaryAddress(folly::IPAddress(ip));
+    route.dest.prefixLength = prefixLength;
+    route.nextHopAddrs_ref()->push_back(
+        facebook::network::toBinaryAddress(folly::IPAddress("10.0.0.1")));
+    return route;
+  };
+  // Prefix length too long, including once truncated to 8 bits
+  for (auto route :
+       {makeRoute("11.0.0.0", 33),
+        makeRoute("11.0.0.0", 256 + 24),
+        makeRoute("2401:db00::", 129),
+        makeRoute("11.0.0.0", -1)}) {
+    std::vector<UnicastRoute> routes = {makeRoute("12.0.0.0", 8), route};
+    EXPECT_THROW(
+        RouteBatch::fromUnicastRoutes(routes, kDefaultAdminDistance),
+        FbossError);
+  }
+}
+
+TEST(RouteBatch, FromUnicastRoutesMalformedChunk) {
+  auto routes = makeUnicastRoutes(50000);
+  routes.back().dest.prefixLength = 129;
+  folly::CPUThreadPoolExecutor executor(RouteBatch::kMaxConversionThreads);
+
+  // Thrown from a chunk converted on the executor
+  EXPECT_THROW(
+      RouteBatch::fromUnicastRoutes(routes, kDefaultAdminDistance, &executor),
+      FbossError);
+}
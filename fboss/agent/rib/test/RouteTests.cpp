@@ -11,6 +11,7 @@
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
 #include "fboss/agent/rib/RouteNextHop.h"
 #include "fboss/agent/rib/RouteNextHopEntry.h"
 #include "fboss/agent/rib/RouteTypes.h"
@@ -1883,4 +1884,99 @@ TEST_F(UcmpTest, Ten) {
   runVaryFromHundredTest(10, {10, 10, 10, 1});
 }
 
+TEST(Route, incrementalResolve) {
+  // Routes in (v4Full, v6Full) are always fully re-resolved, while routes in
+  // (v4Incr, v6Incr) are re-resolved using a NextHopDependencyIndex. The two
+  // must agree after every update.
+  IPv4NetworkToRouteMap v4Full, v4Incr;
+  IPv6NetworkToRouteMap v6Full, v6Incr;
+  NextHopDependencyIndex dependencies;
+
+  configRoutes(&v4Full, &v6Full);
+  configRoutes(&v4Incr, &v6Incr);
+
+  auto update = [&](auto&& updateFn) {
+    RouteUpdater full(&v4Full, &v6Full);
+    updateFn(full);
+    full.updateDone();
+
+    RouteUpdater incremental(&v4Incr, &v6Incr, &dependencies);
+    updateFn(incremental);
+    incremental.updateDone();
+
+    EXPECT_TRUE(dependencies.isInitialized());
+    EXPECT_ROUTES_MATCH(&v4Full, &v4Incr);
+    EXPECT_ROUTES_MATCH(&v6Full, &v6Incr);
+  };
+
+  // Recursive chain spanning both address families:
+  // 5::/16 -> 20.1.1.1, 20/8 -> 10.1.1.1, 10/8 -> 1.1.1.10
+  update([](RouteUpdater& u) {
+    u.addRoute(
+        IPAddress("10.0.0.0"),
+        8,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"1.1.1.10"}), kDistance));
+    u.addRoute(
+        IPAddress("20.0.0.0"),
+        8,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"10.1.1.1"}), kDistance));
+    u.addRoute(
+        IPAddress("5::"),
+        16,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"20.1.1.1"}), kDistance));
+  });
+  EXPECT_FWD_INFO(getRoute(v6Incr, "5::/16"), InterfaceID(1), "1.1.1.10");
+
+  // A more specific route for 20/8's next hop changes the whole chain
+  update([](RouteUpdater& u) {
+    u.addRoute(
+        IPAddress("10.1.0.0"),
+        16,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"2.2.2.10"}), kDistance));
+  });
+  EXPECT_FWD_INFO(getRoute(v4Incr, "20.0.0.0/8"), InterfaceID(2), "2.2.2.10");
+  EXPECT_FWD_INFO(getRoute(v6Incr, "5::/16"), InterfaceID(2), "2.2.2.10");
+
+  // Changing an unrelated route leaves the chain alone
+  update([](RouteUpdater& u) {
+    u.addRoute(
+        IPAddress("10.0.0.0"),
+        8,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"3.3.3.10"}), kDistance));
+  });
+  EXPECT_FWD_INFO(getRoute(v6Incr, "5::/16"), InterfaceID(2), "2.2.2.10");
+
+  // Removing the more specific route falls back to the modified 10/8
+  update([](RouteUpdater& u) {
+    u.delRoute(IPAddress("10.1.0.0"), 16, kClientA);
+  });
+  EXPECT_FWD_INFO(getRoute(v6Incr, "5::/16"), InterfaceID(3), "3.3.3.10");
+
+  // Removing the bottom of the chain makes everything above unresolvable
+  update([](RouteUpdater& u) {
+    u.delRoute(IPAddress("10.0.0.0"), 8, kClientA);
+  });
+  EXPECT_TRUE(getRoute(v4Incr, "20.0.0.0/8")->isUnresolvable());
+  EXPECT_TRUE(getRoute(v6Incr, "5::/16")->isUnresolvable());
+
+  // Re-adding it resolves the chain again
+  update([](RouteUpdater& u) {
+    u.addRoute(
+        IPAddress("10.0.0.0"),
+        8,
+        kClientB,
+        RouteNextHopEntry(makeNextHops({"4.4.4.10"}), kDistance));
+  });
+  EXPECT_FWD_INFO(getRoute(v6Incr, "5::/16"), InterfaceID(4), "4.4.4.10");
+
+  update([](RouteUpdater& u) { u.removeAllRoutesForClient(kClientA); });
+  // Only 10/8 from kClientB still has an unresolved next hop
+  EXPECT_EQ(1, dependencies.numRoutes());
+}
+
 } // namespace facebook::fboss::rib
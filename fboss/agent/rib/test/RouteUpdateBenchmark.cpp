@@ -10,11 +10,13 @@
 
 #include "common/init/Init.h"
 #include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/ThriftHandler.h"
 #include "fboss/agent/hw/sim/SimPlatform.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/rib/ForwardingInformationBaseUpdater.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
 #include "fboss/agent/rib/RouteTypes.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/RouteDistributionGenerator.h"
@@ -23,6 +25,10 @@
 
 #include <folly/Benchmark.h>
 
+#include <atomic>
+#include <map>
+#include <thread>
+
 using namespace facebook::fboss;
 
 auto constexpr kEcmpWidth = 4;
@@ -48,6 +54,63 @@ std::vector<NextHopThrift> nextHopsThrift(
   return nexthops;
 }
 
+template <typename RouteChunk>
+std::vector<UnicastRoute> toUnicastRoutes(const RouteChunk& chunk) {
+  std::vector<UnicastRoute> routes;
+  for (const auto& route : chunk) {
+    UnicastRoute unicastRoute;
+
+    IpPrefix prefix;
+    prefix.ip = facebook::network::toBinaryAddress(route.prefix.first);
+    prefix.prefixLength = route.prefix.second;
+    unicastRoute.dest_ref() = prefix;
+    unicastRoute.nextHops_ref() = nextHopsThrift(route.nhops);
+
+    routes.push_back(std::move(unicastRoute));
+  }
+  return routes;
+}
+
+/*
+ * The same routes as toUnicastRoutes(), in the columnar form of
+ * syncFibBatchInVrf(). Routes with identical next hops share an entry.
+ */
+template <typename RouteChunk>
+UnicastRouteBatch toUnicastRouteBatch(const RouteChunk& chunk) {
+  UnicastRouteBatch batch;
+  std::map<std::vector<folly::IPAddress>, int32_t> nextHopIndices;
+  for (const auto& route : chunk) {
+    auto [it, inserted] = nextHopIndices.emplace(
+        route.nhops, static_cast<int32_t>(batch.nextHops_ref()->size()));
+    if (inserted) {
+      UnicastRouteBatchNextHops nextHops;
+      nextHops.nextHops_ref() = nextHopsThrift(route.nhops);
+      batch.nextHops_ref()->push_back(std::move(nextHops));
+    }
+    const auto& network = route.prefix.first;
+    auto prefixLength = static_cast<char>(route.prefix.second);
+    if (network.isV4()) {
+      batch.v4Networks_ref()->append(
+          reinterpret_cast<const char*>(network.bytes()), network.byteCount());
+      batch.v4PrefixLengths_ref()->push_back(prefixLength);
+      batch.v4NextHopIndices_ref()->push_back(it->second);
+    } else {
+      batch.v6Networks_ref()->append(
+          reinterpret_cast<const char*>(network.bytes()), network.byteCount());
+      batch.v6PrefixLengths_ref()->push_back(prefixLength);
+      batch.v6NextHopIndices_ref()->push_back(it->second);
+    }
+  }
+  return batch;
+}
+
+void noopFibUpdate(
+    RouterID /* vrf */,
+    const rib::IPv4NetworkToRouteMap& /* v4NetworkToRoute */,
+    const rib::IPv6NetworkToRouteMap& /* v6NetworkToRoute */,
+    const rib::UpdatedPrefixes* /* updatedPrefixes */,
+    void* /* cookie */) {}
+
 } // namespace
 
 template <typename Generator>
@@ -123,21 +186,9 @@ static void runNewRibTest() {
   suspender.dismiss();
 
   for (const auto& chunk : routeChunks) {
-    std::vector<UnicastRoute> routesToAdd;
+    std::vector<UnicastRoute> routesToAdd = toUnicastRoutes(chunk);
     std::vector<IpPrefix> routesToDel;
 
-    for (const auto& route : chunk) {
-      UnicastRoute routeToAdd;
-
-      IpPrefix prefix;
-      prefix.ip = facebook::network::toBinaryAddress(route.prefix.first);
-      prefix.prefixLength = route.prefix.second;
-      routeToAdd.dest_ref() = prefix;
-      routeToAdd.nextHops_ref() = nextHopsThrift(route.nhops);
-
-      routesToAdd.push_back(std::move(routeToAdd));
-    }
-
     sw->getRib()->update(
         vrfZero,
         ClientID(10),
@@ -149,9 +200,10 @@ static void runNewRibTest() {
         [](RouterID vrf,
            const rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
            const rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+           const rib::UpdatedPrefixes* updatedPrefixes,
            void* cookie) {
           rib::ForwardingInformationBaseUpdater fibUpdater(
-              vrf, v4NetworkToRoute, v6NetworkToRoute);
+              vrf, v4NetworkToRoute, v6NetworkToRoute, updatedPrefixes);
           static_cast<SwSwitch*>(cookie)->updateStateBlocking(
               "", std::move(fibUpdater));
         },
@@ -159,6 +211,88 @@ static void runNewRibTest() {
   }
 }
 
+/*
+ * Measure the RIB cost of withdrawing and re-announcing a single prefix once
+ * a full table has been programmed. This exercises incremental recursive
+ * resolution, so its cost should be independent of the table size. The FIB
+ * callback is a no-op to isolate the RIB from FIB/SwitchState updates.
+ */
+template <typename Generator>
+static void runRibSinglePrefixChurnTest(unsigned iters) {
+  folly::BenchmarkSuspender suspender;
+
+  const RouterID vrfZero{0};
+  const ClientID clientId{10};
+
+  SimPlatform plat(folly::MacAddress(), 128);
+  std::vector<PortID> ports;
+  for (int i = 0; i < 128; ++i) {
+    ports.push_back(PortID(i));
+  }
+  cfg::SwitchConfig config =
+      utility::onePortPerVlanConfig(plat.getHwSwitch(), ports);
+  auto testHandle =
+      createTestHandle(&config, SwitchFlags::ENABLE_STANDALONE_RIB);
+  auto sw = testHandle->getSw();
+
+  sw->updateStateBlocking(
+      "add VRF0", [=](const std::shared_ptr<SwitchState>& state) {
+        std::shared_ptr<SwitchState> newState{state};
+        auto newRouteTables = newState->getRouteTables()->modify(&newState);
+        newRouteTables->addRouteTable(
+            std::make_shared<RouteTable>(RouterID(0)));
+        return newState;
+      });
+
+  auto routeChunks =
+      Generator(sw->getAppliedState(), 1337, kEcmpWidth, vrfZero).get();
+  CHECK(!routeChunks.empty() && !routeChunks.front().empty());
+
+  // Program the full table.
+  for (const auto& chunk : routeChunks) {
+    sw->getRib()->update(
+        vrfZero,
+        clientId,
+        AdminDistance::EBGP,
+        toUnicastRoutes(chunk),
+        {},
+        false /* sync */,
+        "churn benchmark setup",
+        noopFibUpdate,
+        nullptr);
+  }
+
+  // Churn the first generated prefix.
+  auto toAdd = toUnicastRoutes(utility::RouteDistributionGenerator::RouteChunk{
+      routeChunks.front().front()});
+  std::vector<IpPrefix> toDel{*toAdd.front().dest_ref()};
+
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    sw->getRib()->update(
+        vrfZero,
+        clientId,
+        AdminDistance::EBGP,
+        {},
+        toDel,
+        false /* sync */,
+        "churn benchmark withdraw",
+        noopFibUpdate,
+        nullptr);
+    sw->getRib()->update(
+        vrfZero,
+        clientId,
+        AdminDistance::EBGP,
+        toAdd,
+        {},
+        false /* sync */,
+        "churn benchmark announce",
+        noopFibUpdate,
+        nullptr);
+  }
+}
+
 BENCHMARK(FibSyncFSWLegacy) {
   runOldRibTest<utility::FSWRouteScaleGenerator>();
 }
@@ -191,6 +325,201 @@ BENCHMARK_RELATIVE(FibSyncHgridUu) {
   runNewRibTest<utility::HgridUuRouteScaleGenerator>();
 }
 
+BENCHMARK(RibSinglePrefixChurnFSW, iters) {
+  runRibSinglePrefixChurnTest<utility::FSWRouteScaleGenerator>(iters);
+}
+
+BENCHMARK(RibSinglePrefixChurnHgridDu, iters) {
+  runRibSinglePrefixChurnTest<utility::HgridDuRouteScaleGenerator>(iters);
+}
+
+BENCHMARK(RibSinglePrefixChurnHgridUu, iters) {
+  runRibSinglePrefixChurnTest<utility::HgridUuRouteScaleGenerator>(iters);
+}
+
+/*
+ * End to end cost of syncing a full table through the thrift handler, from
+ * a list of routes vs. a columnar route batch. Includes conversion, RIB
+ * resolution and programming the FIB into the SwitchState.
+ */
+template <typename Generator>
+static void runThriftSyncFibTest(bool columnar) {
+  folly::BenchmarkSuspender suspender;
+
+  SimPlatform plat(folly::MacAddress(), 128);
+  std::vector<PortID> ports;
+  for (int i = 0; i < 128; ++i) {
+    ports.push_back(PortID(i));
+  }
+  cfg::SwitchConfig config =
+      utility::onePortPerVlanConfig(plat.getHwSwitch(), ports);
+  auto testHandle =
+      createTestHandle(&config, SwitchFlags::ENABLE_STANDALONE_RIB);
+  auto sw = testHandle->getSw();
+
+  sw->updateStateBlocking(
+      "add VRF0", [=](const std::shared_ptr<SwitchState>& state) {
+        std::shared_ptr<SwitchState> newState{state};
+        auto newRouteTables = newState->getRouteTables()->modify(&newState);
+        newRouteTables->addRouteTable(
+            std::make_shared<RouteTable>(RouterID(0)));
+        return newState;
+      });
+  ThriftHandler handler(sw);
+
+  // Sync the whole table in one call, as a routing daemon does on restart
+  auto generator =
+      Generator(sw->getAppliedState(), 1337, kEcmpWidth, RouterID(0));
+  utility::RouteDistributionGenerator::RouteChunk allRoutes;
+  for (const auto& chunk : generator.get()) {
+    allRoutes.insert(allRoutes.end(), chunk.begin(), chunk.end());
+  }
+  auto routes =
+      std::make_unique<std::vector<UnicastRoute>>(toUnicastRoutes(allRoutes));
+  auto batch = std::make_unique<UnicastRouteBatch>(
+      toUnicastRouteBatch(allRoutes));
+
+  suspender.dismiss();
+
+  if (columnar) {
+    handler.syncFibBatchInVrf(10, std::move(batch), 0);
+  } else {
+    handler.syncFib(10, std::move(routes));
+  }
+
+  // Don't count freeing the routes and tearing down the switch
+  suspender.rehire();
+}
+
+BENCHMARK(ThriftSyncFibFSW) {
+  runThriftSyncFibTest<utility::FSWRouteScaleGenerator>(false);
+}
+
+BENCHMARK_RELATIVE(ThriftSyncFibBatchFSW) {
+  runThriftSyncFibTest<utility::FSWRouteScaleGenerator>(true);
+}
+
+BENCHMARK(ThriftSyncFibHgridUu) {
+  runThriftSyncFibTest<utility::HgridUuRouteScaleGenerator>(false);
+}
+
+BENCHMARK_RELATIVE(ThriftSyncFibBatchHgridUu) {
+  runThriftSyncFibTest<utility::HgridUuRouteScaleGenerator>(true);
+}
+
+/*
+ * Program `kRoutesPerVrf` routes into each of `numVrfs` VRFs of a standalone
+ * RIB, with one writer thread per VRF if `parallel` is set or a single
+ * writer otherwise. `numReaders` threads concurrently poll
+ * getRouteTableDetails() to show that readers don't stall writers.
+ */
+static void
+runConcurrentRibUpdates(int numVrfs, bool parallel, int numReaders = 0) {
+  constexpr auto kRoutesPerVrf = 50000;
+  constexpr auto kRoutesPerUpdate = 500;
+
+  folly::BenchmarkSuspender suspender;
+
+  rib::RoutingInformationBase rib;
+  rib::RoutingInformationBase::RouterIDAndNetworkToInterfaceRoutes
+      interfaceRoutes;
+  for (int vrf = 0; vrf < numVrfs; ++vrf) {
+    rib.createVrf(RouterID(vrf));
+    interfaceRoutes[RouterID(vrf)].emplace(
+        folly::IPAddress::createNetwork("1.1.1.0/24"),
+        std::make_pair(InterfaceID(1), folly::IPAddress("1.1.1.1")));
+  }
+  rib.reconfigure(interfaceRoutes, {}, {}, {}, noopFibUpdate, nullptr);
+
+  // Pre-build all updates so only RIB programming is measured.
+  std::vector<std::vector<UnicastRoute>> updates;
+  for (int i = 0; i < kRoutesPerVrf; i += kRoutesPerUpdate) {
+    std::vector<UnicastRoute> update;
+    for (int j = i; j < i + kRoutesPerUpdate; ++j) {
+      UnicastRoute route;
+      IpPrefix prefix;
+      prefix.ip = facebook::network::toBinaryAddress(
+          folly::IPAddress::fromLongHBO(
+              (10u << 24) + (static_cast<uint32_t>(j) << 8)));
+      prefix.prefixLength = 24;
+      route.dest_ref() = prefix;
+      route.nextHops_ref() = nextHopsThrift(
+          {folly::IPAddress("1.1.1.10"), folly::IPAddress("1.1.1.11")});
+      update.push_back(std::move(route));
+    }
+    updates.push_back(std::move(update));
+  }
+
+  auto programVrf = [&](RouterID vrf) {
+    for (const auto& update : updates) {
+      rib.update(
+          vrf,
+          ClientID(10),
+          AdminDistance::EBGP,
+          update,
+          {},
+          false /* sync */,
+          "concurrent update benchmark",
+          noopFibUpdate,
+          nullptr);
+    }
+  };
+
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < numReaders; ++i) {
+    readers.emplace_back([&rib, &done, i, numVrfs] {
+      while (!done) {
+        folly::doNotOptimizeAway(
+            rib.getRouteTableDetails(RouterID(i % numVrfs)));
+      }
+    });
+  }
+
+  suspender.dismiss();
+
+  if (parallel) {
+    std::vector<std::thread> writers;
+    for (int vrf = 0; vrf < numVrfs; ++vrf) {
+      writers.emplace_back(programVrf, RouterID(vrf));
+    }
+    for (auto& writer : writers) {
+      writer.join();
+    }
+  } else {
+    for (int vrf = 0; vrf < numVrfs; ++vrf) {
+      programVrf(RouterID(vrf));
+    }
+  }
+
+  suspender.rehire();
+
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
+BENCHMARK(RibUpdate4VrfsSerial) {
+  runConcurrentRibUpdates(4, false);
+}
+
+BENCHMARK_RELATIVE(RibUpdate4VrfsParallel) {
+  runConcurrentRibUpdates(4, true);
+}
+
+BENCHMARK(RibUpdate8VrfsSerial) {
+  runConcurrentRibUpdates(8, false);
+}
+
+BENCHMARK_RELATIVE(RibUpdate8VrfsParallel) {
+  runConcurrentRibUpdates(8, true);
+}
+
+BENCHMARK_RELATIVE(RibUpdate8VrfsParallelWithReaders) {
+  runConcurrentRibUpdates(8, true, 4);
+}
+
 int main(int argc, char** argv) {
   facebook::initFacebook(&argc, &argv);
   folly::runBenchmarks();
@@ -30,6 +30,15 @@ template <typename AddressT>
 std::shared_ptr<Route<AddressT>>
 ForwardingInformationBase<AddressT>::longestMatch(
     const AddressT& address) const {
+  if (isLpmIndexUsable()) {
+    auto mask = this->getExtraFields().lpmIndex.longestMatchLength(address);
+    if (mask < 0) {
+      return nullptr;
+    }
+    return exactMatch(
+        RoutePrefix<AddressT>{address.mask(mask), static_cast<uint8_t>(mask)});
+  }
+
   std::shared_ptr<Route<AddressT>> longestMatchRoute = nullptr;
   // longestCommonLength must be wider than int8_t because it needs to hold
   // values in the range [-1, 128].
@@ -58,6 +67,78 @@ ForwardingInformationBase<AddressT>::longestMatch(
   return longestMatchRoute;
 }
 
+template <typename AddressT>
+void ForwardingInformationBase<AddressT>::addNode(
+    const std::shared_ptr<Route<AddressT>>& route) {
+  Base::addNode(route);
+  const auto& prefix = route->prefix();
+  this->writableExtraFields().lpmIndex.insert(prefix.network, prefix.mask);
+}
+
+template <typename AddressT>
+void ForwardingInformationBase<AddressT>::removeNode(
+    const std::shared_ptr<Route<AddressT>>& route) {
+  Base::removeNode(route);
+  const auto& prefix = route->prefix();
+  this->writableExtraFields().lpmIndex.erase(prefix.network, prefix.mask);
+}
+
+template <typename AddressT>
+std::shared_ptr<Route<AddressT>>
+ForwardingInformationBase<AddressT>::removeNode(
+    const RoutePrefix<AddressT>& prefix) {
+  auto route = Base::removeNode(prefix);
+  this->writableExtraFields().lpmIndex.erase(prefix.network, prefix.mask);
+  return route;
+}
+
+template <typename AddressT>
+std::shared_ptr<Route<AddressT>>
+ForwardingInformationBase<AddressT>::removeNodeIf(
+    const RoutePrefix<AddressT>& prefix) {
+  auto route = Base::removeNodeIf(prefix);
+  if (route) {
+    this->writableExtraFields().lpmIndex.erase(prefix.network, prefix.mask);
+  }
+  return route;
+}
+
+template <typename AddressT>
+typename ForwardingInformationBase<AddressT>::NodeContainer&
+ForwardingInformationBase<AddressT>::writableNodes() {
+  this->writableExtraFields().lpmIndexValid = false;
+  return Base::writableNodes();
+}
+
+template <typename AddressT>
+void ForwardingInformationBase<AddressT>::publish() {
+  if (this->isPublished()) {
+    return;
+  }
+  if (!isLpmIndexUsable()) {
+    rebuildLpmIndex();
+  }
+  Base::publish();
+}
+
+template <typename AddressT>
+bool ForwardingInformationBase<AddressT>::isLpmIndexUsable() const {
+  // A FIB constructed from a set of routes starts with an empty index
+  const auto& extra = this->getExtraFields();
+  return extra.lpmIndexValid && extra.lpmIndex.size() == this->size();
+}
+
+template <typename AddressT>
+void ForwardingInformationBase<AddressT>::rebuildLpmIndex() {
+  auto& extra = this->writableExtraFields();
+  extra.lpmIndex.clear();
+  for (const auto& prefixAndRoute : this->getAllNodes()) {
+    const auto& prefix = prefixAndRoute.first;
+    extra.lpmIndex.insert(prefix.network, prefix.mask);
+  }
+  extra.lpmIndexValid = true;
+}
+
 FBOSS_INSTANTIATE_NODE_MAP(
     ForwardingInformationBase<folly::IPAddressV4>,
     ForwardingInformationBaseTraits<folly::IPAddressV4>);
@@ -9,18 +9,57 @@
  */
 #pragma once
 
+#include "fboss/agent/state/LpmIndex.h"
 #include "fboss/agent/state/NodeMap.h"
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/RouteTypes.h"
+#include "fboss/lib/PersistentMap.h"
 
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 
 namespace facebook::fboss {
 
+/*
+ * Besides the routes, the FIB keeps an LpmIndex of their prefixes so that
+ * longestMatch() doesn't need to scan every route. The index is derived from
+ * the routes, so it isn't serialized, and like the routes it is shared with
+ * the FIB this one was cloned from.
+ */
 template <typename AddressT>
-using ForwardingInformationBaseTraits =
-    NodeMapTraits<RoutePrefix<AddressT>, Route<AddressT>>;
+struct ForwardingInformationBaseExtraFields {
+  template <typename Fn>
+  void forEachChild(Fn /*fn*/) {}
+
+  folly::dynamic toFollyDynamic() const {
+    return folly::dynamic::object;
+  }
+
+  static ForwardingInformationBaseExtraFields fromFollyDynamic(
+      const folly::dynamic& /*json*/) {
+    ForwardingInformationBaseExtraFields extra;
+    // Set after the routes were added, rebuild on publish()
+    extra.lpmIndexValid = false;
+    return extra;
+  }
+
+  LpmIndex<AddressT> lpmIndex;
+  // False if the routes were modified without updating the index
+  bool lpmIndexValid{true};
+};
+
+/*
+ * The FIB holds every route and is cloned on each route update. Its nodes are
+ * stored in a PersistentMap, so that a clone shares all unchanged routes with
+ * the original and NodeMapDelta can skip over them instead of comparing every
+ * route.
+ */
+template <typename AddressT>
+using ForwardingInformationBaseTraits = NodeMapTraits<
+    RoutePrefix<AddressT>,
+    Route<AddressT>,
+    ForwardingInformationBaseExtraFields<AddressT>,
+    PersistentMap<RoutePrefix<AddressT>, std::shared_ptr<Route<AddressT>>>>;
 
 template <typename AddressT>
 class ForwardingInformationBase
@@ -34,13 +73,37 @@ class ForwardingInformationBase
   using Base = NodeMapT<
       ForwardingInformationBase<AddressT>,
       ForwardingInformationBaseTraits<AddressT>>;
+  using NodeContainer = typename Base::NodeContainer;
 
   std::shared_ptr<Route<AddressT>> exactMatch(
       const RoutePrefix<AddressT>& prefix) const;
 
+  /*
+   * Uses the LPM index when it is in sync with the routes, which is always
+   * the case once the FIB is published, and falls back to scanning every
+   * route otherwise.
+   */
   std::shared_ptr<Route<AddressT>> longestMatch(const AddressT& address) const;
 
+  /*
+   * The NodeMapT modifiers, extended to keep the LPM index in sync. Routes
+   * modified through writableNodes() or set wholesale through the
+   * constructor are indexed again when the FIB is published.
+   */
+  void addNode(const std::shared_ptr<Route<AddressT>>& route);
+  void removeNode(const std::shared_ptr<Route<AddressT>>& route);
+  std::shared_ptr<Route<AddressT>> removeNode(
+      const RoutePrefix<AddressT>& prefix);
+  std::shared_ptr<Route<AddressT>> removeNodeIf(
+      const RoutePrefix<AddressT>& prefix);
+  NodeContainer& writableNodes();
+
+  void publish() override;
+
  private:
+  bool isLpmIndexUsable() const;
+  void rebuildLpmIndex();
+
   // Inherit the constructors required for clone()
   using Base::Base;
   friend class CloneAllocator;
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/state/LpmIndex.h"
+
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+#include <glog/logging.h>
+
+namespace facebook::fboss {
+
+template <typename AddressT>
+template <size_t kBits>
+size_t LpmIndex<AddressT>::Bitmap<kBits>::rank(size_t i) const {
+  size_t count = 0;
+  for (size_t word = 0; word < i / 64; ++word) {
+    count += __builtin_popcountll(words[word]);
+  }
+  if (i % 64) {
+    count += __builtin_popcountll(
+        words[i / 64] & ((uint64_t(1) << (i % 64)) - 1));
+  }
+  return count;
+}
+
+template <typename AddressT>
+template <size_t kBits>
+bool LpmIndex<AddressT>::Bitmap<kBits>::none() const {
+  for (auto word : words) {
+    if (word) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename AddressT>
+uint8_t LpmIndex<AddressT>::addressByte(const AddressT& address, int depth) {
+  return address.bytes()[depth];
+}
+
+template <typename AddressT>
+typename LpmIndex<AddressT>::Node* LpmIndex<AddressT>::writableNode(
+    NodePtr& node) {
+  if (!node) {
+    node = std::make_shared<Node>();
+  } else if (node.use_count() > 1) {
+    node = std::make_shared<Node>(*node);
+  }
+  return node.get();
+}
+
+template <typename AddressT>
+typename LpmIndex<AddressT>::NodePtr& LpmIndex<AddressT>::writableChild(
+    Node* node,
+    uint8_t byte) {
+  auto pos = node->childBitmap.rank(byte);
+  if (!node->childBitmap.test(byte)) {
+    node->children.insert(node->children.begin() + pos, nullptr);
+    node->childBitmap.set(byte);
+  }
+  return node->children[pos];
+}
+
+template <typename AddressT>
+void LpmIndex<AddressT>::insert(const AddressT& network, uint8_t mask) {
+  CHECK_LE(mask, AddressT::bitCount());
+  int depth = mask == 0 ? 0 : (mask - 1) / kStride;
+  auto bit = prefixBit(addressByte(network, depth), mask - depth * kStride);
+
+  auto node = writableNode(root_);
+  for (int i = 0; i < depth; ++i) {
+    node = writableNode(writableChild(node, addressByte(network, i)));
+  }
+  if (!node->prefixBitmap.test(bit)) {
+    node->prefixBitmap.set(bit);
+    ++size_;
+  }
+}
+
+template <typename AddressT>
+void LpmIndex<AddressT>::erase(const AddressT& network, uint8_t mask) {
+  CHECK_LE(mask, AddressT::bitCount());
+  int depth = mask == 0 ? 0 : (mask - 1) / kStride;
+  auto bit = prefixBit(addressByte(network, depth), mask - depth * kStride);
+
+  // Look the prefix up first, so that erasing a missing prefix doesn't clone
+  // any shared nodes.
+  const Node* found = root_.get();
+  for (int i = 0; found && i < depth; ++i) {
+    found = found->child(addressByte(network, i));
+  }
+  if (!found || !found->prefixBitmap.test(bit)) {
+    return;
+  }
+
+  std::array<Node*, AddressT::byteCount()> parents;
+  auto node = writableNode(root_);
+  for (int i = 0; i < depth; ++i) {
+    parents[i] = node;
+    node = writableNode(writableChild(node, addressByte(network, i)));
+  }
+  node->prefixBitmap.reset(bit);
+  --size_;
+
+  // Remove the nodes left without any prefixes or children
+  for (int i = depth - 1; i >= 0 && node->empty(); --i) {
+    auto parent = parents[i];
+    auto byte = addressByte(network, i);
+    parent->children.erase(
+        parent->children.begin() + parent->childBitmap.rank(byte));
+    parent->childBitmap.reset(byte);
+    node = parent;
+  }
+  if (root_->empty()) {
+    root_.reset();
+  }
+}
+
+template <typename AddressT>
+int LpmIndex<AddressT>::longestMatchLength(const AddressT& address) const {
+  int longest = -1;
+  const Node* node = root_.get();
+  for (int depth = 0; node; ++depth) {
+    auto byte = addressByte(address, depth);
+    for (int len = kStride; len >= 0; --len) {
+      if (node->prefixBitmap.test(prefixBit(byte, len))) {
+        longest = depth * kStride + len;
+        break;
+      }
+    }
+    node = node->child(byte);
+  }
+  return longest;
+}
+
+template class LpmIndex<folly::IPAddressV4>;
+template class LpmIndex<folly::IPAddressV6>;
+
+} // namespace facebook::fboss
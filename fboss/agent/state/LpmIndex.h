@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * LpmIndex answers longest prefix match queries over a set of prefixes.
+ *
+ * It is a multibit trie with a stride of 8 bits, where each node is
+ * compressed as in Tree Bitmap: a bitmap of the (up to 511) prefixes ending
+ * in the node and a bitmap of its (up to 256) children, which are stored
+ * densely and indexed by popcount. A lookup visits at most one node per
+ * address byte, i.e. 4 for v4 and 16 for v6, independent of the number of
+ * prefixes.
+ *
+ * Nodes are immutable once shared: copying an index is O(1), and modifying
+ * a copy only clones the nodes on the path to the modified prefix. This lets
+ * each FIB generation keep its own index while sharing all unchanged nodes
+ * with the previous one. Nodes that are not shared are modified in place.
+ *
+ * The index only records which prefixes exist, it is up to the caller to map
+ * the matching prefix back to its value.
+ */
+template <typename AddressT>
+class LpmIndex {
+ public:
+  void insert(const AddressT& network, uint8_t mask);
+  void erase(const AddressT& network, uint8_t mask);
+
+  /*
+   * Return the mask length of the longest prefix containing `address`, or -1
+   * if there is none.
+   */
+  int longestMatchLength(const AddressT& address) const;
+
+  size_t size() const {
+    return size_;
+  }
+  void clear() {
+    root_.reset();
+    size_ = 0;
+  }
+
+ private:
+  static constexpr int kStride = 8;
+  static constexpr int kFanout = 1 << kStride;
+  // Prefixes of length [0, kStride] within a node
+  static constexpr int kNumNodePrefixes = (kFanout << 1) - 1;
+
+  template <size_t kBits>
+  struct Bitmap {
+    bool test(size_t i) const {
+      return words[i / 64] & (uint64_t(1) << (i % 64));
+    }
+    void set(size_t i) {
+      words[i / 64] |= uint64_t(1) << (i % 64);
+    }
+    void reset(size_t i) {
+      words[i / 64] &= ~(uint64_t(1) << (i % 64));
+    }
+    // Number of bits set below i
+    size_t rank(size_t i) const;
+    bool none() const;
+
+    std::array<uint64_t, (kBits + 63) / 64> words{};
+  };
+
+  struct Node;
+  using NodePtr = std::shared_ptr<Node>;
+
+  struct Node {
+    const Node* child(uint8_t byte) const {
+      return childBitmap.test(byte) ? children[childBitmap.rank(byte)].get()
+                                    : nullptr;
+    }
+    bool empty() const {
+      return children.empty() && prefixBitmap.none();
+    }
+
+    // Bit (1 << len) - 1 + (byte >> (kStride - len)) is set if the prefix of
+    // len bits of byte ends in this node.
+    Bitmap<kNumNodePrefixes> prefixBitmap;
+    Bitmap<kFanout> childBitmap;
+    std::vector<NodePtr> children;
+  };
+
+  static uint8_t addressByte(const AddressT& address, int depth);
+  static size_t prefixBit(uint8_t byte, int len) {
+    return (size_t(1) << len) - 1 + (byte >> (kStride - len));
+  }
+  /*
+   * Return a node that can be modified in place, cloning `node` first if it
+   * is shared with another index.
+   */
+  static Node* writableNode(NodePtr& node);
+  static NodePtr& writableChild(Node* node, uint8_t byte);
+
+  NodePtr root_;
+  size_t size_{0};
+};
+
+} // namespace facebook::fboss
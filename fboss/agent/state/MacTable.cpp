@@ -48,18 +48,17 @@ void MacTable::updateEntry(
     std::optional<cfg::AclLookupClass> classID,
     MacEntryType type) {
   CHECK(!this->isPublished());
-  auto& nodes = this->writableNodes();
-  auto it = nodes.find(mac);
-  if (it == nodes.end()) {
+  auto oldEntry = this->getNodeIf(mac);
+  if (!oldEntry) {
     throw FbossError("Mac entry for ", mac.toString(), " does not exist");
   }
-  auto entry = it->second->clone();
+  auto entry = oldEntry->clone();
 
   entry->setMac(mac);
   entry->setPort(portDescr);
   entry->setClassID(classID);
   entry->setType(type);
-  it->second = entry;
+  updateNode(entry);
 }
 
 FBOSS_INSTANTIATE_NODE_MAP(MacTable, MacTableTraits);
@@ -49,33 +49,39 @@ std::shared_ptr<typename TraitsT::Node> NodeMapT<MapTypeT, TraitsT>::getNodeIf(
 
 template <typename MapTypeT, typename TraitsT>
 void NodeMapT<MapTypeT, TraitsT>::addNode(const std::shared_ptr<Node>& node) {
-  auto& nodes = writableNodes();
-  auto ret = nodes.insert(std::make_pair(TraitsT::getKey(node), node));
+  auto& nodes = this->writableFields()->nodes;
+  auto key = TraitsT::getKey(node);
+  auto ret = nodes.insert(std::make_pair(key, node));
   if (!ret.second) {
-    throw FbossError("duplicate node ID ", TraitsT::getKey(node));
+    throw FbossError("duplicate node ID ", key);
   }
+  recordChange(key);
 }
 
 template <typename MapTypeT, typename TraitsT>
 void NodeMapT<MapTypeT, TraitsT>::updateNode(
     const std::shared_ptr<Node>& node) {
-  auto& nodes = writableNodes();
-  auto it = nodes.find(TraitsT::getKey(node));
+  auto& nodes = this->writableFields()->nodes;
+  auto key = TraitsT::getKey(node);
+  auto it = nodes.find(key);
   if (it == nodes.end()) {
-    throw FbossError("node ID ", TraitsT::getKey(node), " does not exist");
+    throw FbossError("node ID ", key, " does not exist");
   }
-  it->second = node;
+  nodes.insert_or_assign(it, key, node);
+  recordChange(key);
 }
 
 template <typename MapTypeT, typename TraitsT>
 void NodeMapT<MapTypeT, TraitsT>::removeNode(
     const std::shared_ptr<Node>& node) {
-  auto& nodes = writableNodes();
-  auto it = nodes.find(TraitsT::getKey(node));
+  auto& nodes = this->writableFields()->nodes;
+  auto key = TraitsT::getKey(node);
+  auto it = nodes.find(key);
   if (it == nodes.end()) {
-    throw FbossError("node ID ", TraitsT::getKey(node), " does not exist");
+    throw FbossError("node ID ", key, " does not exist");
   }
   nodes.erase(it);
+  recordChange(key);
 }
 
 template <typename MapTypeT, typename TraitsT>
@@ -91,16 +97,32 @@ std::shared_ptr<typename TraitsT::Node> NodeMapT<MapTypeT, TraitsT>::removeNode(
 template <typename MapTypeT, typename TraitsT>
 std::shared_ptr<typename TraitsT::Node>
 NodeMapT<MapTypeT, TraitsT>::removeNodeIf(const KeyType& key) {
-  auto& nodes = writableNodes();
+  auto& nodes = this->writableFields()->nodes;
   auto it = nodes.find(key);
   if (it == nodes.end()) {
     return nullptr;
   }
   std::shared_ptr<Node> node = it->second;
   nodes.erase(it);
+  recordChange(key);
   return node;
 }
 
+template <typename MapTypeT, typename TraitsT>
+void NodeMapT<MapTypeT, TraitsT>::publish() {
+  if (this->isPublished()) {
+    return;
+  }
+  this->writableFields()->changes.seal();
+  NodeBaseT<MapTypeT, NodeMapFields<TraitsT>>::publish();
+}
+
+template <typename MapTypeT, typename TraitsT>
+void NodeMapT<MapTypeT, TraitsT>::recordChange(const KeyType& key) {
+  auto* fields = this->writableFields();
+  fields->changes.recordChange(key, fields->nodes.size());
+}
+
 template <typename MapTypeT, typename TraitsT>
 folly::dynamic NodeMapT<MapTypeT, TraitsT>::toFollyDynamic() const {
   folly::dynamic nodesJson = folly::dynamic::array;
@@ -10,12 +10,35 @@
 #pragma once
 
 #include <boost/container/flat_map.hpp>
+#include <type_traits>
+#include <vector>
 
 #include "fboss/agent/state/NodeBase.h"
+#include "fboss/agent/state/NodeMapChangeLog.h"
 #include "fboss/agent/state/NodeMapIterator.h"
 
 namespace facebook::fboss {
 
+namespace detail {
+/*
+ * The container used to store a NodeMap's nodes: TraitsT::NodeContainer if
+ * the traits define one, a flat_map otherwise.
+ */
+template <typename TraitsT, typename = void>
+struct NodeMapContainer {
+  using type = boost::container::flat_map<
+      typename TraitsT::KeyType,
+      std::shared_ptr<typename TraitsT::Node>>;
+};
+
+template <typename TraitsT>
+struct NodeMapContainer<
+    TraitsT,
+    std::void_t<typename TraitsT::NodeContainer>> {
+  using type = typename TraitsT::NodeContainer;
+};
+} // namespace detail
+
 /*
  * NodeMapFields defines the fields contained inside a NodeMapT instantiation
  */
@@ -24,8 +47,7 @@ struct NodeMapFields {
   using KeyType = typename TraitsT::KeyType;
   using Node = typename TraitsT::Node;
   using ExtraFields = typename TraitsT::ExtraFields;
-  using NodeContainer =
-      boost::container::flat_map<KeyType, std::shared_ptr<Node>>;
+  using NodeContainer = typename detail::NodeMapContainer<TraitsT>::type;
 
   NodeMapFields() {}
   NodeMapFields(NodeContainer nodes) : nodes(std::move(nodes)) {}
@@ -42,6 +64,9 @@ struct NodeMapFields {
 
   NodeContainer nodes;
   ExtraFields extra;
+  // Keys changed since this map was cloned. Only fields copied from another
+  // map track changes, replacing the nodes wholesale starts a new history.
+  NodeMapChangeLog<KeyType> changes;
 };
 
 struct NodeMapNoExtraFields {
@@ -57,11 +82,22 @@ struct NodeMapNoExtraFields {
   }
 };
 
-template <typename KeyT, typename NodeT, typename ExtraT = NodeMapNoExtraFields>
+/*
+ * NodeContainerT must provide the subset of the flat_map interface used by
+ * NodeMapT. Maps which are large and frequently copied, such as the FIB, can
+ * use a PersistentMap so that clone() doesn't copy every node pointer.
+ */
+template <
+    typename KeyT,
+    typename NodeT,
+    typename ExtraT = NodeMapNoExtraFields,
+    typename NodeContainerT =
+        boost::container::flat_map<KeyT, std::shared_ptr<NodeT>>>
 struct NodeMapTraits {
   using KeyType = KeyT;
   using Node = NodeT;
   using ExtraFields = ExtraT;
+  using NodeContainer = NodeContainerT;
 
   static KeyType getKey(const std::shared_ptr<Node>& node) {
     return node->getID();
@@ -99,8 +135,15 @@ class NodeMapT : public NodeBaseT<MapTypeT, NodeMapFields<TraitsT>> {
   const NodeContainer& getAllNodes() const {
     return this->getFields()->nodes;
   }
+  /*
+   * Direct access to the node container bypasses change tracking, so any delta
+   * computed against this map has to compare it entry by entry. Prefer
+   * addNode()/updateNode()/removeNode().
+   */
   NodeContainer& writableNodes() {
-    return this->writableFields()->nodes;
+    auto* fields = this->writableFields();
+    fields->changes.stopTracking();
+    return fields->nodes;
   }
 
   const ExtraFields& getExtraFields() const {
@@ -123,6 +166,29 @@ class NodeMapT : public NodeBaseT<MapTypeT, NodeMapFields<TraitsT>> {
     return (ReverseIterator(getAllNodes().rend()));
   }
 
+  /*
+   * Iterator to the first node whose key is not less than `key`.
+   */
+  Iterator lowerBound(const KeyType& key) const {
+    return Iterator(getAllNodes().lower_bound(key));
+  }
+
+  /*
+   * Return the sorted keys of the nodes which may differ between `origin` and
+   * this map, or nullptr if they are unknown. Keys are only known when both
+   * maps are published and this map was cloned from `origin`.
+   */
+  const std::vector<KeyType>* getChangedKeysSince(
+      const MapTypeT& origin) const {
+    if (!this->isPublished() || !origin.isPublished()) {
+      return nullptr;
+    }
+    return this->getFields()->changes.getChangesSince(
+        origin.getFields()->changes);
+  }
+
+  void publish() override;
+
   /*
    * The following functions modify the static state.
    * These should only be called on unpublished objects which are only visible
@@ -154,6 +220,9 @@ class NodeMapT : public NodeBaseT<MapTypeT, NodeMapFields<TraitsT>> {
  private:
   // Inherit the constructor required for clone()
   using NodeBaseT<MapTypeT, NodeMapFields<TraitsT>>::NodeBaseT;
+
+  void recordChange(const KeyType& key);
+
   friend class CloneAllocator;
 };
 
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * NodeMapChangeLog records the keys of the nodes that were added, updated or
+ * removed in a NodeMap since it was cloned from a previous version of the map.
+ *
+ * Every change log carries an ID unique to its map object. A copy (i.e. a
+ * clone of the map) remembers the ID of the log it was copied from, which lets
+ * NodeMapDelta tell whether the changes recorded in the new map are exactly
+ * the changes relative to the old map. When they are, the delta only visits
+ * the changed keys instead of comparing both maps entry by entry.
+ *
+ * Tracking is abandoned, and deltas fall back to a full comparison, when the
+ * map's nodes are modified without going through NodeMapT (see
+ * NodeMapT::writableNodes()), or when the number of recorded changes grows
+ * larger than the map itself.
+ */
+template <typename KeyT>
+class NodeMapChangeLog {
+ public:
+  // A log that isn't derived from any other map doesn't track changes
+  NodeMapChangeLog() : id_(nextId()) {}
+
+  // A copied log tracks the changes relative to the copied map
+  NodeMapChangeLog(const NodeMapChangeLog& origin)
+      : id_(nextId()), originId_(origin.id_), tracking_(true) {}
+
+  NodeMapChangeLog& operator=(const NodeMapChangeLog& /*other*/) {
+    // The map's nodes are being replaced wholesale
+    originId_ = 0;
+    stopTracking();
+    return *this;
+  }
+
+  void recordChange(const KeyT& key, size_t mapSize) {
+    if (!tracking_) {
+      return;
+    }
+    if (changedKeys_.size() >= std::max(mapSize, kMinTrackedChanges)) {
+      // A full comparison is cheaper than going through this many keys
+      stopTracking();
+      return;
+    }
+    changedKeys_.push_back(key);
+  }
+
+  void stopTracking() {
+    tracking_ = false;
+    changedKeys_.clear();
+    changedKeys_.shrink_to_fit();
+  }
+
+  /*
+   * Sort and deduplicate the changed keys. Called when the map is published,
+   * after which no more changes can be recorded.
+   */
+  void seal() {
+    std::sort(changedKeys_.begin(), changedKeys_.end());
+    changedKeys_.erase(
+        std::unique(
+            changedKeys_.begin(),
+            changedKeys_.end(),
+            [](const KeyT& a, const KeyT& b) { return !(a < b) && !(b < a); }),
+        changedKeys_.end());
+    sealed_ = true;
+  }
+
+  /*
+   * Return the sorted keys of all nodes that may differ between `origin` and
+   * the map owning this log, or nullptr if they are not known.
+   */
+  const std::vector<KeyT>* getChangesSince(
+      const NodeMapChangeLog& origin) const {
+    if (!tracking_ || !sealed_ || originId_ != origin.id_) {
+      return nullptr;
+    }
+    return &changedKeys_;
+  }
+
+ private:
+  static constexpr size_t kMinTrackedChanges = 16;
+
+  static uint64_t nextId() {
+    static std::atomic<uint64_t> nextId{1};
+    return nextId.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint64_t id_;
+  // ID of the log this one was copied from, 0 if none
+  uint64_t originId_{0};
+  bool tracking_{false};
+  bool sealed_{false};
+  std::vector<KeyT> changedKeys_;
+};
+
+} // namespace facebook::fboss
@@ -30,14 +30,23 @@ NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::Iterator(
       newMap_(newMap),
       value_(nullNode_, nullNode_) {
   // Advance to the first difference
-  while (oldIt_ != oldMap_->end() && newIt_ != newMap_->end() &&
-         *oldIt_ == *newIt_) {
-    ++oldIt_;
-    ++newIt_;
-  }
+  InnerIter::advancePastUnchanged(
+      oldIt_, oldMap_->end(), newIt_, newMap_->end());
   updateValue();
 }
 
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::Iterator(
+    const MapType* oldMap,
+    const MapType* newMap,
+    const std::vector<KeyType>* changedKeys)
+    : oldMap_(oldMap),
+      newMap_(newMap),
+      changedKeys_(changedKeys),
+      value_(nullNode_, nullNode_) {
+  advanceToNextChangedKey();
+}
+
 template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
 NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::Iterator()
     : oldIt_(),
@@ -73,6 +82,11 @@ void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::updateValue() {
 
 template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
 void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::advance() {
+  if (changedKeys_) {
+    advanceToNextChangedKey();
+    return;
+  }
+
   // If we have already hit the end of one side, advance the other.
   // We are immediately done after this.
   if (oldIt_ == oldMap_->end()) {
@@ -101,11 +115,36 @@ void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::advance() {
   }
 
   // Advance past any unchanged nodes.
-  while (oldIt_ != oldMap_->end() && newIt_ != newMap_->end() &&
-         *oldIt_ == *newIt_) {
-    ++oldIt_;
-    ++newIt_;
+  InnerIter::advancePastUnchanged(
+      oldIt_, oldMap_->end(), newIt_, newMap_->end());
+  updateValue();
+}
+
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::
+    advanceToNextChangedKey() {
+  while (nextChangedKey_ < changedKeys_->size()) {
+    const auto& key = (*changedKeys_)[nextChangedKey_++];
+    // Position both sides at the key, or just past where it would be if it
+    // isn't in that map, so that updateValue() sees the right pair of nodes.
+    auto oldIt = oldMap_->lowerBound(key);
+    auto newIt = newMap_->lowerBound(key);
+    bool inOld = oldIt != oldMap_->end() && !(key < Traits::getKey(*oldIt));
+    bool inNew = newIt != newMap_->end() && !(key < Traits::getKey(*newIt));
+    if (inOld && inNew && *oldIt == *newIt) {
+      // Node was updated, but ended up unchanged
+      continue;
+    }
+    if (inOld || inNew) {
+      oldIt_ = oldIt;
+      newIt_ = newIt;
+      updateValue();
+      return;
+    }
+    // Node was added and removed again
   }
+  oldIt_ = oldMap_->end();
+  newIt_ = newMap_->end();
   updateValue();
 }
 
@@ -13,6 +13,7 @@
 #include <functional>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include <folly/functional/ApplyTuple.h>
 
@@ -156,6 +157,14 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
       typename MapType::Iterator oldIt,
       const MapType* newMap,
       typename MapType::Iterator newIt);
+  /*
+   * Iterate over the nodes with the given keys only. The keys must be sorted
+   * and include every node that differs between the two maps.
+   */
+  Iterator(
+      const MapType* oldMap,
+      const MapType* newMap,
+      const std::vector<typename MapType::KeyType>* changedKeys);
   Iterator();
 
   const value_type& operator*() const {
@@ -185,14 +194,19 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
  private:
   using InnerIter = typename MapType::Iterator;
   using Traits = typename MapType::Traits;
+  using KeyType = typename MapType::KeyType;
 
   void advance();
+  void advanceToNextChangedKey();
   void updateValue();
 
-  InnerIter oldIt_{nullptr};
-  InnerIter newIt_{nullptr};
+  InnerIter oldIt_;
+  InnerIter newIt_;
   const MapType* oldMap_{nullptr};
   const MapType* newMap_{nullptr};
+  // When set, only these keys are visited instead of walking both maps
+  const std::vector<KeyType>* changedKeys_{nullptr};
+  size_t nextChangedKey_{0};
   VALUE value_;
 
   static std::shared_ptr<Node> nullNode_;
@@ -214,6 +228,11 @@ NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::begin() const {
   if (!new_) {
     return Iterator(getOld(), old_->begin(), getOld(), old_->end());
   }
+  // If the new map recorded its changes since it was cloned from the old one,
+  // visit just those rather than comparing the maps entry by entry.
+  if (auto changedKeys = getNew()->getChangedKeysSince(*getOld())) {
+    return Iterator(getOld(), getNew(), changedKeys);
+  }
   return Iterator(getOld(), old_->begin(), getNew(), new_->begin());
 }
 
@@ -11,6 +11,29 @@
 
 #include <boost/container/flat_map.hpp>
 
+namespace facebook::fboss::detail {
+
+/*
+ * Advance the container iterators `a` and `b` in lockstep past all entries
+ * which hold the same node.
+ *
+ * Containers whose storage is shared between copies provide a faster
+ * overload (found through ADL) which skips entire shared ranges at once.
+ */
+template <typename ContainerIterator>
+void advancePastShared(
+    ContainerIterator& a,
+    const ContainerIterator& aEnd,
+    ContainerIterator& b,
+    const ContainerIterator& bEnd) {
+  while (a != aEnd && b != bEnd && a->second == b->second) {
+    ++a;
+    ++b;
+  }
+}
+
+} // namespace facebook::fboss::detail
+
 /*
  * NodeMapIterator is a very small wrapper around flat_map::const_iterator.
  *
@@ -52,6 +75,19 @@ class NodeMapIterator
     return it_ != other.it_;
   }
 
+  /*
+   * Advance `a` and `b` past all nodes that are identical in both maps.
+   */
+  static void advancePastUnchanged(
+      NodeMapIterator& a,
+      const NodeMapIterator& aEnd,
+      NodeMapIterator& b,
+      const NodeMapIterator& bEnd) {
+    // Let ADL pick the overload of containers with shared storage
+    using facebook::fboss::detail::advancePastShared;
+    advancePastShared(a.it_, aEnd.it_, b.it_, bEnd.it_);
+  }
+
  private:
   typename NodeContainer::const_iterator it_;
 };
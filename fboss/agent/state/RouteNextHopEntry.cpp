@@ -11,6 +11,7 @@
 
 #include "fboss/agent/FbossError.h"
 
+#include <folly/hash/Hash.h>
 #include <folly/logging/xlog.h>
 #include <gflags/gflags.h>
 #include <numeric>
@@ -46,10 +47,15 @@ std::vector<NextHopThrift> fromRouteNextHopSet(RouteNextHopSet const& nhs) {
 } // namespace util
 
 RouteNextHopEntry::RouteNextHopEntry(NextHopSet nhopSet, AdminDistance distance)
+    : RouteNextHopEntry(InternedNextHopSet(std::move(nhopSet)), distance) {}
+
+RouteNextHopEntry::RouteNextHopEntry(
+    InternedNextHopSet nhopSet,
+    AdminDistance distance)
     : adminDistance_(distance),
       action_(Action::NEXTHOPS),
       nhopSet_(std::move(nhopSet)) {
-  if (nhopSet_.size() == 0) {
+  if (nhopSet_->size() == 0) {
     throw FbossError("Empty nexthop set is passed to the RouteNextHopEntry");
   }
 }
@@ -82,7 +88,7 @@ std::string RouteNextHopEntry::str() const {
 bool operator==(const RouteNextHopEntry& a, const RouteNextHopEntry& b) {
   return (
       a.getAction() == b.getAction() and
-      a.getNextHopSet() == b.getNextHopSet() and
+      a.getInternedNextHopSet() == b.getInternedNextHopSet() and
       a.getAdminDistance() == b.getAdminDistance());
 }
 
@@ -90,9 +96,25 @@ bool operator<(const RouteNextHopEntry& a, const RouteNextHopEntry& b) {
   if (a.getAdminDistance() != b.getAdminDistance()) {
     return a.getAdminDistance() < b.getAdminDistance();
   }
-  return (
-      (a.getAction() == b.getAction()) ? (a.getNextHopSet() < b.getNextHopSet())
-                                       : a.getAction() < b.getAction());
+  if (a.getAction() != b.getAction()) {
+    return a.getAction() < b.getAction();
+  }
+  return a.getInternedNextHopSet() != b.getInternedNextHopSet() &&
+      a.getNextHopSet() < b.getNextHopSet();
+}
+
+size_t RouteNextHopEntry::NextHopSetHash::operator()(
+    const NextHopSet& nhops) const {
+  // Label forwarding actions are left out, equality checks them anyway
+  size_t hash = nhops.size();
+  for (const auto& nhop : nhops) {
+    hash = folly::hash::hash_combine(
+        hash,
+        nhop.addr().hash(),
+        nhop.isResolved() ? static_cast<uint32_t>(nhop.intf()) : 0,
+        nhop.weight());
+  }
+  return hash;
 }
 
 // Methods for RouteNextHopEntry
@@ -131,7 +153,7 @@ folly::dynamic RouteNextHopEntry::toFollyDynamic() const {
   folly::dynamic entry = folly::dynamic::object;
   entry[kAction] = forwardActionStr(action_);
   folly::dynamic nhops = folly::dynamic::array;
-  for (const auto& nhop : nhopSet_) {
+  for (const auto& nhop : *nhopSet_) {
     nhops.push_back(nhop.toFollyDynamic());
   }
   entry[kNexthops] = std::move(nhops);
@@ -148,9 +170,11 @@ RouteNextHopEntry RouteNextHopEntry::fromFollyDynamic(
       : AdminDistance(entryJson[kAdminDistance].asInt());
   RouteNextHopEntry entry(Action::DROP, adminDistance);
   entry.action_ = action;
+  NextHopSet nhops;
   for (const auto& nhop : entryJson[kNexthops]) {
-    entry.nhopSet_.insert(util::nextHopFromFollyDynamic(nhop));
+    nhops.insert(util::nextHopFromFollyDynamic(nhop));
   }
+  entry.nhopSet_ = InternedNextHopSet(std::move(nhops));
   return entry;
 }
 
@@ -158,7 +182,7 @@ bool RouteNextHopEntry::isValid(bool forMplsRoute) const {
   bool valid = true;
   if (!forMplsRoute) {
     /* for ip2mpls routes, next hop label forwarding action must be push */
-    for (const auto& nexthop : nhopSet_) {
+    for (const auto& nexthop : *nhopSet_) {
       if (action_ != Action::NEXTHOPS) {
         continue;
       }
@@ -15,6 +15,7 @@
 
 #include "fboss/agent/state/RouteNextHop.h"
 #include "fboss/agent/state/RouteTypes.h"
+#include "fboss/lib/Interned.h"
 
 DECLARE_uint32(ecmp_width);
 
@@ -24,6 +25,11 @@ class RouteNextHopEntry {
  public:
   using Action = RouteForwardAction;
   using NextHopSet = boost::container::flat_set<NextHop>;
+  struct NextHopSetHash {
+    size_t operator()(const NextHopSet& nhops) const;
+  };
+  // All entries with the same next hops share one copy of them
+  using InternedNextHopSet = Interned<NextHopSet, NextHopSetHash>;
 
   RouteNextHopEntry(Action action, AdminDistance distance)
       : adminDistance_(distance), action_(action) {
@@ -31,11 +37,12 @@ class RouteNextHopEntry {
   }
 
   RouteNextHopEntry(NextHopSet nhopSet, AdminDistance distance);
+  RouteNextHopEntry(InternedNextHopSet nhopSet, AdminDistance distance);
 
   RouteNextHopEntry(NextHop nhop, AdminDistance distance)
-      : adminDistance_(distance), action_(Action::NEXTHOPS) {
-    nhopSet_.emplace(std::move(nhop));
-  }
+      : adminDistance_(distance),
+        action_(Action::NEXTHOPS),
+        nhopSet_(NextHopSet{std::move(nhop)}) {}
 
   AdminDistance getAdminDistance() const {
     return adminDistance_;
@@ -46,6 +53,10 @@ class RouteNextHopEntry {
   }
 
   const NextHopSet& getNextHopSet() const {
+    return *nhopSet_;
+  }
+
+  const InternedNextHopSet& getInternedNextHopSet() const {
     return nhopSet_;
   }
 
@@ -79,7 +90,7 @@ class RouteNextHopEntry {
 
   // Reset the NextHopSet
   void reset() {
-    nhopSet_.clear();
+    nhopSet_ = InternedNextHopSet();
     action_ = Action::DROP;
   }
 
@@ -88,7 +99,7 @@ class RouteNextHopEntry {
  private:
   AdminDistance adminDistance_;
   Action action_{Action::DROP};
-  NextHopSet nhopSet_;
+  InternedNextHopSet nhopSet_;
 };
 
 /**
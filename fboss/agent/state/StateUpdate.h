@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 
 #include <folly/FBString.h>
@@ -32,8 +34,25 @@ class SwitchState;
  */
 class StateUpdate {
  public:
-  explicit StateUpdate(folly::StringPiece name, bool allowCoalesce = true)
-      : name_(name.str()), allowCoalesce_(allowCoalesce) {}
+  /*
+   * Pending updates are applied in priority order, and in FIFO order within a
+   * priority. This keeps latency sensitive updates from queueing behind a
+   * burst of large ones.
+   */
+  enum class Priority : uint8_t {
+    // Link state, LACP and neighbor updates, which directly affect forwarding
+    HIGH,
+    NORMAL,
+    // Large updates such as route programming and config application
+    BULK,
+  };
+  static constexpr size_t kNumPriorities = 3;
+
+  explicit StateUpdate(
+      folly::StringPiece name,
+      bool allowCoalesce = true,
+      Priority priority = Priority::NORMAL)
+      : name_(name.str()), allowCoalesce_(allowCoalesce), priority_(priority) {}
   virtual ~StateUpdate() {}
 
   const std::string& getName() const {
@@ -44,6 +63,10 @@ class StateUpdate {
     return allowCoalesce_;
   }
 
+  Priority getPriority() const {
+    return priority_;
+  }
+
   /*
    * Apply the update, and return a new SwitchState.
    *
@@ -84,6 +107,9 @@ class StateUpdate {
 
   std::string name_;
   bool allowCoalesce_;
+  Priority priority_;
+  // When the update was queued, set by SwSwitch
+  std::chrono::steady_clock::time_point queuedTime_;
 
   // An intrusive list hook for maintaining the list of pending updates.
   folly::IntrusiveListHook listHook_;
@@ -2,6 +2,7 @@
 
 #include <folly/dynamic.h>
 #include <folly/json.h>
+#include <thrift/lib/cpp2/folly_dynamic/folly_dynamic.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include "fboss/agent/state/NodeBase.h"
@@ -13,6 +14,11 @@ namespace facebook::fboss {
 // object to/from JSON using Thrift serializers. For this to work
 // one must supply Thrift type (ThrifT) that stores FieldsT state.
 //
+// Conversion to/from folly::dynamic goes directly through the Thrift
+// reflection metadata (so ThriftT must be generated with the reflection
+// option) and produces the same layout as the SimpleJSON serializer, so
+// state written by either can be read by the other.
+//
 // TODO: in future, FieldsT and ThrifT should be one type
 //
 template <typename ThriftT, typename NodeT, typename FieldsT>
@@ -21,8 +27,14 @@ class ThriftyBaseT : public NodeBaseT<NodeT, FieldsT> {
   using NodeBaseT<NodeT, FieldsT>::NodeBaseT;
 
   static std::shared_ptr<NodeT> fromFollyDynamic(folly::dynamic const& dyn) {
-    auto const jsonStr = folly::toJson(dyn);
-    return fromJson(jsonStr);
+    ThriftT obj;
+    apache::thrift::from_dynamic(
+        obj,
+        dyn,
+        apache::thrift::dynamic_format::JSON_1,
+        apache::thrift::format_adherence::LENIENT);
+    auto fields = FieldsT::fromThrift(obj);
+    return std::make_shared<NodeT>(fields);
   }
 
   static std::shared_ptr<NodeT> fromJson(const folly::fbstring& jsonStr) {
@@ -42,7 +54,8 @@ class ThriftyBaseT : public NodeBaseT<NodeT, FieldsT> {
   }
 
   folly::dynamic toFollyDynamic() const override {
-    return folly::parseJson(this->str());
+    return apache::thrift::to_dynamic(
+        this->getFields()->toThrift(), apache::thrift::dynamic_format::JSON_1);
   }
 };
 
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/state/ForwardingInformationBase.h"
+#include "fboss/agent/state/Route.h"
+
+#include <folly/Benchmark.h>
+
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+// 200k routes in total, split the way our larger FIBs are
+constexpr int kNumV4Routes = 150000;
+constexpr int kNumV6Routes = 50000;
+constexpr int kNumLookups = 1000;
+
+template <typename AddressT>
+std::shared_ptr<Route<AddressT>> makeRoute(const AddressT& network, int mask) {
+  RouteFields<AddressT> fields(
+      RoutePrefix<AddressT>{network.mask(mask), static_cast<uint8_t>(mask)});
+  return std::make_shared<Route<AddressT>>(fields);
+}
+
+folly::IPAddressV4 randomV4(std::mt19937& gen) {
+  return folly::IPAddressV4::fromLongHBO(gen());
+}
+
+folly::IPAddressV6 randomV6(std::mt19937& gen) {
+  std::array<uint8_t, 16> bytes;
+  for (auto& byte : bytes) {
+    byte = gen();
+  }
+  // Keep all addresses in 2401:db00::/32 as in our fleet
+  bytes[0] = 0x24;
+  bytes[1] = 0x01;
+  bytes[2] = 0xdb;
+  bytes[3] = 0x00;
+  return folly::IPAddressV6::fromBinary(folly::range(bytes));
+}
+
+std::shared_ptr<ForwardingInformationBaseV4> makeFibV4(std::mt19937& gen) {
+  auto fib = std::make_shared<ForwardingInformationBaseV4>();
+  fib->addNode(makeRoute(folly::IPAddressV4("0.0.0.0"), 0));
+  while (fib->size() < kNumV4Routes) {
+    auto route = makeRoute(randomV4(gen), gen() % 4 ? 24 : 16 + gen() % 16);
+    if (!fib->exactMatch(route->prefix())) {
+      fib->addNode(route);
+    }
+  }
+  return fib;
+}
+
+std::shared_ptr<ForwardingInformationBaseV6> makeFibV6(std::mt19937& gen) {
+  auto fib = std::make_shared<ForwardingInformationBaseV6>();
+  fib->addNode(makeRoute(folly::IPAddressV6("::"), 0));
+  while (fib->size() < kNumV6Routes) {
+    auto route = makeRoute(randomV6(gen), gen() % 2 ? 64 : 48 + gen() % 80);
+    if (!fib->exactMatch(route->prefix())) {
+      fib->addNode(route);
+    }
+  }
+  return fib;
+}
+
+/*
+ * Look up random addresses in a FIB of the given size. With useIndex false,
+ * the routes are touched directly so that the FIB has to scan them, as it
+ * always did before the LPM index.
+ */
+template <typename AddressT, typename MakeFib, typename RandomAddress>
+void runLookups(
+    unsigned iters,
+    bool useIndex,
+    MakeFib makeFib,
+    RandomAddress randomAddress) {
+  folly::BenchmarkSuspender suspender;
+  std::mt19937 gen(0);
+  auto fib = makeFib(gen);
+  if (useIndex) {
+    fib->publish();
+  } else {
+    fib->writableNodes();
+  }
+  std::vector<AddressT> addresses;
+  for (int i = 0; i < kNumLookups; ++i) {
+    addresses.push_back(randomAddress(gen));
+  }
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(
+        fib->longestMatch(addresses[i % addresses.size()]));
+  }
+}
+
+} // namespace
+
+BENCHMARK(FibV4LongestMatchScan, iters) {
+  runLookups<folly::IPAddressV4>(iters, false, makeFibV4, randomV4);
+}
+
+BENCHMARK_RELATIVE(FibV4LongestMatchIndex, iters) {
+  runLookups<folly::IPAddressV4>(iters, true, makeFibV4, randomV4);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(FibV6LongestMatchScan, iters) {
+  runLookups<folly::IPAddressV6>(iters, false, makeFibV6, randomV6);
+}
+
+BENCHMARK_RELATIVE(FibV6LongestMatchIndex, iters) {
+  runLookups<folly::IPAddressV6>(iters, true, makeFibV6, randomV6);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
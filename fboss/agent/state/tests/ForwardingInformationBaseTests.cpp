@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include <array>
 #include <memory>
+#include <random>
 
 namespace {
 
@@ -276,4 +277,83 @@ TEST(ForwardingInformationBaseV6, IPv6DefaultPrefixComparesSmallest) {
   EXPECT_EQ(firstRouteObserved->prefix().mask, 0);
 }
 
+TEST_F(ForwardingInformationBaseV4Test, LPMAfterRemove) {
+  fib.removeNode(RoutePrefixV4{ip4_0, 4});
+  CHECK_LPM(fib.longestMatch(folly::IPAddressV4("0.0.0.0")), ip4_0, 1);
+
+  fib.removeNodeIf(RoutePrefixV4{ip4_160, 3});
+  CHECK_LPM(fib.longestMatch(folly::IPAddressV4("161.16.8.1")), ip4_128, 2);
+
+  fib.removeNode(RoutePrefixV4{ip4_128, 2});
+  EXPECT_EQ(nullptr, fib.longestMatch(folly::IPAddressV4("161.16.8.1")));
+}
+
+TEST_F(ForwardingInformationBaseV6Test, LPMAfterRemove) {
+  fib.removeNode(RoutePrefixV6{ip6_0, 4});
+  CHECK_LPM(fib.longestMatch(folly::IPAddressV6("::")), ip6_0, 1);
+
+  fib.removeNodeIf(RoutePrefixV6{ip6_160, 3});
+  CHECK_LPM(fib.longestMatch(folly::IPAddressV6("A110:801::")), ip6_128, 2);
+
+  fib.removeNode(RoutePrefixV6{ip6_128, 2});
+  EXPECT_EQ(nullptr, fib.longestMatch(folly::IPAddressV6("A110:801::")));
+}
+
+TEST(ForwardingInformationBaseV4, LPMIndexSharedWithClone) {
+  auto fib = std::make_shared<ForwardingInformationBaseV4>();
+  fib->addNode(createRouteFromPrefix(ip4_0, 1));
+  fib->addNode(createRouteFromPrefix(ip4_64, 3));
+  fib->publish();
+
+  auto clonedFib = fib->clone();
+  clonedFib->addNode(createRouteFromPrefix(ip4_72, 6));
+  clonedFib->removeNode(RoutePrefixV4{ip4_0, 1});
+  clonedFib->publish();
+
+  // Modifying the clone must leave the original FIB's index untouched
+  folly::IPAddressV4 address("72.0.0.1");
+  CHECK_LPM(fib->longestMatch(address), ip4_64, 3);
+  CHECK_LPM(clonedFib->longestMatch(address), ip4_72, 6);
+  CHECK_LPM(fib->longestMatch(folly::IPAddressV4("1.1.1.1")), ip4_0, 1);
+  EXPECT_EQ(nullptr, clonedFib->longestMatch(folly::IPAddressV4("1.1.1.1")));
+}
+
+TEST(ForwardingInformationBaseV6, LPMIndexMatchesScan) {
+  std::mt19937 gen(0);
+  auto randomAddress = [&gen]() {
+    std::array<uint8_t, 16> bytes;
+    for (auto& byte : bytes) {
+      // Keep addresses close together so that prefixes overlap
+      byte = gen() % 4;
+    }
+    return folly::IPAddressV6::fromBinary(folly::range(bytes));
+  };
+
+  ForwardingInformationBaseV6 fib;
+  for (int i = 0; i < 1000; ++i) {
+    uint8_t mask = gen() % 129;
+    auto prefix = RoutePrefixV6{randomAddress().mask(mask), mask};
+    if (!fib.exactMatch(prefix)) {
+      fib.addNode(createRouteFromPrefix(prefix));
+    }
+  }
+  auto published = fib.clone();
+  published->publish();
+  // Modifying the routes directly bypasses the index, so the unpublished FIB
+  // has to scan them
+  fib.writableNodes();
+
+  for (int i = 0; i < 1000; ++i) {
+    auto address = randomAddress();
+    auto expected = fib.longestMatch(address);
+    auto route = published->longestMatch(address);
+    if (expected) {
+      ASSERT_NE(nullptr, route);
+      EXPECT_EQ(expected->prefix(), route->prefix());
+    } else {
+      EXPECT_EQ(nullptr, route);
+    }
+  }
+}
+
 } // namespace facebook::fboss
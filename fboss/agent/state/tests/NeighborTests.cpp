@@ -11,9 +11,11 @@
 #include "fboss/agent/test/TestUtils.h"
 
 #include "fboss/agent/state/ArpEntry.h"
+#include "fboss/agent/state/ArpTable.h"
 #include "fboss/agent/state/NdpEntry.h"
 #include "fboss/agent/state/NeighborEntry.h"
 #include "fboss/agent/state/NeighborResponseTable.h"
+#include "fboss/agent/state/NodeMapDelta-defs.h"
 
 #include <gtest/gtest.h>
 
@@ -26,6 +28,22 @@ using folly::IPAddressV4;
 using folly::IPAddressV6;
 using folly::MacAddress;
 
+namespace {
+using ArpDeltaEntries =
+    std::vector<std::pair<std::shared_ptr<ArpEntry>, std::shared_ptr<ArpEntry>>>;
+
+ArpDeltaEntries getDeltaEntries(
+    const std::shared_ptr<ArpTable>& oldTable,
+    const std::shared_ptr<ArpTable>& newTable) {
+  ArpDeltaEntries entries;
+  for (const auto& delta :
+       NodeMapDelta<ArpTable>(oldTable.get(), newTable.get())) {
+    entries.emplace_back(delta.getOld(), delta.getNew());
+  }
+  return entries;
+}
+} // namespace
+
 template <typename NeighborEntryT>
 void serializeTest(const NeighborEntryT& entry) {
   auto serialized = entry.toFollyDynamic();
@@ -61,3 +79,50 @@ TEST(NeighborResponseEntry, serialize) {
 
   EXPECT_TRUE(*entry == entryBack);
 }
+
+TEST(ArpTable, deltaVisitsOnlyChangedEntries) {
+  auto port = PortDescriptor(PortID(1));
+  auto intf = InterfaceID(1);
+  auto mac = MacAddress("01:02:03:04:05:06");
+  auto table = std::make_shared<ArpTable>();
+  for (int i = 0; i < 100; ++i) {
+    table->addEntry(IPAddressV4::fromLongHBO(0x0a000000 + i), mac, port, intf);
+  }
+  table->publish();
+
+  auto updated = table->clone();
+  updated->updateEntry(
+      IPAddressV4("10.0.0.5"), MacAddress("01:02:03:04:05:07"), port, intf);
+  updated->removeEntry(IPAddressV4("10.0.0.7"));
+  updated->addEntry(IPAddressV4("10.0.1.1"), mac, port, intf);
+  // Entries which end up unchanged must not show up in the delta
+  updated->addEntry(IPAddressV4("10.0.1.2"), mac, port, intf);
+  updated->removeEntry(IPAddressV4("10.0.1.2"));
+  updated->updateEntry(
+      IPAddressV4("10.0.0.9"), table->getEntry(IPAddressV4("10.0.0.9")));
+  updated->publish();
+  ASSERT_NE(nullptr, updated->getChangedKeysSince(*table));
+
+  // Same contents, but modified behind NodeMapT's back so that the delta has
+  // to compare every entry.
+  auto untracked = updated->clone();
+  untracked->writableNodes();
+  untracked->publish();
+  EXPECT_EQ(nullptr, untracked->getChangedKeysSince(*table));
+
+  auto entries = getDeltaEntries(table, updated);
+  EXPECT_EQ(entries, getDeltaEntries(table, untracked));
+  ASSERT_EQ(3, entries.size());
+  EXPECT_EQ(IPAddressV4("10.0.0.5"), entries[0].second->getIP());
+  EXPECT_EQ(IPAddressV4("10.0.0.7"), entries[1].first->getIP());
+  EXPECT_EQ(nullptr, entries[1].second);
+  EXPECT_EQ(nullptr, entries[2].first);
+  EXPECT_EQ(IPAddressV4("10.0.1.1"), entries[2].second->getIP());
+
+  // The recorded changes are only valid relative to the map they were cloned
+  // from.
+  auto other = table->clone();
+  other->publish();
+  EXPECT_EQ(nullptr, updated->getChangedKeysSince(*other));
+  EXPECT_EQ(entries, getDeltaEntries(other, updated));
+}
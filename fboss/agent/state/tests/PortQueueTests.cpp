@@ -15,6 +15,7 @@
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/json.h>
 #include <gtest/gtest.h>
 
 using namespace facebook::fboss;
@@ -174,6 +175,34 @@ TEST(PortQueue, serialization) {
   }
 }
 
+TEST(PortQueue, simpleJsonCompatible) {
+  // generatePortQueue() as written by SimpleJSONSerializer, which warm boot
+  // state used to be converted through
+  std::string jsonStr =
+      R"({"id":5,"weight":5,"reserved":1000,"scalingFactor":"ONE",)"
+      R"("scheduling":"WEIGHTED_ROUND_ROBIN","streamType":"UNICAST",)"
+      R"("aqms":[{"detection":{"linear":)"
+      R"({"minimumLength":208,"maximumLength":416}},"behavior":0},)"
+      R"({"detection":{"linear":)"
+      R"({"minimumLength":624,"maximumLength":624}},"behavior":1}],)"
+      R"("name":"queue0","sharedBytes":10000,)"
+      R"("portQueueRate":{"pktsPerSec":{"minimum":0,"maximum":200}}})";
+  auto pqObject = generatePortQueue();
+  EXPECT_EQ(*pqObject, *PortQueue::fromFollyDynamic(folly::parseJson(jsonStr)));
+  EXPECT_EQ(folly::parseJson(jsonStr), pqObject->toFollyDynamic());
+  EXPECT_EQ(jsonStr, pqObject->str());
+
+  // Same layout as the old serializer for every kind of queue
+  std::vector<PortQueue*> queues = {generatePortQueue(),
+                                    generateProdPortQueue(),
+                                    generateProdCPUPortQueue(),
+                                    generateDefaultPortQueue()};
+  for (const auto* queue : queues) {
+    EXPECT_EQ(folly::parseJson(queue->str()), queue->toFollyDynamic());
+    EXPECT_EQ(*queue, *PortQueue::fromJson(queue->str()));
+  }
+}
+
 TEST(PortQueue, stateDelta) {
   auto platform = createMockPlatform();
   auto stateV0 = applyInitConfig();
@@ -263,6 +263,49 @@ TEST(Port, ToFromJSON) {
   EXPECT_EQ(dyn1, dyn2);
 }
 
+TEST(Port, SimpleJsonCompatible) {
+  // Written by SimpleJSONSerializer, which warm boot state used to be
+  // converted through
+  std::string jsonStr =
+      R"({"portId":100,"portName":"eth1/1/1","portDescription":"TEST",)"
+      R"("portState":"ENABLED","portOperState":true,"ingressVlan":2000,)"
+      R"("portSpeed":"XG","portMaxSpeed":"XG","portFEC":"OFF",)"
+      R"("rxPause":true,"txPause":false,)"
+      R"("vlanMemberShips":{"2000":{"tagged":true}},)"
+      R"("sFlowIngressRate":100,"sFlowEgressRate":200,)"
+      R"("queues":[{"id":0,"weight":1,"reserved":3328,)"
+      R"("scalingFactor":"ONE","scheduling":"WEIGHTED_ROUND_ROBIN",)"
+      R"("streamType":"UNICAST","aqms":[{"detection":{"linear":)"
+      R"({"minimumLength":208,"maximumLength":416}},"behavior":0}],)"
+      R"("portQueueRate":{"pktsPerSec":{"minimum":0,"maximum":200}}}],)"
+      R"("portLoopbackMode":"NONE","ingressMirror":"mirror0",)"
+      R"("qosPolicy":"qp","sampleDest":"CPU",)"
+      R"("portProfileID":"PROFILE_10G_1_NRZ_NOFEC",)"
+      R"("lookupClassesToDistrubuteTrafficOn":[10,11],"maxFrameSize":9412})";
+  auto port = Port::fromFollyDynamic(folly::parseJson(jsonStr));
+
+  EXPECT_EQ(PortID{100}, port->getID());
+  EXPECT_EQ(cfg::PortState::ENABLED, port->getAdminState());
+  EXPECT_EQ(VlanID(2000), port->getIngressVlan());
+  EXPECT_TRUE(port->getVlans().at(VlanID(2000)).tagged);
+  EXPECT_EQ("mirror0", port->getIngressMirror().value());
+  EXPECT_FALSE(port->getEgressMirror().has_value());
+  EXPECT_EQ(
+      cfg::SampleDestination::CPU, port->getSampleDestination().value());
+  EXPECT_EQ(9412, port->getMaxFrameSize());
+  auto queues = port->getPortQueues();
+  ASSERT_EQ(1, queues.size());
+  EXPECT_EQ(3328, queues[0]->getReservedBytes().value());
+  EXPECT_EQ(1, queues[0]->getAqms().size());
+  EXPECT_TRUE(queues[0]->getPortQueueRate().has_value());
+
+  // Same layout as the old serializer, in both directions
+  auto oldPort = Port::fromJson(jsonStr);
+  EXPECT_EQ(folly::parseJson(jsonStr), port->toFollyDynamic());
+  EXPECT_EQ(folly::parseJson(oldPort->str()), port->toFollyDynamic());
+  EXPECT_EQ(jsonStr, port->str());
+}
+
 TEST(Port, ToFromJSONMissingMaxFrameSize) {
   std::string jsonStr = R"(
         {
@@ -3140,3 +3140,25 @@ TEST_F(UcmpTest, Twenty) {
 TEST_F(UcmpTest, Ten) {
   runVaryFromHundredTest(10, {10, 10, 10, 1});
 }
+
+TEST(RouteNextHopEntry, InternsNextHopSets) {
+  RouteNextHopEntry entry1(makeNextHops({"1.1.1.10", "2.2.2.10"}), DISTANCE);
+  RouteNextHopEntry entry2(makeNextHops({"2.2.2.10", "1.1.1.10"}), DISTANCE);
+  RouteNextHopEntry entry3(makeNextHops({"1.1.1.10"}), DISTANCE);
+
+  // Entries with equal next hops share them
+  EXPECT_EQ(&entry1.getNextHopSet(), &entry2.getNextHopSet());
+  EXPECT_EQ(entry1, entry2);
+  EXPECT_FALSE(entry1 < entry2 || entry2 < entry1);
+  EXPECT_NE(&entry1.getNextHopSet(), &entry3.getNextHopSet());
+  EXPECT_FALSE(entry1 == entry3);
+  EXPECT_TRUE(entry3 < entry1 || entry1 < entry3);
+
+  auto deserialized =
+      RouteNextHopEntry::fromFollyDynamic(entry1.toFollyDynamic());
+  EXPECT_EQ(&entry1.getNextHopSet(), &deserialized.getNextHopSet());
+
+  entry2.reset();
+  EXPECT_TRUE(entry2.getNextHopSet().empty());
+  EXPECT_EQ(2, entry1.getNextHopSet().size());
+}
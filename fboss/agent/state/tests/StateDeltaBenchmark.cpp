@@ -0,0 +1,142 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/state/ArpTable.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+#include "fboss/agent/state/VlanMapDelta.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+const VlanID kVlan{1};
+const InterfaceID kIntf{1};
+constexpr int kNumPorts = 64;
+const folly::MacAddress kMac("02:00:00:00:00:01");
+const folly::MacAddress kUpdatedMac("02:00:00:00:00:02");
+
+folly::IPAddressV4 arpIp(int i) {
+  return folly::IPAddressV4::fromLongHBO(0x0a000000 + i);
+}
+
+PortDescriptor arpPort(int i) {
+  return PortDescriptor(PortID(i % kNumPorts + 1));
+}
+
+std::shared_ptr<SwitchState> makeState(int numArpEntries) {
+  auto state = std::make_shared<SwitchState>();
+  for (int i = 1; i <= kNumPorts; ++i) {
+    state->registerPort(PortID(i), folly::to<std::string>("port", i));
+  }
+  auto arpTable = std::make_shared<ArpTable>();
+  for (int i = 0; i < numArpEntries; ++i) {
+    arpTable->addEntry(arpIp(i), kMac, arpPort(i), kIntf);
+  }
+  auto vlan = std::make_shared<Vlan>(kVlan, "vlan1");
+  vlan->setArpTable(arpTable);
+  state->addVlan(vlan);
+  state->publish();
+  return state;
+}
+
+/*
+ * Resolve a single ARP entry to a new MAC. When trackChanges is false, the
+ * table is modified the same way, but its change log is discarded so that the
+ * delta has to compare both tables entry by entry.
+ */
+std::shared_ptr<SwitchState> updateOneArpEntry(
+    const std::shared_ptr<SwitchState>& oldState,
+    int numArpEntries,
+    bool trackChanges) {
+  auto newState = oldState;
+  auto arpTable = newState->getVlans()->getVlan(kVlan)->getArpTable()->modify(
+      kVlan, &newState);
+  auto entry = numArpEntries / 2;
+  arpTable->updateEntry(arpIp(entry), kUpdatedMac, arpPort(entry), kIntf);
+  if (!trackChanges) {
+    arpTable->writableNodes();
+  }
+  newState->publish();
+  return newState;
+}
+
+size_t walkDelta(const StateDelta& delta) {
+  size_t changes = 0;
+  for (const auto& portDelta : delta.getPortsDelta()) {
+    folly::doNotOptimizeAway(portDelta);
+    ++changes;
+  }
+  for (const auto& vlanDelta : delta.getVlansDelta()) {
+    for (const auto& arpDelta : vlanDelta.getArpDelta()) {
+      folly::doNotOptimizeAway(arpDelta);
+      ++changes;
+    }
+  }
+  return changes;
+}
+
+void runStateDeltaBenchmark(
+    unsigned iters,
+    int numArpEntries,
+    bool trackChanges) {
+  folly::BenchmarkSuspender suspender;
+  auto oldState = makeState(numArpEntries);
+  auto newState = updateOneArpEntry(oldState, numArpEntries, trackChanges);
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    StateDelta delta(oldState, newState);
+    auto changes = walkDelta(delta);
+    CHECK_EQ(changes, 1);
+  }
+}
+
+} // namespace
+
+BENCHMARK(StateDelta1ArpChange1kEntriesFullScan, iters) {
+  runStateDeltaBenchmark(iters, 1000, false);
+}
+
+BENCHMARK_RELATIVE(StateDelta1ArpChange1kEntriesTracked, iters) {
+  runStateDeltaBenchmark(iters, 1000, true);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(StateDelta1ArpChange10kEntriesFullScan, iters) {
+  runStateDeltaBenchmark(iters, 10000, false);
+}
+
+BENCHMARK_RELATIVE(StateDelta1ArpChange10kEntriesTracked, iters) {
+  runStateDeltaBenchmark(iters, 10000, true);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(StateDelta1ArpChange100kEntriesFullScan, iters) {
+  runStateDeltaBenchmark(iters, 100000, false);
+}
+
+BENCHMARK_RELATIVE(StateDelta1ArpChange100kEntriesTracked, iters) {
+  runStateDeltaBenchmark(iters, 100000, true);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
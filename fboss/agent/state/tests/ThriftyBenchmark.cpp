@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/PortMap.h"
+#include "fboss/agent/state/PortQueue.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/json.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr int kNumPorts = 512;
+constexpr int kNumQueuesPerPort = 8;
+constexpr int kNumVlansPerPort = 4;
+
+/*
+ * A SwitchState with as many ports as our largest platforms, each with a
+ * full set of queues and a few VLANs, so that the Thrifty nodes dominate.
+ */
+std::shared_ptr<SwitchState> makeState() {
+  auto state = std::make_shared<SwitchState>();
+  for (int i = 1; i <= kNumPorts; ++i) {
+    auto port =
+        std::make_shared<Port>(PortID(i), folly::to<std::string>("eth", i));
+    port->setDescription(folly::to<std::string>("port ", i));
+    port->setAdminState(cfg::PortState::ENABLED);
+    port->setOperState(true);
+    port->setSpeed(cfg::PortSpeed::HUNDREDG);
+    port->setIngressVlan(VlanID(1));
+    for (int v = 0; v < kNumVlansPerPort; ++v) {
+      port->addVlan(VlanID(i * kNumVlansPerPort + v), v != 0);
+    }
+    QueueConfig queues;
+    for (int q = 0; q < kNumQueuesPerPort; ++q) {
+      auto queue = std::make_shared<PortQueue>(static_cast<uint8_t>(q));
+      queue->setScheduling(cfg::QueueScheduling::WEIGHTED_ROUND_ROBIN);
+      queue->setStreamType(cfg::StreamType::UNICAST);
+      queue->setWeight(q + 1);
+      queue->setReservedBytes(3328);
+      queue->setName(folly::to<std::string>("queue", q));
+      queues.push_back(queue);
+    }
+    port->resetPortQueues(queues);
+    state->addPort(port);
+  }
+  state->publish();
+  return state;
+}
+
+void runToFollyDynamic(unsigned iters, bool viaJson) {
+  folly::BenchmarkSuspender suspender;
+  auto state = makeState();
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    for (const auto& port : *state->getPorts()) {
+      if (viaJson) {
+        folly::doNotOptimizeAway(folly::parseJson(port->str()));
+      } else {
+        folly::doNotOptimizeAway(port->toFollyDynamic());
+      }
+    }
+  }
+}
+
+void runFromFollyDynamic(unsigned iters, bool viaJson) {
+  folly::BenchmarkSuspender suspender;
+  std::vector<folly::dynamic> ports;
+  for (const auto& port : *makeState()->getPorts()) {
+    ports.push_back(port->toFollyDynamic());
+  }
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    for (const auto& port : ports) {
+      if (viaJson) {
+        folly::doNotOptimizeAway(Port::fromJson(folly::toJson(port)));
+      } else {
+        folly::doNotOptimizeAway(Port::fromFollyDynamic(port));
+      }
+    }
+  }
+}
+
+} // namespace
+
+BENCHMARK(PortsToFollyDynamicViaJson, iters) {
+  runToFollyDynamic(iters, true);
+}
+
+BENCHMARK_RELATIVE(PortsToFollyDynamic, iters) {
+  runToFollyDynamic(iters, false);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(PortsFromFollyDynamicViaJson, iters) {
+  runFromFollyDynamic(iters, true);
+}
+
+BENCHMARK_RELATIVE(PortsFromFollyDynamic, iters) {
+  runFromFollyDynamic(iters, false);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(SwitchStateRoundTrip, iters) {
+  folly::BenchmarkSuspender suspender;
+  auto state = makeState();
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(
+        SwitchState::fromFollyDynamic(state->toFollyDynamic()));
+  }
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
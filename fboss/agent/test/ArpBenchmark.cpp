@@ -11,6 +11,8 @@
 
 #include <folly/Benchmark.h>
 #include <folly/Memory.h>
+#include "fboss/agent/ArpCache.h"
+#include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/TunManager.h"
 #include "fboss/agent/hw/mock/MockRxPacket.h"
@@ -18,10 +20,16 @@
 #include "fboss/agent/hw/sim/SimSwitch.h"
 #include "fboss/agent/state/ArpResponseTable.h"
 #include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/PortDescriptor.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/Vlan.h"
 #include "fboss/agent/state/VlanMap.h"
 
+#include <time.h>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
 using namespace facebook::fboss;
 using folly::IPAddress;
 using folly::IPAddressV4;
@@ -30,6 +38,10 @@ using std::make_shared;
 using std::make_unique;
 using std::shared_ptr;
 using std::unique_ptr;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
 
 namespace {
 
@@ -38,6 +50,9 @@ unique_ptr<SwSwitch> sw;
 unique_ptr<MockRxPacket> arpRequest_10_0_0_1;
 unique_ptr<MockRxPacket> arpRequest_10_0_0_5;
 
+// Neighbors of the neighbor cache benchmarks, all in 10.64.0.0/14
+constexpr int kNumNeighbors = 100000;
+
 unique_ptr<SwSwitch> setupSwitch() {
   MacAddress localMac("02:00:01:00:00:01");
   auto sw = make_unique<SwSwitch>(make_unique<SimPlatform>(localMac, 10));
@@ -65,6 +80,7 @@ unique_ptr<SwSwitch> setupSwitch() {
     Interface::Addresses addrs1;
     addrs1.emplace(IPAddress("10.0.0.1"), 24);
     addrs1.emplace(IPAddress("192.168.0.1"), 24);
+    addrs1.emplace(IPAddress("10.64.0.1"), 14);
     intf1->setAddresses(addrs1);
     state->addIntf(intf1);
 
@@ -136,6 +152,89 @@ void init() {
   arpRequest_10_0_0_5->setSrcVlan(VlanID(1));
 }
 
+IPAddressV4 neighborIP(int i) {
+  return IPAddressV4::fromLongHBO((10u << 24) + (64u << 16) + 2 + i);
+}
+
+template <typename Fn>
+void runInNeighborThread(Fn fn) {
+  sw->getNeighborCacheEvb()->runInEventBaseThreadAndWait(std::move(fn));
+}
+
+void waitForStateUpdates() {
+  sw->updateStateBlocking(
+      "wait for neighbor updates",
+      [](const shared_ptr<SwitchState>&) -> shared_ptr<SwitchState> {
+        return nullptr;
+      });
+}
+
+// A cache for VLAN 1, separate from the one the NeighborUpdater maintains
+shared_ptr<ArpCache> createArpCache(seconds timeout) {
+  auto cache = make_shared<ArpCache>(
+      sw.get(), sw->getState().get(), VlanID(1), "Vlan1", InterfaceID(1));
+  cache->setTimeout(timeout);
+  cache->setStaleEntryInterval(timeout);
+  return cache;
+}
+
+// Entries must be destroyed on the neighbor thread, which runs their timers
+void destroyArpCache(shared_ptr<ArpCache> cache) {
+  runInNeighborThread([cache = std::move(cache)]() mutable { cache.reset(); });
+  waitForStateUpdates();
+}
+
+void addNeighbors(ArpCache* cache) {
+  runInNeighborThread([cache] {
+    for (int i = 0; i < kNumNeighbors; ++i) {
+      cache->receivedArpMine(
+          neighborIP(i),
+          MacAddress::fromHBO(0x020000000000 + i),
+          PortDescriptor(PortID(1)),
+          ARP_OP_REPLY);
+    }
+  });
+  // Entries schedule their first timeout from the neighbor thread's queue
+  runInNeighborThread([] {});
+}
+
+microseconds neighborThreadCpuTime() {
+  microseconds cpuTime;
+  runInNeighborThread([&cpuTime] {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    cpuTime = duration_cast<microseconds>(
+        seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+  });
+  return cpuTime;
+}
+
+/*
+ * CPU used by the neighbor cache thread to age kNumNeighbors entries. With a
+ * 1s timeout, entries go STALE after 0.5-1.5s and are then checked for hits
+ * about once a second, so nearly every entry's timer fires every second.
+ */
+void printNeighborAgingCpu() {
+  constexpr auto kAgingPeriod = seconds(10);
+
+  auto cache = createArpCache(seconds(1));
+  addNeighbors(cache.get());
+  waitForStateUpdates();
+
+  auto cpuBefore = neighborThreadCpuTime();
+  std::this_thread::sleep_for(kAgingPeriod);
+  auto cpuTime = neighborThreadCpuTime() - cpuBefore;
+
+  std::cout << kNumNeighbors << " neighbors aging for " << kAgingPeriod.count()
+            << "s: neighbor thread CPU "
+            << duration_cast<milliseconds>(cpuTime).count() << "ms ("
+            << 100.0 * cpuTime.count() /
+          duration_cast<microseconds>(kAgingPeriod).count()
+            << "%)" << std::endl;
+
+  destroyArpCache(std::move(cache));
+}
+
 } // unnamed namespace
 
 BENCHMARK(ArpRequest, numIters) {
@@ -176,6 +275,22 @@ BENCHMARK(ArpRequestNotMine, numIters) {
   }
 }
 
+// Creating kNumNeighbors REACHABLE entries, and scheduling their timeouts
+BENCHMARK(ArpCacheAddNeighbors, numIters) {
+  for (size_t n = 0; n < numIters; ++n) {
+    shared_ptr<ArpCache> cache;
+    BENCHMARK_SUSPEND {
+      cache = createArpCache(seconds(300));
+    }
+
+    addNeighbors(cache.get());
+
+    BENCHMARK_SUSPEND {
+      destroyArpCache(std::move(cache));
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
 
@@ -187,6 +302,7 @@ int main(int argc, char** argv) {
   // BENCHMARK_SUSPEND, but the packet handling code is cheap enough that even
   // the small overhead of BENCHMARK_SUSPEND negatively impacts the results.)
   init();
+  printNeighborAgingCpu();
 
   folly::runBenchmarks();
   return 0;
@@ -14,6 +14,7 @@
 #include "fboss/agent/AddressUtil.h"
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/NeighborCache.h"
 #include "fboss/agent/NeighborUpdater.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwitchStats.h"
@@ -37,10 +38,17 @@
 #include "fboss/agent/test/TestUtils.h"
 
 #include <boost/range/combine.hpp>
+#include <folly/synchronization/Baton.h>
 #include <gtest/gtest.h>
 #include <array>
+#include <chrono>
+#include <functional>
 #include <future>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace facebook::fboss;
 using facebook::network::toBinaryAddress;
@@ -263,6 +271,36 @@ void testSendArpRequest(
   counters.checkDelta(SwitchStats::kCounterPrefix + "arp.reply.rx.sum", 0);
 }
 
+/*
+ * An ARP cache for VLAN 1, separate from the one the NeighborUpdater
+ * maintains, which hands the probes it sends to onProbe instead.
+ */
+class ProbeRecordingArpCache : public NeighborCache<ArpTable> {
+ public:
+  ProbeRecordingArpCache(
+      SwSwitch* sw,
+      std::function<void(IPAddressV4)> onProbe)
+      : NeighborCache<ArpTable>(
+            sw,
+            VlanID(1),
+            "Vlan1",
+            InterfaceID(1),
+            std::chrono::seconds(300),
+            2 /* maxNeighborProbes */,
+            std::chrono::seconds(300)),
+        onProbe_(std::move(onProbe)) {}
+
+  using NeighborCache<ArpTable>::setEntry;
+  using NeighborCache<ArpTable>::setPendingEntry;
+
+ private:
+  void probeFor(IPAddressV4 ip) const override {
+    onProbe_(ip);
+  }
+
+  std::function<void(IPAddressV4)> onProbe_;
+};
+
 } // unnamed namespace
 
 TEST(ArpTest, BasicSendRequest) {
@@ -1137,6 +1175,80 @@ TEST(ArpTest, ArpExpiration) {
   EXPECT_TRUE(arpExpirations[0]->wait());
 }
 
+TEST(ArpTest, ProbeBatches) {
+  constexpr size_t kNumEntries = 150;
+  constexpr size_t kMaxProbesPerBatch = 100;
+  constexpr size_t kNumStopped = 10;
+  auto handle = createTestHandle(testStateA());
+  auto sw = handle->getSw();
+  auto evb = sw->getNeighborCacheEvb();
+
+  std::vector<IPAddressV4> ips;
+  for (size_t i = 0; i < kNumEntries; ++i) {
+    ips.push_back(IPAddressV4::fromLongHBO((10u << 24) + 100 + i));
+  }
+
+  std::mutex mutex;
+  std::set<IPAddressV4> probed;
+  std::set<IPAddressV4> stopped;
+  size_t firstBatch = 0;
+  folly::Baton<> done;
+  std::shared_ptr<ProbeRecordingArpCache> cache;
+  cache = std::make_shared<ProbeRecordingArpCache>(
+      sw, [&](IPAddressV4 ip) {
+        std::lock_guard<std::mutex> g(mutex);
+        probed.insert(ip);
+        if (probed.size() == kMaxProbesPerBatch) {
+          // Once the first batch is out, have some of the entries whose
+          // probes are still queued stop probing
+          evb->runInEventBaseThread([&]() {
+            std::lock_guard<std::mutex> g2(mutex);
+            firstBatch = probed.size();
+            for (const auto& entryIP : ips) {
+              if (!probed.count(entryIP) && stopped.size() < kNumStopped) {
+                stopped.insert(entryIP);
+                cache->setEntry(
+                    entryIP,
+                    MacAddress("02:10:20:30:40:22"),
+                    PortDescriptor(PortID(1)),
+                    NeighborEntryState::REACHABLE);
+              }
+            }
+          });
+        } else if (probed.size() == kNumEntries - kNumStopped) {
+          done.post();
+        }
+      });
+
+  // Entries are INCOMPLETE, and probe again a second after being created.
+  // Hold up the neighbor thread until they are all due, so that they all
+  // queue their probe at once.
+  evb->runInEventBaseThreadAndWait([&]() {
+    for (const auto& ip : ips) {
+      cache->setPendingEntry(ip);
+    }
+  });
+  evb->runInEventBaseThreadAndWait(
+      []() { std::this_thread::sleep_for(std::chrono::milliseconds(1500)); });
+  done.wait();
+  // Let the batch with the last probes finish
+  evb->runInEventBaseThreadAndWait([]() {});
+
+  {
+    std::lock_guard<std::mutex> g(mutex);
+    EXPECT_EQ(kMaxProbesPerBatch, firstBatch);
+    EXPECT_EQ(kNumStopped, stopped.size());
+    EXPECT_EQ(kNumEntries - kNumStopped, probed.size());
+    for (const auto& ip : stopped) {
+      EXPECT_EQ(0, probed.count(ip));
+    }
+  }
+
+  // Entries must be destroyed on the neighbor thread, which runs their timers
+  evb->runInEventBaseThreadAndWait([&]() { cache.reset(); });
+  waitForStateUpdates(sw);
+}
+
 TEST(ArpTest, PortFlapRecover) {
   auto handle = setupTestHandle(std::chrono::seconds(1));
   auto sw = handle->getSw();
@@ -13,6 +13,12 @@
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/hw/sim/SimPlatform.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/rib/ForwardingInformationBaseUpdater.h"
+#include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
+#include "fboss/agent/rib/RouteUpdater.h"
+#include "fboss/agent/state/ForwardingInformationBaseContainer.h"
+#include "fboss/agent/state/ForwardingInformationBaseMap.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/RouteScaleGenerators.h"
@@ -24,6 +30,122 @@
 
 using namespace facebook::fboss;
 
+namespace {
+
+const RouterID kVrf{0};
+const auto kClientId = ClientID(10);
+
+/*
+ * A 200k route v4 RIB and the SwitchState whose FIB was derived from it.
+ * Shared across the FIB update benchmarks since building it dominates
+ * their run time.
+ */
+class FibUpdateFixture {
+ public:
+  static constexpr auto kNumRoutes = 200000;
+
+  static FibUpdateFixture& get() {
+    static FibUpdateFixture fixture;
+    return fixture;
+  }
+
+  /*
+   * Point `numChanged` routes at alternating next-hops in the RIB and
+   * re-resolve them. Returns the prefixes the FIB updater needs to patch.
+   */
+  const rib::UpdatedPrefixes* changeRoutes(int numChanged) {
+    updater_ = std::make_unique<rib::RouteUpdater>(
+        &v4Routes_, &v6Routes_, &dependencies_);
+    generation_++;
+    for (int i = 0; i < numChanged; ++i) {
+      updater_->addRoute(
+          prefix(i),
+          24,
+          kClientId,
+          rib::RouteNextHopEntry(
+              rib::UnresolvedNextHop(
+                  folly::IPAddress(generation_ % 2 ? "1.1.1.11" : "1.1.1.10"),
+                  rib::ECMP_WEIGHT),
+              AdminDistance::EBGP));
+    }
+    updater_->updateDone();
+    return updater_->getUpdatedPrefixes();
+  }
+
+  std::shared_ptr<SwitchState> updateFib(
+      const rib::UpdatedPrefixes* updatedPrefixes) {
+    rib::ForwardingInformationBaseUpdater fibUpdater(
+        kVrf, v4Routes_, v6Routes_, updatedPrefixes);
+    return fibUpdater(state_);
+  }
+
+  void setState(std::shared_ptr<SwitchState> state) {
+    state->publish();
+    state_ = std::move(state);
+  }
+
+ private:
+  FibUpdateFixture() {
+    rib::RouteUpdater updater(&v4Routes_, &v6Routes_, &dependencies_);
+    updater.addInterfaceRoute(
+        folly::IPAddress("1.1.1.1"),
+        24,
+        folly::IPAddress("1.1.1.1"),
+        InterfaceID(1));
+    for (int i = 0; i < kNumRoutes; ++i) {
+      updater.addRoute(
+          prefix(i),
+          24,
+          kClientId,
+          rib::RouteNextHopEntry(
+              rib::UnresolvedNextHop(
+                  folly::IPAddress("1.1.1.10"), rib::ECMP_WEIGHT),
+              AdminDistance::EBGP));
+    }
+    updater.updateDone();
+
+    auto fibContainer =
+        std::make_shared<ForwardingInformationBaseContainer>(kVrf);
+    fibContainer->writableFields()->fibV4 =
+        std::make_shared<ForwardingInformationBaseV4>();
+    fibContainer->writableFields()->fibV6 =
+        std::make_shared<ForwardingInformationBaseV6>();
+    auto fibMap = std::make_shared<ForwardingInformationBaseMap>();
+    fibMap->addNode(fibContainer);
+    state_ = std::make_shared<SwitchState>();
+    state_->resetForwardingInformationBases(fibMap);
+    setState(updateFib(nullptr));
+  }
+
+  static folly::IPAddress prefix(int index) {
+    // 10.0.0.0/24, 10.0.1.0/24, ...
+    return folly::IPAddress::fromLongHBO(
+        (10u << 24) + (static_cast<uint32_t>(index) << 8));
+  }
+
+  rib::IPv4NetworkToRouteMap v4Routes_;
+  rib::IPv6NetworkToRouteMap v6Routes_;
+  rib::NextHopDependencyIndex dependencies_;
+  std::unique_ptr<rib::RouteUpdater> updater_;
+  std::shared_ptr<SwitchState> state_;
+  int generation_{0};
+};
+
+void runFibUpdateBenchmark(int numChanged, bool incremental) {
+  folly::BenchmarkSuspender suspender;
+
+  auto& fixture = FibUpdateFixture::get();
+  auto updatedPrefixes = fixture.changeRoutes(numChanged);
+
+  suspender.dismiss();
+  auto newState = fixture.updateFib(incremental ? updatedPrefixes : nullptr);
+  suspender.rehire();
+
+  fixture.setState(std::move(newState));
+}
+
+} // namespace
+
 template <typename Generator>
 static void runConversionBenchmark() {
   auto constexpr kEcmpWidth = 4;
@@ -79,6 +201,34 @@ BENCHMARK(RibConversionHgridUu) {
   runConversionBenchmark<utility::HgridUuRouteScaleGenerator>();
 }
 
+/*
+ * Cost of applying a RIB update touching N prefixes to a 200k route FIB,
+ * rebuilding the FIB from the whole RIB vs. patching only changed prefixes.
+ */
+BENCHMARK(FibRebuild1Prefix) {
+  runFibUpdateBenchmark(1, false);
+}
+
+BENCHMARK_RELATIVE(FibPatch1Prefix) {
+  runFibUpdateBenchmark(1, true);
+}
+
+BENCHMARK(FibRebuild100Prefixes) {
+  runFibUpdateBenchmark(100, false);
+}
+
+BENCHMARK_RELATIVE(FibPatch100Prefixes) {
+  runFibUpdateBenchmark(100, true);
+}
+
+BENCHMARK(FibRebuild10kPrefixes) {
+  runFibUpdateBenchmark(10000, false);
+}
+
+BENCHMARK_RELATIVE(FibPatch10kPrefixes) {
+  runFibUpdateBenchmark(10000, true);
+}
+
 int main(int argc, char** argv) {
   facebook::initFacebook(&argc, &argv);
   folly::runBenchmarks();
@@ -0,0 +1,243 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/ThriftHandler.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/Benchmark.h>
+#include <folly/FileUtil.h>
+#include <folly/IPAddress.h>
+#include <folly/String.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace facebook::fboss;
+using facebook::network::toBinaryAddress;
+
+/*
+ * Latency and peak memory of reading a 200k route table over the route table
+ * thrift APIs, all at once vs. in pages.
+ */
+
+namespace {
+
+constexpr int kNumV4Routes = 150000;
+constexpr int kNumV6Routes = 50000;
+constexpr int kPageSize = 1000;
+
+class RouteTableFixture {
+ public:
+  static RouteTableFixture& get() {
+    static RouteTableFixture fixture;
+    return fixture;
+  }
+
+  ThriftHandler& handler() {
+    return *handler_;
+  }
+
+ private:
+  RouteTableFixture() {
+    cfg::SwitchConfig config;
+    config.vlans_ref()->resize(1);
+    *config.vlans[0].id_ref() = 1;
+    config.interfaces_ref()->resize(1);
+    *config.interfaces[0].intfID_ref() = 1;
+    *config.interfaces[0].vlanID_ref() = 1;
+    *config.interfaces[0].routerID_ref() = 0;
+    config.interfaces_ref()[0].mac_ref() = "00:02:00:00:00:01";
+    config.interfaces_ref()[0].ipAddresses_ref()->resize(2);
+    config.interfaces[0].ipAddresses_ref()[0] = "10.0.0.1/24";
+    config.interfaces[0].ipAddresses_ref()[1] = "2401:db00:2110:3001::1/64";
+
+    handle_ = createTestHandle(&config);
+    auto sw = handle_->getSw();
+    sw->initialConfigApplied(std::chrono::steady_clock::now());
+    sw->fibSynced();
+    handler_ = std::make_unique<ThriftHandler>(sw);
+
+    // 4 way ECMP over next hops on the interface subnets
+    std::vector<folly::IPAddress> v4NextHops, v6NextHops;
+    for (int i = 10; i < 14; ++i) {
+      v4NextHops.emplace_back(folly::sformat("10.0.0.{}", i));
+      v6NextHops.emplace_back(folly::sformat("2401:db00:2110:3001::{}", i));
+    }
+    auto routes = std::make_unique<std::vector<UnicastRoute>>();
+    for (int i = 0; i < kNumV4Routes; ++i) {
+      // 11.0.0.0/24, 11.0.1.0/24, ...
+      routes->push_back(makeRoute(
+          folly::IPAddress::fromLongHBO((11u << 24) + (uint32_t(i) << 8)),
+          24,
+          v4NextHops));
+    }
+    for (int i = 0; i < kNumV6Routes; ++i) {
+      // 2401:db00:0:0::/64, 2401:db00:0:1::/64, ...
+      routes->push_back(makeRoute(
+          folly::IPAddress(
+              folly::sformat("2401:db00:{:x}:{:x}::", i >> 16, i & 0xffff)),
+          64,
+          v6NextHops));
+    }
+    handler_->addUnicastRoutes(10, std::move(routes));
+  }
+
+  static UnicastRoute makeRoute(
+      const folly::IPAddress& network,
+      uint8_t mask,
+      const std::vector<folly::IPAddress>& nextHops) {
+    UnicastRoute route;
+    route.dest.ip = toBinaryAddress(network);
+    route.dest.prefixLength = mask;
+    for (const auto& nextHop : nextHops) {
+      route.nextHopAddrs_ref()->push_back(toBinaryAddress(nextHop));
+    }
+    return route;
+  }
+
+  std::unique_ptr<HwTestHandle> handle_;
+  std::unique_ptr<ThriftHandler> handler_;
+};
+
+size_t getRouteTable() {
+  std::vector<UnicastRoute> routes;
+  RouteTableFixture::get().handler().getRouteTable(routes);
+  return routes.size();
+}
+
+size_t getRouteTableDetails() {
+  std::vector<RouteDetails> routes;
+  RouteTableFixture::get().handler().getRouteTableDetails(routes);
+  return routes.size();
+}
+
+template <typename Page, typename GetPage>
+size_t getAllPages(GetPage getPage) {
+  size_t numRoutes = 0;
+  RouteTablePageRequest request;
+  *request.maxRoutes_ref() = kPageSize;
+  while (true) {
+    Page page;
+    getPage(page, std::make_unique<RouteTablePageRequest>(request));
+    numRoutes += page.routes_ref()->size();
+    if (!page.nextCursor_ref().has_value()) {
+      return numRoutes;
+    }
+    request.cursor_ref() = page.nextCursor_ref().value();
+  }
+}
+
+size_t getRouteTablePages() {
+  return getAllPages<UnicastRoutePage>([](auto& page, auto request) {
+    RouteTableFixture::get().handler().getRouteTablePage(
+        page, std::move(request));
+  });
+}
+
+size_t getRouteTableDetailsPages() {
+  return getAllPages<RouteDetailsPage>([](auto& page, auto request) {
+    RouteTableFixture::get().handler().getRouteTableDetailsPage(
+        page, std::move(request));
+  });
+}
+
+void runBenchmark(unsigned iters, size_t (*getRoutes)()) {
+  folly::BenchmarkSuspender suspender;
+  RouteTableFixture::get();
+  suspender.dismiss();
+  for (unsigned i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(getRoutes());
+  }
+}
+
+// Peak RSS of the process since the last resetPeakRss(), in KB
+int64_t getPeakRssKb() {
+  std::string status;
+  folly::readFile("/proc/self/status", status);
+  std::vector<folly::StringPiece> lines;
+  folly::split('\n', status, lines);
+  for (auto line : lines) {
+    // VmHWM:\t  1234 kB
+    if (line.removePrefix("VmHWM:")) {
+      return std::stoll(line.str());
+    }
+  }
+  return -1;
+}
+
+void resetPeakRss() {
+  // Resets VmHWM to the current RSS
+  folly::writeFile(folly::StringPiece("5"), "/proc/self/clear_refs");
+}
+
+void printPeakRss() {
+  RouteTableFixture::get();
+  std::vector<std::pair<std::string, size_t (*)()>> calls = {
+      {"getRouteTable", getRouteTable},
+      {"getRouteTablePage", getRouteTablePages},
+      {"getRouteTableDetails", getRouteTableDetails},
+      {"getRouteTableDetailsPage", getRouteTableDetailsPages},
+  };
+  for (const auto& [name, getRoutes] : calls) {
+    resetPeakRss();
+    auto before = getPeakRssKb();
+    auto numRoutes = getRoutes();
+    std::cout << name << ": " << numRoutes << " routes, peak RSS +"
+              << getPeakRssKb() - before << " KB" << std::endl;
+  }
+}
+
+} // namespace
+
+BENCHMARK(GetRouteTable, iters) {
+  runBenchmark(iters, getRouteTable);
+}
+
+BENCHMARK_RELATIVE(GetRouteTablePages, iters) {
+  runBenchmark(iters, getRouteTablePages);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(GetRouteTableDetails, iters) {
+  runBenchmark(iters, getRouteTableDetails);
+}
+
+BENCHMARK_RELATIVE(GetRouteTableDetailsPages, iters) {
+  runBenchmark(iters, getRouteTableDetailsPages);
+}
+
+BENCHMARK_DRAW_LINE();
+
+// Time a thrift worker is blocked by a single call
+BENCHMARK(GetRouteTableSinglePage, iters) {
+  folly::BenchmarkSuspender suspender;
+  auto& handler = RouteTableFixture::get().handler();
+  suspender.dismiss();
+  for (unsigned i = 0; i < iters; ++i) {
+    UnicastRoutePage page;
+    auto request = std::make_unique<RouteTablePageRequest>();
+    *request->maxRoutes_ref() = kPageSize;
+    handler.getRouteTablePage(page, std::move(request));
+    folly::doNotOptimizeAway(page);
+  }
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  printPeakRss();
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
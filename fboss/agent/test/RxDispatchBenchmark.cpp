@@ -0,0 +1,242 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketDispatcher.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+
+#include <folly/Benchmark.h>
+#include <folly/MPMCQueue.h>
+#include <folly/synchronization/Baton.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+/*
+ * Latency of LACP packets trapped to the CPU while ARP is flooded at a rate
+ * the ARP handler can't keep up with, when packets are handled in arrival
+ * order on a single thread (as the HwSwitch RX callback does without a
+ * dispatcher), and when they go through an RxPacketDispatcher.
+ */
+
+namespace {
+
+constexpr auto kArpHandlingTime = microseconds(50);
+constexpr auto kArpInterval = microseconds(20);
+constexpr auto kLacpInterval = microseconds(1000);
+constexpr int kNumLacp = 200;
+constexpr int kQueueSize = 1024;
+
+std::unique_ptr<MockRxPacket> makeArp() {
+  auto pkt = MockRxPacket::fromHex(
+      "ff ff ff ff ff ff  02 00 02 01 02 03"
+      // ARP, htype: ethernet, ptype: IPv4, hlen: 6, plen: 4, request
+      "08 06  00 01  08 00  06  04  00 01"
+      "02 00 02 01 02 03  0a 00 00 0f  00 00 00 00 00 00  0a 00 00 01");
+  pkt->padToLength(68);
+  return pkt;
+}
+
+std::unique_ptr<MockRxPacket> makeLacp(int index) {
+  auto pkt = MockRxPacket::fromHex(
+      "01 80 c2 00 00 02  02 00 02 01 02 03  88 09  01 01");
+  pkt->padToLength(128);
+  pkt->setSrcPort(PortID(index + 1));
+  return pkt;
+}
+
+void spin(microseconds duration) {
+  auto end = steady_clock::now() + duration;
+  while (steady_clock::now() < end) {
+  }
+}
+
+/*
+ * Handles packets, spending kArpHandlingTime on ARP, and recording how long
+ * each LACP packet took from being received to being handled.
+ */
+class FloodHandler {
+ public:
+  FloodHandler() : sent_(kNumLacp), latencies_(kNumLacp) {}
+
+  void received(const RxPacket& pkt) {
+    if (isLacp(pkt)) {
+      sent_[lacpIndex(pkt)] = steady_clock::now();
+    }
+  }
+
+  void handle(std::unique_ptr<RxPacket> pkt) {
+    if (!isLacp(*pkt)) {
+      spin(kArpHandlingTime);
+      return;
+    }
+    auto index = lacpIndex(*pkt);
+    latencies_[index] =
+        duration_cast<microseconds>(steady_clock::now() - sent_[index]);
+    lacpDone();
+  }
+
+  void dropped(const RxPacket& pkt) {
+    if (isLacp(pkt)) {
+      latencies_[lacpIndex(pkt)] = microseconds::max();
+      lacpDone();
+    }
+  }
+
+  void wait() {
+    done_.wait();
+  }
+
+  void print(const std::string& name) {
+    std::vector<microseconds> handled;
+    std::copy_if(
+        latencies_.begin(),
+        latencies_.end(),
+        std::back_inserter(handled),
+        [](auto latency) { return latency != microseconds::max(); });
+    std::sort(handled.begin(), handled.end());
+    std::cout << name << ": " << kNumLacp - handled.size() << " LACP lost";
+    if (!handled.empty()) {
+      std::cout << ", latency p50 " << handled[handled.size() / 2].count()
+                << "us, p99 " << handled[handled.size() * 99 / 100].count()
+                << "us, max " << handled.back().count() << "us";
+    }
+    std::cout << std::endl;
+  }
+
+ private:
+  // LACP packets are numbered by their source port, ARP come from port 0
+  static bool isLacp(const RxPacket& pkt) {
+    return pkt.getSrcPort() != PortID(0);
+  }
+  static int lacpIndex(const RxPacket& pkt) {
+    return static_cast<int>(pkt.getSrcPort()) - 1;
+  }
+
+  void lacpDone() {
+    if (++numLacpDone_ == kNumLacp) {
+      done_.post();
+    }
+  }
+
+  std::vector<steady_clock::time_point> sent_;
+  std::vector<microseconds> latencies_;
+  std::atomic<int> numLacpDone_{0};
+  folly::Baton<> done_;
+};
+
+/*
+ * Deliver kNumLacp LACP packets, with ARP packets kArpInterval apart in
+ * between.
+ */
+template <typename Deliver>
+void flood(FloodHandler* handler, Deliver deliver) {
+  auto arp = makeArp();
+  auto next = steady_clock::now();
+  auto nextLacp = next + kLacpInterval;
+  int numLacp = 0;
+  while (numLacp < kNumLacp) {
+    spin(duration_cast<microseconds>(next - steady_clock::now()));
+    next += kArpInterval;
+    std::unique_ptr<RxPacket> pkt;
+    if (next >= nextLacp) {
+      pkt = makeLacp(numLacp++);
+      nextLacp += kLacpInterval;
+    } else {
+      pkt = arp->clone();
+    }
+    handler->received(*pkt);
+    deliver(std::move(pkt));
+  }
+  handler->wait();
+}
+
+void floodInOrder() {
+  FloodHandler handler;
+  folly::MPMCQueue<std::unique_ptr<RxPacket>> ring(kQueueSize);
+  std::thread rxThread([&] {
+    std::unique_ptr<RxPacket> pkt;
+    while (true) {
+      ring.blockingRead(pkt);
+      if (!pkt) {
+        return;
+      }
+      handler.handle(std::move(pkt));
+    }
+  });
+  flood(&handler, [&](std::unique_ptr<RxPacket> pkt) {
+    // Like a full RX ring, drop what doesn't fit
+    if (!ring.write(std::move(pkt))) {
+      handler.dropped(*pkt);
+    }
+  });
+  ring.blockingWrite(nullptr);
+  rxThread.join();
+  handler.print("In order");
+}
+
+void floodDispatched(int numThreads) {
+  FloodHandler handler;
+  RxPacketDispatcher dispatcher(
+      [&](std::unique_ptr<RxPacket> pkt) { handler.handle(std::move(pkt)); },
+      [&](RxPacketDispatcher::Queue /* queue */, const RxPacket& pkt) {
+        handler.dropped(pkt);
+      },
+      numThreads,
+      kQueueSize,
+      -1);
+  flood(&handler, [&](std::unique_ptr<RxPacket> pkt) {
+    dispatcher.dispatch(std::move(pkt));
+  });
+  dispatcher.stop();
+  handler.print(
+      "Dispatched to " + std::to_string(numThreads) + " thread(s), " +
+      std::to_string(dispatcher.getDrops(RxPacketDispatcher::Queue::NEIGHBOR)) +
+      " ARP drops");
+}
+
+} // namespace
+
+// Cost of handing off a packet to a worker that does nothing with it
+BENCHMARK(RxDispatch, numIters) {
+  std::unique_ptr<RxPacketDispatcher> dispatcher;
+  std::unique_ptr<MockRxPacket> arp;
+  BENCHMARK_SUSPEND {
+    dispatcher = std::make_unique<RxPacketDispatcher>(
+        [](std::unique_ptr<RxPacket> /* pkt */) {}, nullptr, 1, 1 << 16, -1);
+    arp = makeArp();
+  }
+  for (size_t n = 0; n < numIters; ++n) {
+    dispatcher->dispatch(arp->clone());
+  }
+  BENCHMARK_SUSPEND {
+    dispatcher.reset();
+  }
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  floodInOrder();
+  floodDispatched(1);
+  floodDispatched(2);
+
+  folly::runBenchmarks();
+  return 0;
+}
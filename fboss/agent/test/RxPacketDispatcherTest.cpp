@@ -0,0 +1,285 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketDispatcher.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+
+#include <folly/Format.h>
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <vector>
+
+using namespace facebook::fboss;
+using Queue = RxPacketDispatcher::Queue;
+
+namespace {
+
+constexpr int kNetworkControlCos = 9;
+
+// dst mac, src mac
+constexpr auto kMacs = "02 00 01 00 00 01  02 00 02 01 02 03";
+
+std::unique_ptr<MockRxPacket> makePacket(
+    const std::string& hex,
+    PortID port = PortID(1)) {
+  auto pkt = MockRxPacket::fromHex(std::string(kMacs) + hex);
+  pkt->padToLength(68);
+  pkt->setSrcPort(port);
+  return pkt;
+}
+
+std::unique_ptr<MockRxPacket> makeArp(PortID port = PortID(1)) {
+  return makePacket(
+      // ARP, htype: ethernet, ptype: IPv4, hlen: 6, plen: 4, request
+      "08 06  00 01  08 00  06  04  00 01"
+      "02 00 02 01 02 03  0a 00 00 0f  00 00 00 00 00 00  0a 00 00 01",
+      port);
+}
+
+std::unique_ptr<MockRxPacket> makeLacp(PortID port = PortID(1)) {
+  // Slow protocols, LACP subtype
+  return makePacket("88 09  01 01", port);
+}
+
+std::unique_ptr<MockRxPacket> makeIPv4(uint8_t proto, uint16_t dstPort) {
+  return makePacket(folly::sformat(
+      // 802.1q, VLAN 1
+      "81 00  00 01"
+      // IPv4, 20 byte header
+      "08 00  45 00 00 28  00 00 00 00  40 {:02x} 00 00"
+      "0a 00 00 0f  0a 00 00 01"
+      // L4 ports
+      "c0 00  {:02x} {:02x}",
+      proto,
+      dstPort >> 8,
+      dstPort & 0xff));
+}
+
+std::unique_ptr<MockRxPacket> makeIPv6(uint8_t proto, uint8_t firstL4Byte) {
+  return makePacket(folly::sformat(
+      "86 dd  60 00 00 00  00 08 {:02x} ff"
+      "fe 80 00 00 00 00 00 00  00 00 00 00 00 00 00 01"
+      "fe 80 00 00 00 00 00 00  00 00 00 00 00 00 00 02"
+      "{:02x} 00 02 23",
+      proto,
+      firstL4Byte));
+}
+
+class CosRxPacket : public MockRxPacket {
+ public:
+  CosRxPacket(std::unique_ptr<folly::IOBuf> buf, int cos)
+      : MockRxPacket(std::move(buf)), cos_(cos) {}
+
+  int cosQueue() const override {
+    return cos_;
+  }
+
+ private:
+  int cos_;
+};
+
+/*
+ * A dispatcher, one worker by default, which records the ports of the
+ * packets it handles, and blocks on the first one until released.
+ */
+class RxPacketDispatcherTest : public ::testing::Test {
+ public:
+  void createDispatcher(size_t queueSize, int numThreads = 1) {
+    dispatcher_ = std::make_unique<RxPacketDispatcher>(
+        [this](std::unique_ptr<RxPacket> pkt) {
+          if (!started_.ready()) {
+            started_.post();
+            release_.wait();
+          }
+          std::lock_guard<std::mutex> g(mutex_);
+          handled_.push_back(pkt->getSrcPort());
+          firstBytes_.push_back(pkt->buf()->data()[0]);
+          if (handled_.size() == expected_) {
+            done_.post();
+          }
+        },
+        [this](Queue queue, const RxPacket& /* pkt */) {
+          dropped_.push_back(queue);
+        },
+        numThreads,
+        queueSize,
+        kNetworkControlCos);
+  }
+
+  // Dispatch a first packet, and wait for the worker to block on it
+  void blockWorker() {
+    EXPECT_TRUE(dispatcher_->dispatch(makeArp(PortID(100))));
+    started_.wait();
+  }
+
+  void releaseAndWait(size_t expected) {
+    expected_ = expected;
+    release_.post();
+    done_.wait();
+  }
+
+  std::unique_ptr<RxPacketDispatcher> dispatcher_;
+  folly::Baton<> started_;
+  folly::Baton<> release_;
+  folly::Baton<> done_;
+  std::mutex mutex_;
+  std::vector<PortID> handled_;
+  std::vector<uint8_t> firstBytes_;
+  size_t expected_{0};
+  std::vector<Queue> dropped_;
+};
+
+} // namespace
+
+TEST_F(RxPacketDispatcherTest, classify) {
+  createDispatcher(16);
+  EXPECT_EQ(Queue::NEIGHBOR, dispatcher_->classify(*makeArp()));
+  EXPECT_EQ(Queue::NETWORK_CONTROL, dispatcher_->classify(*makeLacp()));
+  EXPECT_EQ(
+      Queue::NETWORK_CONTROL, dispatcher_->classify(*makePacket("88 cc")));
+  // BGP
+  EXPECT_EQ(Queue::NETWORK_CONTROL, dispatcher_->classify(*makeIPv4(6, 179)));
+  EXPECT_EQ(Queue::DEFAULT, dispatcher_->classify(*makeIPv4(6, 22)));
+  // DHCP and BFD
+  EXPECT_EQ(Queue::DHCP, dispatcher_->classify(*makeIPv4(17, 67)));
+  EXPECT_EQ(
+      Queue::NETWORK_CONTROL, dispatcher_->classify(*makeIPv4(17, 3784)));
+  // Neighbor solicitation, echo request, DHCPv6 server port
+  EXPECT_EQ(Queue::NEIGHBOR, dispatcher_->classify(*makeIPv6(58, 135)));
+  EXPECT_EQ(Queue::DEFAULT, dispatcher_->classify(*makeIPv6(58, 128)));
+  EXPECT_EQ(Queue::DHCP, dispatcher_->classify(*makeIPv6(17, 0)));
+  // Truncated
+  EXPECT_EQ(
+      Queue::DEFAULT,
+      dispatcher_->classify(*MockRxPacket::fromHex("02 00 01 00 00 01 08")));
+  // The network control CPU queue only decides for packets not recognized
+  // otherwise, it usually also gets ARP
+  auto arp = makeArp();
+  EXPECT_EQ(
+      Queue::NEIGHBOR,
+      dispatcher_->classify(CosRxPacket(arp->buf()->clone(), 9)));
+  EXPECT_EQ(
+      Queue::NEIGHBOR,
+      dispatcher_->classify(CosRxPacket(arp->buf()->clone(), 0)));
+  auto ssh = makeIPv4(6, 22);
+  EXPECT_EQ(
+      Queue::NETWORK_CONTROL,
+      dispatcher_->classify(CosRxPacket(ssh->buf()->clone(), 9)));
+  EXPECT_EQ(
+      Queue::DEFAULT,
+      dispatcher_->classify(CosRxPacket(ssh->buf()->clone(), 0)));
+}
+
+TEST_F(RxPacketDispatcherTest, networkControlFirst) {
+  createDispatcher(16);
+  blockWorker();
+  for (int i = 1; i <= 8; ++i) {
+    EXPECT_TRUE(dispatcher_->dispatch(makeArp(PortID(i))));
+  }
+  EXPECT_TRUE(dispatcher_->dispatch(makeLacp(PortID(9))));
+  releaseAndWait(10);
+
+  ASSERT_EQ(10, handled_.size());
+  EXPECT_EQ(PortID(100), handled_[0]);
+  // LACP jumped the ARP backlog, which stayed in order
+  EXPECT_EQ(PortID(9), handled_[1]);
+  for (int i = 1; i <= 8; ++i) {
+    EXPECT_EQ(PortID(i), handled_[i + 1]);
+  }
+}
+
+TEST_F(RxPacketDispatcherTest, dropWhenFull) {
+  createDispatcher(4);
+  blockWorker();
+  for (int i = 1; i <= 4; ++i) {
+    EXPECT_TRUE(dispatcher_->dispatch(makeArp(PortID(i))));
+  }
+  EXPECT_FALSE(dispatcher_->dispatch(makeArp(PortID(5))));
+  EXPECT_FALSE(dispatcher_->dispatch(makeArp(PortID(6))));
+  // A full neighbor queue does not hold up LACP
+  EXPECT_TRUE(dispatcher_->dispatch(makeLacp(PortID(7))));
+  releaseAndWait(6);
+
+  EXPECT_EQ(2, dispatcher_->getDrops(Queue::NEIGHBOR));
+  EXPECT_EQ(0, dispatcher_->getDrops(Queue::NETWORK_CONTROL));
+  EXPECT_EQ(
+      (std::vector<Queue>{Queue::NEIGHBOR, Queue::NEIGHBOR}), dropped_);
+  EXPECT_EQ(PortID(7), handled_[1]);
+}
+
+TEST_F(RxPacketDispatcherTest, arpOnNetworkControlCos) {
+  createDispatcher(4);
+  blockWorker();
+  // An ARP flood the hardware put on the network control CPU queue
+  for (int i = 1; i <= 6; ++i) {
+    auto pkt = std::make_unique<CosRxPacket>(
+        makeArp()->buf()->clone(), kNetworkControlCos);
+    pkt->setSrcPort(PortID(i));
+    EXPECT_EQ(i <= 4, dispatcher_->dispatch(std::move(pkt)));
+  }
+  EXPECT_TRUE(dispatcher_->dispatch(makeLacp(PortID(7))));
+  releaseAndWait(6);
+
+  // ARP is dropped from its own queue and does not hold up LACP
+  EXPECT_EQ(2, dispatcher_->getDrops(Queue::NEIGHBOR));
+  EXPECT_EQ(0, dispatcher_->getDrops(Queue::NETWORK_CONTROL));
+  ASSERT_EQ(6, handled_.size());
+  EXPECT_EQ(PortID(7), handled_[1]);
+  for (int i = 1; i <= 4; ++i) {
+    EXPECT_EQ(PortID(i), handled_[i + 1]);
+  }
+}
+
+TEST_F(RxPacketDispatcherTest, stop) {
+  createDispatcher(16);
+  blockWorker();
+  EXPECT_TRUE(dispatcher_->dispatch(makeArp(PortID(1))));
+  release_.post();
+  dispatcher_->stop();
+  // Nothing is queued after stopping
+  EXPECT_FALSE(dispatcher_->dispatch(makeArp(PortID(2))));
+  EXPECT_EQ(1, dispatcher_->getDrops(Queue::NEIGHBOR));
+  dispatcher_->stop();
+}
+
+TEST_F(RxPacketDispatcherTest, queueHandledInOrder) {
+  // More workers than queues: packets of a queue still go to a single
+  // worker, and are handled in order
+  createDispatcher(64, 8);
+  blockWorker();
+  for (int i = 1; i <= 32; ++i) {
+    EXPECT_TRUE(dispatcher_->dispatch(makeArp(PortID(i))));
+  }
+  releaseAndWait(33);
+
+  ASSERT_EQ(33, handled_.size());
+  for (int i = 0; i <= 32; ++i) {
+    EXPECT_EQ(PortID(i ? i : 100), handled_[i]);
+  }
+}
+
+TEST_F(RxPacketDispatcherTest, copiesUnmanagedBuffer) {
+  createDispatcher(16);
+  blockWorker();
+  // Like a SAI packet, still in a buffer that is only valid until dispatched
+  auto arp = makeArp(PortID(1));
+  auto data = arp->buf()->coalesce();
+  std::vector<uint8_t> sdkBuffer(data.begin(), data.end());
+  auto pkt = std::make_unique<MockRxPacket>(
+      folly::IOBuf::wrapBuffer(sdkBuffer.data(), sdkBuffer.size()));
+  pkt->setSrcPort(PortID(1));
+  EXPECT_TRUE(dispatcher_->dispatch(std::move(pkt)));
+  sdkBuffer[0] = 0xff;
+  releaseAndWait(2);
+
+  ASSERT_EQ(2, firstBytes_.size());
+  EXPECT_EQ(0x02, firstBytes_[1]);
+}
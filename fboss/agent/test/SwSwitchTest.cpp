@@ -24,11 +24,16 @@
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/Conv.h>
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 #include <folly/MacAddress.h>
+#include <folly/synchronization/Baton.h>
+#include <gflags/gflags.h>
 
 #include <algorithm>
+#include <string>
+#include <vector>
 
 using namespace facebook::fboss;
 using folly::IPAddressV4;
@@ -38,6 +43,9 @@ using std::string;
 using ::testing::_;
 using ::testing::Return;
 
+DECLARE_int32(max_coalesced_state_updates);
+DECLARE_int32(max_coalesced_state_update_ms);
+
 class SwSwitchTest : public ::testing::Test {
  public:
   void SetUp() override {
@@ -58,6 +66,43 @@ class SwSwitchTest : public ::testing::Test {
   std::unique_ptr<HwTestHandle> handle{nullptr};
 };
 
+class SwSwitchUpdateQueueTest : public SwSwitchTest {
+ public:
+  // Hold up the update thread until unblockUpdates(), so that the updates
+  // queued meanwhile are handled together
+  void blockUpdates() {
+    folly::Baton<> started;
+    sw->updateState(
+        "Block updates", [this, &started](const std::shared_ptr<SwitchState>&) {
+          started.post();
+          unblock_.wait();
+          return std::shared_ptr<SwitchState>();
+        });
+    started.wait();
+  }
+
+  void unblockUpdates() {
+    unblock_.post();
+  }
+
+  // An update that records its name when applied, without changing the state
+  void queueUpdate(const std::string& name, StateUpdate::Priority priority) {
+    sw->updateState(
+        name,
+        [this, name](const std::shared_ptr<SwitchState>&) {
+          applied_.push_back(name);
+          return std::shared_ptr<SwitchState>();
+        },
+        priority);
+  }
+
+  // Only read once waitForStateUpdates() returned
+  std::vector<std::string> applied_;
+
+ private:
+  folly::Baton<> unblock_;
+};
+
 TEST_F(SwSwitchTest, GetPortStats) {
   // get port5 portStats for the first time
   EXPECT_EQ(sw->stats()->getPortStats()->size(), 0);
@@ -216,3 +261,58 @@ TEST_F(SwSwitchTest, VerifyIsValidStateUpdate) {
 
   EXPECT_FALSE(sw->isValidStateUpdate(StateDelta(stateV0, stateV2)));
 }
+
+TEST_F(SwSwitchUpdateQueueTest, HigherPriorityUpdatesFirst) {
+  blockUpdates();
+  queueUpdate("bulk0", StateUpdate::Priority::BULK);
+  queueUpdate("normal0", StateUpdate::Priority::NORMAL);
+  queueUpdate("high0", StateUpdate::Priority::HIGH);
+  queueUpdate("bulk1", StateUpdate::Priority::BULK);
+  queueUpdate("high1", StateUpdate::Priority::HIGH);
+  unblockUpdates();
+  waitForStateUpdates(sw);
+
+  std::vector<std::string> expected{
+      "high0", "high1", "normal0", "bulk0", "bulk1"};
+  EXPECT_EQ(expected, applied_);
+}
+
+TEST_F(SwSwitchUpdateQueueTest, DeferredUpdatesAreApplied) {
+  gflags::FlagSaver flagSaver;
+  // Every batch stops after its first update, leaving the rest to be
+  // requeued for later batches
+  FLAGS_max_coalesced_state_update_ms = 0;
+  blockUpdates();
+  std::vector<std::string> expected;
+  for (int i = 0; i < 10; ++i) {
+    expected.push_back(folly::to<std::string>("update", i));
+    queueUpdate(expected.back(), StateUpdate::Priority::NORMAL);
+  }
+  queueUpdate("high", StateUpdate::Priority::HIGH);
+  expected.insert(expected.begin(), "high");
+  unblockUpdates();
+  waitForStateUpdates(sw);
+
+  EXPECT_EQ(expected, applied_);
+}
+
+TEST_F(SwSwitchUpdateQueueTest, HwSyncUpdateDoesNotStrandUpdates) {
+  gflags::FlagSaver flagSaver;
+  auto origState = sw->getAppliedState();
+  auto newState = bringAllPortsUp(sw->getAppliedState()->clone());
+  // Have HwSwitch reject an update, which queues an update to get back in
+  // sync without scheduling it
+  EXPECT_HW_CALL(sw, stateChanged(_)).WillRepeatedly(Return(origState));
+  sw->updateState(
+      "Reject update",
+      [=](const std::shared_ptr<SwitchState>& /*state*/) { return newState; });
+  waitForStateUpdates(sw);
+  EXPECT_NE(sw->getAppliedState(), sw->getDesiredState());
+
+  // One update per batch: the sync update takes the batch of the next
+  // update, which must still be applied
+  FLAGS_max_coalesced_state_updates = 1;
+  EXPECT_HW_CALL(sw, stateChanged(_)).WillRepeatedly(Return(newState));
+  waitForStateUpdates(sw);
+  EXPECT_EQ(sw->getAppliedState(), sw->getDesiredState());
+}
@@ -332,3 +332,149 @@ TEST(ThriftTest, syncFib) {
   EXPECT_EQ(4 + 1, tables3->getRouteTable(rid)->getRibV4()->size());
   EXPECT_EQ(4 + 1, tables3->getRouteTable(rid)->getRibV6()->size());
 }
+
+namespace {
+
+std::unique_ptr<HwTestHandle> setupRouteTableTestHandle() {
+  cfg::SwitchConfig config;
+  config.vlans_ref()->resize(1);
+  *config.vlans[0].id_ref() = 1;
+  config.interfaces_ref()->resize(1);
+  *config.interfaces[0].intfID_ref() = 1;
+  *config.interfaces[0].vlanID_ref() = 1;
+  *config.interfaces[0].routerID_ref() = 0;
+  config.interfaces_ref()[0].mac_ref() = "00:02:00:00:00:01";
+  config.interfaces_ref()[0].ipAddresses_ref()->resize(2);
+  config.interfaces[0].ipAddresses_ref()[0] = "10.0.0.1/24";
+  config.interfaces[0].ipAddresses_ref()[1] = "2401:db00:2110:3001::0001/64";
+
+  auto handle = createTestHandle(&config);
+  auto sw = handle->getSw();
+  sw->initialConfigApplied(std::chrono::steady_clock::now());
+  sw->fibSynced();
+  return handle;
+}
+
+/*
+ * Fetch pages until the whole route table was returned, and concatenate
+ * them.
+ */
+template <typename Page>
+auto getAllPages(
+    const RouteTablePageRequest& firstRequest,
+    std::function<void(Page&, std::unique_ptr<RouteTablePageRequest>)>
+        getPage) {
+  std::decay_t<decltype(*Page().routes_ref())> routes;
+  auto request = std::make_unique<RouteTablePageRequest>(firstRequest);
+  while (true) {
+    Page page;
+    getPage(page, std::make_unique<RouteTablePageRequest>(*request));
+    EXPECT_LE(
+        page.routes_ref()->size(),
+        static_cast<size_t>(*request->maxRoutes_ref()));
+    routes.insert(
+        routes.end(), page.routes_ref()->begin(), page.routes_ref()->end());
+    if (!page.nextCursor_ref().has_value()) {
+      break;
+    }
+    request->cursor_ref() = page.nextCursor_ref().value();
+  }
+  return routes;
+}
+
+} // unnamed namespace
+
+TEST(ThriftTest, getRouteTablePages) {
+  auto handle = setupRouteTableTestHandle();
+  ThriftHandler handler(handle->getSw());
+
+  for (int i = 0; i < 10; ++i) {
+    handler.addUnicastRoute(
+        10,
+        makeUnicastRoute(folly::sformat("7.{}.0.0/16", i), "10.0.0.22"));
+    handler.addUnicastRoute(
+        20,
+        makeUnicastRoute(
+            folly::sformat("aaaa:{}::0/64", i), "2401:db00:2110:3001::22"));
+  }
+
+  std::vector<UnicastRoute> routeTable;
+  handler.getRouteTable(routeTable);
+  std::vector<RouteDetails> routeTableDetails;
+  handler.getRouteTableDetails(routeTableDetails);
+
+  for (auto maxRoutes : {1, 3, 1000}) {
+    RouteTablePageRequest request;
+    *request.maxRoutes_ref() = maxRoutes;
+    EXPECT_EQ(
+        routeTable,
+        getAllPages<UnicastRoutePage>(request, [&](auto& page, auto req) {
+          handler.getRouteTablePage(page, std::move(req));
+        }));
+    EXPECT_EQ(
+        routeTableDetails,
+        getAllPages<RouteDetailsPage>(request, [&](auto& page, auto req) {
+          handler.getRouteTableDetailsPage(page, std::move(req));
+        }));
+  }
+
+  std::vector<UnicastRoute> clientRoutes;
+  handler.getRouteTableByClient(clientRoutes, 20);
+  RouteTablePageRequest clientRequest;
+  *clientRequest.maxRoutes_ref() = 4;
+  clientRequest.filter_ref()->clientId_ref() = 20;
+  EXPECT_EQ(
+      clientRoutes,
+      getAllPages<UnicastRoutePage>(clientRequest, [&](auto& page, auto req) {
+        handler.getRouteTablePage(page, std::move(req));
+      }));
+}
+
+TEST(ThriftTest, getRouteTablePageFilters) {
+  auto handle = setupRouteTableTestHandle();
+  ThriftHandler handler(handle->getSw());
+
+  handler.addUnicastRoute(10, makeUnicastRoute("7.1.0.0/16", "10.0.0.22"));
+  handler.addUnicastRoute(10, makeUnicastRoute("7.1.1.0/24", "10.0.0.22"));
+  handler.addUnicastRoute(20, makeUnicastRoute("7.2.0.0/16", "10.0.0.33"));
+  handler.addUnicastRoute(
+      20, makeUnicastRoute("aaaa:1::0/64", "2401:db00:2110:3001::22"));
+
+  auto getPrefixes = [&](const RouteTableFilter& filter) {
+    UnicastRoutePage page;
+    auto request = std::make_unique<RouteTablePageRequest>();
+    *request->filter_ref() = filter;
+    handler.getRouteTablePage(page, std::move(request));
+    EXPECT_FALSE(page.nextCursor_ref().has_value());
+    std::vector<IpPrefix> prefixes;
+    for (const auto& route : *page.routes_ref()) {
+      prefixes.push_back(route.dest);
+    }
+    return prefixes;
+  };
+
+  RouteTableFilter prefixFilter;
+  prefixFilter.prefix_ref() = ipPrefix("7.1.0.0", 16);
+  EXPECT_THAT(
+      getPrefixes(prefixFilter),
+      UnorderedElementsAreArray(
+          {ipPrefix("7.1.0.0", 16), ipPrefix("7.1.1.0", 24)}));
+
+  RouteTableFilter clientFilter;
+  clientFilter.clientId_ref() = 20;
+  EXPECT_THAT(
+      getPrefixes(clientFilter),
+      UnorderedElementsAreArray(
+          {ipPrefix("7.2.0.0", 16), ipPrefix("aaaa:1::", 64)}));
+
+  RouteTableFilter nextHopFilter;
+  nextHopFilter.nextHop_ref() = toBinaryAddress(IPAddress("10.0.0.22"));
+  EXPECT_THAT(
+      getPrefixes(nextHopFilter),
+      UnorderedElementsAreArray(
+          {ipPrefix("7.1.0.0", 16), ipPrefix("7.1.1.0", 24)}));
+
+  RouteTableFilter badFilter;
+  badFilter.prefix_ref() = ipPrefix("7.1.0.0", 33);
+  EXPECT_THROW(getPrefixes(badFilter), FbossError);
+}
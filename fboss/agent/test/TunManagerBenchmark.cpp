@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/TunManager.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/InterfaceMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+/*
+ * Throughput of packets sent to the host through TunManager, from one and
+ * several threads, the way packets trapped to the CPU are sent from the rx
+ * threads. This creates real tun interfaces, routes and rules, so run it as
+ * root in a network namespace of its own, e.g.:
+ *
+ *   unshare --user --map-root-user --net ./tun_manager_benchmark
+ *
+ * Packets are to an address of the interface subnet that is not assigned, so
+ * the kernel drops them once read from the tun interface.
+ */
+
+namespace {
+
+std::unique_ptr<MockRxPacket> makeUdpPacket() {
+  auto pkt = MockRxPacket::fromHex(
+      // dst mac, src mac, ethertype
+      "00 02 00 00 00 01  02 00 02 01 02 03  08 00"
+      // IPv4, length 228, ttl 64, UDP, no checksum, 10.0.0.3 -> 10.0.0.2
+      "45 00 00 e4  00 00 00 00  40 11 00 00  0a 00 00 03  0a 00 00 02"
+      // UDP 10000 -> 10001, length 208, no checksum
+      "27 10 27 11  00 d0 00 00");
+  pkt->padToLength(14 + 228);
+  return pkt;
+}
+
+void sendToHost(unsigned iters, int numThreads) {
+  folly::BenchmarkSuspender suspender;
+  auto state = testStateA();
+  auto handle = createTestHandle(state);
+  auto sw = handle->getSw();
+
+  // Virtual interfaces are up regardless of their ports
+  auto intf = state->getInterfaces()->getInterface(InterfaceID(1));
+  intf->modify(&state)->setIsVirtual(true);
+
+  folly::ScopedEventBaseThread evbThread("TunManager");
+  auto tunMgr = std::make_unique<TunManager>(sw, evbThread.getEventBase());
+  evbThread.getEventBase()->runInEventBaseThreadAndWait(
+      [&]() { tunMgr->sync(state); });
+  auto pkt = makeUdpPacket();
+  suspender.dismiss();
+
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto n = i; n < iters; n += numThreads) {
+        tunMgr->sendPacketToHost(InterfaceID(1), pkt->clone());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  suspender.rehire();
+  evbThread.getEventBase()->runInEventBaseThreadAndWait(
+      [&]() { tunMgr.reset(); });
+}
+
+} // namespace
+
+BENCHMARK_PARAM(sendToHost, 1)
+BENCHMARK_PARAM(sendToHost, 4)
+BENCHMARK_PARAM(sendToHost, 16)
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace facebook::fboss {
+
+/*
+ * Interned is an immutable, reference counted handle to a hash consed value
+ * of type T: all handles to equal values share a single copy of the value,
+ * held in a process wide registry. Many objects holding the same value, e.g.
+ * routes pointing at the same ECMP group, then only cost a pointer each, and
+ * comparing two handles is a pointer comparison.
+ *
+ * A value is dropped from the registry once its last handle goes away.
+ * Interning hashes the value and looks it up under a lock, so handles are
+ * meant to be created once and copied from there on.
+ *
+ * operator< orders handles by address, which makes them cheap map keys, but
+ * it is neither the order of the values nor stable across runs.
+ */
+template <
+    typename T,
+    typename Hash = std::hash<T>,
+    typename Equal = std::equal_to<T>>
+class Interned {
+ public:
+  // Handle to a default constructed T
+  Interned() : value_(defaultValue()) {}
+  /* implicit */ Interned(T value) : value_(intern(std::move(value))) {}
+
+  const T& get() const {
+    return *value_;
+  }
+  const T& operator*() const {
+    return *value_;
+  }
+  const T* operator->() const {
+    return value_.get();
+  }
+
+  bool operator==(const Interned& other) const {
+    return value_ == other.value_;
+  }
+  bool operator!=(const Interned& other) const {
+    return value_ != other.value_;
+  }
+  bool operator<(const Interned& other) const {
+    return value_ < other.value_;
+  }
+
+  size_t hash() const {
+    return std::hash<const T*>()(value_.get());
+  }
+
+  // Number of distinct values currently interned
+  static size_t numInterned() {
+    auto& registry = getRegistry();
+    std::shared_lock<std::shared_mutex> lock(registry.mutex);
+    return registry.values.size();
+  }
+
+ private:
+  struct ValueHash {
+    size_t operator()(const T* value) const {
+      return Hash()(*value);
+    }
+  };
+  struct ValueEqual {
+    bool operator()(const T* lhs, const T* rhs) const {
+      return Equal()(*lhs, *rhs);
+    }
+  };
+  struct Registry {
+    std::shared_mutex mutex;
+    std::unordered_map<const T*, std::weak_ptr<const T>, ValueHash, ValueEqual>
+        values;
+  };
+
+  static Registry& getRegistry() {
+    // Leaked, as handles may outlive static destruction
+    static auto* registry = new Registry();
+    return *registry;
+  }
+
+  static const std::shared_ptr<const T>& defaultValue() {
+    static const auto* value = new std::shared_ptr<const T>(intern(T()));
+    return *value;
+  }
+
+  static std::shared_ptr<const T> intern(T value) {
+    auto& registry = getRegistry();
+    {
+      std::shared_lock<std::shared_mutex> lock(registry.mutex);
+      auto itr = registry.values.find(&value);
+      if (itr != registry.values.end()) {
+        if (auto interned = itr->second.lock()) {
+          return interned;
+        }
+      }
+    }
+    // Allocate outside of the lock, since dropping an unused candidate takes
+    // the lock again.
+    std::shared_ptr<const T> candidate(new T(std::move(value)), &release);
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+    auto itr = registry.values.find(candidate.get());
+    if (itr != registry.values.end()) {
+      if (auto interned = itr->second.lock()) {
+        lock.unlock();
+        return interned;
+      }
+      // The last handle to an equal value is being dropped, but hasn't
+      // removed it from the registry yet.
+      registry.values.erase(itr);
+    }
+    registry.values.emplace(candidate.get(), candidate);
+    return candidate;
+  }
+
+  static void release(const T* value) {
+    auto& registry = getRegistry();
+    {
+      std::unique_lock<std::shared_mutex> lock(registry.mutex);
+      auto itr = registry.values.find(value);
+      // An equal value may have been interned again in the meantime
+      if (itr != registry.values.end() && itr->first == value) {
+        registry.values.erase(itr);
+      }
+    }
+    delete value;
+  }
+
+  std::shared_ptr<const T> value_;
+};
+
+} // namespace facebook::fboss
+
+namespace std {
+template <typename T, typename Hash, typename Equal>
+struct hash<facebook::fboss::Interned<T, Hash, Equal>> {
+  size_t operator()(
+      const facebook::fboss::Interned<T, Hash, Equal>& interned) const {
+    return interned.hash();
+  }
+};
+} // namespace std
@@ -0,0 +1,608 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+namespace facebook::fboss {
+
+/*
+ * PersistentMap is an ordered map implemented as a copy-on-write B+tree whose
+ * nodes are shared between copies of the map.
+ *
+ * Copying a PersistentMap is O(1): only the root pointer is copied. Modifying
+ * a copy only clones the O(log n) nodes on the path from the root to the
+ * modified leaf, every other node stays shared with the original. Nodes that
+ * are not shared (e.g. while building a map from scratch) are modified in
+ * place, so bulk insertion doesn't pay for copying.
+ *
+ * Two maps derived from each other share all unchanged subtrees, which
+ * advancePastShared() uses to skip over identical ranges when walking two
+ * maps in lockstep, as NodeMapDelta does.
+ *
+ * The API is the subset of std::map/boost::container::flat_map needed by
+ * NodeMapT. Entries are immutable through iterators; use insert_or_assign()
+ * to replace a value. As with std::map, any modification invalidates
+ * iterators.
+ */
+template <typename K, typename V, typename Compare = std::less<K>>
+class PersistentMap {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+
+ private:
+  // Max number of entries in a leaf and of children in an internal node
+  static constexpr size_t kMaxLeafSize = 64;
+  static constexpr size_t kMaxFanout = 32;
+  // Leaves smaller than this are merged with a sibling after an erase
+  static constexpr size_t kMinLeafSize = kMaxLeafSize / 4;
+
+  struct Node;
+  using NodePtr = std::shared_ptr<const Node>;
+
+  struct Node {
+    bool isLeaf() const {
+      return children.empty();
+    }
+    size_t count() const {
+      return isLeaf() ? entries.size() : children.size();
+    }
+    const K& minKey() const {
+      return isLeaf() ? entries.front().first : minKeys.front();
+    }
+
+    // Leaf nodes
+    std::vector<value_type> entries;
+    // Internal nodes: minKeys[i] is the smallest key under children[i]
+    std::vector<K> minKeys;
+    std::vector<NodePtr> children;
+  };
+
+ public:
+  class const_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename PersistentMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() {}
+
+    reference operator*() const {
+      return path_.back().first->entries[path_.back().second];
+    }
+    pointer operator->() const {
+      return &(operator*());
+    }
+
+    const_iterator& operator++() {
+      advanceFrom(path_.size() - 1);
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+    const_iterator& operator--() {
+      retreat();
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator tmp(*this);
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      if (path_.empty() || other.path_.empty()) {
+        return path_.empty() && other.path_.empty();
+      }
+      return path_.back() == other.path_.back();
+    }
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+
+    /*
+     * Advance `a` and `b` past all entries which are identical in both,
+     * stopping at the first difference or when either reaches its end.
+     *
+     * Whenever `a` and `b` point at the same position of the same (shared)
+     * node, everything from there to the end of that node's subtree is
+     * identical in both maps and is skipped at once. When the maps are
+     * copies of each other, this takes time proportional to the number of
+     * differences times the height of the tree rather than to their size.
+     */
+    friend void advancePastShared(
+        const_iterator& a,
+        const const_iterator& aEnd,
+        const_iterator& b,
+        const const_iterator& bEnd) {
+      while (a != aEnd && b != bEnd) {
+        // Find the highest level, counting from the leaves, at which both
+        // iterators share the same node and position.
+        size_t shared = 0;
+        auto aLevel = a.path_.size();
+        auto bLevel = b.path_.size();
+        while (aLevel > 0 && bLevel > 0 &&
+               a.path_[aLevel - 1] == b.path_[bLevel - 1]) {
+          ++shared;
+          --aLevel;
+          --bLevel;
+        }
+        if (shared) {
+          a.skipSubtreeAt(aLevel);
+          b.skipSubtreeAt(bLevel);
+          continue;
+        }
+        if (!(a->second == b->second) || Compare()(a->first, b->first) ||
+            Compare()(b->first, a->first)) {
+          return;
+        }
+        ++a;
+        ++b;
+      }
+    }
+
+   private:
+    friend class PersistentMap;
+
+    // Path from the root to the current entry: (node, index in node).
+    using Path =
+        boost::container::small_vector<std::pair<const Node*, size_t>, 8>;
+
+    explicit const_iterator(const Node* root) : root_(root) {}
+
+    const Node* nodeAt(size_t level) const {
+      return path_[level].first;
+    }
+
+    void descendLeftmost() {
+      while (!path_.back().first->isLeaf()) {
+        const auto& top = path_.back();
+        path_.emplace_back(top.first->children[top.second].get(), 0);
+      }
+    }
+    void descendRightmost() {
+      while (!path_.back().first->isLeaf()) {
+        const auto& top = path_.back();
+        const Node* child = top.first->children[top.second].get();
+        path_.emplace_back(child, child->count() - 1);
+      }
+    }
+
+    // Move to the entry following the current position of the node at
+    // `level`, leaving the subtrees below it.
+    void advanceFrom(size_t level) {
+      path_.resize(level + 1);
+      while (true) {
+        auto& top = path_.back();
+        if (++top.second < top.first->count()) {
+          descendLeftmost();
+          return;
+        }
+        path_.pop_back();
+        if (path_.empty()) {
+          return;
+        }
+      }
+    }
+
+    // Skip the rest of the node at `level`, including the current position.
+    void skipSubtreeAt(size_t level) {
+      if (level == 0) {
+        path_.clear();
+      } else {
+        advanceFrom(level - 1);
+      }
+    }
+
+    void retreat() {
+      if (path_.empty()) {
+        path_.emplace_back(root_, root_->count() - 1);
+        descendRightmost();
+        return;
+      }
+      while (path_.back().second == 0) {
+        path_.pop_back();
+      }
+      --path_.back().second;
+      descendRightmost();
+    }
+
+    const Node* root_{nullptr};
+    Path path_;
+  };
+  using iterator = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = const_reverse_iterator;
+
+  PersistentMap() {}
+
+  size_t size() const {
+    return size_;
+  }
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  const_iterator begin() const {
+    const_iterator it(root_.get());
+    if (root_) {
+      it.path_.emplace_back(root_.get(), 0);
+      it.descendLeftmost();
+    }
+    return it;
+  }
+  const_iterator end() const {
+    return const_iterator(root_.get());
+  }
+  const_iterator cbegin() const {
+    return begin();
+  }
+  const_iterator cend() const {
+    return end();
+  }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  const_iterator find(const K& key) const {
+    auto it = lower_bound(key);
+    if (it != end() && !Compare()(key, it->first)) {
+      return it;
+    }
+    return end();
+  }
+
+  const_iterator lower_bound(const K& key) const {
+    const_iterator it(root_.get());
+    if (!root_) {
+      return it;
+    }
+    const Node* node = root_.get();
+    while (!node->isLeaf()) {
+      auto idx = childIndex(*node, key);
+      it.path_.emplace_back(node, idx);
+      node = node->children[idx].get();
+    }
+    auto entry = leafLowerBound(*node, key);
+    it.path_.emplace_back(node, entry - node->entries.begin());
+    if (entry == node->entries.end()) {
+      // key is larger than all entries in this leaf, the lower bound is the
+      // first entry of the next leaf (if any).
+      it.path_.back().second--;
+      ++it;
+    }
+    return it;
+  }
+
+  size_t count(const K& key) const {
+    return find(key) == end() ? 0 : 1;
+  }
+
+  std::pair<const_iterator, bool> insert(value_type value) {
+    auto key = value.first;
+    bool inserted =
+        insertImpl(std::move(value.first), std::move(value.second), false);
+    return std::make_pair(find(key), inserted);
+  }
+
+  template <typename... Args>
+  std::pair<const_iterator, bool> emplace(const K& key, Args&&... args) {
+    return insert(value_type(key, V(std::forward<Args>(args)...)));
+  }
+
+  template <typename... Args>
+  const_iterator
+  emplace_hint(const_iterator /* hint */, const K& key, Args&&... args) {
+    insertImpl(K(key), V(std::forward<Args>(args)...), false);
+    return find(key);
+  }
+
+  template <typename M>
+  std::pair<const_iterator, bool> insert_or_assign(const K& key, M&& value) {
+    bool inserted = insertImpl(K(key), V(std::forward<M>(value)), true);
+    return std::make_pair(find(key), inserted);
+  }
+
+  template <typename M>
+  const_iterator
+  insert_or_assign(const_iterator /* hint */, const K& key, M&& value) {
+    return insert_or_assign(key, std::forward<M>(value)).first;
+  }
+
+  size_t erase(const K& key) {
+    if (!root_) {
+      return 0;
+    }
+    bool erased = false;
+    auto newRoot = eraseImpl(root_, false, key, &erased);
+    if (!erased) {
+      return 0;
+    }
+    root_ = std::move(newRoot);
+    // Collapse internal nodes left with a single child
+    while (root_ && !root_->isLeaf() && root_->children.size() == 1) {
+      root_ = root_->children.front();
+    }
+    --size_;
+    return 1;
+  }
+
+  const_iterator erase(const_iterator pos) {
+    auto key = pos->first;
+    erase(key);
+    return lower_bound(key);
+  }
+
+  void clear() {
+    root_.reset();
+    size_ = 0;
+  }
+
+  void swap(PersistentMap& other) {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+  }
+
+  bool operator==(const PersistentMap& other) const {
+    if (size_ != other.size_) {
+      return false;
+    }
+    auto it = begin();
+    auto otherIt = other.begin();
+    advancePastShared(it, end(), otherIt, other.end());
+    return it == end() && otherIt == other.end();
+  }
+  bool operator!=(const PersistentMap& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  static size_t childIndex(const Node& node, const K& key) {
+    // Last child whose min key is <= key, or the first child if key is
+    // smaller than all of them.
+    auto it = std::upper_bound(
+        node.minKeys.begin() + 1, node.minKeys.end(), key, Compare());
+    return (it - node.minKeys.begin()) - 1;
+  }
+
+  static typename std::vector<value_type>::const_iterator leafLowerBound(
+      const Node& leaf,
+      const K& key) {
+    return std::lower_bound(
+        leaf.entries.begin(),
+        leaf.entries.end(),
+        key,
+        [](const value_type& entry, const K& k) {
+          return Compare()(entry.first, k);
+        });
+  }
+
+  /*
+   * Return a node that may be modified in place: `node` itself if this map
+   * holds the only reference to it, a copy of it otherwise. A node is also
+   * shared if any of its ancestors is, even when its own use count is 1.
+   */
+  static std::shared_ptr<Node> writable(const NodePtr& node, bool shared) {
+    if (!shared && node.use_count() == 1) {
+      return std::const_pointer_cast<Node>(node);
+    }
+    return std::make_shared<Node>(*node);
+  }
+
+  bool insertImpl(K key, V value, bool overwrite) {
+    if (!root_) {
+      auto leaf = std::make_shared<Node>();
+      leaf->entries.emplace_back(std::move(key), std::move(value));
+      root_ = std::move(leaf);
+      size_ = 1;
+      return true;
+    }
+    NodePtr split;
+    bool inserted = false;
+    auto newRoot = insertImpl(
+        root_,
+        false,
+        std::move(key),
+        std::move(value),
+        overwrite,
+        &split,
+        &inserted);
+    if (!newRoot) {
+      // Nothing changed
+      return false;
+    }
+    if (split) {
+      auto root = std::make_shared<Node>();
+      root->minKeys = {newRoot->minKey(), split->minKey()};
+      root->children = {std::move(newRoot), std::move(split)};
+      newRoot = std::move(root);
+    }
+    root_ = std::move(newRoot);
+    if (inserted) {
+      ++size_;
+    }
+    return inserted;
+  }
+
+  /*
+   * Insert into the subtree rooted at `node`. Returns the node replacing it,
+   * or nullptr if the subtree is unchanged. If the replacement overflowed,
+   * its upper half is returned in `split`.
+   */
+  static NodePtr insertImpl(
+      const NodePtr& node,
+      bool shared,
+      K key,
+      V value,
+      bool overwrite,
+      NodePtr* split,
+      bool* inserted) {
+    if (node->isLeaf()) {
+      auto entry = leafLowerBound(*node, key);
+      auto pos = entry - node->entries.begin();
+      bool exists =
+          entry != node->entries.end() && !Compare()(key, entry->first);
+      if (exists && (!overwrite || entry->second == value)) {
+        return nullptr;
+      }
+      auto leaf = writable(node, shared);
+      if (exists) {
+        leaf->entries[pos].second = std::move(value);
+      } else {
+        leaf->entries.emplace(
+            leaf->entries.begin() + pos, std::move(key), std::move(value));
+        *inserted = true;
+        if (leaf->entries.size() > kMaxLeafSize) {
+          auto sibling = std::make_shared<Node>();
+          auto mid = leaf->entries.begin() + leaf->entries.size() / 2;
+          sibling->entries.assign(
+              std::make_move_iterator(mid),
+              std::make_move_iterator(leaf->entries.end()));
+          leaf->entries.erase(mid, leaf->entries.end());
+          *split = std::move(sibling);
+        }
+      }
+      return leaf;
+    }
+
+    auto idx = childIndex(*node, key);
+    NodePtr childSplit;
+    auto child = insertImpl(
+        node->children[idx],
+        shared || node.use_count() > 1,
+        std::move(key),
+        std::move(value),
+        overwrite,
+        &childSplit,
+        inserted);
+    if (!child) {
+      return nullptr;
+    }
+    auto internal = writable(node, shared);
+    internal->minKeys[idx] = child->minKey();
+    internal->children[idx] = std::move(child);
+    if (childSplit) {
+      internal->minKeys.insert(
+          internal->minKeys.begin() + idx + 1, childSplit->minKey());
+      internal->children.insert(
+          internal->children.begin() + idx + 1, std::move(childSplit));
+      if (internal->children.size() > kMaxFanout) {
+        auto sibling = std::make_shared<Node>();
+        auto half = internal->children.size() / 2;
+        sibling->minKeys.assign(
+            std::make_move_iterator(internal->minKeys.begin() + half),
+            std::make_move_iterator(internal->minKeys.end()));
+        sibling->children.assign(
+            std::make_move_iterator(internal->children.begin() + half),
+            std::make_move_iterator(internal->children.end()));
+        internal->minKeys.resize(half);
+        internal->children.resize(half);
+        *split = std::move(sibling);
+      }
+    }
+    return internal;
+  }
+
+  /*
+   * Erase `key` from the subtree rooted at `node`. Returns the node replacing
+   * it, which is nullptr if the subtree became empty. `erased` is only set if
+   * the key was found, otherwise the return value must be ignored.
+   */
+  static NodePtr
+  eraseImpl(const NodePtr& node, bool shared, const K& key, bool* erased) {
+    if (node->isLeaf()) {
+      auto entry = leafLowerBound(*node, key);
+      if (entry == node->entries.end() || Compare()(key, entry->first)) {
+        return node;
+      }
+      *erased = true;
+      if (node->entries.size() == 1) {
+        return nullptr;
+      }
+      auto pos = entry - node->entries.begin();
+      auto leaf = writable(node, shared);
+      leaf->entries.erase(leaf->entries.begin() + pos);
+      return leaf;
+    }
+
+    auto idx = childIndex(*node, key);
+    auto child = eraseImpl(
+        node->children[idx], shared || node.use_count() > 1, key, erased);
+    if (!*erased) {
+      return node;
+    }
+    if (!child && node->children.size() == 1) {
+      return nullptr;
+    }
+    auto internal = writable(node, shared);
+    if (!child) {
+      internal->minKeys.erase(internal->minKeys.begin() + idx);
+      internal->children.erase(internal->children.begin() + idx);
+      return internal;
+    }
+    internal->minKeys[idx] = child->minKey();
+    internal->children[idx] = std::move(child);
+    mergeSmallLeaf(internal.get(), idx);
+    return internal;
+  }
+
+  /*
+   * Merge the leaf at `idx` into a sibling leaf if it became small, so that
+   * deletions don't leave behind a long tail of nearly empty leaves.
+   */
+  static void mergeSmallLeaf(Node* parent, size_t idx) {
+    const auto& child = parent->children[idx];
+    if (!child->isLeaf() || child->entries.size() >= kMinLeafSize ||
+        parent->children.size() == 1) {
+      return;
+    }
+    auto left = idx > 0 ? idx - 1 : idx;
+    auto right = left + 1;
+    if (parent->children[left]->count() + parent->children[right]->count() >
+        kMaxLeafSize / 2) {
+      return;
+    }
+    // parent is exclusively owned here, so its children's use counts are
+    // accurate.
+    auto merged = writable(parent->children[left], false);
+    const auto& rightEntries = parent->children[right]->entries;
+    merged->entries.insert(
+        merged->entries.end(), rightEntries.begin(), rightEntries.end());
+    parent->children[left] = std::move(merged);
+    parent->minKeys.erase(parent->minKeys.begin() + right);
+    parent->children.erase(parent->children.begin() + right);
+  }
+
+  NodePtr root_;
+  size_t size_{0};
+};
+
+} // namespace facebook::fboss
@@ -146,7 +146,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
       // specific root.
       auto prefix = IPADDRTYPE::longestCommonPrefix(
           {root_->ipAddress(), root_->masklen()}, {toAdd, mask});
-      std::unique_ptr<TreeNode> newRoot = nullptr;
+      NodePtr newRoot = nullptr;
       if (prefix.first == toAdd && prefix.second == mask) {
         // To be added node is the new root
         newRoot = std::move(newNode);
@@ -217,7 +217,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
         // bestMatchChild and new node.
         auto internalNode = makeNode(prefix.first, prefix.second);
         auto internalNodeRaw = internalNode.get();
-        std::unique_ptr<TreeNode> oldBestMatchChild = nullptr;
+        NodePtr oldBestMatchChild = nullptr;
         if (toAddDirection == TreeDirection::LEFT) {
           oldBestMatchChild = bestMatch->resetLeft(std::move(internalNode));
         } else {
@@ -237,7 +237,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
         CHECK(internalNode == nullptr);
       } else {
         // New node needs to be inserted  b/w bestMatch and bestMatchChild
-        std::unique_ptr<TreeNode> oldBestMatchChild = nullptr;
+        NodePtr oldBestMatchChild = nullptr;
         if (toAddDirection == TreeDirection::LEFT) {
           oldBestMatchChild = bestMatch->resetLeft(std::move(newNode));
         } else {
@@ -402,21 +402,16 @@ bool RadixTree<IPADDRTYPE, T, TreeTraits>::radixSubTreesEqual(
 }
 
 template <typename IPADDRTYPE, typename T, typename TreeTraits>
-std::unique_ptr<typename RadixTree<IPADDRTYPE, T, TreeTraits>::TreeNode>
+typename RadixTree<IPADDRTYPE, T, TreeTraits>::NodePtr
 RadixTree<IPADDRTYPE, T, TreeTraits>::cloneSubTree(const TreeNode* node) {
   if (!node) {
     return nullptr;
   }
-  std::unique_ptr<TreeNode> copy;
+  NodePtr copy;
   if (node->isValueNode()) {
-    copy = std::make_unique<TreeNode>(
-        node->ipAddress(),
-        node->masklen(),
-        node->value(),
-        node->nodeDeleteCallback());
+    copy = makeNode(node->ipAddress(), node->masklen(), node->value());
   } else {
-    copy = std::make_unique<TreeNode>(
-        node->ipAddress(), node->masklen(), node->nodeDeleteCallback());
+    copy = makeNode(node->ipAddress(), node->masklen());
   }
   copy->resetLeft(cloneSubTree(node->left()));
   copy->resetRight(cloneSubTree(node->right()));
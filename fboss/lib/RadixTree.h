@@ -8,7 +8,9 @@
 #include <exception>
 #include <functional>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -22,12 +24,20 @@
 #include <optional>
 
 namespace facebook::network {
+
+template <typename IPADDRTYPE, typename T>
+class RadixTreeNodeArena;
+
 /*
  * Node in RadixTree, holds IP, mask. Will hold  value for nodes
  * created as a result of user inserts. Other type of nodes are
  * ones created by the radix tree implementation, which will
  * hold no values. All non value nodes will have 2 children,
  * this invariant must be maintained at all times.
+ *
+ * Nodes are allocated from, and hold a pointer to, the
+ * RadixTreeNodeArena of the tree that created them. The arena also
+ * holds the delete callback, so it is not copied into every node.
  */
 template <typename IPADDRTYPE, typename T>
 class RadixTreeNode {
@@ -35,30 +45,37 @@ class RadixTreeNode {
   // Optional function parameter to call from destructor
   typedef std::function<void(const RadixTreeNode<IPADDRTYPE, T>&)>
       NodeDeleteCallback;
+  typedef RadixTreeNodeArena<IPADDRTYPE, T> Arena;
 
-  RadixTreeNode(
-      const IPADDRTYPE& ipAddr,
-      uint8_t mlen,
-      NodeDeleteCallback deleteCallback)
-      : ipAddress_(ipAddr), masklen_(mlen), deleteCallback_(deleteCallback) {}
+  // Returns nodes to the arena they were allocated from
+  struct Deleter {
+    void operator()(RadixTreeNode* node) const;
+  };
+  typedef std::unique_ptr<RadixTreeNode, Deleter> Ptr;
+
+  RadixTreeNode(const IPADDRTYPE& ipAddr, uint8_t mlen, Arena* arena)
+      : ipAddress_(ipAddr), masklen_(mlen), arena_(arena) {}
 
   template <typename VALUE>
   RadixTreeNode(
       const IPADDRTYPE& ipAddr,
       uint8_t mlen,
       VALUE&& val,
-      NodeDeleteCallback deleteCallback)
+      Arena* arena)
       : ipAddress_(ipAddr),
         masklen_(mlen),
         value_(std::forward<VALUE>(val)),
-        deleteCallback_(deleteCallback) {}
+        arena_(arena) {}
 
   ~RadixTreeNode() {
-    if (deleteCallback_) {
-      deleteCallback_(*this);
+    if (arena_ && arena_->nodeDeleteCallback()) {
+      arena_->nodeDeleteCallback()(*this);
     }
   }
 
+  RadixTreeNode(const RadixTreeNode&) = delete;
+  RadixTreeNode& operator=(const RadixTreeNode&) = delete;
+
   enum class TreeDirection { LEFT, RIGHT, PARENT, THIS_NODE };
 
   const IPADDRTYPE& ipAddress() const {
@@ -101,10 +118,10 @@ class RadixTreeNode {
     return value_.value();
   }
   NodeDeleteCallback nodeDeleteCallback() const {
-    return deleteCallback_;
+    return arena_ ? arena_->nodeDeleteCallback() : NodeDeleteCallback();
   }
   std::string str(bool printValue = true) const {
-    auto nodeStr = folly::to<std::string>(ipAddress_.str(), "/", masklen_);
+    auto nodeStr = folly::to<std::string>(ipAddress_.str(), "/", masklen());
     if (printValue) {
       nodeStr += isNonValueNode()
           ? "(*)"
@@ -129,8 +146,7 @@ class RadixTreeNode {
         (!isValueNode() || this->value() == r.value());
   }
 
-  std::unique_ptr<RadixTreeNode> resetLeft(
-      std::unique_ptr<RadixTreeNode> newLeft) {
+  Ptr resetLeft(Ptr newLeft) {
     auto old = std::move(left_);
     left_ = std::move(newLeft);
     if (left_) {
@@ -139,8 +155,7 @@ class RadixTreeNode {
     return old;
   }
 
-  std::unique_ptr<RadixTreeNode> resetRight(
-      std::unique_ptr<RadixTreeNode> newRight) {
+  Ptr resetRight(Ptr newRight) {
     auto old = std::move(right_);
     right_ = std::move(newRight);
     if (right_) {
@@ -163,15 +178,135 @@ class RadixTreeNode {
   }
 
  protected:
+  // Members are ordered so that masklen_ packs into the padding after the
+  // address, which keeps a V6 node with a pointer sized value within 80
+  // bytes.
   IPADDRTYPE ipAddress_;
-  uint32_t masklen_{0}; // Number of bits to match.
+  uint8_t masklen_{0}; // Number of bits to match.
   std::optional<T> value_;
-  std::unique_ptr<RadixTreeNode> left_{nullptr};
-  std::unique_ptr<RadixTreeNode> right_{nullptr};
+  Ptr left_{nullptr};
+  Ptr right_{nullptr};
   RadixTreeNode* parent_{nullptr};
+  Arena* arena_{nullptr};
+};
+
+/*
+ * Slab allocator for the nodes of a RadixTree.
+ *
+ * Nodes are carved out of slabs of geometrically increasing size and
+ * recycled through a free list, so a tree built by a stream of inserts
+ * keeps its nodes packed next to each other instead of scattered over the
+ * heap, and erasing and re-adding routes doesn't go back to malloc.
+ *
+ * A subtree moved to another tree keeps pointing at the arena its nodes
+ * were allocated from, so the arena is reference counted by its tree and
+ * its live nodes: it frees itself once the tree has released it and the
+ * last of its nodes is gone. Like the tree itself, an arena is not thread
+ * safe.
+ */
+template <typename IPADDRTYPE, typename T>
+class RadixTreeNodeArena {
+ public:
+  typedef RadixTreeNode<IPADDRTYPE, T> TreeNode;
+  typedef typename TreeNode::NodeDeleteCallback NodeDeleteCallback;
+
+  explicit RadixTreeNodeArena(NodeDeleteCallback deleteCallback)
+      : deleteCallback_(std::move(deleteCallback)) {}
+
+  RadixTreeNodeArena(const RadixTreeNodeArena&) = delete;
+  RadixTreeNodeArena& operator=(const RadixTreeNodeArena&) = delete;
+
+  template <typename... Args>
+  typename TreeNode::Ptr makeNode(Args&&... args) {
+    auto slot = allocate();
+    TreeNode* node;
+    try {
+      node = new (slot) TreeNode(std::forward<Args>(args)..., this);
+    } catch (...) {
+      deallocate(slot);
+      throw;
+    }
+    ++liveNodes_;
+    return typename TreeNode::Ptr(node);
+  }
+
+  void destroy(TreeNode* node) {
+    node->~TreeNode();
+    deallocate(reinterpret_cast<Slot*>(node));
+    --liveNodes_;
+    if (released_ && liveNodes_ == 0) {
+      delete this;
+    }
+  }
+
+  // Called by the owning tree once it no longer allocates from this arena
+  void release() {
+    released_ = true;
+    if (liveNodes_ == 0) {
+      delete this;
+    }
+  }
+
+  const NodeDeleteCallback& nodeDeleteCallback() const {
+    return deleteCallback_;
+  }
+  size_t liveNodes() const {
+    return liveNodes_;
+  }
+  size_t allocatedBytes() const {
+    return allocatedSlots_ * sizeof(Slot);
+  }
+
+ private:
+  static constexpr size_t kMinSlabSlots = 32;
+  static constexpr size_t kMaxSlabSlots = 4096;
+
+  union Slot {
+    Slot* next;
+    typename std::aligned_storage<sizeof(TreeNode), alignof(TreeNode)>::type
+        storage;
+  };
+
+  ~RadixTreeNodeArena() = default;
+
+  Slot* allocate() {
+    if (!freeList_) {
+      slabs_.emplace_back(new Slot[nextSlabSlots_]);
+      auto slab = slabs_.back().get();
+      // Thread the free list in address order so that consecutive
+      // allocations are adjacent in memory.
+      for (size_t i = nextSlabSlots_; i > 0; --i) {
+        slab[i - 1].next = freeList_;
+        freeList_ = &slab[i - 1];
+      }
+      allocatedSlots_ += nextSlabSlots_;
+      nextSlabSlots_ = std::min(nextSlabSlots_ * 2, kMaxSlabSlots);
+    }
+    auto slot = freeList_;
+    freeList_ = slot->next;
+    return slot;
+  }
+
+  void deallocate(Slot* slot) {
+    slot->next = freeList_;
+    freeList_ = slot;
+  }
+
   NodeDeleteCallback deleteCallback_;
+  std::vector<std::unique_ptr<Slot[]>> slabs_;
+  Slot* freeList_{nullptr};
+  size_t nextSlabSlots_{kMinSlabSlots};
+  size_t allocatedSlots_{0};
+  size_t liveNodes_{0};
+  bool released_{false};
 };
 
+template <typename IPADDRTYPE, typename T>
+void RadixTreeNode<IPADDRTYPE, T>::Deleter::operator()(
+    RadixTreeNode* node) const {
+  node->arena_->destroy(node);
+}
+
 /*
  * Forward Iterator to traverse a Radix tree
  * Traverses the tree in DFS/preorder fashion
@@ -387,6 +522,11 @@ class RadixTree {
       const TreeTraits& treeTraits = TreeTraits())
       : nodeDeleteCallback_(nodeDelCallback), traits_(treeTraits) {}
 
+  ~RadixTree() {
+    clear();
+    releaseArena();
+  }
+
   RadixTree(const RadixTree& r) = delete;
   RadixTree& operator=(const RadixTree& r) = delete;
 
@@ -419,6 +559,9 @@ class RadixTree {
     size_ = r.size_;
     makeRoot(std::move(r.root_));
     r.size_ = 0;
+    // The moved nodes are now the only users of r's arena, r gets a new
+    // one on its next insert.
+    r.releaseArena();
     return *this;
   }
   // Clone this radix tree onto another
@@ -430,7 +573,7 @@ class RadixTree {
         "clone template type must be the same as Radix tree value type");
     RadixTree copy(nodeDeleteCallback_, traits_);
     copy.size_ = size_;
-    copy.root_ = cloneSubTree(root_.get());
+    copy.root_ = copy.cloneSubTree(root_.get());
     return copy;
   }
   /*
@@ -588,9 +731,19 @@ class RadixTree {
   const TreeTraits& traits() const {
     return traits_;
   }
+  /*
+   * Bytes allocated for the nodes created by this tree. Nodes moved in from
+   * another tree are accounted to the arena of that tree.
+   */
+  size_t allocatedBytes() const {
+    return arena_ ? arena_->allocatedBytes() : 0;
+  }
 
  private:
-  static std::unique_ptr<TreeNode> cloneSubTree(const TreeNode* node);
+  typedef typename TreeNode::Ptr NodePtr;
+  typedef typename TreeNode::Arena Arena;
+
+  NodePtr cloneSubTree(const TreeNode* node);
   // Worker function to do the actual longest match lookup.
   const TreeNode* longestMatchImpl(
       const IPADDRTYPE& ipaddr,
@@ -611,18 +764,30 @@ class RadixTree {
             ipaddr, masklen, foundExact, includeNonValueNodes, trail));
   }
 
-  std::unique_ptr<TreeNode> makeNode(const IPADDRTYPE& ip, uint8_t masklen) {
-    return std::make_unique<TreeNode>(ip, masklen, nodeDeleteCallback_);
+  Arena* arena() {
+    if (!arena_) {
+      arena_ = new Arena(nodeDeleteCallback_);
+    }
+    return arena_;
+  }
+
+  void releaseArena() {
+    if (arena_) {
+      arena_->release();
+      arena_ = nullptr;
+    }
+  }
+
+  NodePtr makeNode(const IPADDRTYPE& ip, uint8_t masklen) {
+    return arena()->makeNode(ip, masklen);
   }
 
   template <typename VALUE>
-  std::unique_ptr<TreeNode>
-  makeNode(const IPADDRTYPE& ip, uint8_t masklen, VALUE&& value) {
-    return std::make_unique<TreeNode>(
-        ip, masklen, std::forward<VALUE>(value), nodeDeleteCallback_);
+  NodePtr makeNode(const IPADDRTYPE& ip, uint8_t masklen, VALUE&& value) {
+    return arena()->makeNode(ip, masklen, std::forward<VALUE>(value));
   }
 
-  void makeRoot(std::unique_ptr<TreeNode> newRoot) {
+  void makeRoot(NodePtr newRoot) {
     CHECK(root_ != newRoot || root_ == nullptr);
     if (newRoot) {
       newRoot->setParent(nullptr);
@@ -635,7 +800,9 @@ class RadixTree {
       bool includeNonValueNodes,
       const TreeNode* node) const;
 
-  std::unique_ptr<TreeNode> root_{nullptr};
+  // Allocated on the first insert, see RadixTreeNodeArena for ownership
+  Arena* arena_{nullptr};
+  NodePtr root_{nullptr};
   size_t size_{0};
   NodeDeleteCallback nodeDeleteCallback_;
   TreeTraits traits_;
@@ -1063,6 +1230,9 @@ class RadixTree<folly::IPAddress, T> {
   size_t size6() const {
     return ipv6Tree_.size();
   }
+  size_t allocatedBytes() const {
+    return ipv4Tree_.allocatedBytes() + ipv6Tree_.allocatedBytes();
+  }
   /*
    * Insert a IP, mask, value in tree. Returns inserted node, true
    * if a node was inserted. If a node for IP, mask already existed
@@ -10,14 +10,26 @@
 #include <folly/Synchronized.h>
 #include <folly/futures/Future.h>
 #include <folly/logging/xlog.h>
+#include <folly/portability/Asm.h>
 
 #include <algorithm>
+#include <chrono>
 #include <thread>
 
 namespace {
 constexpr uint32_t kFacebookFpgaRTCWriteBlock = 0x2000;
 constexpr uint32_t kFacebookFpgaRTCReadBlock = 0x3000;
 constexpr uint32_t kFacebookFpgaRTCIOBlockSize = 0x0200;
+
+// Short transactions, like single byte DOM reads, complete within this time,
+// so poll the status register without sleeping until then.
+constexpr auto kBusyPollTime = std::chrono::microseconds(100);
+// Then sleep between polls, doubling the sleep up to the max.
+constexpr auto kInitialPollBackoff = std::chrono::microseconds(20);
+constexpr auto kMaxPollBackoff = std::chrono::microseconds(1000);
+// Give up on a transaction after this long, plus the time per byte.
+constexpr auto kTransactionTimeout = std::chrono::milliseconds(20);
+constexpr auto kTransactionTimeoutPerByte = std::chrono::microseconds(100);
 } // unnamed namespace
 
 namespace facebook::fboss {
@@ -29,27 +41,49 @@ FbFpgaI2c::FbFpgaI2c(FbDomFpga* fpga, uint32_t rtcId, uint32_t pimId)
   XLOG(DBG4, "Initialized I2C controller for rtcId={:d}", rtcId);
 }
 
-bool FbFpgaI2c::waitForResponse(size_t len) {
+void FbFpgaI2c::clearStatus() {
+  /*
+   * The done and error bits are write 1 to clear. Clear them before posting a
+   * descriptor, so that the status of the previous transaction is not taken
+   * for that of the new one before the FPGA picks it up.
+   */
   I2cRtcStatus rtcStatus;
-  uint32_t retries = 20;
-
-  // Make the initial wait according to the length of read/write.
-  usleep(100 * len);
-
-  rtcStatus = readReg<I2cRtcStatus>();
+  rtcStatus.reg = 0;
+  rtcStatus.desc0done = 1;
+  rtcStatus.desc0error = 1;
+  writeReg(rtcStatus);
+}
 
-  while (!rtcStatus.desc0done && --retries) {
-    usleep(1000);
-    rtcStatus = readReg<I2cRtcStatus>();
-  }
+bool FbFpgaI2c::waitForResponse(size_t len) {
+  auto start = std::chrono::steady_clock::now();
+  auto busyPollEnd = start + kBusyPollTime;
+  auto deadline = start + kTransactionTimeout +
+      kTransactionTimeoutPerByte * static_cast<int64_t>(len);
+  std::chrono::microseconds backoff = kInitialPollBackoff;
+
+  while (true) {
+    auto rtcStatus = readReg<I2cRtcStatus>();
+    if (rtcStatus.desc0error) {
+      XLOG(DBG5) << "I2C read/write ops has error.";
+      return false;
+    }
+    if (rtcStatus.desc0done) {
+      return true;
+    }
 
-  if (rtcStatus.desc0error) {
-    XLOG(DBG5) << "I2C read/write ops has error.";
-    rtcStatus.reg = 0xffffffff;
-    return false;
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      XLOG(DBG5) << "I2C read/write ops timed out.";
+      return false;
+    }
+    if (now < busyPollEnd) {
+      folly::asm_volatile_pause();
+      continue;
+    }
+    std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(
+        backoff, deadline - now));
+    backoff = std::min(backoff * 2, kMaxPollBackoff);
   }
-
-  return rtcStatus.desc0done;
 }
 
 uint8_t FbFpgaI2c::readByte(uint8_t channel, uint8_t offset) {
@@ -74,8 +108,10 @@ void FbFpgaI2c::read(
   descUpper.channel = channel;
   descUpper.valid = 1;
 
+  clearStatus();
   writeReg(descLower);
   writeReg(descUpper);
+  auto start = std::chrono::steady_clock::now();
 
   // Increment the counter for I2C read tranbsaction issued
   incrReadTotal();
@@ -83,7 +119,10 @@ void FbFpgaI2c::read(
   uint32_t readBlockAddr =
       getRegAddr(kFacebookFpgaRTCReadBlock, kFacebookFpgaRTCIOBlockSize);
 
-  if (!waitForResponse(descLower.len)) {
+  auto done = waitForResponse(descLower.len);
+  recordReadLatency(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start));
+  if (!done) {
     // Increment the counter for I2C read transaction failure and
     // throw error
     incrReadFailed();
@@ -134,10 +173,15 @@ void FbFpgaI2c::write(uint8_t channel, uint8_t offset, folly::ByteRange buf) {
     fpga_->write(writeBlockAddr + bytesWritten, data);
   }
 
+  clearStatus();
   writeReg(descLower);
   writeReg(descUpper);
+  auto start = std::chrono::steady_clock::now();
 
-  if (!waitForResponse(descLower.len)) {
+  auto done = waitForResponse(descLower.len);
+  recordWriteLatency(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start));
+  if (!done) {
     // Increment the counter for I2c write transaction failure and
     // throw error
     incrWriteFailed();
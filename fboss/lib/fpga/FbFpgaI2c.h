@@ -38,6 +38,7 @@ class FbFpgaI2c : public I2cController {
   void write(uint8_t channel, uint8_t offset, folly::ByteRange buf);
 
  private:
+  void clearStatus();
   bool waitForResponse(size_t len);
   uint32_t getRegAddr(uint32_t regBase, uint32_t regIncr);
 
@@ -0,0 +1,200 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/fpga/FbFpgaI2c.h"
+#include "fboss/lib/fpga/FbFpgaRegisters.h"
+#include "fboss/lib/test/FakePhysicalMemory.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <numeric>
+
+using namespace facebook::fboss;
+
+namespace {
+
+const uint64_t kFakePhysicalAddr = 0xfb000000;
+const uint32_t kFakeSize = 0x4000;
+const uint32_t kRtcId = 1;
+const uint32_t kReadBlock = 0x3000 + 0x200 * kRtcId;
+const uint32_t kWriteBlock = 0x2000 + 0x200 * kRtcId;
+
+uint32_t regAddr(uint32_t base, uint32_t incr) {
+  return base + incr * kRtcId;
+}
+
+/*
+ * An FPGA backed by a register file in memory, whose RTC completes a
+ * transaction a given time after it is issued.
+ */
+class FakeFbDomFpga : public FbDomFpga {
+ public:
+  FakeFbDomFpga() : FbDomFpga(kFakePhysicalAddr, kFakeSize, 0) {
+    registers_.mmap();
+  }
+
+  uint32_t read(uint32_t offset) const override {
+    if (offset == statusAddr() && pending_ &&
+        std::chrono::steady_clock::now() >= doneTime_) {
+      I2cRtcStatus status;
+      status.reg = 0;
+      status.desc0done = 1;
+      status.desc0error = failTransactions_;
+      registers_.write(offset, status.reg);
+      pending_ = false;
+    }
+    return registers_.read(offset);
+  }
+
+  void write(uint32_t offset, uint32_t value) override {
+    if (offset == statusAddr()) {
+      // Write 1 to clear
+      registers_.write(offset, registers_.read(offset) & ~value);
+      return;
+    }
+    registers_.write(offset, value);
+    I2cDescriptorUpper upper;
+    upper.reg = value;
+    if (offset == regAddr(
+                      I2cDescriptorUpper::baseAddr::value,
+                      I2cDescriptorUpper::addrIncr::value) &&
+        upper.valid) {
+      // The status of the previous transaction is only cleared once the new
+      // one completes
+      pending_ = !hang_;
+      doneTime_ = std::chrono::steady_clock::now() + transactionTime_;
+      ++numTransactions_;
+    }
+  }
+
+  void setTransactionTime(std::chrono::microseconds time) {
+    transactionTime_ = time;
+  }
+  void setFailTransactions(bool fail) {
+    failTransactions_ = fail;
+  }
+  void setHang(bool hang) {
+    hang_ = hang;
+  }
+  int getNumTransactions() const {
+    return numTransactions_;
+  }
+
+ private:
+  static uint32_t statusAddr() {
+    return regAddr(
+        I2cRtcStatus::baseAddr::value, I2cRtcStatus::addrIncr::value);
+  }
+
+  mutable FakePhysicalMemory32 registers_{kFakePhysicalAddr, kFakeSize, false};
+  mutable bool pending_{false};
+  std::chrono::steady_clock::time_point doneTime_;
+  std::chrono::microseconds transactionTime_{0};
+  bool failTransactions_{false};
+  bool hang_{false};
+  int numTransactions_{0};
+};
+
+int64_t sum(const std::vector<int64_t>& histogram) {
+  return std::accumulate(histogram.begin(), histogram.end(), int64_t(0));
+}
+
+class FbFpgaI2cTest : public ::testing::Test {
+ public:
+  FakeFbDomFpga fpga_;
+  FbFpgaI2c i2c_{&fpga_, kRtcId, 1};
+};
+
+} // namespace
+
+TEST_F(FbFpgaI2cTest, read) {
+  for (uint32_t i = 0; i < 128; i += 4) {
+    fpga_.write(kReadBlock + i, 0x03020100 + 0x04040404 * (i / 4));
+  }
+
+  std::array<uint8_t, 128> buf;
+  i2c_.read(0, 0, folly::MutableByteRange(buf.data(), buf.size()));
+  for (size_t i = 0; i < buf.size(); ++i) {
+    EXPECT_EQ(i, buf[i]);
+  }
+
+  const auto& stats = i2c_.getI2cControllerPlatformStats();
+  EXPECT_EQ(1, *stats.readTotal__ref());
+  EXPECT_EQ(0, *stats.readFailed__ref());
+  EXPECT_EQ(128, *stats.readBytes__ref());
+  EXPECT_EQ(
+      i2c_controller_stats_constants::LATENCY_BUCKET_BOUNDS_US().size() + 1,
+      stats.readLatencyHistogram__ref()->size());
+  EXPECT_EQ(1, sum(*stats.readLatencyHistogram__ref()));
+  EXPECT_TRUE(stats.writeLatencyHistogram__ref()->empty());
+}
+
+TEST_F(FbFpgaI2cTest, write) {
+  std::array<uint8_t, 6> buf = {1, 2, 3, 4, 5, 6};
+  i2c_.write(2, 0x7f, folly::ByteRange(buf.data(), buf.size()));
+  EXPECT_EQ(0x04030201, fpga_.read(kWriteBlock));
+  EXPECT_EQ(0x0605, fpga_.read(kWriteBlock + 4) & 0xffff);
+
+  const auto& stats = i2c_.getI2cControllerPlatformStats();
+  EXPECT_EQ(1, *stats.writeTotal__ref());
+  EXPECT_EQ(6, *stats.writeBytes__ref());
+  EXPECT_EQ(1, sum(*stats.writeLatencyHistogram__ref()));
+}
+
+TEST_F(FbFpgaI2cTest, slowTransaction) {
+  // Takes long enough to get past busy polling and back off
+  fpga_.setTransactionTime(std::chrono::milliseconds(2));
+  EXPECT_EQ(0, i2c_.readByte(0, 0));
+  EXPECT_EQ(1, fpga_.getNumTransactions());
+
+  const auto& stats = i2c_.getI2cControllerPlatformStats();
+  EXPECT_EQ(0, *stats.readFailed__ref());
+  // Not recorded as faster than it was
+  const auto& histogram = *stats.readLatencyHistogram__ref();
+  EXPECT_EQ(1, sum(histogram));
+  EXPECT_EQ(0, histogram[0] + histogram[1] + histogram[2] + histogram[3]);
+}
+
+TEST_F(FbFpgaI2cTest, transactionError) {
+  fpga_.setFailTransactions(true);
+  EXPECT_THROW(i2c_.readByte(0, 0), FbFpgaI2cError);
+  EXPECT_THROW(i2c_.writeByte(0, 0, 1), FbFpgaI2cError);
+
+  const auto& stats = i2c_.getI2cControllerPlatformStats();
+  EXPECT_EQ(1, *stats.readFailed__ref());
+  EXPECT_EQ(1, *stats.writeFailed__ref());
+  // Failed transactions are timed too
+  EXPECT_EQ(1, sum(*stats.readLatencyHistogram__ref()));
+  EXPECT_EQ(1, sum(*stats.writeLatencyHistogram__ref()));
+}
+
+TEST_F(FbFpgaI2cTest, transactionTimeout) {
+  fpga_.setHang(true);
+  EXPECT_THROW(i2c_.readByte(0, 0), FbFpgaI2cError);
+
+  const auto& stats = i2c_.getI2cControllerPlatformStats();
+  EXPECT_EQ(1, *stats.readFailed__ref());
+  // Timed out after at least 20ms
+  const auto& histogram = *stats.readLatencyHistogram__ref();
+  EXPECT_EQ(1, histogram.back() + histogram[histogram.size() - 2]);
+}
+
+TEST_F(FbFpgaI2cTest, staleStatus) {
+  // The previous transaction leaves its done bit set
+  EXPECT_EQ(0, i2c_.readByte(0, 0));
+
+  fpga_.setTransactionTime(std::chrono::milliseconds(2));
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(0, i2c_.readByte(0, 0));
+  EXPECT_GE(
+      std::chrono::steady_clock::now() - start, std::chrono::milliseconds(2));
+}
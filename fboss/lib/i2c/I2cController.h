@@ -10,6 +10,10 @@
 #pragma once
 
 #include <stdint.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "fboss/lib/i2c/gen-cpp2/i2c_controller_stats_constants.h"
 #include "fboss/lib/i2c/gen-cpp2/i2c_controller_stats_types.h"
 
 namespace facebook::fboss {
@@ -31,6 +35,8 @@ class I2cController {
     *i2cControllerPlatformStats_.writeTotal__ref() = 0;
     *i2cControllerPlatformStats_.writeFailed__ref() = 0;
     *i2cControllerPlatformStats_.writeBytes__ref() = 0;
+    i2cControllerPlatformStats_.readLatencyHistogram__ref()->clear();
+    i2cControllerPlatformStats_.writeLatencyHistogram__ref()->clear();
   }
   // Total number of reads
   void incrReadTotal(uint32_t count = 1) {
@@ -57,6 +63,17 @@ class I2cController {
     *i2cControllerPlatformStats_.writeBytes__ref() += count;
   }
 
+  // Latency of a read transaction, from issue to completion
+  void recordReadLatency(std::chrono::microseconds latency) {
+    recordLatency(
+        *i2cControllerPlatformStats_.readLatencyHistogram__ref(), latency);
+  }
+  // Latency of a write transaction, from issue to completion
+  void recordWriteLatency(std::chrono::microseconds latency) {
+    recordLatency(
+        *i2cControllerPlatformStats_.writeLatencyHistogram__ref(), latency);
+  }
+
   /* Get the I2c transaction stats from the i2c controller
    */
   const I2cControllerStats& getI2cControllerPlatformStats() const {
@@ -65,6 +82,18 @@ class I2cController {
   }
 
  private:
+  static void recordLatency(
+      std::vector<int64_t>& histogram,
+      std::chrono::microseconds latency) {
+    const auto& bounds =
+        i2c_controller_stats_constants::LATENCY_BUCKET_BOUNDS_US();
+    histogram.resize(bounds.size() + 1);
+    auto bucket =
+        std::lower_bound(bounds.begin(), bounds.end(), latency.count()) -
+        bounds.begin();
+    ++histogram[bucket];
+  }
+
   // Platform i2c controller stats
   I2cControllerStats i2cControllerPlatformStats_;
 };
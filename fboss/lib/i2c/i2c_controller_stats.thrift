@@ -3,6 +3,19 @@ namespace py neteng.fboss.i2c_controller_stats
 
 const i64 STAT_UNINITIALIZED = 0
 
+// Upper bounds, in microseconds, of the buckets of the transaction latency
+// histograms. The histograms have one more bucket for longer transactions.
+const list<i64> LATENCY_BUCKET_BOUNDS_US = [
+  100,
+  250,
+  500,
+  1000,
+  2500,
+  5000,
+  10000,
+  25000,
+]
+
 struct I2cControllerStats {
   1: string controllerName_ = ""
   2: i64 readTotal_ = STAT_UNINITIALIZED
@@ -11,4 +24,8 @@ struct I2cControllerStats {
   5: i64 writeTotal_ = STAT_UNINITIALIZED
   6: i64 writeFailed_ = STAT_UNINITIALIZED
   7: i64 writeBytes_ = STAT_UNINITIALIZED
+  // Number of transactions per LATENCY_BUCKET_BOUNDS_US bucket, including
+  // failed ones. Empty until the first transaction completes.
+  8: list<i64> readLatencyHistogram_
+  9: list<i64> writeLatencyHistogram_
 }
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/Interned.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+struct SetHash {
+  size_t operator()(const std::set<int>& values) const {
+    size_t hash = 0;
+    for (auto value : values) {
+      hash = hash * 31 + value;
+    }
+    return hash;
+  }
+};
+
+using InternedString = Interned<std::string>;
+using InternedSet = Interned<std::set<int>, SetHash>;
+} // namespace
+
+TEST(Interned, EqualValuesShareStorage) {
+  InternedString a(std::string("foo"));
+  InternedString b(std::string("foo"));
+  InternedString c(std::string("bar"));
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(&a.get(), &b.get());
+  EXPECT_NE(a, c);
+  EXPECT_EQ("foo", *a);
+  EXPECT_EQ(3, a->size());
+  EXPECT_EQ(a.hash(), b.hash());
+}
+
+TEST(Interned, DefaultIsDefaultValue) {
+  InternedSet empty;
+  EXPECT_TRUE(empty->empty());
+  EXPECT_EQ(empty, InternedSet(std::set<int>()));
+  EXPECT_NE(empty, InternedSet(std::set<int>{1}));
+}
+
+TEST(Interned, ValuesDroppedWithLastHandle) {
+  auto before = InternedSet::numInterned();
+  {
+    InternedSet a(std::set<int>{1, 2, 3});
+    auto b = a;
+    EXPECT_EQ(before + 1, InternedSet::numInterned());
+    InternedSet c(std::set<int>{4});
+    EXPECT_EQ(before + 2, InternedSet::numInterned());
+  }
+  EXPECT_EQ(before, InternedSet::numInterned());
+  // Interning a value again after it was dropped works
+  InternedSet a(std::set<int>{1, 2, 3});
+  EXPECT_EQ(3, a->size());
+  EXPECT_EQ(before + 1, InternedSet::numInterned());
+}
+
+TEST(Interned, ConcurrentInterning) {
+  constexpr auto kNumThreads = 8;
+  constexpr auto kNumIterations = 10000;
+  std::vector<std::thread> threads;
+  std::vector<InternedSet> results(kNumThreads);
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([i, &results] {
+      for (auto j = 0; j < kNumIterations; ++j) {
+        // Repeatedly intern and drop the same few values
+        InternedSet value(std::set<int>{j % 4});
+        if (j == kNumIterations - 1) {
+          results[i] = value;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& result : results) {
+    EXPECT_EQ(results.front(), result);
+  }
+}
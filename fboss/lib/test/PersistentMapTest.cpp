@@ -0,0 +1,195 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/PersistentMap.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+using namespace facebook::fboss;
+
+namespace {
+using TestMap = PersistentMap<int, std::shared_ptr<int>>;
+using RefMap = std::map<int, std::shared_ptr<int>>;
+
+void expectSameEntries(const TestMap& map, const RefMap& expected) {
+  ASSERT_EQ(map.size(), expected.size());
+  auto it = map.begin();
+  for (const auto& entry : expected) {
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->first, entry.first);
+    EXPECT_EQ(it->second, entry.second);
+    ++it;
+  }
+  EXPECT_EQ(it, map.end());
+
+  auto rit = map.rbegin();
+  for (auto expectedIt = expected.rbegin(); expectedIt != expected.rend();
+       ++expectedIt) {
+    ASSERT_NE(rit, map.rend());
+    EXPECT_EQ(rit->first, expectedIt->first);
+    ++rit;
+  }
+  EXPECT_EQ(rit, map.rend());
+}
+
+// Count the entries visited while walking two maps in lockstep, skipping
+// shared entries the same way NodeMapDelta does.
+int countDifferences(const TestMap& a, const TestMap& b) {
+  int differences = 0;
+  auto aIt = a.begin();
+  auto bIt = b.begin();
+  while (true) {
+    advancePastShared(aIt, a.end(), bIt, b.end());
+    if (aIt == a.end() && bIt == b.end()) {
+      break;
+    }
+    ++differences;
+    if (bIt == b.end() || (aIt != a.end() && aIt->first < bIt->first)) {
+      ++aIt;
+    } else if (aIt == a.end() || bIt->first < aIt->first) {
+      ++bIt;
+    } else {
+      ++aIt;
+      ++bIt;
+    }
+  }
+  return differences;
+}
+} // namespace
+
+TEST(PersistentMap, empty) {
+  TestMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.rbegin(), map.rend());
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_EQ(map.erase(1), 0);
+}
+
+TEST(PersistentMap, insertFindErase) {
+  TestMap map;
+  RefMap expected;
+  for (int i = 0; i < 10000; ++i) {
+    // Insert out of order to exercise splits in the middle of nodes
+    int key = (i * 7919) % 10000;
+    auto value = std::make_shared<int>(key);
+    auto ret = map.insert(std::make_pair(key, value));
+    EXPECT_TRUE(ret.second);
+    EXPECT_EQ(ret.first->first, key);
+    expected[key] = value;
+  }
+  expectSameEntries(map, expected);
+
+  // Inserting an existing key doesn't replace the value
+  auto ret = map.insert(std::make_pair(42, std::make_shared<int>(-1)));
+  EXPECT_FALSE(ret.second);
+  EXPECT_EQ(*ret.first->second, 42);
+
+  auto replacement = std::make_shared<int>(-1);
+  map.insert_or_assign(42, replacement);
+  expected[42] = replacement;
+  EXPECT_EQ(map.find(42)->second, replacement);
+
+  for (int key = 0; key < 10000; key += 3) {
+    EXPECT_EQ(map.erase(key), 1);
+    expected.erase(key);
+  }
+  EXPECT_EQ(map.erase(3), 0);
+  expectSameEntries(map, expected);
+
+  EXPECT_EQ(map.lower_bound(3)->first, 4);
+  EXPECT_EQ(map.lower_bound(10000), map.end());
+
+  auto it = map.begin();
+  while (it != map.end()) {
+    it = map.erase(it);
+  }
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(PersistentMap, copiesAreIndependent) {
+  TestMap map;
+  RefMap expected;
+  for (int i = 0; i < 5000; ++i) {
+    auto value = std::make_shared<int>(i);
+    map.insert(std::make_pair(i, value));
+    expected[i] = value;
+  }
+
+  auto copy = map;
+  auto copyExpected = expected;
+  for (int i = 0; i < 5000; i += 100) {
+    auto value = std::make_shared<int>(-i);
+    copy.insert_or_assign(i, value);
+    copyExpected[i] = value;
+    copy.erase(i + 1);
+    copyExpected.erase(i + 1);
+  }
+  copy.insert(std::make_pair(10000, std::make_shared<int>(10000)));
+  copyExpected[10000] = copy.find(10000)->second;
+
+  expectSameEntries(map, expected);
+  expectSameEntries(copy, copyExpected);
+  EXPECT_NE(map, copy);
+}
+
+TEST(PersistentMap, advancePastShared) {
+  TestMap map;
+  for (int i = 0; i < 100000; ++i) {
+    map.insert(std::make_pair(i, std::make_shared<int>(i)));
+  }
+  auto copy = map;
+  EXPECT_EQ(countDifferences(map, copy), 0);
+  EXPECT_EQ(map, copy);
+
+  copy.insert_or_assign(500, std::make_shared<int>(-1));
+  copy.erase(70000);
+  copy.insert(std::make_pair(100000, std::make_shared<int>(100000)));
+  EXPECT_EQ(countDifferences(map, copy), 3);
+
+  // Equal maps built independently share no nodes, and are compared entry by
+  // entry.
+  TestMap rebuilt;
+  for (const auto& entry : map) {
+    rebuilt.insert(entry);
+  }
+  EXPECT_EQ(countDifferences(map, rebuilt), 0);
+  EXPECT_EQ(map, rebuilt);
+}
+
+TEST(PersistentMap, randomOperations) {
+  std::mt19937 rng(0);
+  TestMap map;
+  RefMap expected;
+  for (int i = 0; i < 100000; ++i) {
+    int key = rng() % 2000;
+    if (rng() % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      auto value = std::make_shared<int>(i);
+      map.insert_or_assign(key, value);
+      expected[key] = value;
+    }
+    if (i % 10000 == 0) {
+      auto snapshot = map;
+      auto snapshotExpected = expected;
+      expectSameEntries(map, expected);
+      if (!map.empty()) {
+        map.erase(map.begin());
+        expected.erase(expected.begin());
+      }
+      expectSameEntries(snapshot, snapshotExpected);
+    }
+  }
+  expectSameEntries(map, expected);
+}
@@ -3,7 +3,9 @@
 #include <folly/Benchmark.h>
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
+#include <iostream>
 #include <set>
+#include <utility>
 #include <vector>
 #include "PyRadixWrapper.h"
 #include "common/base/Random.h"
@@ -27,6 +29,11 @@ DEFINE_int32(
     lookup_count,
     5000,
     "The number of elements to look up on each lookup iteration");
+DEFINE_int32(
+    dc_route_scale,
+    20,
+    "Factor by which to scale the fleet route distribution used by the "
+    "DC benchmarks");
 namespace {
 set<Prefix4> insertSet4;
 set<Prefix4> eraseSet4;
@@ -197,9 +204,254 @@ BENCHMARK_RELATIVE(RadixTreeLongestMatch6) {
   }
 }
 
+// DC benchmarks
+//
+// The benchmarks above use uniformly random prefixes, which make for a
+// sparse, bushy tree. Routes in our DCs are allocated sequentially out of a
+// few mask lengths instead, so these use the mask length distribution of a
+// random wedge in the fleet (same as HwWarmbootExitBenchmark), scaled up by
+// --dc_route_scale, with consecutive prefixes of each mask length like
+// RouteDistributionGenerator generates.
+
+// Mask length to number of prefixes
+const vector<pair<uint8_t, int>> kDcDistribution6 = {
+    {37, 7},
+    {44, 11},
+    {47, 6},
+    {48, 3},
+    {52, 61},
+    {54, 340},
+    {64, 1542},
+    {80, 1},
+    {127, 4},
+};
+const vector<pair<uint8_t, int>> kDcDistribution4 = {
+    {15, 4},
+    {16, 1},
+    {17, 1},
+    {21, 10},
+    {24, 31},
+    {26, 6},
+    {27, 26},
+    {31, 40},
+};
+
+vector<Prefix4> dcPrefixes4;
+vector<Prefix6> dcPrefixes6;
+// Host addresses covered by the DC prefixes, to look up
+vector<IPAddressV4> dcLookups4;
+vector<IPAddressV6> dcLookups6;
+
+IPAddressV4 nthPrefix4(const IPAddressV4& base, uint8_t mask, uint32_t n) {
+  return IPAddressV4::fromLongHBO(base.toLongHBO() + (n << (32 - mask)));
+}
+
+IPAddressV6 nthPrefix6(const IPAddressV6& base, uint8_t mask, uint32_t n) {
+  auto bytes = base.toByteArray();
+  // Add n at bit position mask, carrying towards the most significant byte
+  auto bit = 128 - mask;
+  unsigned __int128 carry = static_cast<unsigned __int128>(n) << (bit % 8);
+  for (int i = 15 - bit / 8; i >= 0 && carry; --i) {
+    carry += bytes[i];
+    bytes[i] = carry & 0xff;
+    carry >>= 8;
+  }
+  return IPAddressV6(bytes);
+}
+
+void setupDcPrefixes() {
+  for (const auto& maskAndCount : kDcDistribution4) {
+    auto mask = maskAndCount.first;
+    auto base = IPAddressV4::fromLongHBO(folly::Random::rand32()).mask(mask);
+    for (int i = 0; i < maskAndCount.second * FLAGS_dc_route_scale; ++i) {
+      dcPrefixes4.emplace_back(nthPrefix4(base, mask, i), mask);
+    }
+  }
+  // All v6 routes are carved out of 2401:db00::/32
+  auto supernet6 = IPAddressV6("2401:db00::");
+  for (const auto& maskAndCount : kDcDistribution6) {
+    auto mask = maskAndCount.first;
+    auto bytes = supernet6.toByteArray();
+    *(uint64_t*)(&bytes[4]) ^= folly::Random::rand64();
+    *(uint32_t*)(&bytes[12]) ^= folly::Random::rand32();
+    auto base = IPAddressV6(bytes).mask(mask);
+    for (int i = 0; i < maskAndCount.second * FLAGS_dc_route_scale; ++i) {
+      dcPrefixes6.emplace_back(nthPrefix6(base, mask, i), mask);
+    }
+  }
+
+  for (int i = 0; i < FLAGS_lookup_count; ++i) {
+    const auto& pfx4 = dcPrefixes4[folly::Random::rand32(dcPrefixes4.size())];
+    auto hostBits4 = uint64_t(folly::Random::rand32()) >> pfx4.mask;
+    dcLookups4.push_back(
+        IPAddressV4::fromLongHBO(pfx4.ip.toLongHBO() | hostBits4));
+
+    const auto& pfx6 = dcPrefixes6[folly::Random::rand32(dcPrefixes6.size())];
+    auto network6 = pfx6.ip.toByteArray();
+    ByteArray16 host6;
+    *(uint64_t*)(&host6[0]) = folly::Random::rand64();
+    *(uint64_t*)(&host6[8]) = folly::Random::rand64();
+    for (int byte = 0; byte < 16; ++byte) {
+      auto networkBits = min(max(pfx6.mask - byte * 8, 0), 8);
+      uint8_t networkMask = 0xff00 >> networkBits;
+      host6[byte] =
+          (network6[byte] & networkMask) | (host6[byte] & ~networkMask);
+    }
+    dcLookups6.push_back(IPAddressV6(host6));
+  }
+}
+
+template <typename TREE, typename PREFIXES>
+void setupDcTree(TREE& tree, const PREFIXES& prefixes) {
+  auto count = 0;
+  for (const auto& pfx : prefixes) {
+    tree.insert(pfx.ip, pfx.mask, count++);
+  }
+}
+
+template <typename NODE>
+size_t countNodes(const NODE* node) {
+  return node ? 1 + countNodes(node->left()) + countNodes(node->right()) : 0;
+}
+
+template <typename TREE>
+void printMemoryFootprint(const string& name, const TREE& tree) {
+  auto nodes = countNodes(tree.root());
+  cout << name << ": " << tree.size() << " prefixes, " << nodes
+       << " nodes of " << sizeof(typename TREE::TreeNode) << " bytes, "
+       << tree.allocatedBytes() << " bytes allocated ("
+       << tree.allocatedBytes() / max<size_t>(tree.size(), 1)
+       << " bytes/prefix)" << endl;
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(PyRadixDcInsert4) {
+  PyRadixWrapper<IPAddressV4, int> pyrtree;
+  setupDcTree(pyrtree, dcPrefixes4);
+}
+
+BENCHMARK_RELATIVE(RadixTreeDcInsert4) {
+  RadixTree<IPAddressV4, int> rtree;
+  setupDcTree(rtree, dcPrefixes4);
+}
+
+BENCHMARK(PyRadixDcErase4) {
+  PyRadixWrapper<IPAddressV4, int> pyrtree;
+  BENCHMARK_SUSPEND {
+    setupDcTree(pyrtree, dcPrefixes4);
+  }
+  for (const auto& pfx : dcPrefixes4) {
+    pyrtree.erase(pfx.ip, pfx.mask);
+  }
+}
+
+BENCHMARK_RELATIVE(RadixTreeDcErase4) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupDcTree(rtree, dcPrefixes4);
+  }
+  for (const auto& pfx : dcPrefixes4) {
+    rtree.erase(pfx.ip, pfx.mask);
+  }
+}
+
+BENCHMARK(PyRadixDcLongestMatch4) {
+  PyRadixWrapper<IPAddressV4, int> pyrtree;
+  BENCHMARK_SUSPEND {
+    setupDcTree(pyrtree, dcPrefixes4);
+  }
+  for (const auto& addr : dcLookups4) {
+    doNotOptimizeAway(pyrtree.longestMatch(addr, 32));
+  }
+}
+
+BENCHMARK_RELATIVE(RadixTreeDcLongestMatch4) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupDcTree(rtree, dcPrefixes4);
+  }
+  for (const auto& addr : dcLookups4) {
+    doNotOptimizeAway(rtree.longestMatch(addr, 32));
+  }
+}
+
+BENCHMARK(RadixTreeDcIterate4) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupDcTree(rtree, dcPrefixes4);
+  }
+  for (const auto& node : rtree) {
+    doNotOptimizeAway(node.value());
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(PyRadixDcInsert6) {
+  PyRadixWrapper<IPAddressV6, int> pyrtree;
+  setupDcTree(pyrtree, dcPrefixes6);
+}
+
+BENCHMARK_RELATIVE(RadixTreeDcInsert6) {
+  RadixTree<IPAddressV6, int> rtree;
+  setupDcTree(rtree, dcPrefixes6);
+}
+
+BENCHMARK(PyRadixDcErase6) {
+  PyRadixWrapper<IPAddressV6, int> pyrtree;
+  BENCHMARK_SUSPEND {
+    setupDcTree(pyrtree, dcPrefixes6);
+  }
+  for (const auto& pfx : dcPrefixes6) {
+    pyrtree.erase(pfx.ip, pfx.mask);
+  }
+}
+
+BENCHMARK_RELATIVE(RadixTreeDcErase6) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupDcTree(rtree, dcPrefixes6);
+  }
+  for (const auto& pfx : dcPrefixes6) {
+    rtree.erase(pfx.ip, pfx.mask);
+  }
+}
+
+BENCHMARK(PyRadixDcLongestMatch6) {
+  PyRadixWrapper<IPAddressV6, int> pyrtree;
+  BENCHMARK_SUSPEND {
+    setupDcTree(pyrtree, dcPrefixes6);
+  }
+  for (const auto& addr : dcLookups6) {
+    doNotOptimizeAway(pyrtree.longestMatch(addr, 128));
+  }
+}
+
+BENCHMARK_RELATIVE(RadixTreeDcLongestMatch6) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupDcTree(rtree, dcPrefixes6);
+  }
+  for (const auto& addr : dcLookups6) {
+    doNotOptimizeAway(rtree.longestMatch(addr, 128));
+  }
+}
+
+BENCHMARK(RadixTreeDcIterate6) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupDcTree(rtree, dcPrefixes6);
+  }
+  for (const auto& node : rtree) {
+    doNotOptimizeAway(node.value());
+  }
+}
+
 } // namespace
 
-int main(int /*argc*/, char* /*argv*/ []) {
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
   vector<Prefix4> inserted4;
   while (insertSet4.size() < FLAGS_insert_count) {
     auto mask = folly::Random::rand32(32);
@@ -252,5 +504,15 @@ int main(int /*argc*/, char* /*argv*/ []) {
     auto newIp = pfx.ip.mask(newMask);
     longestMatchSet6.insert(Prefix6(newIp, newMask));
   }
+
+  setupDcPrefixes();
+  {
+    RadixTree<IPAddressV4, int> rtree4;
+    setupDcTree(rtree4, dcPrefixes4);
+    printMemoryFootprint("DC v4", rtree4);
+    RadixTree<IPAddressV6, int> rtree6;
+    setupDcTree(rtree6, dcPrefixes6);
+    printMemoryFootprint("DC v6", rtree6);
+  }
   runBenchmarks();
 }
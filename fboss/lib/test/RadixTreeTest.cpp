@@ -1343,6 +1343,49 @@ TEST(RadixTree, MoveConstructible) {
       accumulate(ipRtree.begin(), ipRtree.end(), 0, counterIP));
 }
 
+TEST(RadixTree, MovedNodesOutliveSourceTree) {
+  auto deletedFromA = 0;
+  auto deletedFromB = 0;
+  auto treeA = std::make_unique<RadixTree<IPAddressV4, int>>(
+      [&](const RadixTreeNode<IPAddressV4, int>& n) {
+        deletedFromA += !n.isNonValueNode();
+      });
+  RadixTree<IPAddressV4, int> treeB(
+      [&](const RadixTreeNode<IPAddressV4, int>& n) {
+        deletedFromB += !n.isNonValueNode();
+      });
+  setupTestTree4(*treeA);
+  auto prefixesMoved = treeA->size();
+  treeB = std::move(*treeA);
+  // Nodes moved to treeB keep treeA's delete callback, even once treeA
+  // itself is gone
+  treeA.reset();
+  EXPECT_EQ(0, deletedFromA);
+  EXPECT_EQ(prefixesMoved, treeB.size());
+
+  EXPECT_TRUE(treeB.insert(ip80_0_0_1, 32, 100).second);
+  EXPECT_TRUE(treeB.erase(ip80_0_0_1, 32));
+  EXPECT_EQ(0, deletedFromA);
+  EXPECT_EQ(1, deletedFromB);
+  treeB.clear();
+  EXPECT_EQ(prefixesMoved, deletedFromA);
+  EXPECT_EQ(1, deletedFromB);
+}
+
+TEST(RadixTree, EraseAndInsertReusesNodes) {
+  RadixTree<IPAddressV4, int> rtree;
+  setupTestTree4(rtree);
+  auto allocatedBytes = rtree.allocatedBytes();
+  EXPECT_LT(0, allocatedBytes);
+  for (auto i = 0; i < 10; ++i) {
+    auto erased = rtree.clone();
+    rtree.clear();
+    setupTestTree4(rtree);
+    EXPECT_TRUE(rtree == erased);
+    EXPECT_EQ(allocatedBytes, rtree.allocatedBytes());
+  }
+}
+
 TEST(RadixTree, Clone) {
   RadixTree<IPAddressV4, int> v4Tree;
   RadixTree<IPAddressV6, int> v6Tree;
@@ -26,6 +26,11 @@ class StatsPublisher {
   static void bumpModuleErrors();
   static void missingPorts(TransceiverID module);
   static void bumpAOIOverride();
+  // I2C bytes not read thanks to change-driven DOM refresh, compared to
+  // rereading the whole first page every refresh interval. Can be negative.
+  static void bumpDomBytesSaved(int64_t bytes);
+  // Seconds since the module's DOM data was last read
+  static void updateDomDataAge(TransceiverID module, int64_t ageSec);
 
  private:
   TransceiverManager* transceiverManager_{nullptr};
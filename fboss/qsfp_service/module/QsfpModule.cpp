@@ -207,7 +207,7 @@ bool QsfpModule::customizationSupported() const {
 }
 
 bool QsfpModule::shouldRefresh(time_t cooldown) const {
-  return std::time(nullptr) - lastRefreshTime_ >= cooldown;
+  return std::time(nullptr) - lastRefreshTime_ + refreshPhase_ >= cooldown;
 }
 
 void QsfpModule::ensureOutOfReset() const {
@@ -295,8 +295,29 @@ folly::Future<folly::Unit> QsfpModule::futureRefresh() {
 void QsfpModule::refreshLocked() {
   detectPresenceLocked();
 
+  if (present_ && !dirty_) {
+    StatsPublisher::updateDomDataAge(
+        getID(), std::time(nullptr) - lastRefreshTime_);
+  }
+
   auto customizeWanted = customizationWanted(FLAGS_customize_interval);
   auto willRefresh = !dirty_ && shouldRefresh(FLAGS_qsfp_data_refresh_interval);
+  if (present_ && !dirty_ && !willRefresh) {
+    switch (pollQsfpFlags()) {
+      case FlagsPollResult::NONE:
+        interruptRefreshed_ = false;
+        break;
+      case FlagsPollResult::REFRESH_VOLATILE:
+        // Only refresh early once per interrupt. While the module keeps
+        // signaling, the periodic refresh picks up any further changes.
+        willRefresh = !interruptRefreshed_;
+        interruptRefreshed_ = true;
+        break;
+      case FlagsPollResult::REFRESH_ALL:
+        dirty_ = true;
+        break;
+    }
+  }
   if (!dirty_ && !customizeWanted && !willRefresh) {
     return;
   }
@@ -305,6 +326,10 @@ void QsfpModule::refreshLocked() {
     // make sure data is up to date before trying to customize.
     ensureOutOfReset();
     updateQsfpData(true);
+    if (FLAGS_qsfp_data_refresh_interval > 0) {
+      refreshPhase_ =
+          static_cast<int>(getID()) % FLAGS_qsfp_data_refresh_interval;
+    }
   }
 
   if (customizeWanted) {
@@ -315,14 +340,18 @@ void QsfpModule::refreshLocked() {
     }
   }
 
-  if (customizeWanted || willRefresh) {
-    // update either if data is stale or if we customized this
-    // round. We update in the customization because we may have
-    // written fields, but only need a partial update because all of
-    // these fields are in the LOWER qsfp page. There are a small
-    // number of writable fields on other qsfp pages, but we don't
-    // currently use them.
+  if (customizeWanted) {
+    // We update in the customization because we may have written
+    // fields, but only need a partial update because all of these
+    // fields are in the LOWER qsfp page. There are a small number of
+    // writable fields on other qsfp pages, but we don't currently use
+    // them.
     updateQsfpData(false);
+  } else if (willRefresh) {
+    // Data is stale, but we haven't written anything, so only the fields
+    // that change on their own need refreshing.
+    updateVolatileQsfpData();
+    refreshPhase_ = 0;
   }
 
   // assign
@@ -148,6 +148,15 @@ class QsfpModule : public Transceiver {
    * too frequently. These MUST be accessed holding qsfpModuleMutex_.
    */
   time_t lastRefreshTime_{0};
+  // How much earlier than the refresh interval the next periodic refresh
+  // is due. This spreads the refreshes of different modules over the
+  // interval instead of bursting them all after e.g. a restart.
+  time_t refreshPhase_{0};
+  // Whether we already refreshed early for the interrupt the module is
+  // still signaling. Flags for persistent conditions (e.g. Rx LOS on a
+  // down port) re-latch as soon as they are read, so they would otherwise
+  // trigger a refresh on every poll.
+  bool interruptRefreshed_{false};
   time_t lastCustomizeTime_{0};
   time_t lastRemediateTime_{0};
 
@@ -269,6 +278,32 @@ class QsfpModule : public Transceiver {
    */
   virtual void updateQsfpData(bool allPages = true) = 0;
 
+  /*
+   * Update only the cached fields that change without us writing to the
+   * transceiver, i.e. status, flags and monitors. This is what the
+   * periodic refresh reads. Defaults to refreshing the first page.
+   */
+  virtual void updateVolatileQsfpData() {
+    updateQsfpData(false);
+  }
+
+  enum class FlagsPollResult {
+    // Nothing changed
+    NONE,
+    // The module is signaling a flag, so refresh the volatile data now
+    REFRESH_VOLATILE,
+    // The module reinitialized, so refresh all pages
+    REFRESH_ALL,
+  };
+
+  /*
+   * Cheaply poll the module's status and interrupt bits between periodic
+   * refreshes, to find out whether the cached data needs refreshing early.
+   */
+  virtual FlagsPollResult pollQsfpFlags() {
+    return FlagsPollResult::NONE;
+  }
+
   /*
    * Helpers to parse DOM data for DAC cables. These incorporate some
    * extra fields that FB has vendors put in the 'Vendor specific'
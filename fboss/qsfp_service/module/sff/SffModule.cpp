@@ -34,6 +34,15 @@ namespace {
 
 constexpr int kUsecBetweenPowerModeFlap = 100000;
 
+// Lower page bytes that change without us writing them: identifier, status,
+// latched flags and monitors. The control bytes follow them.
+constexpr int kVolatileLowerPageBytes = 82;
+// Identifier and status bytes, polled between refreshes
+constexpr int kStatusBytes = 3;
+// Bits of the second status byte
+constexpr uint8_t kStatusDataNotReady = 1 << 0;
+constexpr uint8_t kStatusIntL = 1 << 1;
+
 }
 
 namespace facebook {
@@ -702,6 +711,57 @@ void SffModule::updateQsfpData(bool allPages) {
   }
 }
 
+void SffModule::updateVolatileQsfpData() {
+  // expects the lock to be held
+  if (!present_) {
+    return;
+  }
+  try {
+    XLOG(DBG3) << "Performing volatile qsfp data cache refresh for transceiver "
+               << folly::to<std::string>(qsfpImpl_->getName());
+    qsfpImpl_->readTransceiver(
+        TransceiverI2CApi::ADDR_QSFP, 0, kVolatileLowerPageBytes, lowerPage_);
+    lastRefreshTime_ = std::time(nullptr);
+    StatsPublisher::bumpDomBytesSaved(
+        sizeof(lowerPage_) - kVolatileLowerPageBytes);
+  } catch (const std::exception& ex) {
+    dirty_ = true;
+    XLOG(ERR) << "Error update data for transceiver:"
+              << folly::to<std::string>(qsfpImpl_->getName()) << ": "
+              << ex.what();
+    throw;
+  }
+}
+
+QsfpModule::FlagsPollResult SffModule::pollQsfpFlags() {
+  // expects the lock to be held
+  std::array<uint8_t, kStatusBytes> status = {{0}};
+  try {
+    qsfpImpl_->readTransceiver(
+        TransceiverI2CApi::ADDR_QSFP, 0, status.size(), status.data());
+  } catch (const std::exception& ex) {
+    dirty_ = true;
+    XLOG(ERR) << "Error polling flags for transceiver:"
+              << folly::to<std::string>(qsfpImpl_->getName()) << ": "
+              << ex.what();
+    throw;
+  }
+  // Polls are extra reads compared to refreshing the first page on every
+  // refresh interval
+  StatsPublisher::bumpDomBytesSaved(-kStatusBytes);
+
+  auto wasNotReady = lowerPage_[2] & kStatusDataNotReady;
+  auto notReady = status[2] & kStatusDataNotReady;
+  if (status[0] != lowerPage_[0] || (wasNotReady && !notReady)) {
+    return FlagsPollResult::REFRESH_ALL;
+  }
+  if (!(status[2] & kStatusIntL)) {
+    // IntL is active low
+    return FlagsPollResult::REFRESH_VOLATILE;
+  }
+  return FlagsPollResult::NONE;
+}
+
 void SffModule::setCdrIfSupported(
     cfg::PortSpeed speed,
     FeatureState currentStateTx,
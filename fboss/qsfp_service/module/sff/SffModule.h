@@ -201,6 +201,19 @@ class SffModule : public QsfpModule {
    */
   void updateQsfpData(bool allPages = true) override;
 
+  /*
+   * Reread the lower page up to the end of the channel monitors. The
+   * control bytes after that only change when we write them.
+   */
+  void updateVolatileQsfpData() override;
+
+  /*
+   * Read the identifier and status bytes. An asserted IntL means a flag
+   * changed, and a module that became ready or changed identity needs all
+   * of its pages reread.
+   */
+  FlagsPollResult pollQsfpFlags() override;
+
  private:
   /*
    * Helpers to parse DOM data for DAC cables. These incorporate some
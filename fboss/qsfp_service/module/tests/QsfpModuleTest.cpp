@@ -402,6 +402,73 @@ TEST_F(QsfpModuleTest, updateQsfpDataFull) {
   qsfp_->actualUpdateQsfpData(true);
 }
 
+TEST_F(QsfpModuleTest, refreshPollsFlagsBetweenRefreshes) {
+  // Fresh data, so the next refresh isn't due yet
+  qsfp_->actualUpdateQsfpData(true);
+
+  // IntL deasserted: only the status bytes are read
+  std::array<uint8_t, 3> status = {{0, 0, 0x02}};
+  EXPECT_CALL(*transImpl_, readTransceiver(_, 0, 3, _))
+      .WillOnce(DoAll(
+          SetArrayArgument<3>(status.begin(), status.end()), Return(0)));
+  EXPECT_CALL(*transImpl_, readTransceiver(_, _, Ne(3), _)).Times(0);
+  EXPECT_CALL(*qsfp_, updateQsfpData(_)).Times(0);
+  qsfp_->refresh();
+}
+
+TEST_F(QsfpModuleTest, refreshVolatileDataOnInterrupt) {
+  qsfp_->actualUpdateQsfpData(true);
+
+  // IntL asserted: the flags and monitors are reread, but not the control
+  // bytes or upper pages
+  std::array<uint8_t, 3> status = {{0, 0, 0}};
+  EXPECT_CALL(*transImpl_, readTransceiver(_, 0, 3, _))
+      .WillOnce(DoAll(
+          SetArrayArgument<3>(status.begin(), status.end()), Return(0)));
+  EXPECT_CALL(*transImpl_, readTransceiver(_, 0, 82, _)).Times(1);
+  EXPECT_CALL(*qsfp_, updateQsfpData(_)).Times(0);
+  EXPECT_CALL(*transImpl_, writeTransceiver(_, _, _, _)).Times(0);
+  qsfp_->refresh();
+}
+
+TEST_F(QsfpModuleTest, refreshOnceOnPersistentInterrupt) {
+  qsfp_->actualUpdateQsfpData(true);
+
+  // A persistent condition keeps IntL asserted across polls, but only the
+  // first poll rereads the flags and monitors
+  std::array<uint8_t, 3> asserted = {{0, 0, 0}};
+  std::array<uint8_t, 3> deasserted = {{0, 0, 0x02}};
+  EXPECT_CALL(*transImpl_, readTransceiver(_, 0, 3, _))
+      .WillOnce(DoAll(
+          SetArrayArgument<3>(asserted.begin(), asserted.end()), Return(0)))
+      .WillOnce(DoAll(
+          SetArrayArgument<3>(asserted.begin(), asserted.end()), Return(0)))
+      .WillOnce(DoAll(
+          SetArrayArgument<3>(deasserted.begin(), deasserted.end()),
+          Return(0)))
+      .WillOnce(DoAll(
+          SetArrayArgument<3>(asserted.begin(), asserted.end()), Return(0)));
+  EXPECT_CALL(*transImpl_, readTransceiver(_, 0, 82, _)).Times(2);
+  EXPECT_CALL(*qsfp_, updateQsfpData(_)).Times(0);
+  qsfp_->refresh();
+  qsfp_->refresh();
+  // Once IntL deasserts, the next interrupt refreshes early again
+  qsfp_->refresh();
+  qsfp_->refresh();
+}
+
+TEST_F(QsfpModuleTest, refreshAllPagesOnModuleChange) {
+  qsfp_->actualUpdateQsfpData(true);
+
+  // A different identifier means a different module
+  std::array<uint8_t, 3> status = {{0x11, 0, 0x02}};
+  EXPECT_CALL(*transImpl_, readTransceiver(_, 0, 3, _))
+      .WillOnce(DoAll(
+          SetArrayArgument<3>(status.begin(), status.end()), Return(0)));
+  EXPECT_CALL(*qsfp_, updateQsfpData(true)).Times(1);
+  qsfp_->refresh();
+}
+
 TEST_F(QsfpModuleTest, skipCustomizingMissingPorts) {
   // set present_ = false, dirty_ = true
   EXPECT_CALL(*transImpl_, detectTransceiver()).WillRepeatedly(Return(false));
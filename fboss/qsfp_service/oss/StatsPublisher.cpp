@@ -30,4 +30,10 @@ void StatsPublisher::missingPorts(TransceiverID /* unused */) {
 void StatsPublisher::bumpModuleErrors() {}
 // static
 void StatsPublisher::bumpAOIOverride() {}
+// static
+void StatsPublisher::bumpDomBytesSaved(int64_t /* unused */) {}
+// static
+void StatsPublisher::updateDomDataAge(
+    TransceiverID /* unused */,
+    int64_t /* unused */) {}
 }}
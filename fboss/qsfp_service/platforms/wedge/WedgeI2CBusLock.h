@@ -19,6 +19,10 @@ namespace facebook { namespace fboss {
 /*
  * A small wrapper around CP2112 which is aware of the topology of wedge's QSFP
  * I2C bus, and can select specific QSFPs to query.
+ *
+ * Every access to the bus is serialized, not just accesses to one module:
+ * all modules are reached through the same CP2112 and the mux selection
+ * (selectedPort_) of the wrapped bus.
  */
 class WedgeI2CBusLock : public TransceiverI2CApi {
  public:
@@ -4,6 +4,7 @@
 
 #include <folly/logging/xlog.h>
 #include <fb303/ThreadCachedServiceData.h>
+#include "fboss/lib/i2c/gen-cpp2/i2c_controller_stats_constants.h"
 #include "fboss/qsfp_service/module/QsfpModule.h"
 #include "fboss/qsfp_service/module/cmis/CmisModule.h"
 #include "fboss/qsfp_service/module/sff/SffModule.h"
@@ -17,6 +18,24 @@ constexpr int kSecAfterModuleOutOfReset = 2;
 
 namespace facebook { namespace fboss {
 
+namespace {
+
+// Publish one counter per bucket, named after the bucket's upper bound
+void publishLatencyHistogram(
+    const std::string& prefix,
+    const std::vector<int64_t>& histogram) {
+  const auto& bounds =
+      i2c_controller_stats_constants::LATENCY_BUCKET_BOUNDS_US();
+  for (size_t i = 0; i < histogram.size(); ++i) {
+    auto statName = i < bounds.size()
+        ? folly::to<std::string>(prefix, ".le_", bounds[i], "us")
+        : folly::to<std::string>(prefix, ".inf");
+    tcData().setCounter(statName, histogram[i]);
+  }
+}
+
+} // namespace
+
 WedgeManager::WedgeManager(std::unique_ptr<TransceiverPlatformApi> api) :
   qsfpPlatApi_(std::move(api)) {
   /* Constructor for WedgeManager class:
@@ -282,6 +301,15 @@ void WedgeManager::publishI2cTransactionStats() {
     statName = folly::to<std::string>(
         "qsfp.", *counter.controllerName__ref(), ".writeBytes");
     tcData().setCounter(statName, *counter.writeBytes__ref());
+
+    publishLatencyHistogram(
+        folly::to<std::string>(
+            "qsfp.", *counter.controllerName__ref(), ".readLatency"),
+        *counter.readLatencyHistogram__ref());
+    publishLatencyHistogram(
+        folly::to<std::string>(
+            "qsfp.", *counter.controllerName__ref(), ".writeLatency"),
+        *counter.writeLatencyHistogram__ref());
   }
 }
 